@@ -8,6 +8,7 @@ Possible options:
   -h,         --help                  Display help
   -p,         --pybind                Compile python bindings
   -n,         --no-tests              Don't build tests
+  -b,         --benchmarks            Build benchmarks
   -u,         --no-unpack             Don't unpack datasets
   -j[N],      --jobs[=N]              Allow N jobs at once (default [=1])
   -d,         --debug                 Set debug build type
@@ -29,6 +30,9 @@ for i in "$@"
         -n|--no-tests) # Don't build tests
             NO_TESTS=true
             ;;
+        -b|--benchmarks) # Build benchmarks
+            BENCHMARKS=true
+            ;;
         -u|--no-unpack) # Don't unpack datasets
             NO_UNPACK=true
             ;;
@@ -86,6 +90,10 @@ else
   fi
 fi
 
+if [[ $BENCHMARKS == true ]]; then
+  PREFIX="$PREFIX -D COMPILE_BENCHMARKS=ON"
+fi
+
 if [[ $NO_UNPACK == true ]]; then
   PREFIX="$PREFIX -D UNPACK_DATASETS=OFF"
 fi
@@ -0,0 +1,127 @@
+#include "comparison.h"
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <tuple>
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+namespace bench {
+
+namespace {
+
+using boost::property_tree::ptree;
+
+using RunKey = std::tuple<std::string, std::size_t, unsigned>;
+
+struct Run {
+    bool ok;
+    bool isolated;
+    double wall_ms;
+    std::size_t peak_rss_bytes;
+};
+
+std::map<RunKey, Run> ReadRuns(std::filesystem::path const& path) {
+    ptree document;
+    boost::property_tree::read_json(path.string(), document);
+    std::map<RunKey, Run> runs;
+    for (auto const& [_, run] : document.get_child("runs")) {
+        RunKey key{run.get<std::string>("case"), run.get<std::size_t>("rows"),
+                   run.get<unsigned>("threads")};
+        runs[std::move(key)] = {run.get<std::string>("status") == "ok",
+                                run.get<bool>("isolated", false),
+                                run.get<double>("wall_ms_median", 0),
+                                run.get<std::size_t>("peak_rss_bytes", 0)};
+    }
+    return runs;
+}
+
+std::string ToString(RunKey const& key) {
+    auto const& [name, rows, threads] = key;
+    return name + " rows=" + (rows == 0 ? "all" : std::to_string(rows)) +
+           " threads=" + std::to_string(threads);
+}
+
+std::string FormatChange(double baseline, double current, char const* unit) {
+    char text[96];
+    std::snprintf(text, sizeof(text), "%.1f %s -> %.1f %s (%+.1f%%)", baseline, unit, current, unit,
+                  (current / baseline - 1) * 100);
+    return text;
+}
+
+enum class Change { kNone, kRegression, kImprovement };
+
+Change GetChange(double baseline, double current, double tolerance, double min_difference) {
+    if (current > baseline * (1 + tolerance) && current - baseline > min_difference) {
+        return Change::kRegression;
+    }
+    if (current < baseline * (1 - tolerance) && baseline - current > min_difference) {
+        return Change::kImprovement;
+    }
+    return Change::kNone;
+}
+
+}  // namespace
+
+std::size_t CompareWithBaseline(std::filesystem::path const& results_path,
+                                std::filesystem::path const& baseline_path,
+                                ComparisonOptions const& options, std::ostream& out) {
+    std::map<RunKey, Run> const runs = ReadRuns(results_path);
+    std::map<RunKey, Run> const baseline_runs = ReadRuns(baseline_path);
+    std::size_t regressions = 0;
+    std::size_t improvements = 0;
+    std::size_t missing = 0;
+    std::size_t dropped = 0;
+    auto report = [&](Change change, RunKey const& key, std::string const& what) {
+        if (change == Change::kNone) return;
+        if (change == Change::kRegression) {
+            ++regressions;
+            out << "REGRESSION  ";
+        } else {
+            ++improvements;
+            out << "improvement ";
+        }
+        out << ToString(key) << ": " << what << '\n';
+    };
+
+    for (auto const& [key, run] : runs) {
+        auto const it = baseline_runs.find(key);
+        if (it == baseline_runs.end()) {
+            ++missing;
+            out << "new         " << ToString(key) << ": not in the baseline\n";
+            continue;
+        }
+        Run const& baseline = it->second;
+        if (!run.ok || !baseline.ok) {
+            if (baseline.ok) report(Change::kRegression, key, "failed, succeeded in the baseline");
+            if (run.ok) report(Change::kImprovement, key, "succeeded, failed in the baseline");
+            continue;
+        }
+        report(GetChange(baseline.wall_ms, run.wall_ms, options.tolerance,
+                         options.min_difference_ms),
+               key, "wall time " + FormatChange(baseline.wall_ms, run.wall_ms, "ms"));
+        if (run.isolated && baseline.isolated && baseline.peak_rss_bytes != 0) {
+            double const mib = 1 << 20;
+            report(GetChange(static_cast<double>(baseline.peak_rss_bytes),
+                             static_cast<double>(run.peak_rss_bytes), options.tolerance,
+                             static_cast<double>(options.min_difference_bytes)),
+                   key,
+                   "peak RSS " + FormatChange(static_cast<double>(baseline.peak_rss_bytes) / mib,
+                                              static_cast<double>(run.peak_rss_bytes) / mib,
+                                              "MiB"));
+        }
+    }
+    for (auto const& [key, baseline] : baseline_runs) {
+        if (runs.contains(key)) continue;
+        ++dropped;
+        out << "dropped     " << ToString(key) << ": only in the baseline\n";
+    }
+    out << runs.size() << " runs compared with " << baseline_path.string() << ": " << regressions
+        << " regressions, " << improvements << " improvements, " << missing
+        << " not in the baseline, " << dropped << " only in the baseline\n";
+    return regressions;
+}
+
+}  // namespace bench
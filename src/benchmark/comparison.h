@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <ostream>
+
+namespace bench {
+
+struct ComparisonOptions {
+    // Relative change of the median wall time or the peak RSS that is reported
+    double tolerance = 0.1;
+    // Changes of the median wall time smaller than this are noise whatever the relative change
+    double min_difference_ms = 5;
+    // Same for the peak RSS
+    std::size_t min_difference_bytes = 4 << 20;
+};
+
+/* Compares the runs of two result files, matching them by case, number of rows and number of
+ * threads. Prints the regressions, the improvements, the runs missing from the baseline and the
+ * baseline runs missing from the results to out, returns the number of regressions. A run that
+ * succeeded in the baseline and fails now is a regression. The peak RSS is only compared between
+ * runs made in processes of their own */
+std::size_t CompareWithBaseline(std::filesystem::path const& results_path,
+                                std::filesystem::path const& baseline_path,
+                                ComparisonOptions const& options, std::ostream& out);
+
+}  // namespace bench
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <concepts>
+#include <cstdio>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+namespace bench {
+
+/* Writes JSON to a stream without building a document. The caller is responsible for the calls
+ * forming a valid document, e.g. for every object member being preceded by Key */
+class JsonWriter {
+private:
+    std::ostream& out_;
+    // Whether a value has been written at every level of nesting
+    std::vector<bool> has_values_;
+    bool after_key_ = false;
+
+    void BeforeValue() {
+        if (after_key_) {
+            after_key_ = false;
+            return;
+        }
+        if (!has_values_.empty()) {
+            if (has_values_.back()) out_ << ',';
+            has_values_.back() = true;
+        }
+    }
+
+    void WriteString(std::string_view str) {
+        out_ << '"';
+        for (char c : str) {
+            switch (c) {
+                case '"':
+                    out_ << "\\\"";
+                    break;
+                case '\\':
+                    out_ << "\\\\";
+                    break;
+                case '\n':
+                    out_ << "\\n";
+                    break;
+                case '\t':
+                    out_ << "\\t";
+                    break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char escaped[7];
+                        std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                        out_ << escaped;
+                    } else {
+                        out_ << c;
+                    }
+            }
+        }
+        out_ << '"';
+    }
+
+public:
+    explicit JsonWriter(std::ostream& out) : out_(out) {}
+
+    JsonWriter& BeginObject() {
+        BeforeValue();
+        out_ << '{';
+        has_values_.push_back(false);
+        return *this;
+    }
+
+    JsonWriter& EndObject() {
+        has_values_.pop_back();
+        out_ << '}';
+        return *this;
+    }
+
+    JsonWriter& BeginArray() {
+        BeforeValue();
+        out_ << '[';
+        has_values_.push_back(false);
+        return *this;
+    }
+
+    JsonWriter& EndArray() {
+        has_values_.pop_back();
+        out_ << ']';
+        return *this;
+    }
+
+    JsonWriter& Key(std::string_view key) {
+        BeforeValue();
+        WriteString(key);
+        out_ << ':';
+        after_key_ = true;
+        return *this;
+    }
+
+    JsonWriter& Value(std::string_view value) {
+        BeforeValue();
+        WriteString(value);
+        return *this;
+    }
+
+    JsonWriter& Value(char const* value) {
+        return Value(std::string_view{value});
+    }
+
+    JsonWriter& Value(double value) {
+        BeforeValue();
+        char number[32];
+        std::snprintf(number, sizeof(number), "%.10g", value);
+        out_ << number;
+        return *this;
+    }
+
+    template <std::integral Integer>
+    JsonWriter& Value(Integer value) {
+        BeforeValue();
+        out_ << +value;
+        return *this;
+    }
+
+    JsonWriter& Value(bool value) {
+        BeforeValue();
+        out_ << (value ? "true" : "false");
+        return *this;
+    }
+
+    JsonWriter& Null() {
+        BeforeValue();
+        out_ << "null";
+        return *this;
+    }
+
+    /* Writes an already serialized value */
+    JsonWriter& Raw(std::string_view json) {
+        BeforeValue();
+        out_ << json;
+        return *this;
+    }
+
+    /* Starts a new line, whitespace between values does not change the document */
+    JsonWriter& NewLine() {
+        out_ << '\n';
+        return *this;
+    }
+};
+
+}  // namespace bench
@@ -0,0 +1,384 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#include <process.h>
+#else
+#include <spawn.h>
+#include <sys/wait.h>
+#endif
+
+#include <easylogging++.h>
+
+#include "comparison.h"
+#include "json_writer.h"
+#include "measurement.h"
+#include "suite.h"
+
+INITIALIZE_EASYLOGGINGPP
+
+#if !defined(_WIN32)
+extern char** environ;
+#endif
+
+namespace bench {
+
+namespace {
+
+constexpr std::string_view kUsage = R"(Usage: Desbordante_bench [options]
+
+Runs the mining algorithms over the datasets of input_data and writes the wall time, peak RSS,
+progress phase times and counters of every run as JSON.
+
+Options:
+  --family=NAME          only run the cases of a family: fd, afd, ucc, ind, od or stats
+  --algorithm=NAME       only run the cases of an algorithm
+  --dataset=TEXT         only run the cases whose datasets contain TEXT in their names
+  --heavy                also run the cases that take long on the whole datasets
+  --list                 print the selected cases and exit
+  --rows=N[,N...]        numbers of leading rows to run on, 0 for whole tables (default: 0)
+  --threads=N[,N...]     numbers of threads for the algorithms that take them (default: 1)
+  --repeat=N             repetitions of every run, the median wall time is compared (default: 3)
+  --data-dir=PATH        directory with the datasets (default: ./input_data)
+  --output=PATH          file to write the results to (default: benchmark_results.json)
+  --in-process           run every case in this process instead of a process of its own, the
+                         peak RSS then covers the earlier cases too
+  --baseline=PATH        compare the results with an earlier result file, exit with 1 if a run
+                         has regressed
+  --tolerance=X          relative change that is reported (default: 0.1)
+  --min-difference-ms=X  smaller changes of the wall time are ignored (default: 5)
+  --help                 print this message
+)";
+
+struct Options {
+    std::optional<std::string> family;
+    std::optional<std::string> algorithm;
+    std::optional<std::string> dataset;
+    bool heavy = false;
+    bool list = false;
+    std::vector<std::size_t> rows = {0};
+    std::vector<config::ThreadNumType> threads = {1};
+    unsigned repetitions = 3;
+    std::filesystem::path data_dir = std::filesystem::current_path() / "input_data";
+    std::filesystem::path output = "benchmark_results.json";
+    bool in_process = false;
+    std::optional<std::filesystem::path> baseline;
+    ComparisonOptions comparison;
+    bool help = false;
+    // Set when the process has been started to measure a single case
+    std::optional<std::string> run_case;
+};
+
+unsigned long ParseNumber(std::string_view option, std::string const& value) {
+    std::size_t parsed = 0;
+    unsigned long number;
+    try {
+        number = std::stoul(value, &parsed);
+    } catch (std::logic_error const&) {
+        parsed = 0;
+    }
+    if (parsed == 0 || parsed != value.size()) {
+        throw std::invalid_argument("Invalid value of --" + std::string(option) + ": " + value);
+    }
+    return number;
+}
+
+double ParseDouble(std::string_view option, std::string const& value) {
+    std::size_t parsed = 0;
+    double number;
+    try {
+        number = std::stod(value, &parsed);
+    } catch (std::logic_error const&) {
+        parsed = 0;
+    }
+    if (parsed == 0 || parsed != value.size() || number < 0) {
+        throw std::invalid_argument("Invalid value of --" + std::string(option) + ": " + value);
+    }
+    return number;
+}
+
+template <typename Number>
+std::vector<Number> ParseNumbers(std::string_view option, std::string const& value) {
+    std::vector<Number> numbers;
+    std::istringstream stream(value);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        numbers.push_back(static_cast<Number>(ParseNumber(option, item)));
+    }
+    if (numbers.empty()) {
+        throw std::invalid_argument("Invalid value of --" + std::string(option) + ": " + value);
+    }
+    return numbers;
+}
+
+Options ParseOptions(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i != argc; ++i) {
+        std::string_view const arg = argv[i];
+        if (!arg.starts_with("--")) {
+            throw std::invalid_argument("Unexpected argument " + std::string(arg));
+        }
+        std::size_t const equals = arg.find('=');
+        std::string_view const name = arg.substr(2, equals - 2);
+        bool const has_value = equals != std::string_view::npos;
+        std::string const value{has_value ? arg.substr(equals + 1) : std::string_view{}};
+
+        if (name == "heavy" || name == "list" || name == "in-process" || name == "help") {
+            if (has_value) {
+                throw std::invalid_argument("--" + std::string(name) + " takes no value");
+            }
+            if (name == "heavy") options.heavy = true;
+            if (name == "list") options.list = true;
+            if (name == "in-process") options.in_process = true;
+            if (name == "help") options.help = true;
+            continue;
+        }
+        if (!has_value) throw std::invalid_argument("--" + std::string(name) + " needs a value");
+        if (name == "family") {
+            options.family = value;
+        } else if (name == "algorithm") {
+            options.algorithm = value;
+        } else if (name == "dataset") {
+            options.dataset = value;
+        } else if (name == "rows") {
+            options.rows = ParseNumbers<std::size_t>(name, value);
+        } else if (name == "threads") {
+            options.threads = ParseNumbers<config::ThreadNumType>(name, value);
+        } else if (name == "repeat") {
+            options.repetitions = static_cast<unsigned>(ParseNumber(name, value));
+            if (options.repetitions == 0) throw std::invalid_argument("--repeat must be positive");
+        } else if (name == "data-dir") {
+            options.data_dir = value;
+        } else if (name == "output") {
+            options.output = value;
+        } else if (name == "baseline") {
+            options.baseline = value;
+        } else if (name == "tolerance") {
+            options.comparison.tolerance = ParseDouble(name, value);
+        } else if (name == "min-difference-ms") {
+            options.comparison.min_difference_ms = ParseDouble(name, value);
+        } else if (name == "run-case") {
+            options.run_case = value;
+        } else {
+            throw std::invalid_argument("Unknown option --" + std::string(name));
+        }
+    }
+    return options;
+}
+
+bool IsSelected(BenchmarkCase const& benchmark_case, Options const& options) {
+    if (options.family && benchmark_case.family != *options.family) return false;
+    if (options.algorithm && benchmark_case.algorithm != *options.algorithm) return false;
+    if (options.dataset &&
+        std::none_of(benchmark_case.datasets.begin(), benchmark_case.datasets.end(),
+                     [&](Dataset const& dataset) {
+                         return dataset.file_name.find(*options.dataset) != std::string::npos;
+                     })) {
+        return false;
+    }
+    return options.heavy || !benchmark_case.heavy;
+}
+
+std::filesystem::path GetExecutablePath(char const* argv0) {
+    std::error_code error;
+    std::filesystem::path path = std::filesystem::read_symlink("/proc/self/exe", error);
+    return error ? std::filesystem::path(argv0) : path;
+}
+
+// Exit code of a process started for a single case when the algorithm has thrown, the record of
+// the run is written anyway
+constexpr int kRunError = 3;
+
+// Runs the executable with the arguments, without a shell, and waits for it. Returns its exit
+// code, or 128 plus the number of the signal that has terminated it, as shells do
+int RunProcess(std::filesystem::path const& executable, std::vector<std::string> arguments) {
+    std::string const program = executable.string();
+#if defined(_WIN32)
+    // The arguments are joined with spaces into a command line that is split again by the child
+    for (std::string& argument : arguments) argument = '"' + argument + '"';
+#endif
+    arguments.insert(arguments.begin(), program);
+    std::vector<char*> argv;
+    for (std::string& argument : arguments) argv.push_back(argument.data());
+    argv.push_back(nullptr);
+#if defined(_WIN32)
+    intptr_t const exit_code = _spawnvp(_P_WAIT, program.c_str(), argv.data());
+    if (exit_code == -1) {
+        throw std::system_error(errno, std::generic_category(), "Error: couldn't run " + program);
+    }
+    return static_cast<int>(exit_code);
+#else
+    pid_t pid = 0;
+    int const error = posix_spawnp(&pid, program.c_str(), nullptr, nullptr, argv.data(), environ);
+    if (error != 0) {
+        throw std::system_error(error, std::generic_category(), "Error: couldn't run " + program);
+    }
+    int status = 0;
+    while (waitpid(pid, &status, 0) == -1) {
+        if (errno != EINTR) {
+            throw std::system_error(errno, std::generic_category(),
+                                    "Error: couldn't wait for " + program);
+        }
+    }
+    return WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+#endif
+}
+
+// Runs the case in a new process of this executable so that its peak RSS is its own. Returns
+// the run record the process has written, exit_status is the exit status of the process
+std::optional<std::string> RunIsolated(std::filesystem::path const& executable,
+                                       BenchmarkCase const& benchmark_case,
+                                       MeasurementConfig const& config,
+                                       std::filesystem::path const& result_path, int& exit_status) {
+    std::filesystem::remove(result_path);
+    exit_status = RunProcess(executable, {"--run-case=" + benchmark_case.GetName(),
+                                          "--rows=" + std::to_string(config.rows),
+                                          "--threads=" + std::to_string(config.threads),
+                                          "--repeat=" + std::to_string(config.repetitions),
+                                          "--data-dir=" + config.data_dir.string(),
+                                          "--output=" + result_path.string()});
+    std::ifstream result(result_path);
+    std::string record{std::istreambuf_iterator<char>(result), std::istreambuf_iterator<char>()};
+    result.close();
+    std::filesystem::remove(result_path);
+    if (record.empty()) return std::nullopt;
+    return record;
+}
+
+void WriteFailure(JsonWriter& writer, BenchmarkCase const& benchmark_case,
+                  MeasurementConfig const& config, int exit_status) {
+    writer.BeginObject();
+    writer.Key("case").Value(benchmark_case.GetName());
+    writer.Key("family").Value(benchmark_case.family);
+    writer.Key("algorithm").Value(benchmark_case.algorithm);
+    writer.Key("rows").Value(config.rows);
+    writer.Key("threads").Value(config.threads);
+    writer.Key("isolated").Value(true);
+    writer.Key("status").Value("failed");
+    writer.Key("exit_status").Value(exit_status);
+    writer.EndObject();
+}
+
+int RunCase(Options const& options) {
+    for (BenchmarkCase const& benchmark_case : GetSuite()) {
+        if (benchmark_case.GetName() != *options.run_case) continue;
+        MeasurementConfig const config{options.data_dir, options.rows.front(),
+                                       options.threads.front(), options.repetitions, true};
+        std::ofstream out(options.output);
+        JsonWriter writer(out);
+        bool const succeeded = Measure(benchmark_case, config, writer);
+        if (!out) return EXIT_FAILURE;
+        return succeeded ? EXIT_SUCCESS : kRunError;
+    }
+    std::cerr << "Unknown case " << *options.run_case << '\n';
+    return EXIT_FAILURE;
+}
+
+int RunSuite(Options const& options, char const* argv0) {
+    std::vector<BenchmarkCase const*> cases;
+    for (BenchmarkCase const& benchmark_case : GetSuite()) {
+        if (IsSelected(benchmark_case, options)) cases.push_back(&benchmark_case);
+    }
+    if (options.list) {
+        for (BenchmarkCase const* benchmark_case : cases) {
+            std::cout << benchmark_case->GetName() << '\n';
+        }
+        return EXIT_SUCCESS;
+    }
+
+    std::filesystem::path const executable = GetExecutablePath(argv0);
+    std::filesystem::path const result_path = options.output.string() + ".run";
+    std::ofstream out(options.output);
+    if (!out) {
+        std::cerr << "Cannot write to " << options.output.string() << '\n';
+        return EXIT_FAILURE;
+    }
+    JsonWriter writer(out);
+    writer.BeginObject();
+    writer.Key("version").Value(1);
+    writer.Key("hardware_threads").Value(std::thread::hardware_concurrency());
+    writer.Key("repetitions").Value(options.repetitions);
+    writer.Key("runs").BeginArray();
+    for (BenchmarkCase const* benchmark_case : cases) {
+        bool const uses_threads = UsesThreads(*benchmark_case);
+        for (std::size_t rows : options.rows) {
+            for (config::ThreadNumType threads : options.threads) {
+                // The other thread counts would repeat the same run
+                if (!uses_threads && threads != options.threads.front()) continue;
+                MeasurementConfig const config{options.data_dir, rows, threads,
+                                               options.repetitions, !options.in_process};
+                std::cerr << benchmark_case->GetName() << " rows="
+                          << (rows == 0 ? "all" : std::to_string(rows))
+                          << " threads=" << threads << ": " << std::flush;
+                writer.NewLine();
+                if (options.in_process) {
+                    std::ostringstream record;
+                    JsonWriter record_writer(record);
+                    bool const succeeded = Measure(*benchmark_case, config, record_writer);
+                    writer.Raw(record.str());
+                    std::cerr << (succeeded ? "done\n" : "error\n");
+                    continue;
+                }
+                int exit_status = 0;
+                std::optional<std::string> record =
+                        RunIsolated(executable, *benchmark_case, config, result_path, exit_status);
+                if (record) {
+                    writer.Raw(*record);
+                    std::cerr << (exit_status == 0 ? "done\n" : "error\n");
+                } else {
+                    WriteFailure(writer, *benchmark_case, config, exit_status);
+                    std::cerr << "failed with status " << exit_status << '\n';
+                }
+            }
+        }
+    }
+    writer.NewLine().EndArray().EndObject().NewLine();
+    out.close();
+    std::cerr << "Results are written to " << options.output.string() << '\n';
+
+    if (!options.baseline) return EXIT_SUCCESS;
+    std::size_t const regressions =
+            CompareWithBaseline(options.output, *options.baseline, options.comparison, std::cerr);
+    return regressions == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+}  // namespace
+
+}  // namespace bench
+
+int main(int argc, char** argv) {
+    // Writing the log would be measured along with the algorithms
+    el::Configurations conf;
+    conf.set(el::Level::Global, el::ConfigurationType::Enabled, "false");
+    el::Loggers::reconfigureAllLoggers(conf);
+
+    bench::Options options;
+    try {
+        options = bench::ParseOptions(argc, argv);
+    } catch (std::invalid_argument const& e) {
+        std::cerr << e.what() << "\n\n" << bench::kUsage;
+        return 2;
+    }
+    if (options.help) {
+        std::cout << bench::kUsage;
+        return EXIT_SUCCESS;
+    }
+    try {
+        return options.run_case ? bench::RunCase(options) : bench::RunSuite(options, argv[0]);
+    } catch (std::exception const& e) {
+        std::cerr << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,145 @@
+#include "measurement.h"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "algorithms/algorithm_types.h"
+#include "algorithms/create_algorithm.h"
+#include "config/names.h"
+#include "config/tabular_data/input_tables_type.h"
+#include "model/table/dataset_cache.h"
+#include "parser/csv_parser/csv_parser.h"
+#include "row_limited_stream.h"
+#include "util/resource_usage.h"
+
+namespace bench {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double ToMilliseconds(Clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+double GetMedian(std::vector<double> values) {
+    if (values.empty()) return 0;
+    std::sort(values.begin(), values.end());
+    std::size_t const middle = values.size() / 2;
+    return values.size() % 2 == 1 ? values[middle] : (values[middle - 1] + values[middle]) / 2;
+}
+
+// Fresh streams every repetition, the parsers are not shared between runs
+algos::StdParamsMap MakeOptions(BenchmarkCase const& benchmark_case,
+                                MeasurementConfig const& config) {
+    using namespace config::names;
+    config::InputTables tables;
+    for (Dataset const& dataset : benchmark_case.datasets) {
+        config::InputTable table = std::make_shared<CSVParser>(
+                config.data_dir / dataset.file_name, dataset.separator, dataset.has_header);
+        if (config.rows != 0) {
+            table = std::make_shared<RowLimitedStream>(std::move(table), config.rows);
+        }
+        tables.push_back(std::move(table));
+    }
+    algos::StdParamsMap options = benchmark_case.options;
+    options[kTable] = tables.front();
+    options[kTables] = std::move(tables);
+    options[kThreads] = config.threads;
+    return options;
+}
+
+void WriteTimes(JsonWriter& writer, std::string_view key, std::vector<double> const& times) {
+    writer.Key(key).BeginArray();
+    for (double time : times) writer.Value(time);
+    writer.EndArray();
+}
+
+void WriteMetrics(JsonWriter& writer, util::MetricsSnapshot const& metrics) {
+    static constexpr std::string_view kPhasePrefix = "phase.";
+    writer.Key("phases_ms").BeginObject();
+    for (auto const& [name, value] : metrics.timers) {
+        if (!name.starts_with(kPhasePrefix)) continue;
+        writer.Key(std::string_view{name}.substr(kPhasePrefix.size()))
+                .Value(ToMilliseconds(value.total));
+    }
+    writer.EndObject();
+    writer.Key("timers_ms").BeginObject();
+    for (auto const& [name, value] : metrics.timers) {
+        if (name.starts_with(kPhasePrefix)) continue;
+        writer.Key(name).Value(ToMilliseconds(value.total));
+    }
+    writer.EndObject();
+    writer.Key("counters").BeginObject();
+    for (auto const& [name, value] : metrics.counters) {
+        writer.Key(name).Value(value);
+    }
+    writer.EndObject();
+}
+
+}  // namespace
+
+bool UsesThreads(BenchmarkCase const& benchmark_case) {
+    std::string const name{benchmark_case.algorithm};
+    auto const algorithm = algos::CreateAlgorithmInstance(
+            algos::AlgorithmType::_from_string_nocase(name.c_str()));
+    return algorithm->GetPossibleOptions().contains(config::names::kThreads);
+}
+
+bool Measure(BenchmarkCase const& benchmark_case, MeasurementConfig const& config,
+             JsonWriter& writer) {
+    std::vector<double> load_ms;
+    std::vector<double> execute_ms;
+    std::vector<double> wall_ms;
+    util::MetricsSnapshot metrics;
+    std::string error;
+    try {
+        std::string const algorithm_name{benchmark_case.algorithm};
+        for (unsigned i = 0; i != config.repetitions; ++i) {
+            // Every repetition parses the tables again instead of reusing the relations
+            model::DatasetCache::Instance().Clear();
+            algos::StdParamsMap const options = MakeOptions(benchmark_case, config);
+            auto const start = Clock::now();
+            std::unique_ptr<algos::Algorithm> algorithm =
+                    algos::CreateAlgorithm(algorithm_name, options);
+            auto const loaded = Clock::now();
+            algorithm->Execute();
+            auto const finish = Clock::now();
+            load_ms.push_back(ToMilliseconds(loaded - start));
+            execute_ms.push_back(ToMilliseconds(finish - loaded));
+            wall_ms.push_back(ToMilliseconds(finish - start));
+            metrics = algorithm->GetMetrics();
+        }
+    } catch (std::exception const& e) {
+        error = e.what();
+    }
+    model::DatasetCache::Instance().Clear();
+
+    writer.BeginObject();
+    writer.Key("case").Value(benchmark_case.GetName());
+    writer.Key("family").Value(benchmark_case.family);
+    writer.Key("algorithm").Value(benchmark_case.algorithm);
+    writer.Key("datasets").BeginArray();
+    for (Dataset const& dataset : benchmark_case.datasets) writer.Value(dataset.file_name);
+    writer.EndArray();
+    writer.Key("rows").Value(config.rows);
+    writer.Key("threads").Value(config.threads);
+    writer.Key("isolated").Value(config.isolated);
+    writer.Key("status").Value(error.empty() ? "ok" : "error");
+    if (!error.empty()) writer.Key("error").Value(error);
+    WriteTimes(writer, "load_ms", load_ms);
+    WriteTimes(writer, "execute_ms", execute_ms);
+    WriteTimes(writer, "wall_ms", wall_ms);
+    writer.Key("wall_ms_median").Value(GetMedian(wall_ms));
+    writer.Key("peak_rss_bytes").Value(util::GetPeakResidentSetSize());
+    WriteMetrics(writer, metrics);
+    writer.EndObject();
+    return error.empty();
+}
+
+}  // namespace bench
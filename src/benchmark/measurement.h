@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+
+#include "config/thread_number/type.h"
+#include "json_writer.h"
+#include "suite.h"
+
+namespace bench {
+
+struct MeasurementConfig {
+    std::filesystem::path data_dir;
+    // Number of leading rows of every table to run on, 0 for the whole table
+    std::size_t rows = 0;
+    config::ThreadNumType threads = 1;
+    unsigned repetitions = 1;
+    // Whether the case runs in a process of its own, otherwise the peak RSS covers the earlier
+    // cases too
+    bool isolated = false;
+};
+
+/* Whether the algorithm of the case takes the number of threads as an option */
+bool UsesThreads(BenchmarkCase const& benchmark_case);
+
+/* Runs the case config.repetitions times and writes the record of the run as a JSON object:
+ * the times of every repetition, the peak RSS, the progress phase times, timers and counters of
+ * the last repetition. An exception thrown by the algorithm is recorded with the status "error",
+ * false is returned then */
+bool Measure(BenchmarkCase const& benchmark_case, MeasurementConfig const& config,
+             JsonWriter& writer);
+
+}  // namespace bench
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "model/table/dataset_stream_wrapper.h"
+#include "model/table/idataset_stream.h"
+
+namespace bench {
+
+/* The first rows of a stream, so that a dataset can be benchmarked at several sizes */
+class RowLimitedStream final
+    : public model::DatasetStreamWrapper<std::shared_ptr<model::IDatasetStream>> {
+private:
+    std::size_t max_rows_;
+    std::size_t rows_read_ = 0;
+
+public:
+    RowLimitedStream(std::shared_ptr<model::IDatasetStream> stream, std::size_t max_rows)
+        : DatasetStreamWrapper(std::move(stream)), max_rows_(max_rows) {}
+
+    Row GetNextRow() override {
+        ++rows_read_;
+        return stream_->GetNextRow();
+    }
+
+    [[nodiscard]] bool HasNextRow() const override {
+        return rows_read_ < max_rows_ && stream_->HasNextRow();
+    }
+
+    void Reset() override {
+        stream_->Reset();
+        rows_read_ = 0;
+    }
+
+    [[nodiscard]] std::string GetIdentity() const override {
+        std::string identity = stream_->GetIdentity();
+        return identity.empty() ? identity : identity + "#rows=" + std::to_string(max_rows_);
+    }
+};
+
+}  // namespace bench
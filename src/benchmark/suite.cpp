@@ -0,0 +1,85 @@
+#include "suite.h"
+
+#include <initializer_list>
+
+#include "config/error/type.h"
+#include "config/names.h"
+
+namespace bench {
+
+namespace {
+
+Dataset const kIris{"iris.csv", ',', false};
+Dataset const kAbalone{"abalone.csv", ',', false};
+Dataset const kBreastCancer{"breast_cancer.csv", ',', true};
+Dataset const kNeighbors10k{"neighbors10k.csv", ',', true};
+Dataset const kCIPublicHighway10k{"CIPublicHighway10k.csv", ',', true};
+Dataset const kAdult{"adult.csv", ';', false};
+Dataset const kFlight1k{"flight_1k.csv", ';', true};
+Dataset const kEpicMeds{"EpicMeds.csv", '|', true};
+Dataset const kIowa1kk{"iowa1kk.csv", ',', true};
+Dataset const kOdAbalone{"od_norm_data/metanome/abalone_norm.csv", ',', true};
+Dataset const kOdHorse10c{"od_norm_data/metanome/horse_10c_norm.csv", ',', true};
+
+class SuiteBuilder {
+private:
+    std::vector<BenchmarkCase> cases_;
+
+public:
+    // Every algorithm over every dataset, each table on its own
+    SuiteBuilder& Add(std::string_view family, std::initializer_list<std::string_view> algorithms,
+                      std::initializer_list<Dataset> datasets, bool heavy = false,
+                      algos::StdParamsMap const& options = {}) {
+        for (std::string_view algorithm : algorithms) {
+            for (Dataset const& dataset : datasets) {
+                cases_.push_back({family, algorithm, {dataset}, options, heavy});
+            }
+        }
+        return *this;
+    }
+
+    std::vector<BenchmarkCase> Build() {
+        return std::move(cases_);
+    }
+};
+
+std::vector<BenchmarkCase> MakeSuite() {
+    using namespace config::names;
+    algos::StdParamsMap const afd_options = {{kError, config::ErrorType{0.01}}};
+    return SuiteBuilder()
+            .Add("fd",
+                 {"tane", "pyro", "fastfds", "dfd", "depminer", "fdep", "fun", "hyfd", "pfdtane",
+                  "aidfd"},
+                 {kBreastCancer, kNeighbors10k, kCIPublicHighway10k})
+            .Add("fd", {"fdmine"}, {kIris, kAbalone})
+            .Add("fd", {"tane", "pyro", "dfd", "hyfd"}, {kAdult, kFlight1k, kEpicMeds}, true)
+            .Add("afd", {"tane", "pyro"}, {kNeighbors10k, kAdult}, false, afd_options)
+            .Add("ucc", {"hyucc", "pyroucc", "hpivalid"},
+                 {kBreastCancer, kNeighbors10k, kCIPublicHighway10k})
+            .Add("ucc", {"hyucc", "pyroucc", "hpivalid"}, {kAdult, kFlight1k, kEpicMeds, kIowa1kk},
+                 true)
+            .Add("ind", {"spider", "faida"}, {kCIPublicHighway10k, kAdult})
+            .Add("ind", {"spider", "faida"}, {kEpicMeds, kIowa1kk}, true)
+            .Add("od", {"fastod"}, {kOdAbalone, kOdHorse10c})
+            .Add("stats", {"stats"}, {kNeighbors10k, kAdult})
+            .Add("stats", {"stats"}, {kIowa1kk}, true)
+            .Build();
+}
+
+}  // namespace
+
+std::string BenchmarkCase::GetName() const {
+    std::string name = std::string(family) + "/" + std::string(algorithm) + "/";
+    for (size_t i = 0; i != datasets.size(); ++i) {
+        if (i != 0) name += "+";
+        name += datasets[i].file_name;
+    }
+    return name;
+}
+
+std::vector<BenchmarkCase> const& GetSuite() {
+    static std::vector<BenchmarkCase> const suite = MakeSuite();
+    return suite;
+}
+
+}  // namespace bench
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "algorithms/algo_factory.h"
+
+namespace bench {
+
+/* A table of the input_data directory */
+struct Dataset {
+    std::string_view file_name;
+    char separator;
+    bool has_header;
+};
+
+/* Algorithm run over one dataset (several for inclusion dependencies) */
+struct BenchmarkCase {
+    // fd, afd, ucc, ind, od or stats
+    std::string_view family;
+    // Name of algos::AlgorithmType
+    std::string_view algorithm;
+    std::vector<Dataset> datasets;
+    // Options besides the input tables and the number of threads
+    algos::StdParamsMap options;
+    // Takes long on the full dataset, so it is only run when asked for
+    bool heavy = false;
+
+    // family/algorithm/dataset, identifies the case in the results and the baseline
+    std::string GetName() const;
+};
+
+/* Cases over the datasets unpacked from datasets/datasets.zip, the same tables the tests use */
+std::vector<BenchmarkCase> const& GetSuite();
+
+}  // namespace bench
@@ -10,6 +10,7 @@
 #include "config/exceptions.h"
 #include "config/names_and_descriptions.h"
 #include "config/tabular_data/input_table/option.h"
+#include "model/table/dataset_cache.h"
 #include "types/create_type.h"
 
 namespace algos {
@@ -78,7 +79,7 @@ void ACAlgorithm::RegisterOptions() {
 }
 
 void ACAlgorithm::LoadDataInternal() {
-    typed_relation_ = model::ColumnLayoutTypedRelationData::CreateFrom(*input_table_,
+    typed_relation_ = model::DatasetCache::Instance().GetTypedRelation(*input_table_,
                                                                        false);  // nulls are ignored
 }
 
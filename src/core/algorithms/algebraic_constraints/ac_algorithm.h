@@ -52,7 +52,7 @@ private:
      * by ratio of exceptional records */
     double p_fuzz_;
     size_t iterations_limit_;
-    std::unique_ptr<TypedRelation> typed_relation_;
+    std::shared_ptr<TypedRelation> typed_relation_;
     std::unique_ptr<algebraic_constraints::ACExceptionFinder> ac_exception_finder_;
     double seed_;
     std::vector<ACPairsCollection> ac_pairs_;
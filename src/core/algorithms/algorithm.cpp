@@ -1,8 +1,13 @@
 #include "algorithms/algorithm.h"
 
 #include <cassert>
+#include <optional>
+#include <string>
+
+#include <easylogging++.h>
 
 #include "config/exceptions.h"
+#include "util/watchdog.h"
 
 namespace algos {
 
@@ -30,6 +35,15 @@ void Algorithm::ExecutePrepare() {
 Algorithm::Algorithm(std::vector<std::string_view> phase_names)
     : progress_(std::move(phase_names)) {}
 
+void Algorithm::RecordPhaseTime() noexcept {
+    auto const now = std::chrono::steady_clock::now();
+    std::size_t const phase_id = progress_.GetProgress().first;
+    if (phase_id < phase_timers_.size()) {
+        phase_timers_[phase_id]->Add(now - phase_start_);
+    }
+    phase_start_ = now;
+}
+
 void Algorithm::ExcludeOptions(std::string_view parent_option) noexcept {
     auto it = opt_parents_.find(parent_option);
     if (it == opt_parents_.end()) return;
@@ -74,8 +88,41 @@ unsigned long long Algorithm::Execute() {
     if (!GetNeededOptions().empty())
         throw std::logic_error("All options need to be set before execution.");
     progress_.ResetProgress();
-    ResetState();
-    auto time_ms = ExecuteInternal();
+    metrics_.Reset();
+    budget_token_ = {};
+    complete_ = true;
+    CheckCancellation();
+    std::optional<util::Watchdog> watchdog;
+    if (time_limit_seconds_ != 0 || memory_budget_mb_ != 0) {
+        watchdog.emplace(budget_token_, std::chrono::seconds(time_limit_seconds_),
+                         std::size_t{memory_budget_mb_} * 1024 * 1024);
+    }
+    util::MetricsScope metrics_scope(&metrics_);
+    phase_timers_.clear();
+    for (std::string_view phase_name : progress_.GetPhaseNames()) {
+        phase_timers_.push_back(&metrics_.GetTimer("phase." + std::string(phase_name)));
+    }
+    unsigned long long time_ms;
+    {
+        util::ScopedMetricTimer execute_timer("execute");
+        phase_start_ = std::chrono::steady_clock::now();
+        auto const start_time = phase_start_;
+        ResetState();
+        try {
+            time_ms = ExecuteInternal();
+        } catch (util::BudgetExceeded const&) {
+            complete_ = false;
+            time_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                              std::chrono::steady_clock::now() - start_time)
+                              .count();
+            LOG(INFO) << "Execution stopped after " << time_ms << " ms, "
+                      << (watchdog->GetExceededLimit() == util::Watchdog::Limit::kMemory
+                                  ? "the memory budget"
+                                  : "the time limit")
+                      << " has been exceeded. The results are partial";
+        }
+        RecordPhaseTime();
+    }
     for (auto const& opt_name : available_options_) {
         possible_options_.at(opt_name)->Unset();
     }
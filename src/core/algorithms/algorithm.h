@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <filesystem>
 #include <string_view>
 #include <typeindex>
@@ -11,9 +12,13 @@
 #include <boost/any.hpp>
 
 #include "config/ioption.h"
+#include "config/memory_budget/option.h"
 #include "config/option.h"
+#include "config/time_limit/option.h"
 #include "model/table/idataset_stream.h"
 #include "parser/csv_parser/csv_parser.h"
+#include "util/cancellation.h"
+#include "util/metrics.h"
 #include "util/progress.h"
 
 namespace algos {
@@ -21,6 +26,17 @@ namespace algos {
 class Algorithm {
 private:
     util::Progress progress_;
+    util::CancellationToken cancellation_token_;
+    // Cancelled when the run exceeds its time limit or memory budget, zero means no limit
+    util::CancellationToken budget_token_;
+    config::TimeLimitSecondsType time_limit_seconds_ = 0;
+    config::MemoryBudgetMBType memory_budget_mb_ = 0;
+    // False if the last run has been stopped by its budget
+    bool complete_ = true;
+    util::Metrics metrics_;
+    // Timers of the progress phases of the current run and the start of the current phase
+    std::vector<util::MetricTimer*> phase_timers_;
+    std::chrono::steady_clock::time_point phase_start_;
     // All options the algorithm may use
     std::unordered_map<std::string_view, std::unique_ptr<config::IOption>> possible_options_;
     // All options that can be set at the moment
@@ -34,6 +50,7 @@ private:
     // configuration parameters on the same dataset.
     virtual void ResetState() = 0;
 
+    void RecordPhaseTime() noexcept;
     void ExcludeOptions(std::string_view parent_option) noexcept;
     void ClearOptions() noexcept;
     virtual void LoadDataInternal() = 0;
@@ -49,9 +66,52 @@ protected:
     }
 
     void ToNextProgressPhase() noexcept {
+        RecordPhaseTime();
         progress_.ToNextProgressPhase();
     }
 
+    // Worker threads should poll this and stop early, the main thread then calls CheckCancellation.
+    // True both when the run has been cancelled and when it has exceeded its budget.
+    bool IsCancelled() const noexcept {
+        return cancellation_token_.IsCancelled() || budget_token_.IsCancelled();
+    }
+
+    // Lets an algorithm save the results it can vouch for before CheckCancellation stops it.
+    bool IsBudgetExceeded() const noexcept {
+        return budget_token_.IsCancelled();
+    }
+
+    // Cancellation point. Call it from the main loop (not from worker threads) of a long-running
+    // algorithm, it throws util::ExecutionCancelled if the run has been cancelled and
+    // util::BudgetExceeded if it has exceeded its budget. Execute catches the latter and keeps
+    // the results registered so far, so they must be valid when a cancellation point is reached.
+    void CheckCancellation() const {
+        if (cancellation_token_.IsCancelled()) {
+            throw util::ExecutionCancelled("Execution has been cancelled");
+        }
+        if (budget_token_.IsCancelled()) {
+            throw util::BudgetExceeded("Execution budget has been exceeded");
+        }
+    }
+
+    // Registers the time limit and memory budget options, Execute enforces them through the
+    // cancellation checks.
+    void RegisterBudgetOptions() {
+        RegisterOption(config::kTimeLimitSecondsOpt(&time_limit_seconds_));
+        RegisterOption(config::kMemoryBudgetMBOpt(&memory_budget_mb_));
+    }
+
+    void MakeBudgetOptionsAvailable() {
+        MakeOptionsAvailable(
+                {config::kTimeLimitSecondsOpt.GetName(), config::kMemoryBudgetMBOpt.GetName()});
+    }
+
+    // Metrics of the current run. Code that does not know its algorithm, e.g. PLI intersection,
+    // reports to them through util::GetCurrentMetrics.
+    util::Metrics& GetRunMetrics() noexcept {
+        return metrics_;
+    }
+
     void MakeOptionsAvailable(std::vector<std::string_view> const& option_names);
 
     template <typename T>
@@ -104,6 +164,24 @@ public:
         return progress_.GetPhaseNames();
     }
 
+    // Execute checks the token at its start and at the cancellation points of the algorithm, so
+    // cancelling the token from another thread stops the run with util::ExecutionCancelled.
+    void SetCancellationToken(util::CancellationToken token) noexcept {
+        cancellation_token_ = std::move(token);
+    }
+
+    // Whether the last run has finished. A run stopped by its time limit or memory budget keeps
+    // the results found before the stop, this is false then.
+    bool IsComplete() const noexcept {
+        return complete_;
+    }
+
+    // Metrics of the last run: counters, timers (the whole run and each progress phase) and
+    // histograms. May be called from another thread while the algorithm is running.
+    util::MetricsSnapshot GetMetrics() const {
+        return metrics_.Snapshot();
+    }
+
     std::type_index GetTypeIndex(std::string_view option_name) const;
 
     [[nodiscard]] std::unordered_set<std::string_view> GetPossibleOptions() const;
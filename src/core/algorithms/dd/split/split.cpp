@@ -17,6 +17,7 @@
 #include "config/option_using.h"
 #include "config/tabular_data/input_table/option.h"
 #include "model/table/column_index.h"
+#include "model/table/dataset_cache.h"
 #include "model/types/numeric_type.h"
 #include "util/levenshtein_distance.h"
 
@@ -45,11 +46,10 @@ void Split::MakeExecuteOptsAvailable() {
 }
 
 void Split::LoadDataInternal() {
-    relation_ = ColumnLayoutRelationData::CreateFrom(*input_table_, false);  // nulls are
-                                                                             // ignored
-    input_table_->Reset();
-    typed_relation_ = model::ColumnLayoutTypedRelationData::CreateFrom(*input_table_,
-                                                                       false);  // nulls are ignored
+    model::SharedRelationData data = model::DatasetCache::Instance().Get(
+            *input_table_, false, {.relation = true, .typed_relation = true});  // nulls are ignored
+    relation_ = std::move(data.relation);
+    typed_relation_ = std::move(data.typed_relation);
 }
 
 void Split::SetLimits() {
@@ -61,9 +61,8 @@ void Split::ParseDifferenceTable() {
     has_dif_table_ = (difference_table_.get() != nullptr);
 
     if (has_dif_table_) {
-        difference_typed_relation_ =
-                model::ColumnLayoutTypedRelationData::CreateFrom(*difference_table_,
-                                                                 false);  // nulls are ignored
+        difference_typed_relation_ = model::DatasetCache::Instance().GetTypedRelation(
+                *difference_table_, false);  // nulls are ignored
         assert(typed_relation_->GetNumColumns() == difference_typed_relation_->GetNumColumns());
     }
 }
@@ -32,7 +32,7 @@ private:
     bool has_dif_table_;
 
     config::InputTable difference_table_;
-    std::unique_ptr<model::ColumnLayoutTypedRelationData> difference_typed_relation_;
+    std::shared_ptr<model::ColumnLayoutTypedRelationData> difference_typed_relation_;
 
     Reduce const reduce_method_ = Reduce::IEHybrid;  // currently, the fastest method
     unsigned const num_dfs_per_column_ = 5;
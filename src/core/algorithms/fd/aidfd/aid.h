@@ -12,6 +12,7 @@
 #include "model/table/relational_schema.h"
 #include "model/table/vertical.h"
 #include "search_tree.h"
+#include "util/custom_hashes.h"
 
 namespace algos {
 
@@ -27,7 +28,7 @@ private:
     size_t number_of_attributes_{};
     size_t number_of_tuples_{};
 
-    std::unordered_set<boost::dynamic_bitset<>> neg_cover_{};
+    std::unordered_set<boost::dynamic_bitset<>, util::BitsetHash> neg_cover_{};
 
     constexpr static double const kGrowthThreshold = 0.01;
     constexpr static size_t const kWindowSize = 10;
@@ -1,19 +1,32 @@
 #include "algorithms/fd/depminer/depminer.h"
 
+#include <algorithm>
 #include <chrono>
 #include <list>
 #include <memory>
 
 #include <easylogging++.h>
 
+#include "config/thread_number/option.h"
 #include "model/table/agree_set_factory.h"
 #include "model/table/relational_schema.h"
+#include "util/parallel_for.h"
 
 namespace algos {
 
 Depminer::Depminer(std::optional<ColumnLayoutRelationDataManager> relation_manager)
     : PliBasedFDAlgorithm({"AgreeSets generation", "Finding CMAXSets", "Finding LHS"},
-                          relation_manager) {}
+                          relation_manager) {
+    RegisterOptions();
+}
+
+void Depminer::RegisterOptions() {
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
+}
+
+void Depminer::MakeExecuteOptsAvailableFDInternal() {
+    MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
+}
 
 using boost::dynamic_bitset, std::make_shared, std::shared_ptr, std::setw, std::vector, std::list,
         std::dynamic_pointer_cast;
@@ -26,22 +39,31 @@ unsigned long long Depminer::ExecuteInternal() {
     progress_step_ = kTotalProgressPercent / schema_->GetNumColumns();
 
     // Agree sets
+    model::AgreeSetFactory::Configuration config(threads_num_);
+    if (threads_num_ > 1) {
+        config.mc_gen_method = model::MCGenMethod::kParallel;
+    }
     model::AgreeSetFactory const agree_set_factory =
-            model::AgreeSetFactory(relation_.get(), model::AgreeSetFactory::Configuration(), this);
+            model::AgreeSetFactory(relation_.get(), config, this);
     auto const agree_sets = agree_set_factory.GenAgreeSets();
+    CheckCancellation();
     ToNextProgressPhase();
 
     // maximal sets
     std::vector<CMAXSet> const c_max_cets = GenerateCmaxSets(agree_sets);
+    CheckCancellation();
     ToNextProgressPhase();
 
     // LHS
     auto const lhs_time = std::chrono::system_clock::now();
-    // 1
-    for (auto const& column : schema_->GetColumns()) {
-        LhsForColumn(column, c_max_cets);
-        AddProgress(progress_step_);
-    }
+    // 1, columns are independent
+    util::ParallelForeach(schema_->GetColumns().begin(), schema_->GetColumns().end(),
+                          threads_num_, [this, &c_max_cets](std::unique_ptr<Column> const& column) {
+                              if (IsCancelled()) return;
+                              LhsForColumn(column, c_max_cets);
+                              AddProgress(progress_step_);
+                          });
+    CheckCancellation();
 
     auto const lhs_elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::system_clock::now() - lhs_time);
@@ -52,55 +74,52 @@ unsigned long long Depminer::ExecuteInternal() {
     return elapsed_milliseconds.count();
 }
 
-std::vector<CMAXSet> Depminer::GenerateCmaxSets(std::unordered_set<Vertical> const& agree_sets) {
+std::vector<CMAXSet> Depminer::GenerateCmaxSets(
+        model::AgreeSetFactory::SetOfAgreeSets const& agree_sets) {
     auto const start_time = std::chrono::system_clock::now();
 
-    std::vector<CMAXSet> c_max_cets;
+    // Larger sets first, so that every superset of a set precedes it
+    std::vector<model::AgreeSet const*> sorted_agree_sets;
+    sorted_agree_sets.reserve(agree_sets.size());
+    for (auto const& ag : agree_sets) {
+        sorted_agree_sets.push_back(&ag);
+    }
+    std::sort(sorted_agree_sets.begin(), sorted_agree_sets.end(),
+              [](model::AgreeSet const* lhs, model::AgreeSet const* rhs) {
+                  return lhs->count() > rhs->count();
+              });
 
+    std::vector<CMAXSet> c_max_cets;
+    c_max_cets.reserve(schema_->GetNumColumns());
     for (auto const& column : this->schema_->GetColumns()) {
-        CMAXSet result(*column);
-
-        // finding all sets, which doesn't contain column
-        for (auto const& ag : agree_sets) {
-            if (!ag.Contains(*column)) {
-                result.AddCombination(ag);
-            }
-        }
+        c_max_cets.emplace_back(*column);
+    }
 
-        // finding max sets
-        std::unordered_set<Vertical> super_sets;
-        std::unordered_set<Vertical> sets_delete;
-        bool to_add = true;
+    auto find_max_sets = [this, &sorted_agree_sets](CMAXSet& result) {
+        if (IsCancelled()) return;
+        size_t const column_index = result.GetColumn().GetIndex();
 
-        for (auto const& set : result.GetCombinations()) {
-            for (auto const& super_set : super_sets) {
-                if (set.Contains(super_set)) {
-                    sets_delete.insert(super_set);
-                }
-                if (to_add) {
-                    to_add = !super_set.Contains(set);
-                }
-            }
-            for (auto const& to_delete : sets_delete) {
-                super_sets.erase(to_delete);
+        // finding max sets among all sets, which don't contain column
+        std::vector<model::AgreeSet const*> max_sets;
+        for (model::AgreeSet const* ag : sorted_agree_sets) {
+            if (ag->test(column_index)) {
+                continue;
             }
-            if (to_add) {
-                super_sets.insert(set);
-            } else {
-                to_add = true;
+            bool const is_max = std::none_of(
+                    max_sets.begin(), max_sets.end(),
+                    [ag](model::AgreeSet const* max_set) { return ag->is_subset_of(*max_set); });
+            if (is_max) {
+                max_sets.push_back(ag);
             }
-            sets_delete.clear();
         }
 
         // Inverting MaxSet
-        std::unordered_set<Vertical> result_super_sets;
-        for (auto const& combination : super_sets) {
-            result_super_sets.insert(combination.Invert());
+        for (model::AgreeSet const* max_set : max_sets) {
+            result.AddCombination(schema_->GetVertical(~*max_set));
         }
-        result.MakeNewCombinations(std::move(result_super_sets));
-        c_max_cets.push_back(result);
         AddProgress(progress_step_);
-    }
+    };
+    util::ParallelForeach(c_max_cets.begin(), c_max_cets.end(), threads_num_, find_max_sets);
 
     auto const elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::system_clock::now() - start_time);
@@ -2,6 +2,8 @@
 
 #include "algorithms/fd/depminer/cmax_set.h"
 #include "algorithms/fd/pli_based_fd_algorithm.h"
+#include "config/thread_number/type.h"
+#include "model/table/agree_set_factory.h"
 
 namespace algos {
 
@@ -14,10 +16,15 @@ private:
     static bool CheckJoin(Vertical const& _p, Vertical const& _q);
 
     void LhsForColumn(std::unique_ptr<Column> const& column, std::vector<CMAXSet> const& cmax_sets);
-    std::vector<CMAXSet> GenerateCmaxSets(std::unordered_set<Vertical> const& agree_sets);
+    std::vector<CMAXSet> GenerateCmaxSets(
+            model::AgreeSetFactory::SetOfAgreeSets const& agree_sets);
 
     double progress_step_ = 0;
     RelationalSchema const* schema_ = nullptr;
+    config::ThreadNumType threads_num_;
+
+    void RegisterOptions();
+    void MakeExecuteOptsAvailableFDInternal() final;
 
     void ResetStateFd() final {}
 
@@ -19,10 +19,12 @@ DFD::DFD(std::optional<ColumnLayoutRelationDataManager> relation_manager)
 
 void DFD::RegisterOptions() {
     RegisterOption(config::kThreadNumberOpt(&number_of_threads_));
+    RegisterBudgetOptions();
 }
 
 void DFD::MakeExecuteOptsAvailableFDInternal() {
     MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
+    MakeBudgetOptionsAvailable();
 }
 
 void DFD::ResetStateFd() {
@@ -54,6 +56,8 @@ unsigned long long DFD::ExecuteInternal() {
     for (auto& rhs : schema->GetColumns()) {
         boost::asio::post(
                 search_space_pool, [this, &rhs, schema, progress_step, &partition_storage]() {
+                    util::MetricsScope metrics_scope(&GetRunMetrics());
+                    if (IsCancelled()) return;
                     ColumnData const& rhs_data = relation_->GetColumnData(rhs->GetIndex());
                     model::PositionListIndex const* const rhs_pli = rhs_data.GetPositionListIndex();
 
@@ -69,7 +73,8 @@ unsigned long long DFD::ExecuteInternal() {
 
                     auto search_space = LatticeTraversal(rhs.get(), relation_.get(),
                                                          unique_columns_, partition_storage.get());
-                    auto const minimal_deps = search_space.FindLHSs();
+                    auto const minimal_deps =
+                            search_space.FindLHSs([this] { return IsCancelled(); });
 
                     for (auto const& minimal_dependency_lhs : minimal_deps) {
                         RegisterFd(minimal_dependency_lhs, *rhs);
@@ -80,6 +85,7 @@ unsigned long long DFD::ExecuteInternal() {
     }
 
     search_space_pool.join();
+    CheckCancellation();
     SetProgress(100);
 
     auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -17,7 +17,8 @@ LatticeTraversal::LatticeTraversal(Column const* const rhs,
       partition_storage_(partition_storage),
       gen_(rd_()) {}
 
-std::unordered_set<Vertical> LatticeTraversal::FindLHSs() {
+std::unordered_set<Vertical> LatticeTraversal::FindLHSs(
+        std::function<bool()> const& is_cancelled) {
     RelationalSchema const* const schema = relation_->GetSchema();
 
     // processing of found unique columns
@@ -52,6 +53,7 @@ std::unordered_set<Vertical> LatticeTraversal::FindLHSs() {
             }
 
             do {
+                if (is_cancelled()) return minimal_deps_;
                 auto const node_observation_iter = observations_.find(node);
 
                 if (node_observation_iter != observations_.end()) {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <random>
 #include <stack>
 
@@ -43,5 +44,8 @@ public:
                      std::vector<Vertical> const& unique_verticals,
                      PartitionStorage* const partition_storage);
 
-    std::unordered_set<Vertical> FindLHSs();
+    // Polls is_cancelled between the visited nodes and stops once it returns true, the dependencies
+    // found by then are minimal
+    std::unordered_set<Vertical> FindLHSs(
+            std::function<bool()> const& is_cancelled = [] { return false; });
 };
@@ -10,7 +10,7 @@ model::PositionListIndex* PartitionStorage::Get(Vertical const& vertical) {
     return index_->Get(vertical).get();
 }
 
-PartitionStorage::PartitionStorage(ColumnLayoutRelationData* relation_data,
+PartitionStorage::PartitionStorage(ColumnLayoutRelationData const* relation_data,
                                    CachingMethod caching_method,
                                    CacheEvictionMethod eviction_method)
     : relation_data_(relation_data),
@@ -19,8 +19,10 @@ PartitionStorage::PartitionStorage(ColumnLayoutRelationData* relation_data,
       caching_method_(caching_method),
       eviction_method_(eviction_method) {
     for (auto& column_ptr : relation_data->GetSchema()->GetColumns()) {
+        // The storage only reads the PLIs it holds
         index_->Put(static_cast<Vertical>(*column_ptr),
-                    relation_data->GetColumnData(column_ptr->GetIndex()).GetPliOwnership());
+                    std::const_pointer_cast<model::PositionListIndex>(
+                            relation_data->GetColumnData(column_ptr->GetIndex()).GetPliOwnership()));
     }
 }
 
@@ -35,9 +37,8 @@ PartitionStorage::GetOrCreateFor(Vertical const& vertical) {
     // is PLI already cached?
     model::PositionListIndex* pli = Get(vertical);
     if (pli != nullptr) {
-        pli->IncFreq();
+        ++usage_counts_[pli];
         LOG(DEBUG) << boost::format{"Served from PLI cache."};
-        // addToUsageCounter
         return pli;
     }
     // look for cached PLIs to construct the requested one
@@ -62,7 +63,7 @@ PartitionStorage::GetOrCreateFor(Vertical const& vertical) {
     boost::dynamic_bitset<> cover(relation_data_->GetNumColumns());
     boost::dynamic_bitset<> cover_tester(relation_data_->GetNumColumns());
     if (smallest_pli_rank) {
-        smallest_pli_rank->pli_->IncFreq();
+        ++usage_counts_[smallest_pli_rank->pli_.get()];
         operands.push_back(*smallest_pli_rank);
         cover |= smallest_pli_rank->vertical_->GetColumnIndices();
 
@@ -88,7 +89,7 @@ PartitionStorage::GetOrCreateFor(Vertical const& vertical) {
             }
 
             if (best_rank) {
-                best_rank->pli_->IncFreq();
+                ++usage_counts_[best_rank->pli_.get()];
                 operands.push_back(*best_rank);
                 cover |= best_rank->vertical_->GetColumnIndices();
             }
@@ -102,7 +103,7 @@ PartitionStorage::GetOrCreateFor(Vertical const& vertical) {
             vertical_columns.push_back(std::make_unique<Vertical>(static_cast<Vertical>(*column)));
             auto column_pli = index_->Get(**vertical_columns.rbegin());
             operands.emplace_back(vertical_columns.rbegin()->get(), column_pli, 1);
-            column_pli->IncFreq();
+            ++usage_counts_[column_pli.get()];
         }
     }
     // sort operands by ascending order
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mutex>
+#include <unordered_map>
 
 #include "cache_eviction_method.h"
 #include "caching_method.h"
@@ -20,8 +21,12 @@ private:
             : vertical_(vertical), pli_(pli), added_arity_(initial_arity) {}
     };
 
-    ColumnLayoutRelationData* relation_data_;
+    // Shared with other runs through the dataset cache, so neither the relation nor its column
+    // PLIs are modified
+    ColumnLayoutRelationData const* relation_data_;
     std::unique_ptr<model::VerticalMap<model::PositionListIndex>> index_;
+    // Number of requests every PLI has served in this run, guarded by getting_pli_mutex_
+    std::unordered_map<model::PositionListIndex const*, unsigned> usage_counts_;
 
     int saved_intersections_ = 0;
 
@@ -37,7 +42,7 @@ private:
     CachingProcess(Vertical const& vertical, std::unique_ptr<model::PositionListIndex> pli);
 
 public:
-    PartitionStorage(ColumnLayoutRelationData* relation_data, CachingMethod caching_method,
+    PartitionStorage(ColumnLayoutRelationData const* relation_data, CachingMethod caching_method,
                      CacheEvictionMethod eviction_method);
 
     model::PositionListIndex* Get(Vertical const& vertical);
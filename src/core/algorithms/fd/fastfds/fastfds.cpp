@@ -43,6 +43,7 @@ unsigned long long FastFDs::ExecuteInternal() {
     auto start_time = std::chrono::system_clock::now();
 
     GenDiffSets();
+    CheckCancellation();
     SetProgress(kTotalProgressPercent);
     ToNextProgressPhase();
 
@@ -57,6 +58,7 @@ unsigned long long FastFDs::ExecuteInternal() {
     }
 
     auto task = [this](std::unique_ptr<Column> const& column) {
+        if (IsCancelled()) return;
         if (ColumnContainsOnlyEqualValues(*column)) {
             LOG(DEBUG) << "Registered FD: " << schema_->empty_vertical_->ToString() << "->"
                        << column->ToString();
@@ -88,6 +90,7 @@ unsigned long long FastFDs::ExecuteInternal() {
             task(column);
         }
     }
+    CheckCancellation();
 
     SetProgress(kTotalProgressPercent);
 
@@ -269,15 +272,14 @@ void FastFDs::GenDiffSets() {
     model::AgreeSetFactory::Configuration c;
     c.threads_num = threads_num_;
     if (threads_num_ > 1) {
-        // Not implemented properly, check the description of AgreeSetFactory::GenMcParallel()
-        // c.mc_gen_method = MCGenMethod::kParallel;
+        c.mc_gen_method = model::MCGenMethod::kParallel;
     }
     model::AgreeSetFactory factory(relation_.get(), c, this);
     model::AgreeSetFactory::SetOfAgreeSets agree_sets = factory.GenAgreeSets();
 
     LOG(DEBUG) << "Agree sets:";
     for (auto const& agree_set : agree_sets) {
-        LOG(DEBUG) << agree_set.ToString();
+        LOG(DEBUG) << schema_->GetVertical(agree_set).ToString();
     }
 
     // Complement agree sets to get difference sets
@@ -285,7 +287,7 @@ void FastFDs::GenDiffSets() {
     if (threads_num_ > 1) {
         std::mutex m;
         auto const task = [&m, this](model::AgreeSet const& as) {
-            DiffSet diff_set = as.Invert();
+            DiffSet diff_set = schema_->GetVertical(~as);
             std::lock_guard lock(m);
             diff_sets_.push_back(std::move(diff_set));
         };
@@ -293,7 +295,7 @@ void FastFDs::GenDiffSets() {
         util::ParallelForeach(agree_sets.begin(), agree_sets.end(), threads_num_, task);
     } else {
         for (model::AgreeSet const& agree_set : agree_sets) {
-            diff_sets_.push_back(agree_set.Invert());
+            diff_sets_.push_back(schema_->GetVertical(~agree_set));
         }
     }
 
@@ -11,7 +11,13 @@ namespace algos {
 using boost::dynamic_bitset;
 
 FdMine::FdMine(std::optional<ColumnLayoutRelationDataManager> relation_manager)
-    : PliBasedFDAlgorithm({kDefaultPhaseName}, relation_manager) {}
+    : PliBasedFDAlgorithm({kDefaultPhaseName}, relation_manager) {
+    RegisterBudgetOptions();
+}
+
+void FdMine::MakeExecuteOptsAvailableFDInternal() {
+    MakeBudgetOptionsAvailable();
+}
 
 void FdMine::ResetStateFd() {
     candidate_set_.clear();
@@ -43,6 +49,8 @@ unsigned long long FdMine::ExecuteInternal() {
 
     // 2
     while (!candidate_set_.empty()) {
+        // Step 3 derives non-minimal FDs from an unfinished lattice, so a stopped run has none
+        CheckCancellation();
         for (auto const& candidate : candidate_set_) {
             ComputeNonTrivialClosure(candidate);
             ObtainFDandKey(candidate);
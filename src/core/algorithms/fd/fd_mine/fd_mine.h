@@ -37,6 +37,7 @@ private:
     void Display();
 
     void ResetStateFd() final;
+    void MakeExecuteOptsAvailableFDInternal() final;
     unsigned long long ExecuteInternal() override;
 
 public:
@@ -27,64 +27,14 @@ void DynamicFDVerifier::RegisterOptions() {
 
     auto get_schema_cols = [this]() { return input_table_->GetNumberOfColumns(); };
 
-    auto check_inserts = [this](config::InputTable insert_batch) {
-        if (insert_batch == nullptr || !insert_batch->HasNextRow()) {
-            return;
-        }
-        if (insert_batch->GetNumberOfColumns() != input_table_->GetNumberOfColumns()) {
-            throw config::ConfigurationError(
-                    "Schema mismatch: insert statements must have the same number of columns as "
-                    "the input table");
-        }
-        for (size_t i = 0; i < input_table_->GetNumberOfColumns(); ++i) {
-            if (insert_batch->GetColumnName(i) != input_table_->GetColumnName(i)) {
-                throw config::ConfigurationError(
-                        "Schema mismatch: insert statements' column names must match the input "
-                        "table");
-            }
-        }
+    auto check_inserts = [this](config::InputTable const& insert_batch) {
+        table_data_->CheckInsertStatements(insert_batch);
     };
-
     auto check_deletes = [this](std::unordered_set<size_t> const& delete_batch) {
-        if (delete_batch.empty()) {
-            return;
-        }
-        for (size_t id : delete_batch) {
-            if (!table_data_->IsRowIndexValid(id)) {
-                throw config::ConfigurationError("Attempt to delete a non-existing row");
-            }
-        }
+        table_data_->CheckDeleteStatements(delete_batch);
     };
-
-    auto check_updates = [this](config::InputTable update_batch) {
-        if (update_batch == nullptr || !update_batch->HasNextRow()) {
-            return;
-        }
-        if (update_batch->GetNumberOfColumns() != input_table_->GetNumberOfColumns() + 1) {
-            throw config::ConfigurationError(
-                    "Schema mismatch: update statements must have the number of columns one more "
-                    "than the input table");
-        }
-        for (size_t i = 0; i < input_table_->GetNumberOfColumns(); ++i) {
-            if (update_batch->GetColumnName(i + 1) != input_table_->GetColumnName(i)) {
-                throw config::ConfigurationError(
-                        "Schema mismatch: update statements column names, except of first one, "
-                        "must match the input table");
-            }
-        }
-        std::unordered_set<size_t> rows_to_update;
-        while (update_batch->HasNextRow()) {
-            auto row = update_batch->GetNextRow();
-            size_t id = std::stoull(row.front());
-            if (!table_data_->IsRowIndexValid(id)) {
-                throw config::ConfigurationError("Attempt to update a non-existing row");
-            }
-            if (rows_to_update.contains(id)) {
-                throw config::ConfigurationError("Update statements have duplicates");
-            }
-            rows_to_update.emplace(id);
-        }
-        update_batch->Reset();
+    auto check_updates = [this](config::InputTable const& update_batch) {
+        table_data_->CheckUpdateStatements(update_batch);
     };
 
     RegisterOption(config::kTableOpt(&input_table_));
@@ -104,20 +54,28 @@ void DynamicFDVerifier::MakeExecuteOptsAvailable() {
 }
 
 void DynamicFDVerifier::LoadDataInternal() {
-    CreateFD();
-    input_table_->Reset();
     table_data_ = std::make_shared<model::DynamicTableData>(*input_table_);
-    stats_calculator_ =
-            std::make_unique<DynamicStatsCalculator>(table_data_, lhs_indices_, rhs_indices_);
-    VerifyFD();
+    lhs_pli_ = std::make_shared<model::DynPLI>();
+    rhs_pli_ = std::make_shared<model::DynPLI>();
+    stats_calculator_ = std::make_unique<DynamicStatsCalculator>(table_data_, lhs_pli_);
+    std::vector<std::pair<size_t, model::DynPLI::ClusterValue>> lhs_rows, rhs_rows;
+    lhs_rows.reserve(table_data_->GetNumRowsTotal());
+    rhs_rows.reserve(table_data_->GetNumRowsTotal());
+    for (size_t row_id = 0; row_id < table_data_->GetNumRowsTotal(); ++row_id) {
+        lhs_rows.emplace_back(row_id, ParseStoredRowForPLI(row_id, lhs_indices_));
+        rhs_rows.emplace_back(row_id, ParseStoredRowForPLI(row_id, rhs_indices_));
+    }
+    ApplyChanges({}, lhs_rows, rhs_rows);
     SortHighlightsByProportionDescending();
 }
 
 unsigned long long DynamicFDVerifier::ExecuteInternal() {
     auto start_time = std::chrono::system_clock::now();
-    std::vector<std::pair<std::optional<size_t>, std::vector<int>>> lhs_inserts{}, rhs_inserts{};
-    std::unordered_set<size_t> deletes_and_updates_indices{delete_statement_indices_};
+    std::vector<size_t> removed_rows_ids(delete_statement_indices_.begin(),
+                                         delete_statement_indices_.end());
+    std::vector<std::pair<size_t, model::DynPLI::ClusterValue>> lhs_added, rhs_added;
     if (insert_statements_table_ != nullptr) {
+        size_t next_row_id = table_data_->GetNumRowsTotal();
         while (insert_statements_table_->HasNextRow()) {
             std::vector<std::string> row = insert_statements_table_->GetNextRow();
             if (row.size() != input_table_->GetNumberOfColumns()) {
@@ -125,8 +83,8 @@ unsigned long long DynamicFDVerifier::ExecuteInternal() {
                              << input_table_->GetNumberOfColumns();
                 continue;
             }
-            lhs_inserts.emplace_back(std::nullopt, ParseRowForPLI(row.begin(), lhs_indices_));
-            rhs_inserts.emplace_back(std::nullopt, ParseRowForPLI(row.begin(), rhs_indices_));
+            lhs_added.emplace_back(next_row_id, ParseRowForPLI(row.begin(), lhs_indices_));
+            rhs_added.emplace_back(next_row_id++, ParseRowForPLI(row.begin(), rhs_indices_));
         }
         insert_statements_table_->Reset();
     }
@@ -139,20 +97,16 @@ unsigned long long DynamicFDVerifier::ExecuteInternal() {
                 continue;
             }
             size_t row_id = std::stoull(row.front());
-            lhs_inserts.emplace_back(row_id, ParseRowForPLI(row.begin() + 1, lhs_indices_));
-            rhs_inserts.emplace_back(row_id, ParseRowForPLI(row.begin() + 1, rhs_indices_));
-            deletes_and_updates_indices.emplace(row_id);
+            removed_rows_ids.push_back(row_id);
+            lhs_added.emplace_back(row_id, ParseRowForPLI(row.begin() + 1, lhs_indices_));
+            rhs_added.emplace_back(row_id, ParseRowForPLI(row.begin() + 1, rhs_indices_));
         }
         update_statements_table_->Reset();
     }
 
-    lhs_pli_->UpdateWith(lhs_inserts, deletes_and_updates_indices);
-    rhs_pli_->UpdateWith(rhs_inserts, std::move(deletes_and_updates_indices));
-
     table_data_->Update(insert_statements_table_, update_statements_table_,
                         delete_statement_indices_);
-
-    VerifyFD();
+    ApplyChanges(removed_rows_ids, lhs_added, rhs_added);
     SortHighlightsByProportionDescending();
 
     auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -160,32 +114,24 @@ unsigned long long DynamicFDVerifier::ExecuteInternal() {
     return elapsed_milliseconds.count();
 }
 
-void DynamicFDVerifier::VerifyFD() const {
-    std::unique_ptr<model::DynPLI const> intersection_pli = lhs_pli_->Intersect(rhs_pli_.get());
-    // stats calculator has init state after every Execute() call, will be fixed soon
-    if (lhs_pli_->GetNumCluster() == intersection_pli->GetNumCluster()) {
-        return;
-    }
-
-    stats_calculator_->CalculateStatistics(lhs_pli_.get(), rhs_pli_.get());
+void DynamicFDVerifier::ApplyChanges(
+        std::vector<size_t> const& removed_rows_ids,
+        std::vector<std::pair<size_t, model::DynPLI::ClusterValue>> const& lhs_added,
+        std::vector<std::pair<size_t, model::DynPLI::ClusterValue>> const& rhs_added) {
+    model::DynPLI::Changes const lhs_changes = lhs_pli_->ApplyChanges(removed_rows_ids, lhs_added);
+    model::DynPLI::Changes const rhs_changes = rhs_pli_->ApplyChanges(removed_rows_ids, rhs_added);
+    stats_calculator_->ApplyChanges(lhs_changes, rhs_changes);
 }
 
-void DynamicFDVerifier::CreateFD() {
-    size_t const num_columns = input_table_->GetNumberOfColumns();
-    std::vector<std::vector<int>> lhs_rows, rhs_rows;
-    std::vector<std::string> row;
-
-    while (input_table_->HasNextRow()) {
-        row = input_table_->GetNextRow();
-        if (row.size() != num_columns) {
-            continue;
-        }
-        lhs_rows.emplace_back(ParseRowForPLI(row.begin(), lhs_indices_));
-        rhs_rows.emplace_back(ParseRowForPLI(row.begin(), rhs_indices_));
+int DynamicFDVerifier::GetValueId(std::string const& value) {
+    if (value.empty()) {
+        return kNullValueId;
     }
-
-    lhs_pli_ = model::DynPLI::CreateFor(lhs_rows);
-    rhs_pli_ = model::DynPLI::CreateFor(rhs_rows);
+    auto [iter, is_value_new] = value_dictionary_.try_emplace(value, next_value_id_);
+    if (is_value_new) {
+        next_value_id_++;
+    }
+    return iter->second;
 }
 
 std::vector<int> DynamicFDVerifier::ParseRowForPLI(
@@ -193,16 +139,16 @@ std::vector<int> DynamicFDVerifier::ParseRowForPLI(
         std::vector<unsigned int> const& indices) {
     std::vector<int> result{};
     for (size_t index : indices) {
-        std::string const& field = *(row_begin + index);
-        if (field.empty()) {
-            result.emplace_back(kNullValueId);
-        } else {
-            auto [iter, is_value_new] = value_dictionary_.try_emplace(field, next_value_id_);
-            if (is_value_new) {
-                next_value_id_++;
-            }
-            result.emplace_back(iter->second);
-        }
+        result.emplace_back(GetValueId(*(row_begin + index)));
+    }
+    return result;
+}
+
+std::vector<int> DynamicFDVerifier::ParseStoredRowForPLI(size_t row_id,
+                                                         std::vector<unsigned int> const& indices) {
+    std::vector<int> result{};
+    for (size_t index : indices) {
+        result.emplace_back(GetValueId(table_data_->GetValue(row_id, index)));
     }
     return result;
 }
@@ -3,6 +3,7 @@
 #include <cassert>
 #include <deque>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "algorithms/algorithm.h"
@@ -10,6 +11,7 @@
 #include "config/equal_nulls/type.h"
 #include "config/indices/type.h"
 #include "config/tabular_data/input_table_type.h"
+#include "model/table/dynamic_position_list_index.h"
 #include "model/table/dynamic_table_data.h"
 
 namespace algos::fd_verifier {
@@ -27,28 +29,27 @@ private:
     config::IndicesType lhs_indices_;
     config::IndicesType rhs_indices_;
 
+    std::shared_ptr<model::DynamicTableData> table_data_;
     std::shared_ptr<model::DynPLI> lhs_pli_;
     std::shared_ptr<model::DynPLI> rhs_pli_;
-
-    std::shared_ptr<model::DynamicTableData> table_data_;
     std::shared_ptr<DynamicStatsCalculator> stats_calculator_;
 
     std::unordered_map<std::string, int> value_dictionary_{};
     int next_value_id_ = 1;
     static constexpr int kNullValueId = -1;
 
-    void VerifyFD() const;
-    void CreateFD();
-
+    int GetValueId(std::string const& value);
     inline std::vector<int> ParseRowForPLI(model::IDatasetStream::Row::iterator const& row_begin,
                                            std::vector<unsigned int> const& indices);
+    std::vector<int> ParseStoredRowForPLI(size_t row_id, std::vector<unsigned int> const& indices);
+    /* Applies the batch to both PLIs, then passes their changes to the statistics */
+    void ApplyChanges(std::vector<size_t> const& removed_rows_ids,
+                      std::vector<std::pair<size_t, model::DynPLI::ClusterValue>> const& lhs_added,
+                      std::vector<std::pair<size_t, model::DynPLI::ClusterValue>> const& rhs_added);
     void RegisterOptions();
 
-    void ResetState() final {
-        if (stats_calculator_) {
-            stats_calculator_->ResetState();
-        }
-    }
+    // Statistics are maintained incrementally between batches, so there is nothing to reset
+    void ResetState() final {}
 
 protected:
     void LoadDataInternal() override;
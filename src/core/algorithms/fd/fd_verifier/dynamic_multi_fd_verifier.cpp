@@ -0,0 +1,243 @@
+#include "algorithms/fd/fd_verifier/dynamic_multi_fd_verifier.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+
+#include <easylogging++.h>
+
+#include "config/exceptions.h"
+#include "config/indices/validate_index.h"
+#include "config/names_and_descriptions.h"
+#include "config/option_using.h"
+#include "config/tabular_data/crud_operations/operations.h"
+#include "config/tabular_data/input_table/option.h"
+#include "config/thread_number/option.h"
+#include "util/parallel_for.h"
+
+namespace {
+
+void NormalizeIndices(config::IndicesType& indices) {
+    std::sort(indices.begin(), indices.end());
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+}
+
+}  // namespace
+
+namespace algos::fd_verifier {
+
+DynamicMultiFDVerifier::DynamicMultiFDVerifier() : Algorithm({}) {
+    using namespace config::names;
+    RegisterOptions();
+    MakeOptionsAvailable({config::kTableOpt.GetName(), kFDs, kUCCs,
+                          config::kThreadNumberOpt.GetName()});
+}
+
+void DynamicMultiFDVerifier::RegisterOptions() {
+    DESBORDANTE_OPTION_USING;
+
+    auto check_inserts = [this](config::InputTable const& insert_batch) {
+        table_data_->CheckInsertStatements(insert_batch);
+    };
+    auto check_deletes = [this](std::unordered_set<size_t> const& delete_batch) {
+        table_data_->CheckDeleteStatements(delete_batch);
+    };
+    auto check_updates = [this](config::InputTable const& update_batch) {
+        table_data_->CheckUpdateStatements(update_batch);
+    };
+
+    RegisterOption(config::kTableOpt(&input_table_));
+    RegisterOption(Option{&fds_, kFDs, kDFDs, std::vector<FDIndices>{}});
+    RegisterOption(Option{&uccs_, kUCCs, kDUCCs, std::vector<config::IndicesType>{}});
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
+    RegisterOption(
+            config::kInsertStatementsOpt(&insert_statements_table_).SetValueCheck(check_inserts));
+    RegisterOption(
+            config::kDeleteStatementsOpt(&delete_statement_indices_).SetValueCheck(check_deletes));
+    RegisterOption(
+            config::kUpdateStatementsOpt(&update_statements_table_).SetValueCheck(check_updates));
+}
+
+void DynamicMultiFDVerifier::MakeExecuteOptsAvailable() {
+    MakeOptionsAvailable(kCrudOptions);
+}
+
+size_t DynamicMultiFDVerifier::AddDependency(config::IndicesType lhs_indices,
+                                             config::IndicesType rhs_indices, bool is_ucc) {
+    // Indices are checked here rather than in the options, since the number of columns is only
+    // known once the table has been set
+    for (config::IndicesType* indices : {&lhs_indices, &rhs_indices}) {
+        if (indices->empty() && !(is_ucc && indices == &rhs_indices)) {
+            throw config::ConfigurationError("Indices cannot be empty");
+        }
+        NormalizeIndices(*indices);
+        for (config::IndexType index : *indices) {
+            config::ValidateIndex(index, table_data_->GetNumColumns());
+            is_column_used_[index] = true;
+        }
+    }
+    auto same_dependency = [&lhs_indices, &rhs_indices](Dependency const& dependency) {
+        return dependency.lhs_indices == lhs_indices && dependency.rhs_indices == rhs_indices;
+    };
+    auto it = std::find_if(dependencies_.begin(), dependencies_.end(), same_dependency);
+    if (it != dependencies_.end()) {
+        return std::distance(dependencies_.begin(), it);
+    }
+
+    size_t const lhs_pli_index = GetColumnSetPLI(lhs_indices);
+    std::optional<size_t> rhs_pli_index;
+    if (!is_ucc) {
+        rhs_pli_index = GetColumnSetPLI(rhs_indices);
+    }
+    auto stats_calculator = std::make_unique<DynamicStatsCalculator>(
+            table_data_, column_set_plis_[lhs_pli_index].pli, is_ucc);
+    dependencies_.push_back({std::move(lhs_indices), std::move(rhs_indices), lhs_pli_index,
+                             rhs_pli_index, std::move(stats_calculator)});
+    return dependencies_.size() - 1;
+}
+
+size_t DynamicMultiFDVerifier::GetColumnSetPLI(config::IndicesType const& indices) {
+    auto it = std::find_if(column_set_plis_.begin(), column_set_plis_.end(),
+                           [&indices](ColumnSetPLI const& pli) { return pli.indices == indices; });
+    if (it != column_set_plis_.end()) {
+        return std::distance(column_set_plis_.begin(), it);
+    }
+    column_set_plis_.push_back({indices, std::make_shared<model::DynPLI>(), {}});
+    return column_set_plis_.size() - 1;
+}
+
+void DynamicMultiFDVerifier::LoadDataInternal() {
+    table_data_ = std::make_shared<model::DynamicTableData>(*input_table_);
+    is_column_used_.assign(table_data_->GetNumColumns(), false);
+    // The ids of the values of an earlier table would be left unused
+    value_dictionary_.clear();
+    next_value_id_ = 1;
+    column_set_plis_.clear();
+    dependencies_.clear();
+    fd_dependency_indices_.clear();
+    ucc_dependency_indices_.clear();
+    for (auto const& [lhs_indices, rhs_indices] : fds_) {
+        fd_dependency_indices_.push_back(AddDependency(lhs_indices, rhs_indices, false));
+    }
+    for (auto const& ucc_indices : uccs_) {
+        ucc_dependency_indices_.push_back(AddDependency(ucc_indices, {}, true));
+    }
+
+    std::vector<std::pair<size_t, std::vector<int>>> rows;
+    rows.reserve(table_data_->GetNumRowsTotal());
+    for (size_t row_id = 0; row_id < table_data_->GetNumRowsTotal(); ++row_id) {
+        rows.emplace_back(row_id, EncodeStoredRow(row_id));
+    }
+    ApplyChanges({}, rows);
+}
+
+unsigned long long DynamicMultiFDVerifier::ExecuteInternal() {
+    auto start_time = std::chrono::system_clock::now();
+
+    std::vector<size_t> removed_rows_ids(delete_statement_indices_.begin(),
+                                         delete_statement_indices_.end());
+    std::vector<std::pair<size_t, std::vector<int>>> added_rows;
+    if (insert_statements_table_ != nullptr) {
+        size_t next_row_id = table_data_->GetNumRowsTotal();
+        while (insert_statements_table_->HasNextRow()) {
+            model::IDatasetStream::Row row = insert_statements_table_->GetNextRow();
+            if (row.size() != table_data_->GetNumColumns()) {
+                LOG(WARNING) << "Received row with size " << row.size() << ", but expected "
+                             << table_data_->GetNumColumns();
+                continue;
+            }
+            added_rows.emplace_back(next_row_id++, EncodeRow(row.cbegin()));
+        }
+        insert_statements_table_->Reset();
+    }
+    if (update_statements_table_ != nullptr) {
+        while (update_statements_table_->HasNextRow()) {
+            model::IDatasetStream::Row row = update_statements_table_->GetNextRow();
+            if (row.size() != table_data_->GetNumColumns() + 1) {
+                LOG(WARNING) << "Received row with size " << row.size() << ", but expected "
+                             << table_data_->GetNumColumns() + 1;
+                continue;
+            }
+            size_t row_id = std::stoull(row.front());
+            removed_rows_ids.push_back(row_id);
+            added_rows.emplace_back(row_id, EncodeRow(row.cbegin() + 1));
+        }
+        update_statements_table_->Reset();
+    }
+
+    table_data_->Update(insert_statements_table_, update_statements_table_,
+                        delete_statement_indices_);
+    ApplyChanges(removed_rows_ids, added_rows);
+
+    auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now() - start_time);
+    return elapsed_milliseconds.count();
+}
+
+void DynamicMultiFDVerifier::ApplyChanges(
+        std::vector<size_t> const& removed_rows_ids,
+        std::vector<std::pair<size_t, std::vector<int>>> const& added_rows) {
+    util::ParallelForeach(
+            column_set_plis_.begin(), column_set_plis_.end(), threads_num_,
+            [&](ColumnSetPLI& column_set_pli) {
+                std::vector<std::pair<size_t, model::DynPLI::ClusterValue>> added;
+                added.reserve(added_rows.size());
+                for (auto const& [row_id, codes] : added_rows) {
+                    model::DynPLI::ClusterValue& value = added.emplace_back(row_id, 0).second;
+                    value.reserve(column_set_pli.indices.size());
+                    for (config::IndexType index : column_set_pli.indices) {
+                        value.push_back(codes[index]);
+                    }
+                }
+                column_set_pli.changes = column_set_pli.pli->ApplyChanges(removed_rows_ids, added);
+            });
+    util::ParallelForeach(
+            dependencies_.begin(), dependencies_.end(), threads_num_,
+            [this](Dependency& dependency) {
+                model::DynPLI::Changes const& lhs_changes =
+                        column_set_plis_[dependency.lhs_pli_index].changes;
+                if (dependency.IsUCC()) {
+                    dependency.stats_calculator->ApplyChanges(lhs_changes);
+                } else {
+                    dependency.stats_calculator->ApplyChanges(
+                            lhs_changes, column_set_plis_[*dependency.rhs_pli_index].changes);
+                }
+                dependency.stats_calculator->SortHighlights(
+                        DynamicStatsCalculator::CompareHighlightsByProportionDescending());
+            });
+    for (ColumnSetPLI& column_set_pli : column_set_plis_) {
+        column_set_pli.changes = {};
+    }
+}
+
+int DynamicMultiFDVerifier::GetValueId(std::string const& value) {
+    if (value.empty()) {
+        return kNullValueId;
+    }
+    auto [iter, is_value_new] = value_dictionary_.try_emplace(value, next_value_id_);
+    if (is_value_new) {
+        next_value_id_++;
+    }
+    return iter->second;
+}
+
+std::vector<int> DynamicMultiFDVerifier::EncodeRow(
+        model::IDatasetStream::Row::const_iterator const& row_begin) {
+    std::vector<int> codes(is_column_used_.size(), 0);
+    for (size_t column = 0; column < codes.size(); ++column) {
+        if (!is_column_used_[column]) continue;
+        codes[column] = GetValueId(*(row_begin + column));
+    }
+    return codes;
+}
+
+std::vector<int> DynamicMultiFDVerifier::EncodeStoredRow(size_t row_id) {
+    std::vector<int> codes(is_column_used_.size(), 0);
+    for (size_t column = 0; column < codes.size(); ++column) {
+        if (!is_column_used_[column]) continue;
+        codes[column] = GetValueId(table_data_->GetValue(row_id, column));
+    }
+    return codes;
+}
+
+}  // namespace algos::fd_verifier
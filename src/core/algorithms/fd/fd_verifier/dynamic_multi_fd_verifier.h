@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cassert>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "algorithms/algorithm.h"
+#include "algorithms/fd/fd_verifier/dynamic_stats_calculator.h"
+#include "config/indices/type.h"
+#include "config/tabular_data/input_table_type.h"
+#include "config/thread_number/type.h"
+#include "model/table/dynamic_position_list_index.h"
+#include "model/table/dynamic_table_data.h"
+
+namespace algos::fd_verifier {
+
+/* Monitors many FDs and UCCs over one changing table. The table data and the value dictionary are
+ * shared by all dependencies, so every CRUD batch is parsed and encoded once. Rows are clustered
+ * in one dynamic PLI per distinct column set the dependencies refer to: FDs with a common LHS, or
+ * with the RHS of one being the LHS of another, share the PLI and each batch updates it once.
+ * Only the per-LHS-cluster histograms of RHS clusters are kept per dependency. The PLIs are
+ * updated in parallel, then the statistics of the dependencies are.
+ * A UCC is verified as an FD from its columns to the row id: it is violated exactly by the
+ * clusters containing more than one row, so it needs no RHS PLI and no histograms */
+class DynamicMultiFDVerifier : public Algorithm {
+public:
+    using FDIndices = std::pair<config::IndicesType, config::IndicesType>;
+
+private:
+    struct ColumnSetPLI {
+        config::IndicesType indices;
+        std::shared_ptr<model::DynPLI> pli;
+        /* Changes of the batch being applied */
+        model::DynPLI::Changes changes;
+    };
+
+    struct Dependency {
+        config::IndicesType lhs_indices;
+        /* Empty for UCCs */
+        config::IndicesType rhs_indices;
+        /* Indices in column_set_plis_ */
+        size_t lhs_pli_index;
+        std::optional<size_t> rhs_pli_index;
+        std::unique_ptr<DynamicStatsCalculator> stats_calculator;
+
+        bool IsUCC() const {
+            return !rhs_pli_index.has_value();
+        }
+    };
+
+    config::InputTable input_table_;
+    config::InputTable insert_statements_table_ = nullptr;
+    config::InputTable update_statements_table_ = nullptr;
+    std::unordered_set<size_t> delete_statement_indices_;
+
+    std::vector<FDIndices> fds_;
+    std::vector<config::IndicesType> uccs_;
+    config::ThreadNumType threads_num_;
+
+    std::shared_ptr<model::DynamicTableData> table_data_;
+    std::vector<ColumnSetPLI> column_set_plis_;
+    std::vector<Dependency> dependencies_;
+    /* Indices of the dependencies that verify the requested FDs and UCCs */
+    std::vector<size_t> fd_dependency_indices_;
+    std::vector<size_t> ucc_dependency_indices_;
+
+    std::vector<bool> is_column_used_;
+    std::unordered_map<std::string, int> value_dictionary_{};
+    int next_value_id_ = 1;
+    static constexpr int kNullValueId = -1;
+
+    void RegisterOptions();
+    /* Returns the index of the PLI over the normalized indices, creating it if needed */
+    size_t GetColumnSetPLI(config::IndicesType const& indices);
+    size_t AddDependency(config::IndicesType lhs_indices, config::IndicesType rhs_indices,
+                         bool is_ucc);
+    int GetValueId(std::string const& value);
+    /* Encodes the cells of the columns some dependency refers to, others are left as 0 */
+    std::vector<int> EncodeRow(model::IDatasetStream::Row::const_iterator const& row_begin);
+    std::vector<int> EncodeStoredRow(size_t row_id);
+    /* Applies a batch of removed rows and rows with new values, encoded by EncodeRow, to the PLIs
+     * and statistics of every dependency */
+    void ApplyChanges(std::vector<size_t> const& removed_rows_ids,
+                      std::vector<std::pair<size_t, std::vector<int>>> const& added_rows);
+
+    // Statistics are maintained incrementally between batches, so there is nothing to reset
+    void ResetState() final {}
+
+protected:
+    void LoadDataInternal() override;
+    void MakeExecuteOptsAvailable() override;
+    unsigned long long ExecuteInternal() override;
+
+public:
+    size_t GetNumFDs() const {
+        return fd_dependency_indices_.size();
+    }
+
+    size_t GetNumUCCs() const {
+        return ucc_dependency_indices_.size();
+    }
+
+    /* Returns statistics of the FD with the given index in the fds option */
+    DynamicStatsCalculator const& GetFDStatistics(size_t fd_index) const {
+        assert(fd_index < fd_dependency_indices_.size());
+        return *dependencies_[fd_dependency_indices_[fd_index]].stats_calculator;
+    }
+
+    /* Returns statistics of the UCC with the given index in the uccs option. Highlights are the
+     * clusters of rows that have equal values in the UCC columns */
+    DynamicStatsCalculator const& GetUCCStatistics(size_t ucc_index) const {
+        assert(ucc_index < ucc_dependency_indices_.size());
+        return *dependencies_[ucc_dependency_indices_[ucc_index]].stats_calculator;
+    }
+
+    bool FDHolds(size_t fd_index) const {
+        return GetFDStatistics(fd_index).FDHolds();
+    }
+
+    bool UCCHolds(size_t ucc_index) const {
+        return GetUCCStatistics(ucc_index).FDHolds();
+    }
+
+    DynamicMultiFDVerifier();
+};
+
+}  // namespace algos::fd_verifier
@@ -3,66 +3,196 @@
 #include <algorithm>
 #include <cassert>
 #include <numeric>
-#include <unordered_map>
 
 #include <easylogging++.h>
 
 namespace algos::fd_verifier {
 
-void DynamicStatsCalculator::CalculateStatistics(model::DynPLI const* lhs_pli,
-                                                 model::DynPLI const* rhs_pli) {
-    model::DynPLI::ClusterCollection const& lhs_clusters = lhs_pli->GetClusters();
-    std::shared_ptr<std::vector<int> const> pt_shared = rhs_pli->GetCachedProbingTable();
-    std::vector<int> const& rhs_pt = *pt_shared;
-    size_t num_tuples_conflicting_on_rhs = 0;
-
-    for (auto const& [_, cluster] : lhs_clusters) {
-        if (cluster.size() == 1) continue;
-        Frequencies frequencies = model::DynPLI::CreateFrequencies(cluster, rhs_pt);
-        size_t num_distinct_rhs_values = CalculateNumDistinctRhsValues(frequencies, cluster.size());
-        if (num_distinct_rhs_values == 1) continue;
-        num_tuples_conflicting_on_rhs +=
-                CalculateNumTuplesConflictingOnRhsInCluster(frequencies, cluster.size());
-        num_error_rows_ += cluster.size();
-        highlights_.emplace_back(cluster, num_distinct_rhs_values,
-                                 CalculateNumMostFrequentRhsValue(frequencies));
-    }
-
-    assert(!highlights_.empty());
-    size_t num_rows = table_data_->GetNumRowsActual();
-    error_ = (double)num_tuples_conflicting_on_rhs / (num_rows * num_rows - num_rows);
-}
-
-size_t DynamicStatsCalculator::CalculateNumMostFrequentRhsValue(Frequencies const& frequencies) {
-    // Only singletons in cluster
-    if (frequencies.empty()) {
-        return 1;
-    }
-    auto comp = [](auto const& a, auto const& b) { return a.second < b.second; };
-    return std::max_element(frequencies.begin(), frequencies.end(), comp)->second;
-}
-
-size_t DynamicStatsCalculator::CalculateNumTuplesConflictingOnRhsInCluster(
-        Frequencies const& frequencies, size_t cluster_size) {
-    size_t num_tuples_conflicting_on_rhs = cluster_size * (cluster_size - 1);
-    for (auto const& [_, number_of_values] : frequencies) {
-        if (number_of_values > 1) {
-            num_tuples_conflicting_on_rhs -= number_of_values * (number_of_values - 1);
+auto DynamicStatsCalculator::Touch(ClusterId cluster_id) -> ClusterState& {
+    if (static_cast<size_t>(cluster_id) >= clusters_.size()) {
+        clusters_.resize(cluster_id + 1);
+    }
+    ClusterState& cluster = clusters_[cluster_id];
+    if (!cluster.is_touched) {
+        cluster.is_touched = true;
+        touched_clusters_.push_back(cluster_id);
+    }
+    return cluster;
+}
+
+auto DynamicStatsCalculator::AddToCluster(model::DynPLI::RecordPosition const& lhs_position)
+        -> ClusterState& {
+    ClusterState& cluster = Touch(lhs_position.cluster_id);
+    if (cluster.highlight_index) {
+        model::PLI::Cluster& rows = highlights_[*cluster.highlight_index].cluster_;
+        assert(rows.size() == lhs_position.position);
+        rows.push_back(lhs_position.record_id);
+        ++num_error_rows_;
+    }
+    return cluster;
+}
+
+auto DynamicStatsCalculator::RemoveFromCluster(model::DynPLI::RecordPosition const& lhs_position)
+        -> ClusterState& {
+    ClusterState& cluster = Touch(lhs_position.cluster_id);
+    if (cluster.highlight_index) {
+        // The highlight follows the PLI: the last row takes the place of the removed one
+        model::PLI::Cluster& rows = highlights_[*cluster.highlight_index].cluster_;
+        assert(lhs_position.position < rows.size() &&
+               (size_t)rows[lhs_position.position] == lhs_position.record_id);
+        rows[lhs_position.position] = rows.back();
+        rows.pop_back();
+        --num_error_rows_;
+    }
+    return cluster;
+}
+
+void DynamicStatsCalculator::AddRow(model::DynPLI::RecordPosition const& lhs_position,
+                                    ClusterId rhs_cluster_id) {
+    ClusterState& cluster = AddToCluster(lhs_position);
+    unsigned& frequency = cluster.rhs_frequencies[rhs_cluster_id];
+    if (frequency != 0) {
+        --cluster.frequency_counts[frequency];
+    }
+    cluster.num_pairs_agreeing_on_rhs += 2 * frequency;
+    ++frequency;
+    if (cluster.frequency_counts.size() <= frequency) {
+        cluster.frequency_counts.resize(frequency + 1);
+    }
+    ++cluster.frequency_counts[frequency];
+    cluster.max_frequency = std::max(cluster.max_frequency, frequency);
+}
+
+void DynamicStatsCalculator::RemoveRow(model::DynPLI::RecordPosition const& lhs_position,
+                                       ClusterId rhs_cluster_id) {
+    ClusterState& cluster = RemoveFromCluster(lhs_position);
+    auto frequency_it = cluster.rhs_frequencies.find(rhs_cluster_id);
+    assert(frequency_it != cluster.rhs_frequencies.end());
+    unsigned& frequency = frequency_it->second;
+    --cluster.frequency_counts[frequency];
+    // Some value still occurs frequency - 1 times: the one whose row has just been removed
+    if (frequency == cluster.max_frequency && cluster.frequency_counts[frequency] == 0) {
+        --cluster.max_frequency;
+    }
+    --frequency;
+    cluster.num_pairs_agreeing_on_rhs -= 2 * frequency;
+    if (frequency == 0) {
+        cluster.rhs_frequencies.erase(frequency_it);
+    } else {
+        ++cluster.frequency_counts[frequency];
+    }
+}
+
+void DynamicStatsCalculator::RefreshCluster(ClusterId cluster_id) {
+    ClusterState& cluster = clusters_[cluster_id];
+    cluster.is_touched = false;
+    model::DynPLI::Cluster const& rows = lhs_pli_->GetCluster(cluster_id);
+    size_t const cluster_size = rows.size();
+
+    num_tuples_conflicting_on_rhs_ -= cluster.num_tuples_conflicting_on_rhs;
+    cluster.num_tuples_conflicting_on_rhs =
+            cluster_size * (cluster_size - 1) - cluster.num_pairs_agreeing_on_rhs;
+    num_tuples_conflicting_on_rhs_ += cluster.num_tuples_conflicting_on_rhs;
+
+    if (is_ucc_) {
+        // Every row has a value of its own, so no histogram is kept
+        cluster.max_frequency = cluster_size == 0 ? 0 : 1;
+    }
+    size_t const num_distinct_rhs_values =
+            is_ucc_ ? cluster_size : cluster.rhs_frequencies.size();
+    if (num_distinct_rhs_values > 1) {
+        if (cluster.highlight_index.has_value()) {
+            // The rows of the highlight have been changed along with the cluster
+            Highlight& highlight = highlights_[*cluster.highlight_index];
+            assert(highlight.cluster_.size() == cluster_size);
+            highlight.num_distinct_rhs_values_ = num_distinct_rhs_values;
+            highlight.most_frequent_rhs_value_proportion_ =
+                    (double)cluster.max_frequency / cluster_size;
+        } else {
+            cluster.highlight_index = highlights_.size();
+            highlights_.emplace_back(rows, num_distinct_rhs_values, cluster.max_frequency);
+            highlight_clusters_.push_back(cluster_id);
+            num_error_rows_ += cluster_size;
         }
+    } else if (cluster.highlight_index.has_value()) {
+        RemoveHighlight(cluster);
+    }
+
+    if (cluster_size == 0) {
+        // The PLI has released the cluster id, it may be given to a new cluster
+        cluster = {};
+    }
+}
+
+void DynamicStatsCalculator::RemoveHighlight(ClusterState& cluster) {
+    size_t const index = *cluster.highlight_index;
+    num_error_rows_ -= highlights_[index].GetCluster().size();
+    if (index + 1 != highlights_.size()) {
+        highlights_[index] = std::move(highlights_.back());
+        highlight_clusters_[index] = highlight_clusters_.back();
+        clusters_[highlight_clusters_[index]].highlight_index = index;
+    }
+    highlights_.pop_back();
+    highlight_clusters_.pop_back();
+    cluster.highlight_index.reset();
+}
+
+void DynamicStatsCalculator::ApplyChanges(model::DynPLI::Changes const& lhs_changes,
+                                          model::DynPLI::Changes const& rhs_changes) {
+    assert(!is_ucc_);
+    assert(lhs_changes.removed.size() == rhs_changes.removed.size() &&
+           lhs_changes.added.size() == rhs_changes.added.size());
+    for (size_t i = 0; i < lhs_changes.removed.size(); ++i) {
+        assert(lhs_changes.removed[i].record_id == rhs_changes.removed[i].record_id);
+        RemoveRow(lhs_changes.removed[i], rhs_changes.removed[i].cluster_id);
+    }
+    for (size_t i = 0; i < lhs_changes.added.size(); ++i) {
+        assert(lhs_changes.added[i].record_id == rhs_changes.added[i].record_id);
+        AddRow(lhs_changes.added[i], rhs_changes.added[i].cluster_id);
     }
-    return num_tuples_conflicting_on_rhs;
+    RefreshTouchedClusters();
 }
 
-size_t DynamicStatsCalculator::CalculateNumDistinctRhsValues(Frequencies const& frequencies,
-                                                             size_t cluster_size) {
-    size_t num_non_singleton_rhs_values = std::accumulate(
-            frequencies.begin(), frequencies.end(), 0U,
-            [](unsigned total, auto const& freq_iter) { return total + freq_iter.second; });
-    return frequencies.size() + cluster_size - num_non_singleton_rhs_values;
+void DynamicStatsCalculator::ApplyChanges(model::DynPLI::Changes const& lhs_changes) {
+    assert(is_ucc_);
+    for (model::DynPLI::RecordPosition const& removed : lhs_changes.removed) {
+        RemoveFromCluster(removed);
+    }
+    for (model::DynPLI::RecordPosition const& added : lhs_changes.added) {
+        AddToCluster(added);
+    }
+    RefreshTouchedClusters();
+}
+
+void DynamicStatsCalculator::RefreshTouchedClusters() {
+    for (ClusterId cluster_id : touched_clusters_) {
+        RefreshCluster(cluster_id);
+    }
+    touched_clusters_.clear();
+
+    size_t const num_rows = table_data_->GetNumRowsActual();
+    error_ = num_rows < 2 ? 0
+                          : (double)num_tuples_conflicting_on_rhs_ / (num_rows * num_rows - num_rows);
 }
 
 void DynamicStatsCalculator::SortHighlights(HighlightCompareFunction const& compare) {
-    std::sort(highlights_.begin(), highlights_.end(), compare);
+    std::vector<size_t> order(highlights_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this, &compare](size_t i1, size_t i2) {
+        return compare(highlights_[i1], highlights_[i2]);
+    });
+
+    std::vector<Highlight> sorted_highlights;
+    std::vector<ClusterId> sorted_clusters;
+    sorted_highlights.reserve(highlights_.size());
+    sorted_clusters.reserve(highlights_.size());
+    for (size_t index : order) {
+        clusters_[highlight_clusters_[index]].highlight_index = sorted_highlights.size();
+        sorted_highlights.push_back(std::move(highlights_[index]));
+        sorted_clusters.push_back(highlight_clusters_[index]);
+    }
+    highlights_ = std::move(sorted_highlights);
+    highlight_clusters_ = std::move(sorted_clusters);
 }
 
 auto DynamicStatsCalculator::CompareHighlightsByProportionAscending() -> HighlightCompareFunction {
@@ -2,47 +2,75 @@
 
 #include <functional>
 #include <memory>
-#include <string>
+#include <optional>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "algorithms/fd/fd_verifier/highlight.h"
-#include "config/indices/type.h"
 #include "model/table/dynamic_position_list_index.h"
 #include "model/table/dynamic_table_data.h"
 
 namespace algos::fd_verifier {
 
+/* Maintains FD statistics under a stream of row insertions and removals. The rows are clustered
+ * by their LHS values in a dynamic PLI, and every LHS cluster keeps a histogram of the RHS clusters
+ * of its rows, so a batch only touches the clusters of the rows it changes and costs
+ * O(changed rows) instead of O(table) */
 class DynamicStatsCalculator {
 private:
-    using ClusterIndex = model::DynPLI::Cluster::value_type;
-    using Frequencies = std::unordered_map<ClusterIndex, unsigned>;
+    using ClusterId = model::DynPLI::ClusterId;
+
+    struct ClusterState {
+        /* Number of rows of the cluster in each RHS cluster */
+        std::unordered_map<ClusterId, unsigned> rhs_frequencies;
+        /* frequency_counts[f] is the number of RHS values occurring exactly f times */
+        std::vector<unsigned> frequency_counts = {0};
+        unsigned max_frequency = 0;
+        /* Number of ordered row pairs that agree on RHS, i.e. sum of f * (f - 1) */
+        size_t num_pairs_agreeing_on_rhs = 0;
+        /* Contribution of the cluster to the totals below as of the last refresh */
+        size_t num_tuples_conflicting_on_rhs = 0;
+        std::optional<size_t> highlight_index;
+        /* Whether the cluster is listed in touched_clusters_ */
+        bool is_touched = false;
+    };
 
     std::shared_ptr<model::DynamicTableData> table_data_;
-    config::IndicesType lhs_indices_;
-    config::IndicesType rhs_indices_;
+    std::shared_ptr<model::DynPLI const> lhs_pli_;
+    /* Whether every row is considered to have a distinct RHS value, as a UCC over the LHS */
+    bool is_ucc_;
 
+    /* Indexed by LHS cluster id */
+    std::vector<ClusterState> clusters_;
+    std::vector<ClusterId> touched_clusters_;
+
+    size_t num_tuples_conflicting_on_rhs_ = 0;
     size_t num_error_rows_ = 0;
     long double error_ = 0;
     std::vector<Highlight> highlights_;
-
-    static size_t CalculateNumDistinctRhsValues(Frequencies const& frequencies,
-                                                size_t cluster_size);
-
-    static size_t CalculateNumTuplesConflictingOnRhsInCluster(Frequencies const& frequencies,
-                                                              size_t cluster_size);
-
-    static size_t CalculateNumMostFrequentRhsValue(Frequencies const& frequencies);
+    /* highlight_clusters_[i] is the LHS cluster highlights_[i] was built from */
+    std::vector<ClusterId> highlight_clusters_;
+
+    ClusterState& Touch(ClusterId cluster_id);
+    ClusterState& AddToCluster(model::DynPLI::RecordPosition const& lhs_position);
+    ClusterState& RemoveFromCluster(model::DynPLI::RecordPosition const& lhs_position);
+    void AddRow(model::DynPLI::RecordPosition const& lhs_position, ClusterId rhs_cluster_id);
+    void RemoveRow(model::DynPLI::RecordPosition const& lhs_position, ClusterId rhs_cluster_id);
+    void RefreshCluster(ClusterId cluster_id);
+    void RemoveHighlight(ClusterState& cluster);
+    void RefreshTouchedClusters();
 
 public:
     using HighlightCompareFunction = std::function<bool(Highlight const& h1, Highlight const& h2)>;
 
-    void CalculateStatistics(model::DynPLI const* lhs_pli, model::DynPLI const* rhs_pli);
-
-    void ResetState() {
-        highlights_.clear();
-        num_error_rows_ = 0;
-        error_ = 0;
-    }
+    /* Applies one batch after it has been applied to the LHS and RHS PLIs, in the same order to
+     * both, with the changes they have reported. Must be called after the table data has been
+     * updated, since the error depends on the number of actual rows */
+    void ApplyChanges(model::DynPLI::Changes const& lhs_changes,
+                      model::DynPLI::Changes const& rhs_changes);
+    /* Same for a UCC, which has no RHS PLI */
+    void ApplyChanges(model::DynPLI::Changes const& lhs_changes);
 
     bool FDHolds() const {
         return highlights_.empty();
@@ -73,12 +101,11 @@ public:
     static HighlightCompareFunction CompareHighlightsBySizeAscending();
     static HighlightCompareFunction CompareHighlightsBySizeDescending();
 
-    explicit DynamicStatsCalculator(std::shared_ptr<model::DynamicTableData> table_data,
-                                    config::IndicesType lhs_indices,
-                                    config::IndicesType rhs_indices)
-        : lhs_indices_(std::move(lhs_indices)), rhs_indices_(std::move(rhs_indices)) {
-        table_data_ = table_data;
-    }
+    /* lhs_pli must be empty, rows come with the batches. It may be shared with other
+     * calculators, which then get the same batches */
+    DynamicStatsCalculator(std::shared_ptr<model::DynamicTableData> table_data,
+                           std::shared_ptr<model::DynPLI const> lhs_pli, bool is_ucc = false)
+        : table_data_(std::move(table_data)), lhs_pli_(std::move(lhs_pli)), is_ucc_(is_ucc) {}
 };
 
 }  // namespace algos::fd_verifier
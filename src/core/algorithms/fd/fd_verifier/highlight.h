@@ -1,11 +1,14 @@
 #pragma once
 
 #include <cstddef>
+#include <utility>
 
 #include "model/table/position_list_index.h"
 
 namespace algos::fd_verifier {
 
+class DynamicStatsCalculator;
+
 /* FDVerifier Highlight represents a cluster that violate the FD and provides the information about
  * that cluster */
 class Highlight {
@@ -13,6 +16,10 @@ private:
     model::PLI::Cluster cluster_;    /* cluster that violate the FD */
     size_t num_distinct_rhs_values_; /* number of different RHS values within a cluster */
     double most_frequent_rhs_value_proportion_; /* proportion of most frequent RHS value */
+
+    /* Updates the highlights of the clusters a batch changes in place */
+    friend class DynamicStatsCalculator;
+
 public:
     model::PLI::Cluster const& GetCluster() const {
         return cluster_;
@@ -26,12 +33,12 @@ public:
         return most_frequent_rhs_value_proportion_;
     }
 
-    Highlight(model::PLI::Cluster const& cluster, size_t num_distinct_rhs_values,
+    Highlight(model::PLI::Cluster cluster, size_t num_distinct_rhs_values,
               size_t num_most_frequent_rhs_value)
-        : cluster_(cluster),
+        : cluster_(std::move(cluster)),
           num_distinct_rhs_values_(num_distinct_rhs_values),
           most_frequent_rhs_value_proportion_((double)num_most_frequent_rhs_value /
-                                              cluster.size()) {}
+                                              cluster_.size()) {}
 };
 
 }  // namespace algos::fd_verifier
@@ -1,10 +1,17 @@
 #include "algorithms/fd/fdep/fdep.h"
 
+#include <algorithm>
 #include <chrono>
+#include <mutex>
+#include <utility>
+
+#include <boost/functional/hash.hpp>
 
 #include "config/equal_nulls/option.h"
 #include "config/tabular_data/input_table/option.h"
+#include "config/thread_number/option.h"
 #include "model/table/column_layout_relation_data.h"
+#include "util/parallel_for.h"
 
 // #ifndef PRINT_FDS
 // #define PRINT_FDS
@@ -19,6 +26,15 @@ FDep::FDep() : FDAlgorithm({kDefaultPhaseName}) {
 
 void FDep::RegisterOptions() {
     RegisterOption(config::kTableOpt(&input_table_));
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
+}
+
+void FDep::MakeExecuteOptsAvailableFDInternal() {
+    MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
+}
+
+size_t FDep::DifferenceSetHash::operator()(DifferenceSet const& difference_set) const noexcept {
+    return boost::hash_range(difference_set.begin(), difference_set.end());
 }
 
 void FDep::LoadDataInternal() {
@@ -26,6 +42,11 @@ void FDep::LoadDataInternal() {
     if (number_attributes_ == 0) {
         throw std::runtime_error("Unable to work on an empty dataset.");
     }
+    // Attribute 0 is reserved in FD trees
+    if (number_attributes_ >= FDTreeElement::kMaxAttrNum) {
+        throw std::runtime_error("FDep supports at most " +
+                                 std::to_string(FDTreeElement::kMaxAttrNum - 1) + " columns.");
+    }
     column_names_.resize(number_attributes_);
 
     schema_ = std::make_unique<RelationalSchema>(input_table_->GetRelationName());
@@ -35,15 +56,23 @@ void FDep::LoadDataInternal() {
         schema_->AppendColumn(column_names_[i]);
     }
 
+    std::vector<ValueDictionary<>> dictionaries(number_attributes_);
+    std::vector<std::vector<unsigned>> columns(number_attributes_);
     std::vector<std::string> next_line;
     while (input_table_->HasNextRow()) {
         next_line = input_table_->GetNextRow();
         if (next_line.empty()) break;
-        tuples_.emplace_back(std::vector<size_t>(number_attributes_));
         for (size_t i = 0; i < number_attributes_; ++i) {
-            tuples_.back()[i] = std::hash<std::string>{}(next_line[i]);
+            columns[i].push_back(dictionaries[i].Encode(std::move(next_line[i])));
         }
     }
+
+    number_tuples_ = columns.front().size();
+    encoded_columns_.clear();
+    encoded_columns_.reserve(number_tuples_ * number_attributes_);
+    for (std::vector<unsigned> const& column : columns) {
+        encoded_columns_.insert(encoded_columns_.end(), column.begin(), column.end());
+    }
 }
 
 void FDep::ResetStateFd() {
@@ -56,8 +85,7 @@ unsigned long long FDep::ExecuteInternal() {
     auto start_time = std::chrono::system_clock::now();
 
     BuildNegativeCover();
-
-    this->tuples_.shrink_to_fit();
+    CheckCancellation();
 
     this->pos_cover_tree_ = std::make_unique<FDTreeElement>(this->number_attributes_);
     this->pos_cover_tree_->AddMostGeneralDependencies();
@@ -79,23 +107,92 @@ unsigned long long FDep::ExecuteInternal() {
 
 void FDep::BuildNegativeCover() {
     this->neg_cover_tree_ = std::make_unique<FDTreeElement>(this->number_attributes_);
-    for (auto i = this->tuples_.begin(); i != this->tuples_.end(); ++i) {
-        for (auto j = i + 1; j != this->tuples_.end(); ++j) AddViolatedFDs(*i, *j);
+
+    // Pairs of tuples are compared in tiles of two blocks of tuples, every tile is a task
+    size_t const number_blocks = (number_tuples_ + kBlockSize - 1) / kBlockSize;
+    std::vector<std::pair<size_t, size_t>> block_pairs;
+    block_pairs.reserve(number_blocks * (number_blocks + 1) / 2);
+    for (size_t first_block = 0; first_block < number_blocks; ++first_block) {
+        for (size_t second_block = first_block; second_block < number_blocks; ++second_block) {
+            block_pairs.emplace_back(first_block, second_block);
+        }
+    }
+
+    // Many pairs of tuples share a difference set, so the sets are deduplicated before they are
+    // added to the tree
+    DifferenceSets difference_sets;
+    std::mutex difference_sets_mutex;
+    util::ParallelForeach(block_pairs.begin(), block_pairs.end(), threads_num_,
+                          [&](std::pair<size_t, size_t> const& blocks) {
+                              if (IsCancelled()) return;
+                              DifferenceSets tile_difference_sets;
+                              CollectDifferenceSets(blocks.first, blocks.second,
+                                                    tile_difference_sets);
+                              std::scoped_lock lock(difference_sets_mutex);
+                              difference_sets.merge(tile_difference_sets);
+                          });
+    CheckCancellation();
+
+    for (DifferenceSet const& difference_set : difference_sets) {
+        AddViolatedFDs(difference_set);
     }
 
     this->neg_cover_tree_->FilterSpecializations();
 }
 
-void FDep::AddViolatedFDs(std::vector<size_t> const& t1, std::vector<size_t> const& t2) {
-    std::bitset<FDTreeElement::kMaxAttrNum> equal_attr((2 << this->number_attributes_) - 1);
-    equal_attr.reset(0);
+void FDep::CollectDifferenceSets(size_t first_block, size_t second_block,
+                                 DifferenceSets& difference_sets) const {
+    size_t const first_end = std::min((first_block + 1) * kBlockSize, number_tuples_);
+    size_t const second_end = std::min((second_block + 1) * kBlockSize, number_tuples_);
+    size_t const number_words = (number_attributes_ + 63) / 64;
+    // differences[w * kBlockSize + i] is the w-th word of the difference set of the current tuple
+    // of the first block and the i-th compared tuple of the second block
+    std::vector<std::uint64_t> differences(number_words * kBlockSize);
+
+    for (size_t t1 = first_block * kBlockSize; t1 < first_end; ++t1) {
+        size_t const second_begin =
+                first_block == second_block ? t1 + 1 : second_block * kBlockSize;
+        if (second_begin >= second_end) continue;
+        size_t const number_compared = second_end - second_begin;
+
+        std::fill(differences.begin(), differences.end(), 0);
+        for (size_t attr = 0; attr < this->number_attributes_; ++attr) {
+            unsigned const* column = encoded_columns_.data() + attr * number_tuples_;
+            unsigned const value = column[t1];
+            unsigned const* compared_values = column + second_begin;
+            std::uint64_t* words = differences.data() + attr / 64 * kBlockSize;
+            unsigned const shift = attr % 64;
+            // No branches, so that the comparisons are vectorized
+            for (size_t i = 0; i < number_compared; ++i) {
+                words[i] |= static_cast<std::uint64_t>(compared_values[i] != value) << shift;
+            }
+        }
+
+        for (size_t i = 0; i < number_compared; ++i) {
+            DifferenceSet difference_set{};
+            for (size_t word = 0; word < number_words; ++word) {
+                difference_set[word] = differences[word * kBlockSize + i];
+            }
+            // Equal tuples do not violate any FD
+            if (difference_set != DifferenceSet{}) {
+                difference_sets.insert(difference_set);
+            }
+        }
+    }
+}
+
+void FDep::AddViolatedFDs(DifferenceSet const& difference_set) {
+    std::bitset<FDTreeElement::kMaxAttrNum> equal_attr;
     std::bitset<FDTreeElement::kMaxAttrNum> diff_attr;
 
     for (size_t attr = 0; attr < this->number_attributes_; ++attr) {
-        diff_attr[attr + 1] = (t1[attr] != t2[attr]);
+        if ((difference_set[attr / 64] >> (attr % 64)) & 1) {
+            diff_attr.set(attr + 1);
+        } else {
+            equal_attr.set(attr + 1);
+        }
     }
 
-    equal_attr &= (~diff_attr);
     for (size_t attr = diff_attr._Find_first(); attr != FDTreeElement::kMaxAttrNum;
          attr = diff_attr._Find_next(attr)) {
         this->neg_cover_tree_->AddFunctionalDependency(equal_attr, attr);
@@ -1,12 +1,19 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
+#include <functional>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "algorithms/fd/fd_algorithm.h"
 #include "algorithms/fd/fdep/fd_tree_element.h"
 #include "config/equal_nulls/type.h"
 #include "config/tabular_data/input_table_type.h"
+#include "config/thread_number/type.h"
 #include "model/table/relation_data.h"
 #include "model/table/relational_schema.h"
 
@@ -14,12 +21,38 @@ namespace algos {
 
 class FDep : public FDAlgorithm {
 public:
+    /* Dictionary encoding of the values of a column. Codes are compared instead of values, so
+     * distinct values get distinct codes even if their hashes are equal */
+    template <typename Hash = std::hash<std::string>>
+    class ValueDictionary {
+    private:
+        std::unordered_map<std::string, unsigned, Hash> codes_;
+
+    public:
+        unsigned Encode(std::string value) {
+            return codes_.try_emplace(std::move(value), codes_.size()).first->second;
+        }
+    };
+
     FDep();
 
     ~FDep() override = default;
 
 private:
+    /* Columns on which two tuples differ, column i is bit i */
+    using DifferenceSet = std::array<std::uint64_t, FDTreeElement::kMaxAttrNum / 64>;
+
+    struct DifferenceSetHash {
+        size_t operator()(DifferenceSet const& difference_set) const noexcept;
+    };
+
+    using DifferenceSets = std::unordered_set<DifferenceSet, DifferenceSetHash>;
+
+    // Number of tuples in a block of the pairwise comparison
+    static constexpr size_t kBlockSize = 256;
+
     config::InputTable input_table_;
+    config::ThreadNumType threads_num_;
 
     std::unique_ptr<RelationalSchema> schema_{};
 
@@ -29,9 +62,13 @@ private:
     std::unique_ptr<FDTreeElement> neg_cover_tree_{};
     std::unique_ptr<FDTreeElement> pos_cover_tree_{};
 
-    std::vector<std::vector<size_t>> tuples_;
+    size_t number_tuples_{};
+    /* Dictionary encoded values stored column by column: value of tuple t in column c is
+     * encoded_columns_[c * number_tuples_ + t]. Equal values have equal codes */
+    std::vector<unsigned> encoded_columns_;
 
     void RegisterOptions();
+    void MakeExecuteOptsAvailableFDInternal() final;
 
     void LoadDataInternal() final;
 
@@ -41,9 +78,12 @@ private:
     // Building negative cover via violated dependencies
     void BuildNegativeCover();
 
-    // Iterating over all pairs t1 and t2 of the relation
-    // Adding violated FDs to negative cover tree.
-    void AddViolatedFDs(std::vector<size_t> const& t1, std::vector<size_t> const& t2);
+    // Collecting distinct difference sets of all pairs of tuples in the given blocks of tuples
+    void CollectDifferenceSets(size_t first_block, size_t second_block,
+                               DifferenceSets& difference_sets) const;
+
+    // Adding FDs violated by a pair of tuples with the given difference set to negative cover tree
+    void AddViolatedFDs(DifferenceSet const& difference_set);
 
     // Converting negative cover tree into positive cover tree
     void CalculatePositiveCover(FDTreeElement const& neg_cover_subtree,
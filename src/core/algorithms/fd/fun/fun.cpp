@@ -21,12 +21,18 @@ bool FunQuadruple::Contains(Vertical const& that) const {
 }
 
 FUN::FUN(std::optional<ColumnLayoutRelationDataManager> relation_manager)
-    : PliBasedFDAlgorithm({kDefaultPhaseName}, relation_manager) {}
+    : PliBasedFDAlgorithm({kDefaultPhaseName}, relation_manager) {
+    RegisterBudgetOptions();
+}
 
 void FUN::ResetStateFd() {
     fds_.clear();
 }
 
+void FUN::MakeExecuteOptsAvailableFDInternal() {
+    MakeBudgetOptionsAvailable();
+}
+
 bool FUN::IsKey(FunQuadruple const& l) const {
     return l.GetCount() == relation_->GetNumRows();
 }
@@ -175,6 +181,11 @@ unsigned long long FUN::ExecuteInternal() {
     }
 
     while (!l_k.empty()) {
+        if (IsBudgetExceeded()) {
+            // FDs of the levels processed so far are minimal already
+            RegisterFDs();
+        }
+        CheckCancellation();
         ComputeClosure(l_k_minus_1, l_k);
         ComputeQuasiClosure(l_k_minus_1, l_k);
         DisplayFD(l_k_minus_1);
@@ -185,13 +196,7 @@ unsigned long long FUN::ExecuteInternal() {
     }
     DisplayFD(l_k_minus_1);
 
-    int total_fds = 0;
-    for (auto const& [rhs, lverticals] : fds_) {
-        for (Vertical const& lhs : lverticals) {
-            RegisterFd(lhs, rhs);
-            total_fds++;
-        }
-    }
+    unsigned const total_fds = RegisterFDs();
 
     SetProgress(kTotalProgressPercent);
     auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -203,4 +208,15 @@ unsigned long long FUN::ExecuteInternal() {
     return elapsed_milliseconds.count();
 }
 
+unsigned FUN::RegisterFDs() {
+    unsigned total_fds = 0;
+    for (auto const& [rhs, lverticals] : fds_) {
+        for (Vertical const& lhs : lverticals) {
+            RegisterFd(lhs, rhs);
+            total_fds++;
+        }
+    }
+    return total_fds;
+}
+
 }  // namespace algos
@@ -88,6 +88,7 @@ private:
     using Level = std::list<FunQuadruple>;
 
     void ResetStateFd() final;
+    void MakeExecuteOptsAvailableFDInternal() final;
     unsigned long long ExecuteInternal() final;
 
     Level GenerateCandidate(Level const& l_k) const;
@@ -105,6 +106,8 @@ private:
 
     void DisplayFD(Level const& l_k_minus_1);
 
+    unsigned RegisterFDs();
+
     // Supporting entities
 private:
     RelationalSchema const* schema_;
@@ -6,14 +6,16 @@
 
 namespace algos::hy {
 
-void AllColumnCombinations::Add(boost::dynamic_bitset<>&& column_set) {
-    Add(column_set);
+bool AllColumnCombinations::Add(boost::dynamic_bitset<>&& column_set) {
+    return Add(column_set);
 }
 
-void AllColumnCombinations::Add(boost::dynamic_bitset<> const& column_set) {
+bool AllColumnCombinations::Add(boost::dynamic_bitset<> const& column_set) {
     if (total_ccs_.insert(column_set).second) {
         new_ccs_.Add(boost::dynamic_bitset<>(column_set));
+        return true;
     }
+    return false;
 }
 
 ColumnCombinationList AllColumnCombinations::MoveOutNewColumnCombinations() {
@@ -6,6 +6,7 @@
 #include <boost/dynamic_bitset.hpp>
 
 #include "column_combination_list.h"
+#include "util/custom_hashes.h"
 
 namespace algos::hy {
 
@@ -17,7 +18,7 @@ namespace algos::hy {
  */
 class AllColumnCombinations {
 private:
-    std::unordered_set<boost::dynamic_bitset<>> total_ccs_;
+    std::unordered_set<boost::dynamic_bitset<>, ::util::BitsetHash> total_ccs_;
     ColumnCombinationList new_ccs_;
 
 public:
@@ -28,9 +29,10 @@ public:
      * If the storage had no such combination, it is added to the last-access storage as well.
      *
      * @param column_set column combination
+     * @return whether the combination was not stored yet
      */
-    void Add(boost::dynamic_bitset<>&& column_set);
-    void Add(boost::dynamic_bitset<> const& column_set);
+    bool Add(boost::dynamic_bitset<>&& column_set);
+    bool Add(boost::dynamic_bitset<> const& column_set);
 
     /**
      * @return Number of column sets stored in the last-access storage.
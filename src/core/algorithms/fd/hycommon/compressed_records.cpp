@@ -0,0 +1,120 @@
+#include "compressed_records.h"
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+
+#include "util/agree_mask.h"
+#include "util/parallel_for.h"
+
+namespace {
+
+// Rows transposed at once, a tile of the table stays in cache while its columns are written
+constexpr size_t kTileRows = 1024;
+
+// Width of a column whose largest non-singleton cluster id is max_id
+unsigned char GetWidth(algos::hy::ClusterId max_id) {
+    if (max_id < std::numeric_limits<std::uint8_t>::max()) return 1;
+    if (max_id < std::numeric_limits<std::uint16_t>::max()) return 2;
+    return 4;
+}
+
+}  // namespace
+
+namespace algos::hy {
+
+template <typename T>
+void CompressedRecords::FillTile(Columns const& inverted_plis, size_t column, size_t first_row,
+                                 size_t end_row) noexcept {
+    std::vector<ClusterId> const& cluster_ids = inverted_plis[column];
+    unsigned char* value = data_.get() + first_row * row_size_ + offsets_[column];
+    for (size_t row = first_row; row != end_row; ++row, value += row_size_) {
+        // The singleton cluster id becomes the all-ones value of the width
+        T const cluster_id = static_cast<T>(cluster_ids[row]);
+        std::memcpy(value, &cluster_id, sizeof(T));
+    }
+}
+
+CompressedRecords::CompressedRecords(Columns const& inverted_plis, config::ThreadNumType threads)
+    : num_rows_(inverted_plis.empty() ? 0 : inverted_plis.front().size()),
+      num_columns_(inverted_plis.size()),
+      widths_(num_columns_),
+      offsets_(num_columns_) {
+    std::vector<size_t> columns(num_columns_);
+    std::iota(columns.begin(), columns.end(), 0);
+    util::ParallelForeach(columns.begin(), columns.end(), threads, [&](size_t column) {
+        ClusterId max_id = 0;
+        for (ClusterId cluster_id : inverted_plis[column]) {
+            if (!PLIUtil::IsSingletonCluster(cluster_id)) max_id = std::max(max_id, cluster_id);
+        }
+        widths_[column] = GetWidth(max_id);
+    });
+    for (size_t column = num_columns_; column-- > 1;) {
+        widths_[column - 1] = std::max(widths_[column - 1], widths_[column]);
+    }
+
+    size_t offset = 0;
+    for (size_t column = 0; column != num_columns_; ++column) {
+        offsets_[column] = offset;
+        offset += widths_[column];
+    }
+    // Keeps the 4-byte ids of every row aligned
+    row_size_ = (offset + 3) / 4 * 4;
+
+    size_t first_column = 0;
+    for (size_t i = 0; i != blocks_.size(); ++i) {
+        unsigned char const width = 4 >> i;
+        size_t end_column = first_column;
+        while (end_column != num_columns_ && widths_[end_column] == width) ++end_column;
+        blocks_[i] = {first_column, end_column,
+                      first_column == num_columns_ ? offset : offsets_[first_column]};
+        first_column = end_column;
+    }
+    assert(first_column == num_columns_);
+
+    data_ = std::make_unique_for_overwrite<unsigned char[]>(num_rows_ * row_size_);
+    std::vector<size_t> tiles;
+    for (size_t first_row = 0; first_row < num_rows_; first_row += kTileRows) {
+        tiles.push_back(first_row);
+    }
+    util::ParallelForeach(tiles.begin(), tiles.end(), threads, [&](size_t first_row) {
+        size_t const end_row = std::min(first_row + kTileRows, num_rows_);
+        for (size_t column = 0; column != num_columns_; ++column) {
+            switch (widths_[column]) {
+                case 1:
+                    FillTile<std::uint8_t>(inverted_plis, column, first_row, end_row);
+                    break;
+                case 2:
+                    FillTile<std::uint16_t>(inverted_plis, column, first_row, end_row);
+                    break;
+                default:
+                    FillTile<std::uint32_t>(inverted_plis, column, first_row, end_row);
+            }
+        }
+    });
+}
+
+template <typename T>
+void CompressedRecords::MatchBlock(Block const& block, unsigned char const* first,
+                                   unsigned char const* second, std::uint64_t* mask) noexcept {
+    util::AddAgreeMask(reinterpret_cast<T const*>(first + block.offset),
+                       reinterpret_cast<T const*>(second + block.offset),
+                       block.end_column - block.first_column, std::numeric_limits<T>::max(), mask,
+                       block.first_column);
+}
+
+void CompressedRecords::Match(boost::dynamic_bitset<>& attributes, size_t first_row,
+                              size_t second_row) const noexcept {
+    assert(first_row < num_rows_ && second_row < num_rows_);
+    assert(attributes.size() == num_columns_);
+    thread_local std::vector<std::uint64_t> mask;
+    mask.assign(util::GetAgreeMaskWords(num_columns_), 0);
+    unsigned char const* const first = GetRow(first_row);
+    unsigned char const* const second = GetRow(second_row);
+    MatchBlock<std::uint32_t>(blocks_[0], first, second, mask.data());
+    MatchBlock<std::uint16_t>(blocks_[1], first, second, mask.data());
+    MatchBlock<std::uint8_t>(blocks_[2], first, second, mask.data());
+    util::AgreeMaskToBitset(mask.data(), attributes);
+}
+
+}  // namespace algos::hy
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "algorithms/fd/hycommon/util/pli_util.h"
+#include "config/thread_number/type.h"
+#include "types.h"
+
+namespace algos::hy {
+
+// Cluster ids of every record, stored row by row in a single buffer. Each column takes as many
+// bytes (1, 2 or 4) as its largest cluster id needs, the all-ones value of that width stands for
+// the singleton cluster. Widths never grow from a column to the next one (the columns are ordered
+// by descending number of clusters, otherwise narrow columns are widened), so a row is a block of
+// 4-byte ids followed by a block of 2-byte ids and a block of 1-byte ids.
+class CompressedRecords {
+private:
+    struct Block {
+        size_t first_column;
+        size_t end_column;
+        size_t offset;
+    };
+
+    size_t num_rows_ = 0;
+    size_t num_columns_ = 0;
+    size_t row_size_ = 0;
+    std::vector<unsigned char> widths_;
+    std::vector<size_t> offsets_;
+    // 4-byte, 2-byte and 1-byte blocks
+    std::array<Block, 3> blocks_{};
+    std::unique_ptr<unsigned char[]> data_;
+
+    unsigned char const* GetRow(size_t row) const noexcept {
+        return data_.get() + row * row_size_;
+    }
+
+    template <typename T>
+    static ClusterId Load(unsigned char const* data) noexcept {
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+        return value == std::numeric_limits<T>::max() ? PLIUtil::kSingletonClusterId : value;
+    }
+
+    template <typename T>
+    static void MatchBlock(Block const& block, unsigned char const* first,
+                           unsigned char const* second, std::uint64_t* mask) noexcept;
+
+    template <typename T>
+    void FillTile(Columns const& inverted_plis, size_t column, size_t first_row,
+                  size_t end_row) noexcept;
+
+public:
+    CompressedRecords() = default;
+    // Transposes the inverted PLIs in tiles of rows, the tiles are filled in parallel
+    explicit CompressedRecords(Columns const& inverted_plis, config::ThreadNumType threads = 1);
+
+    size_t GetNumRows() const noexcept {
+        return num_rows_;
+    }
+
+    size_t GetNumColumns() const noexcept {
+        return num_columns_;
+    }
+
+    // Bytes taken by a row
+    size_t GetRowSize() const noexcept {
+        return row_size_;
+    }
+
+    ClusterId Get(size_t row, size_t column) const noexcept {
+        unsigned char const* const value = GetRow(row) + offsets_[column];
+        switch (widths_[column]) {
+            case 1:
+                return Load<std::uint8_t>(value);
+            case 2:
+                return Load<std::uint16_t>(value);
+            default:
+                return Load<std::uint32_t>(value);
+        }
+    }
+
+    // Sets the attributes on which both records belong to the same non-singleton cluster and
+    // resets the others. The ids are compared with the vector instructions of the CPU.
+    void Match(boost::dynamic_bitset<>& attributes, size_t first_row,
+               size_t second_row) const noexcept;
+};
+
+}  // namespace algos::hy
@@ -44,26 +44,16 @@ Columns BuildInvertedPlis(PLIs const& plis) {
     return inverted_plis;
 }
 
-Rows BuildRecordRepresentation(algos::hy::Columns const& inverted_plis) {
-    size_t const num_columns = inverted_plis.size();
-    size_t const num_rows = num_columns == 0 ? 0 : inverted_plis.begin()->size();
-
-    Rows pli_records(num_rows, Row(num_columns));
-
-    for (size_t i = 0; i < num_rows; ++i) {
-        for (size_t j = 0; j < num_columns; ++j) {
-            pli_records[i][j] = inverted_plis[j][i];
-        }
-    }
-
-    return pli_records;
+Rows BuildRecordRepresentation(algos::hy::Columns const& inverted_plis,
+                               config::ThreadNumType threads) {
+    return Rows(inverted_plis, threads);
 }
 
-PLIs BuildPLIs(ColumnLayoutRelationData* relation) {
+PLIs BuildPLIs(ColumnLayoutRelationData const* relation) {
     PLIs plis;
     std::transform(relation->GetColumnData().begin(), relation->GetColumnData().end(),
                    std::back_inserter(plis),
-                   [](auto& column_data) { return column_data.GetPositionListIndex(); });
+                   [](auto const& column_data) { return column_data.GetPositionListIndex(); });
     return plis;
 }
 
@@ -72,14 +62,15 @@ PLIs BuildPLIs(ColumnLayoutRelationData* relation) {
 namespace algos::hy {
 using namespace util;
 
-std::tuple<PLIs, Rows, std::vector<ClusterId>> Preprocess(ColumnLayoutRelationData* relation) {
+std::tuple<PLIs, Rows, std::vector<ClusterId>> Preprocess(
+        ColumnLayoutRelationData const* relation, config::ThreadNumType threads) {
     PLIs plis = BuildPLIs(relation);
 
     auto og_mapping = SortAndGetMapping(plis);
 
     auto const inverted_plis = BuildInvertedPlis(plis);
 
-    auto pli_records = BuildRecordRepresentation(inverted_plis);
+    auto pli_records = BuildRecordRepresentation(inverted_plis, threads);
 
     return std::make_tuple(std::move(plis), std::move(pli_records), std::move(og_mapping));
 }
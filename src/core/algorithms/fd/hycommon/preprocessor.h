@@ -4,6 +4,8 @@
 
 #include <boost/dynamic_bitset.hpp>
 
+#include "compressed_records.h"
+#include "config/thread_number/type.h"
 #include "model/table/column_layout_relation_data.h"
 #include "types.h"
 
@@ -11,14 +13,15 @@ namespace algos::hy::util {
 
 std::vector<ClusterId> SortAndGetMapping(PLIs& plis);
 Columns BuildInvertedPlis(PLIs const& plis);
-Rows BuildRecordRepresentation(Columns const& inverted_plis);
-PLIs BuildPLIs(ColumnLayoutRelationData* relation);
+Rows BuildRecordRepresentation(Columns const& inverted_plis, config::ThreadNumType threads = 1);
+PLIs BuildPLIs(ColumnLayoutRelationData const* relation);
 
 }  // namespace algos::hy::util
 
 namespace algos::hy {
 
-std::tuple<PLIs, Rows, std::vector<ClusterId>> Preprocess(ColumnLayoutRelationData* relation);
+std::tuple<PLIs, Rows, std::vector<ClusterId>> Preprocess(
+        ColumnLayoutRelationData const* relation, config::ThreadNumType threads = 1);
 boost::dynamic_bitset<> RestoreAgreeSet(boost::dynamic_bitset<> const& as,
                                         std::vector<ClusterId> const& og_mapping, size_t num_cols);
 
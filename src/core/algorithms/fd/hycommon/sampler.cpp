@@ -2,6 +2,8 @@
 
 #include <algorithm>
 #include <memory>
+#include <string_view>
+#include <unordered_set>
 #include <utility>
 
 #include <boost/asio/post.hpp>
@@ -9,32 +11,37 @@
 #include <boost/dynamic_bitset.hpp>
 #include <boost/thread/future.hpp>
 
-#include "algorithms/fd/hycommon/util/pli_util.h"
+#include "compressed_records.h"
 #include "efficiency.h"
+#include "util/custom_hashes.h"
+#include "util/metrics.h"
 
 namespace {
 
+/* Number of record pairs compared by the sampler */
+constexpr std::string_view kSampledPairsMetric = "sampler.pairs";
+
 class ClusterComparator {
 private:
-    algos::hy::Rows* sort_keys_;
+    algos::hy::Rows const* sort_keys_;
     size_t comparison_column_1_;
     size_t comparison_column_2_;
 
 public:
-    ClusterComparator(algos::hy::Rows* sort_keys, size_t comparison_column_1,
+    ClusterComparator(algos::hy::Rows const* sort_keys, size_t comparison_column_1,
                       size_t comparison_column_2) noexcept
         : sort_keys_(sort_keys),
           comparison_column_1_(comparison_column_1),
           comparison_column_2_(comparison_column_2) {
-        assert(sort_keys_->front().size() >= 3);
+        assert(sort_keys_->GetNumColumns() >= 3);
     }
 
     bool operator()(size_t o1, size_t o2) noexcept {
-        size_t value1 = (*sort_keys_)[o1][comparison_column_1_];
-        size_t value2 = (*sort_keys_)[o2][comparison_column_1_];
+        size_t value1 = sort_keys_->Get(o1, comparison_column_1_);
+        size_t value2 = sort_keys_->Get(o2, comparison_column_1_);
         if (value1 == value2) {
-            value1 = (*sort_keys_)[o1][comparison_column_2_];
-            value2 = (*sort_keys_)[o2][comparison_column_2_];
+            value1 = sort_keys_->Get(o1, comparison_column_2_);
+            value2 = sort_keys_->Get(o2, comparison_column_2_);
         }
         return value1 > value2;
     }
@@ -74,17 +81,15 @@ public:
 namespace algos::hy {
 
 template <typename F>
-void Sampler::RunWindowImpl(Efficiency& efficiency, model::PositionListIndex const& pli,
-                            F store_match) {
+void Sampler::RunWindowImpl(Efficiency& efficiency, Clusters const& clusters, F store_match) {
     efficiency.IncrementWindow();
 
     size_t const num_attributes = agree_sets_->NumAttributes();
-    size_t const prev_num_agree_sets = agree_sets_->Count();
 
     unsigned comparisons = 0;
     unsigned const window = efficiency.GetWindow();
 
-    for (model::PLI::Cluster const& cluster : pli.GetIndex()) {
+    for (model::PLI::Cluster const& cluster : clusters) {
         boost::dynamic_bitset<> equal_attrs(num_attributes);
         for (size_t i = 0; window < cluster.size() && i < cluster.size() - window; ++i) {
             int const pivot_id = cluster[i];
@@ -99,27 +104,67 @@ void Sampler::RunWindowImpl(Efficiency& efficiency, model::PositionListIndex con
         }
     }
 
-    size_t const num_new_violations = agree_sets_->Count() - prev_num_agree_sets;
+    ::util::AddToCounter(kSampledPairsMetric, comparisons);
 
-    efficiency.SetViolations(num_new_violations);
     efficiency.SetComparisons(comparisons);
 }
 
 std::vector<boost::dynamic_bitset<>> Sampler::RunWindowRet(Efficiency& efficiency,
-                                                           model::PositionListIndex const& pli) {
-    std::vector<boost::dynamic_bitset<>> matched;
+                                                           Clusters const& clusters) {
+    // Deduplicated by the worker, so only distinct agree sets are merged
+    std::unordered_set<boost::dynamic_bitset<>, ::util::BitsetHash> matched;
     auto store_match = [&matched](boost::dynamic_bitset<> const& equal_attrs) {
-        matched.push_back(equal_attrs);
+        matched.insert(equal_attrs);
     };
-    RunWindowImpl(efficiency, pli, store_match);
-    return matched;
+    RunWindowImpl(efficiency, clusters, store_match);
+
+    std::vector<boost::dynamic_bitset<>> result;
+    result.reserve(matched.size());
+    while (!matched.empty()) {
+        result.push_back(std::move(matched.extract(matched.begin()).value()));
+    }
+    return result;
 }
 
-void Sampler::RunWindow(Efficiency& efficiency, model::PositionListIndex const& pli) {
-    auto store_match = [this](boost::dynamic_bitset<> const& equal_attrs) {
-        agree_sets_->Add(equal_attrs);
+void Sampler::RunWindow(Efficiency& efficiency, Clusters const& clusters) {
+    unsigned num_new_violations = 0;
+    auto store_match = [this, &num_new_violations](boost::dynamic_bitset<> const& equal_attrs) {
+        num_new_violations += agree_sets_->Add(equal_attrs);
     };
-    RunWindowImpl(efficiency, pli, store_match);
+    RunWindowImpl(efficiency, clusters, store_match);
+    efficiency.SetViolations(num_new_violations);
+}
+
+void Sampler::RunWindowsParallel(std::vector<Efficiency>& efficiencies) {
+    using Matches = std::vector<boost::dynamic_bitset<>>;
+    std::vector<boost::unique_future<Matches>> futures;
+    for (Efficiency& efficiency : efficiencies) {
+        auto run_window = [&efficiency, this, metrics = ::util::GetCurrentMetrics()]() {
+            ::util::MetricsScope metrics_scope(metrics);
+            return RunWindowRet(efficiency, clusters_[efficiency.GetAttr()]);
+        };
+        boost::packaged_task<Matches> task(std::move(run_window));
+        futures.push_back(task.get_future());
+        boost::asio::post(*pool_, std::move(task));
+    }
+
+    // TODO(polyntsov): this waiting causes significant overhead on some datasets (on flight_1k
+    // it's probably the highest one). However removing this waiting fully removes overhead on
+    // these problematic datasets, it adds overhead on all other datasets :/
+    // It seems that all problematic datasets spend most of the time on the validation phase, so
+    // multithreading here may add some overhead, but I don't really understand how the explicit
+    // waiting causes it. Further investigation is needed.
+    boost::wait_for_all(futures.begin(), futures.end());
+
+    // Merged in the order of the columns, so the violations a window is credited with do not
+    // depend on which worker finished first
+    for (size_t i = 0; i < efficiencies.size(); ++i) {
+        unsigned num_new_violations = 0;
+        for (boost::dynamic_bitset<>& match : futures[i].get()) {
+            num_new_violations += agree_sets_->Add(std::move(match));
+        }
+        efficiencies[i].SetViolations(num_new_violations);
+    }
 }
 
 void Sampler::ProcessComparisonSuggestions(IdPairs const& comparison_suggestions) {
@@ -131,17 +176,18 @@ void Sampler::ProcessComparisonSuggestions(IdPairs const& comparison_suggestions
 
         agree_sets_->Add(std::move(equal_attrs));
     }
+    ::util::AddToCounter(kSampledPairsMetric, comparison_suggestions.size());
 }
 
 void Sampler::SortClustersParallel() {
     ColumnSlider column_slider(plis_->size());
     std::vector<boost::unique_future<void>> sort_futures;
-    for (model::PLI* pli : *plis_) {
+    for (Clusters& clusters : clusters_) {
         ClusterComparator cluster_comparator(compressed_records_.get(),
                                              column_slider.GetLeftNeighbor(),
                                              column_slider.GetRightNeighbor());
-        auto sort = [pli, cluster_comparator]() {
-            for (model::PLI::Cluster& cluster : pli->GetIndex()) {
+        auto sort = [&clusters, cluster_comparator]() {
+            for (model::PLI::Cluster& cluster : clusters) {
                 std::sort(cluster.begin(), cluster.end(), cluster_comparator);
             }
         };
@@ -155,11 +201,11 @@ void Sampler::SortClustersParallel() {
 
 void Sampler::SortClustersSeq() {
     ColumnSlider column_slider(plis_->size());
-    for (model::PLI* pli : *plis_) {
+    for (Clusters& clusters : clusters_) {
         ClusterComparator cluster_comparator(compressed_records_.get(),
                                              column_slider.GetLeftNeighbor(),
                                              column_slider.GetRightNeighbor());
-        for (model::PLI::Cluster& cluster : pli->GetIndex()) {
+        for (model::PLI::Cluster& cluster : clusters) {
             std::sort(cluster.begin(), cluster.end(), cluster_comparator);
         }
         column_slider.ToNextColumn();
@@ -176,33 +222,13 @@ void Sampler::SortClusters() {
 }
 
 void Sampler::InitializeEfficiencyQueueParallel() {
-    using EfficiencyAndMatches = std::pair<Efficiency, std::vector<boost::dynamic_bitset<>>>;
-    std::vector<boost::unique_future<EfficiencyAndMatches>> futures;
+    std::vector<Efficiency> efficiencies;
     for (size_t attr = 0; attr < plis_->size(); ++attr) {
-        auto run_window = [attr, this]() {
-            Efficiency efficiency(attr);
-            return std::make_pair(efficiency, RunWindowRet(efficiency, *(*plis_)[attr]));
-        };
-        boost::packaged_task<EfficiencyAndMatches> task(std::move(run_window));
-        futures.push_back(task.get_future());
-        boost::asio::post(*pool_, std::move(task));
+        efficiencies.emplace_back(attr);
     }
+    RunWindowsParallel(efficiencies);
 
-    // TODO(polyntsov): this waiting causes significant overhead on some datasets (on flight_1k
-    // it's probably the highest one). However removing this waiting fully removes overhead on
-    // these problematic datasets, it adds overhead on all other datasets :/
-    // It seems that all problematic datasets spend most of the time on the validation phase, so
-    // multithreading here may add some overhead, but I don't really understand how the explicit
-    // waiting causes it. Further investigation is needed.
-    boost::wait_for_all(futures.begin(), futures.end());
-
-    for (auto& future : futures) {
-        auto [efficiency, matches] = future.get();
-
-        for (auto& match : matches) {
-            agree_sets_->Add(std::move(match));
-        }
-
+    for (Efficiency const& efficiency : efficiencies) {
         if (efficiency.CalcEfficiency() > 0) {
             efficiency_queue_.push(efficiency);
         }
@@ -212,7 +238,7 @@ void Sampler::InitializeEfficiencyQueueParallel() {
 void Sampler::InitializeEfficiencyQueueSeq() {
     for (size_t attr = 0; attr < plis_->size(); ++attr) {
         Efficiency efficiency(attr);
-        RunWindow(efficiency, *(*plis_)[attr]);
+        RunWindow(efficiency, clusters_[attr]);
 
         if (efficiency.CalcEfficiency() > 0) {
             efficiency_queue_.push(efficiency);
@@ -231,6 +257,10 @@ void Sampler::InitializeEfficiencyQueueImpl() {
 void Sampler::InitializeEfficiencyQueue() {
     size_t const num_attributes = plis_->size();
 
+    clusters_.reserve(num_attributes);
+    for (model::PLI const* pli : *plis_) {
+        clusters_.push_back(pli->GetIndex());
+    }
     if (num_attributes >= 3) {
         SortClusters();
     }
@@ -246,12 +276,11 @@ void Sampler::InitializeEfficiencyQueue() {
 ColumnCombinationList Sampler::GetAgreeSets(IdPairs const& comparison_suggestions) {
     ProcessComparisonSuggestions(comparison_suggestions);
 
-    if (efficiency_queue_.empty()) {
-        if (threads_num_ > 1) {
-            assert(pool_ == nullptr);
-            pool_ = std::make_unique<boost::asio::thread_pool>(threads_num_);
-        }
+    if (threads_num_ > 1 && pool_ == nullptr) {
+        pool_ = std::make_unique<boost::asio::thread_pool>(threads_num_);
+    }
 
+    if (efficiency_queue_.empty()) {
         InitializeEfficiencyQueue();
     } else {
         double const threshold_decrease = 0.9;
@@ -262,13 +291,25 @@ ColumnCombinationList Sampler::GetAgreeSets(IdPairs const& comparison_suggestion
 
     while (!efficiency_queue_.empty() &&
            efficiency_queue_.top().CalcEfficiency() >= efficiency_threshold_) {
-        Efficiency best_efficiency = efficiency_queue_.top();
-        efficiency_queue_.pop();
+        // A round runs the next window of up to threads_num_ most efficient columns, so the
+        // number of columns sampled at once shrinks as their efficiency drops
+        std::vector<Efficiency> round;
+        while ((round.empty() || round.size() < threads_num_) && !efficiency_queue_.empty() &&
+               efficiency_queue_.top().CalcEfficiency() >= efficiency_threshold_) {
+            round.push_back(efficiency_queue_.top());
+            efficiency_queue_.pop();
+        }
 
-        RunWindow(best_efficiency, *(*plis_)[best_efficiency.GetAttr()]);
+        if (round.size() == 1) {
+            RunWindow(round.front(), clusters_[round.front().GetAttr()]);
+        } else {
+            RunWindowsParallel(round);
+        }
 
-        if (best_efficiency.CalcEfficiency() > 0) {
-            efficiency_queue_.push(best_efficiency);
+        for (Efficiency const& efficiency : round) {
+            if (efficiency.CalcEfficiency() > 0) {
+                efficiency_queue_.push(efficiency);
+            }
         }
     }
 
@@ -277,17 +318,7 @@ ColumnCombinationList Sampler::GetAgreeSets(IdPairs const& comparison_suggestion
 
 void Sampler::Match(boost::dynamic_bitset<>& attributes, size_t first_record_id,
                     size_t second_record_id) {
-    assert(first_record_id < compressed_records_->size() &&
-           second_record_id < compressed_records_->size());
-
-    for (size_t i = 0; i < compressed_records_->front().size(); ++i) {
-        TablePos const val1 = (*compressed_records_)[first_record_id][i];
-        TablePos const val2 = (*compressed_records_)[second_record_id][i];
-        if (!PLIUtil::IsSingletonCluster(val1) && !PLIUtil::IsSingletonCluster(val2) &&
-            val1 == val2) {
-            attributes.set(i);
-        }
-    }
+    compressed_records_->Match(attributes, first_record_id, second_record_id);
 }
 
 Sampler::Sampler(PLIsPtr plis, RowsPtr pli_records, config::ThreadNumType threads)
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <deque>
 #include <memory>
 #include <queue>
 #include <vector>
@@ -23,9 +24,13 @@ namespace algos::hy {
 class Sampler {
 private:
     class Efficiency;
+    using Clusters = std::deque<model::PLI::Cluster>;
     double efficiency_threshold_ = kEfficiencyThreshold;
 
     PLIsPtr plis_;
+    // Clusters of the PLIs, sorted so that the windows compare similar records. The PLIs are read
+    // only, so the clusters are copied
+    std::vector<Clusters> clusters_;
     RowsPtr compressed_records_;
     std::priority_queue<Efficiency> efficiency_queue_;
     std::unique_ptr<AllColumnCombinations> agree_sets_;
@@ -40,14 +45,15 @@ private:
     void InitializeEfficiencyQueueParallel();
     void InitializeEfficiencyQueueImpl();
     void InitializeEfficiencyQueue();
+    void RunWindowsParallel(std::vector<Efficiency>& efficiencies);
 
     void Match(boost::dynamic_bitset<>& attributes, size_t first_record_id,
                size_t second_record_id);
     template <typename F>
-    void RunWindowImpl(Efficiency& efficiency, model::PositionListIndex const& pli, F store_match);
+    void RunWindowImpl(Efficiency& efficiency, Clusters const& clusters, F store_match);
     std::vector<boost::dynamic_bitset<>> RunWindowRet(Efficiency& efficiency,
-                                                      model::PositionListIndex const& pli);
-    void RunWindow(Efficiency& efficiency, model::PositionListIndex const& pli);
+                                                      Clusters const& clusters);
+    void RunWindow(Efficiency& efficiency, Clusters const& clusters);
 
 public:
     Sampler(PLIsPtr plis, RowsPtr pli_records, config::ThreadNumType threads = 1);
@@ -12,17 +12,19 @@ class PositionListIndex;
 
 namespace algos::hy {
 
+class CompressedRecords;
+
 // Row (or column) position in the table
 using TablePos = model::ColumnIndex;
 using ClusterId = unsigned int;
 
 // Represents a relation as a list of position list indexes. i-th PLI is a PLI built on i-th column
-// of the relation
-using PLIs = std::vector<model::PositionListIndex*>;
+// of the relation. The PLIs belong to the relation, which other runs may share, so they are read
+// only
+using PLIs = std::vector<model::PositionListIndex const*>;
 using PLIsPtr = std::shared_ptr<PLIs>;
-using Row = std::vector<TablePos>;
-// Represents a relation as a list of rows where each row is a list of row values
-using Rows = std::vector<Row>;
+// Represents a relation as a list of rows where each row is a list of cluster ids of its values
+using Rows = CompressedRecords;
 // Represents a relation as a list of column where each column is a list of column values
 using Columns = std::vector<std::vector<TablePos>>;
 using RowsPtr = std::shared_ptr<Rows>;
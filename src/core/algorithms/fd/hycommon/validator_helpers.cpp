@@ -1,17 +1,17 @@
 #include "validator_helpers.h"
 
+#include "algorithms/fd/hycommon/compressed_records.h"
 #include "algorithms/fd/hycommon/util/pli_util.h"
-#include "algorithms/fd/hyfd/model/fd_tree_vertex.h"
 #include "ucc/hyucc/model/ucc_tree_vertex.h"
 
 namespace algos::hy {
 
-std::vector<ClusterId> BuildClustersIdentifier(Row const& compressed_record,
+std::vector<ClusterId> BuildClustersIdentifier(Rows const& compressed_records, size_t row,
                                                std::vector<ClusterId> const& agree_set) {
     std::vector<ClusterId> sub_cluster;
     sub_cluster.reserve(agree_set.size());
     for (auto attr : agree_set) {
-        ClusterId const cluster_id = compressed_record[attr];
+        ClusterId const cluster_id = compressed_records.Get(row, attr);
 
         if (PLIUtil::IsSingletonCluster(cluster_id)) {
             return {};
@@ -47,10 +47,7 @@ std::vector<VertexAndAgreeSet> CollectCurrentChildren(
 }
 
 using UCCLhsPair = algos::hyucc::LhsPair;
-using FDLhsPair = algos::hyfd::fd_tree::LhsPair;
 template std::vector<UCCLhsPair> CollectCurrentChildren<UCCLhsPair>(
         std::vector<UCCLhsPair> const& cur_level_vertices, size_t num_attributes);
-template std::vector<FDLhsPair> CollectCurrentChildren<FDLhsPair>(
-        std::vector<FDLhsPair> const& cur_level_vertices, size_t num_attributes);
 
 }  // namespace algos::hy
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <string>
 #include <string_view>
 #include <vector>
 
@@ -10,6 +11,7 @@
 #include <easylogging++.h>
 
 #include "types.h"
+#include "util/metrics.h"
 
 #define UNORDERED_FLAT_MAP_AVAILABLE (BOOST_VERSION >= 108100)
 
@@ -22,7 +24,7 @@ namespace algos::hy {
 // Builds a cluster's identifier of the agree set provided. Cluster's identifier is a vector
 // of size_t value where ith value of the vector is an identifier of a cluster of ith set
 // attribute of the agree set.
-std::vector<ClusterId> BuildClustersIdentifier(Row const& compressed_record,
+std::vector<ClusterId> BuildClustersIdentifier(Rows const& compressed_records, size_t row,
                                                std::vector<ClusterId> const& agree_set);
 
 // Builds the next level of the prefix tree traversal
@@ -30,6 +32,29 @@ template <typename VertexAndAgreeSet>
 std::vector<VertexAndAgreeSet> CollectCurrentChildren(
         std::vector<VertexAndAgreeSet> const& cur_level_vertices, size_t num_attributes);
 
+// Counters of validations per level, a counter is looked up by name once per run
+class LevelValidationsMetrics {
+private:
+    ::util::Metrics& metrics_;
+    std::vector<::util::MetricCounter*> counters_;
+
+public:
+    explicit LevelValidationsMetrics(::util::Metrics& metrics) : metrics_(metrics) {}
+
+    ::util::MetricCounter& Get(size_t level_number) {
+        if (counters_.size() <= level_number) {
+            counters_.resize(level_number + 1, nullptr);
+        }
+        if (counters_[level_number] == nullptr) {
+            counters_[level_number] =
+                    &metrics_.GetCounter("validations.level_" + std::to_string(level_number));
+        }
+        return *counters_[level_number];
+    }
+};
+
+// Logs the statistics of a validated level and reports its validations to the current metrics
+// as "validations.level_<level number>"
 template <typename VertexAndAgreeSet, typename InstanceValidations>
 void LogLevel(std::vector<VertexAndAgreeSet> const& cur_level_vertices,
               InstanceValidations const& result, size_t candidates, size_t current_level_number,
@@ -42,6 +67,9 @@ void LogLevel(std::vector<VertexAndAgreeSet> const& cur_level_vertices,
               << result.CountValidations() << " validations; " << num_invalid_instances
               << " invalid; " << candidates << " new candidates; --> " << num_valid_instances << " "
               << primitive << "s";
+    if (auto* metrics = ::util::GetCurrentMetricHandles<LevelValidationsMetrics>()) {
+        metrics->Get(current_level_number).Add(result.CountValidations());
+    }
 }
 
 template <typename T>
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <chrono>
 #include <memory>
+#include <string_view>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -12,39 +13,68 @@
 
 #include "algorithms/fd/hycommon/preprocessor.h"
 #include "algorithms/fd/hycommon/util/pli_util.h"
+#include "config/thread_number/option.h"
 #include "inductor.h"
 #include "sampler.h"
+#include "util/metrics.h"
 #include "validator.h"
 
+namespace {
+
+constexpr std::string_view kFdTreeBytesMetric = "hyfd.fd_tree_bytes";
+
+}  // namespace
+
 namespace algos::hyfd {
 
 HyFD::HyFD(std::optional<ColumnLayoutRelationDataManager> relation_manager)
-    : PliBasedFDAlgorithm({}, relation_manager) {}
+    : PliBasedFDAlgorithm({}, relation_manager) {
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
+    RegisterBudgetOptions();
+}
+
+void HyFD::MakeExecuteOptsAvailableFDInternal() {
+    MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
+    MakeBudgetOptionsAvailable();
+}
 
 unsigned long long HyFD::ExecuteInternal() {
     using namespace hy;
     LOG(TRACE) << "Executing";
     auto const start_time = std::chrono::system_clock::now();
 
-    auto [plis, pli_records, og_mapping] = Preprocess(relation_.get());
+    auto [plis, pli_records, og_mapping] = Preprocess(relation_.get(), threads_num_);
     auto const plis_shared = std::make_shared<PLIs>(std::move(plis));
     auto const pli_records_shared = std::make_shared<Rows>(std::move(pli_records));
 
-    Sampler sampler(plis_shared, pli_records_shared);
+    Sampler sampler(plis_shared, pli_records_shared, threads_num_);
 
     auto const positive_cover_tree =
             std::make_shared<fd_tree::FDTree>(GetRelation().GetNumColumns());
-    Inductor inductor(positive_cover_tree);
-    Validator validator(positive_cover_tree, plis_shared, pli_records_shared);
+    auto is_cancelled = [this] { return IsCancelled(); };
+    Inductor inductor(positive_cover_tree, is_cancelled);
+    Validator validator(positive_cover_tree, plis_shared, pli_records_shared, is_cancelled);
 
     IdPairs comparison_suggestions;
 
     while (true) {
+        if (IsBudgetExceeded()) {
+            // Only the levels the validator has gone through hold on the whole table
+            auto fds = positive_cover_tree->FillFDs();
+            std::erase_if(fds, [&validator](RawFD const& fd) {
+                return fd.lhs_.count() >= validator.GetLevelNum();
+            });
+            RegisterFDs(std::move(fds), og_mapping);
+        }
+        CheckCancellation();
         auto non_fds = sampler.GetNonFDs(comparison_suggestions);
 
         inductor.UpdateFdTree(std::move(non_fds));
 
         comparison_suggestions = validator.ValidateAndExtendCandidates();
+        // The inductor and the validator stop early once the run is cancelled, the FDs of the
+        // validated levels are registered above then
+        if (IsCancelled()) continue;
 
         if (comparison_suggestions.empty()) {
             break;
@@ -53,6 +83,7 @@ unsigned long long HyFD::ExecuteInternal() {
         LOG(TRACE) << "Cycle done";
     }
 
+    ::util::AddToCounter(kFdTreeBytesMetric, positive_cover_tree->GetMemoryUsage());
     auto fds = positive_cover_tree->FillFDs();
     RegisterFDs(std::move(fds), og_mapping);
 
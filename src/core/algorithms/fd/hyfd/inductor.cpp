@@ -9,6 +9,8 @@ void Inductor::UpdateFdTree(NonFDList&& non_fds) {
 
     for (unsigned level = max_level; level != 0; level--) {
         for (auto const& lhs_bits : non_fds.GetLevel(level)) {
+            // The tree is left with unvalidated candidates, as it is after any update
+            if (is_cancelled_()) return;
             auto rhs_bits = lhs_bits;
             rhs_bits.flip();
 
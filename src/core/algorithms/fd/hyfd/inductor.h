@@ -1,5 +1,9 @@
 #pragma once
 
+#include <functional>
+#include <memory>
+#include <utility>
+
 #include <boost/dynamic_bitset.hpp>
 
 #include "algorithms/fd/hyfd/model/fd_tree.h"
@@ -10,11 +14,15 @@ namespace algos::hyfd {
 class Inductor {
 private:
     std::shared_ptr<fd_tree::FDTree> tree_;
+    // Polled between the non-FDs, the update stops once it returns true
+    std::function<bool()> is_cancelled_;
 
     void SpecializeTreeForNonFd(boost::dynamic_bitset<> const& lhs_bits, size_t rhs_id);
 
 public:
-    explicit Inductor(std::shared_ptr<fd_tree::FDTree> tree) noexcept : tree_(std::move(tree)) {}
+    explicit Inductor(std::shared_ptr<fd_tree::FDTree> tree,
+                      std::function<bool()> is_cancelled = [] { return false; }) noexcept
+        : tree_(std::move(tree)), is_cancelled_(std::move(is_cancelled)) {}
 
     void UpdateFdTree(NonFDList&& non_fds);
 };
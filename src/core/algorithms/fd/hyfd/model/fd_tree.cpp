@@ -1,47 +1,149 @@
 #include "fd_tree.h"
 
-#include <memory>
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <stdexcept>
 #include <vector>
 
 #include <boost/dynamic_bitset.hpp>
 
 namespace algos::hyfd::fd_tree {
 
-std::shared_ptr<FDTreeVertex> FDTree::AddFD(boost::dynamic_bitset<> const& lhs, size_t rhs) {
-    FDTreeVertex* cur_node = root_.get();
-    cur_node->SetAttribute(rhs);
+FDTree::FDTree(size_t num_attributes)
+    : num_attributes_(num_attributes),
+      num_blocks_((num_attributes + kBitsPerBlock - 1) / kBitsPerBlock) {
+    [[maybe_unused]] VertexId const root = NewVertex();
+    assert(root == kRoot);
+    for (size_t id = 0; id < num_attributes; id++) {
+        SetFd(kRoot, id);
+    }
+}
+
+VertexId FDTree::NewVertex() {
+    if (!free_vertices_.empty()) {
+        VertexId const vertex = free_vertices_.back();
+        free_vertices_.pop_back();
+        vertices_[vertex] = {};
+        std::fill_n(GetBits(vertex), 2 * num_blocks_, Block{0});
+        return vertex;
+    }
+    if (vertices_.size() == kNoVertex) {
+        throw std::length_error("FD tree has too many nodes");
+    }
+    VertexId const vertex = vertices_.size();
+    vertices_.emplace_back();
+    bits_.resize(bits_.size() + 2 * num_blocks_);
+    return vertex;
+}
+
+void FDTree::FreeSubtree(VertexId vertex) {
+    for (Child const& child : GetChildren(vertex)) {
+        FreeSubtree(child.vertex);
+    }
+    FreeChildren(vertices_[vertex]);
+    free_vertices_.push_back(vertex);
+}
+
+std::uint32_t FDTree::AllocateChildren(std::uint32_t capacity) {
+    size_t const size_class = std::countr_zero(capacity);
+    if (size_class < free_children_.size() && !free_children_[size_class].empty()) {
+        std::uint32_t const begin = free_children_[size_class].back();
+        free_children_[size_class].pop_back();
+        return begin;
+    }
+    if (children_.size() + capacity > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::length_error("FD tree has too many nodes");
+    }
+    std::uint32_t const begin = children_.size();
+    children_.resize(children_.size() + capacity);
+    return begin;
+}
+
+void FDTree::FreeChildren(Vertex const& vertex) {
+    if (vertex.children_capacity == 0) return;
+    size_t const size_class = std::countr_zero(vertex.children_capacity);
+    if (free_children_.size() <= size_class) {
+        free_children_.resize(size_class + 1);
+    }
+    free_children_[size_class].push_back(vertex.children_begin);
+}
+
+std::pair<VertexId, bool> FDTree::AddChild(VertexId vertex, size_t pos) {
+    std::span<Child const> const children = GetChildren(vertex);
+    auto const it = std::lower_bound(
+            children.begin(), children.end(), pos,
+            [](Child const& child, size_t child_pos) { return child.pos < child_pos; });
+    if (it != children.end() && it->pos == pos) {
+        return {it->vertex, false};
+    }
+    size_t const index = it - children.begin();
+
+    VertexId const child = NewVertex();
+    Vertex& v = vertices_[vertex];
+    if (v.num_children == v.children_capacity) {
+        std::uint32_t const capacity = v.children_capacity == 0 ? 1 : 2 * v.children_capacity;
+        std::uint32_t const begin = AllocateChildren(capacity);
+        std::copy_n(children_.begin() + v.children_begin, v.num_children,
+                    children_.begin() + begin);
+        FreeChildren(v);
+        v.children_begin = begin;
+        v.children_capacity = capacity;
+    }
+    Child* const first = children_.data() + v.children_begin;
+    std::copy_backward(first + index, first + v.num_children, first + v.num_children + 1);
+    first[index] = {static_cast<std::uint32_t>(pos), child};
+    ++v.num_children;
+    return {child, true};
+}
+
+VertexId FDTree::GetChild(VertexId vertex, size_t pos) const noexcept {
+    std::span<Child const> const children = GetChildren(vertex);
+    auto const it = std::lower_bound(
+            children.begin(), children.end(), pos,
+            [](Child const& child, size_t child_pos) { return child.pos < child_pos; });
+    return it != children.end() && it->pos == pos ? it->vertex : kNoVertex;
+}
+
+bool FDTree::HasAttributes(VertexId vertex) const noexcept {
+    Block const* const attributes = GetBits(vertex) + num_blocks_;
+    return std::any_of(attributes, attributes + num_blocks_,
+                       [](Block block) { return block != 0; });
+}
+
+VertexId FDTree::AddFD(boost::dynamic_bitset<> const& lhs, size_t rhs) {
+    VertexId cur_node = kRoot;
+    SetAttribute(cur_node, rhs);
 
     for (size_t bit = lhs.find_first(); bit != boost::dynamic_bitset<>::npos;
          bit = lhs.find_next(bit)) {
-        bool is_new = cur_node->AddChild(bit);
+        auto const [child, is_new] = AddChild(cur_node, bit);
 
         if (is_new && lhs.find_next(bit) == boost::dynamic_bitset<>::npos) {
-            auto added_node = cur_node->GetChildPtr(bit);
-            added_node->SetAttribute(rhs);
-            added_node->SetFd(rhs);
-            return added_node;
+            SetAttribute(child, rhs);
+            SetFd(child, rhs);
+            return child;
         }
 
-        cur_node = cur_node->GetChild(bit);
-        cur_node->SetAttribute(rhs);
+        cur_node = child;
+        SetAttribute(cur_node, rhs);
     }
-    cur_node->SetFd(rhs);
-    return nullptr;
+    SetFd(cur_node, rhs);
+    return kNoVertex;
 }
 
-bool FDTree::ContainsFD(boost::dynamic_bitset<> const& lhs, size_t rhs) {
-    FDTreeVertex const* cur_node = root_.get();
+bool FDTree::ContainsFD(boost::dynamic_bitset<> const& lhs, size_t rhs) const {
+    VertexId cur_node = kRoot;
 
     for (size_t bit = lhs.find_first(); bit != boost::dynamic_bitset<>::npos;
          bit = lhs.find_next(bit)) {
-        if (!cur_node->HasChildren() || !cur_node->ContainsChildAt(bit)) {
+        cur_node = GetChild(cur_node, bit);
+        if (cur_node == kNoVertex) {
             return false;
         }
-
-        cur_node = cur_node->GetChild(bit);
     }
 
-    return cur_node->IsFd(rhs);
+    return IsFd(cur_node, rhs);
 }
 
 std::vector<boost::dynamic_bitset<>> FDTree::GetFdAndGenerals(boost::dynamic_bitset<> const& lhs,
@@ -49,20 +151,173 @@ std::vector<boost::dynamic_bitset<>> FDTree::GetFdAndGenerals(boost::dynamic_bit
     assert(lhs.count() != 0);
 
     std::vector<boost::dynamic_bitset<>> result;
-    boost::dynamic_bitset<> const empty_lhs(GetNumAttributes());
-    size_t const starting_bit = lhs.find_first();
+    boost::dynamic_bitset<> cur_lhs(GetNumAttributes());
+    GetFdAndGeneralsRecursive(kRoot, lhs, cur_lhs, rhs, lhs.find_first(), result);
+    return result;
+}
 
-    root_->GetFdAndGeneralsRecursive(lhs, empty_lhs, rhs, starting_bit, result);
+void FDTree::GetFdAndGeneralsRecursive(VertexId vertex, boost::dynamic_bitset<> const& lhs,
+                                       boost::dynamic_bitset<>& cur_lhs, size_t rhs,
+                                       size_t cur_bit,
+                                       std::vector<boost::dynamic_bitset<>>& result) const {
+    if (IsFd(vertex, rhs)) {
+        result.push_back(cur_lhs);
+    }
 
-    return result;
+    if (vertices_[vertex].num_children == 0) {
+        return;
+    }
+
+    for (; cur_bit != boost::dynamic_bitset<>::npos; cur_bit = lhs.find_next(cur_bit)) {
+        VertexId const child = GetChild(vertex, cur_bit);
+        if (child != kNoVertex && IsAttribute(child, rhs)) {
+            cur_lhs.set(cur_bit);
+            GetFdAndGeneralsRecursive(child, lhs, cur_lhs, rhs, lhs.find_next(cur_bit), result);
+            cur_lhs.reset(cur_bit);
+        }
+    }
+}
+
+bool FDTree::FindFdOrGeneralRecursive(VertexId vertex, boost::dynamic_bitset<> const& lhs,
+                                      size_t rhs, size_t cur_bit) const {
+    if (IsFd(vertex, rhs)) {
+        return true;
+    }
+
+    if (vertices_[vertex].num_children == 0) {
+        return false;
+    }
+
+    for (; cur_bit != boost::dynamic_bitset<>::npos; cur_bit = lhs.find_next(cur_bit)) {
+        VertexId const child = GetChild(vertex, cur_bit);
+        if (child != kNoVertex && IsAttribute(child, rhs) &&
+            FindFdOrGeneralRecursive(child, lhs, rhs, lhs.find_next(cur_bit))) {
+            return true;
+        }
+    }
+    return false;
 }
 
-std::vector<LhsPair> FDTree::GetLevel(unsigned target_level) {
-    boost::dynamic_bitset<> const empty_lhs(GetNumAttributes());
+bool FDTree::RemoveRecursive(VertexId vertex, boost::dynamic_bitset<> const& lhs, size_t rhs,
+                             size_t current_lhs_attr) {
+    if (current_lhs_attr == boost::dynamic_bitset<>::npos) {
+        RemoveFd(vertex, rhs);
+        RemoveAttribute(vertex, rhs);
+        return true;
+    }
+
+    VertexId const child = GetChild(vertex, current_lhs_attr);
+    if (child != kNoVertex) {
+        if (!RemoveRecursive(child, lhs, rhs, lhs.find_next(current_lhs_attr))) {
+            return false;
+        }
+
+        if (!HasAttributes(child)) {
+            Vertex& v = vertices_[vertex];
+            Child* const first = children_.data() + v.children_begin;
+            Child* const last = first + v.num_children;
+            Child* const removed = std::find_if(
+                    first, last, [child](Child const& c) { return c.vertex == child; });
+            std::copy(removed + 1, last, removed);
+            --v.num_children;
+            FreeSubtree(child);
+        }
+    }
+
+    if (IsLastNodeOf(vertex, rhs)) {
+        RemoveAttribute(vertex, rhs);
+        return true;
+    }
+    return false;
+}
+
+bool FDTree::IsLastNodeOf(VertexId vertex, size_t rhs) const noexcept {
+    if (IsFd(vertex, rhs)) {
+        return false;
+    }
+    std::span<Child const> const children = GetChildren(vertex);
+    return std::none_of(children.begin(), children.end(),
+                        [this, rhs](Child const& child) { return IsAttribute(child.vertex, rhs); });
+}
+
+std::vector<LhsPair> FDTree::GetLevel(unsigned target_level) const {
+    boost::dynamic_bitset<> lhs(GetNumAttributes());
 
     std::vector<LhsPair> vertices;
-    root_->GetLevelRecursive(target_level, 0, empty_lhs, vertices);
+    GetLevelRecursive(kRoot, target_level, 0, lhs, vertices);
     return vertices;
 }
 
+void FDTree::GetLevelRecursive(VertexId vertex, unsigned target_level, unsigned cur_level,
+                               boost::dynamic_bitset<>& lhs,
+                               std::vector<LhsPair>& vertices) const {
+    if (cur_level == target_level) {
+        vertices.emplace_back(vertex, lhs);
+        return;
+    }
+
+    for (Child const& child : GetChildren(vertex)) {
+        lhs.set(child.pos);
+        GetLevelRecursive(child.vertex, target_level, cur_level + 1, lhs, vertices);
+        lhs.reset(child.pos);
+    }
+}
+
+std::vector<LhsPair> FDTree::GetNextLevel(std::vector<LhsPair> const& level) const {
+    std::vector<LhsPair> next_level;
+    for (auto const& [vertex, lhs] : level) {
+        for (Child const& child : GetChildren(vertex)) {
+            boost::dynamic_bitset<> child_lhs = lhs;
+            child_lhs.set(child.pos);
+            next_level.emplace_back(child.vertex, std::move(child_lhs));
+        }
+    }
+    return next_level;
+}
+
+std::vector<RawFD> FDTree::FillFDs() const {
+    std::vector<RawFD> result;
+    boost::dynamic_bitset<> lhs_for_traverse(GetNumAttributes());
+    FillFDs(kRoot, result, lhs_for_traverse);
+    return result;
+}
+
+void FDTree::FillFDs(VertexId vertex, std::vector<RawFD>& fds,
+                     boost::dynamic_bitset<>& lhs) const {
+    Block const* const bits = GetBits(vertex);
+    for (size_t i = 0; i != num_blocks_; ++i) {
+        for (Block block = bits[i]; block != 0; block &= block - 1) {
+            fds.emplace_back(lhs, i * kBitsPerBlock + std::countr_zero(block));
+        }
+    }
+
+    for (Child const& child : GetChildren(vertex)) {
+        lhs.set(child.pos);
+        FillFDs(child.vertex, fds, lhs);
+        lhs.reset(child.pos);
+    }
+}
+
+boost::dynamic_bitset<> FDTree::GetFds(VertexId vertex) const {
+    Block const* const bits = GetBits(vertex);
+    boost::dynamic_bitset<> fds(bits, bits + num_blocks_);
+    fds.resize(num_attributes_);
+    return fds;
+}
+
+void FDTree::SetFds(VertexId vertex, boost::dynamic_bitset<> const& fds) {
+    assert(fds.size() == num_attributes_);
+    boost::to_block_range(fds, GetBits(vertex));
+}
+
+size_t FDTree::GetMemoryUsage() const noexcept {
+    size_t size = vertices_.capacity() * sizeof(Vertex) + bits_.capacity() * sizeof(Block) +
+                  children_.capacity() * sizeof(Child) +
+                  free_vertices_.capacity() * sizeof(VertexId);
+    for (std::vector<std::uint32_t> const& free_children : free_children_) {
+        size += free_children.capacity() * sizeof(std::uint32_t);
+    }
+    return size;
+}
+
 }  // namespace algos::hyfd::fd_tree
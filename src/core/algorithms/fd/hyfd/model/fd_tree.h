@@ -1,55 +1,157 @@
 #pragma once
 
-#include <memory>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
 #include <vector>
 
 #include <boost/dynamic_bitset.hpp>
 
 #include "algorithms/fd/raw_fd.h"
-#include "fd_tree_vertex.h"
 
 namespace algos::hyfd::fd_tree {
 
+/**
+ * Handle of an FD tree node, stays valid until the node is removed.
+ */
+using VertexId = std::uint32_t;
+
+/**
+ * Pair of a handle of an FD tree node and the corresponding LHS.
+ */
+using LhsPair = std::pair<VertexId, boost::dynamic_bitset<>>;
+
 /**
  * FD prefix tree.
  *
- * Provides global tree manipulation and traversing methods.
+ * LHS of an FD is represented by the path to a node, the path is built in ascending order, i.e.
+ * LHS {0, 1} can be obtained by getting child with position 0, then its child with position 1. If
+ * we go first to child 1, it will not contain child 0. RHSs of the FDs are the fds of the node.
  *
- * @see FDTreeVertex
+ * Nodes are stored in arenas and referred to by their indices. The fds and the union of the RHSs
+ * of the subtree (attributes) of every node are fixed-width bitsets stored side by side in one
+ * array. Only the existing children are stored, sorted by position, in blocks of power of two
+ * sizes taken from a shared pool. Freed nodes and blocks are reused.
  */
 class FDTree {
+public:
+    static constexpr VertexId kRoot = 0;
+    static constexpr VertexId kNoVertex = std::numeric_limits<VertexId>::max();
+
+    struct Child {
+        std::uint32_t pos;
+        VertexId vertex;
+    };
+
 private:
-    std::shared_ptr<FDTreeVertex> root_;
+    using Block = boost::dynamic_bitset<>::block_type;
+    static constexpr size_t kBitsPerBlock = boost::dynamic_bitset<>::bits_per_block;
+
+    struct Vertex {
+        std::uint32_t children_begin = 0;
+        std::uint32_t num_children = 0;
+        std::uint32_t children_capacity = 0;
+    };
+
+    size_t num_attributes_;
+    size_t num_blocks_;
+
+    std::vector<Vertex> vertices_;
+    /* fds followed by attributes of every vertex */
+    std::vector<Block> bits_;
+    std::vector<Child> children_;
+    std::vector<VertexId> free_vertices_;
+    /* Free blocks of children of size 2^i */
+    std::vector<std::vector<std::uint32_t>> free_children_;
+
+    Block* GetBits(VertexId vertex) noexcept {
+        return bits_.data() + 2 * num_blocks_ * vertex;
+    }
 
-public:
-    explicit FDTree(size_t num_attributes) : root_(std::make_shared<FDTreeVertex>(num_attributes)) {
-        for (size_t id = 0; id < num_attributes; id++) {
-            root_->SetFd(id);
-        }
+    Block const* GetBits(VertexId vertex) const noexcept {
+        return bits_.data() + 2 * num_blocks_ * vertex;
     }
 
-    [[nodiscard]] size_t GetNumAttributes() const noexcept {
-        return root_->GetNumAttributes();
+    static bool Test(Block const* bits, size_t pos) noexcept {
+        return (bits[pos / kBitsPerBlock] >> (pos % kBitsPerBlock)) & 1;
+    }
+
+    static void Set(Block* bits, size_t pos) noexcept {
+        bits[pos / kBitsPerBlock] |= Block{1} << (pos % kBitsPerBlock);
     }
 
-    std::shared_ptr<FDTreeVertex> GetRootPtr() noexcept {
-        return root_;
+    static void Reset(Block* bits, size_t pos) noexcept {
+        bits[pos / kBitsPerBlock] &= ~(Block{1} << (pos % kBitsPerBlock));
     }
 
-    [[nodiscard]] FDTreeVertex const& GetRoot() const noexcept {
-        return *root_;
+    bool IsAttribute(VertexId vertex, size_t pos) const noexcept {
+        return Test(GetBits(vertex) + num_blocks_, pos);
+    }
+
+    void SetAttribute(VertexId vertex, size_t pos) noexcept {
+        Set(GetBits(vertex) + num_blocks_, pos);
+    }
+
+    void RemoveAttribute(VertexId vertex, size_t pos) noexcept {
+        Reset(GetBits(vertex) + num_blocks_, pos);
+    }
+
+    bool HasAttributes(VertexId vertex) const noexcept;
+
+    void SetFd(VertexId vertex, size_t pos) noexcept {
+        Set(GetBits(vertex), pos);
+    }
+
+    VertexId NewVertex();
+    void FreeSubtree(VertexId vertex);
+    std::uint32_t AllocateChildren(std::uint32_t capacity);
+    void FreeChildren(Vertex const& vertex);
+
+    /**
+     * Constructs empty child node at the given position if there is no such child.
+     *
+     * @return the child and whether it was constructed
+     */
+    std::pair<VertexId, bool> AddChild(VertexId vertex, size_t pos);
+
+    void GetLevelRecursive(VertexId vertex, unsigned target_level, unsigned cur_level,
+                           boost::dynamic_bitset<>& lhs, std::vector<LhsPair>& vertices) const;
+
+    void GetFdAndGeneralsRecursive(VertexId vertex, boost::dynamic_bitset<> const& lhs,
+                                   boost::dynamic_bitset<>& cur_lhs, size_t rhs, size_t cur_bit,
+                                   std::vector<boost::dynamic_bitset<>>& result) const;
+
+    bool FindFdOrGeneralRecursive(VertexId vertex, boost::dynamic_bitset<> const& lhs, size_t rhs,
+                                  size_t cur_bit) const;
+
+    bool RemoveRecursive(VertexId vertex, boost::dynamic_bitset<> const& lhs, size_t rhs,
+                         size_t current_lhs_attr);
+
+    bool IsLastNodeOf(VertexId vertex, size_t rhs) const noexcept;
+
+    void FillFDs(VertexId vertex, std::vector<RawFD>& fds, boost::dynamic_bitset<>& lhs) const;
+
+public:
+    explicit FDTree(size_t num_attributes);
+
+    [[nodiscard]] size_t GetNumAttributes() const noexcept {
+        return num_attributes_;
     }
 
-    std::shared_ptr<FDTreeVertex> AddFD(boost::dynamic_bitset<> const& lhs, size_t rhs);
+    /**
+     * @return the node of the LHS if it was created, kNoVertex otherwise
+     */
+    VertexId AddFD(boost::dynamic_bitset<> const& lhs, size_t rhs);
 
-    bool ContainsFD(boost::dynamic_bitset<> const& lhs, size_t rhs);
+    bool ContainsFD(boost::dynamic_bitset<> const& lhs, size_t rhs) const;
 
     /**
      * Recursively finds node representing given lhs and removes given rhs bit from it.
-     * Destroys vertices whose children became empty.
+     * Destroys vertices whose subtrees have no FDs left.
      */
     void Remove(boost::dynamic_bitset<> const& lhs, size_t rhs) {
-        root_->RemoveRecursive(lhs, rhs, lhs.find_first());
+        RemoveRecursive(kRoot, lhs, rhs, lhs.find_first());
     }
 
     /**
@@ -62,24 +164,54 @@ public:
      * Checks if any FD has at least given lhs and rhs.
      */
     [[nodiscard]] bool FindFdOrGeneral(boost::dynamic_bitset<> const& lhs, size_t rhs) const {
-        return root_->FindFdOrGeneralRecursive(lhs, rhs, lhs.find_first());
+        return FindFdOrGeneralRecursive(kRoot, lhs, rhs, lhs.find_first());
     }
 
     /**
      * Gets nodes representing FDs with LHS of given arity.
      * @param target_level arity of returned FDs LHSs
      */
-    std::vector<LhsPair> GetLevel(unsigned target_level);
+    [[nodiscard]] std::vector<LhsPair> GetLevel(unsigned target_level) const;
+
+    /**
+     * Gets the children of the nodes, the next level of the tree traversal.
+     */
+    [[nodiscard]] std::vector<LhsPair> GetNextLevel(std::vector<LhsPair> const& level) const;
 
     /**
      * @return vector of all FDs
      */
-    [[nodiscard]] std::vector<RawFD> FillFDs() const {
-        std::vector<RawFD> result;
-        boost::dynamic_bitset<> lhs_for_traverse(GetRoot().GetNumAttributes());
-        GetRoot().FillFDs(result, lhs_for_traverse);
-        return result;
+    [[nodiscard]] std::vector<RawFD> FillFDs() const;
+
+    [[nodiscard]] boost::dynamic_bitset<> GetFds(VertexId vertex) const;
+
+    /**
+     * Replaces stored RHS with provided one.
+     */
+    void SetFds(VertexId vertex, boost::dynamic_bitset<> const& fds);
+
+    void RemoveFd(VertexId vertex, size_t pos) noexcept {
+        Reset(GetBits(vertex), pos);
+    }
+
+    [[nodiscard]] bool IsFd(VertexId vertex, size_t pos) const noexcept {
+        return Test(GetBits(vertex), pos);
+    }
+
+    [[nodiscard]] std::span<Child const> GetChildren(VertexId vertex) const noexcept {
+        Vertex const& v = vertices_[vertex];
+        return {children_.data() + v.children_begin, v.num_children};
     }
+
+    /**
+     * @return the child at the position or kNoVertex
+     */
+    [[nodiscard]] VertexId GetChild(VertexId vertex, size_t pos) const noexcept;
+
+    /**
+     * Bytes allocated for the nodes
+     */
+    [[nodiscard]] size_t GetMemoryUsage() const noexcept;
 };
 
 }  // namespace algos::hyfd::fd_tree
@@ -1,6 +1,7 @@
 #pragma once
 #include "algorithms/fd/hycommon/sampler.h"
 #include "algorithms/fd/hyfd/model/non_fd_list.h"
+#include "config/thread_number/type.h"
 
 namespace algos::hyfd {
 
@@ -9,8 +10,8 @@ private:
     hy::Sampler sampler_;
 
 public:
-    Sampler(hy::PLIsPtr plis, hy::RowsPtr pli_records)
-        : sampler_(std::move(plis), std::move(pli_records)) {}
+    Sampler(hy::PLIsPtr plis, hy::RowsPtr pli_records, config::ThreadNumType threads = 1)
+        : sampler_(std::move(plis), std::move(pli_records), threads) {}
 
     NonFDList GetNonFDs(hy::IdPairs const& comparison_suggestions) {
         return sampler_.GetAgreeSets(comparison_suggestions);
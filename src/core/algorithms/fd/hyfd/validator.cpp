@@ -9,6 +9,7 @@
 #include <boost/dynamic_bitset.hpp>
 #include <easylogging++.h>
 
+#include "algorithms/fd/hycommon/compressed_records.h"
 #include "algorithms/fd/hycommon/util/pli_util.h"
 #include "algorithms/fd/hycommon/validator_helpers.h"
 #include "hyfd_config.h"
@@ -28,7 +29,7 @@ std::pair<std::vector<size_t>, std::vector<size_t>> BuildRhsMappings(
         boost::dynamic_bitset<> const& rhs, algos::hy::Rows const& compressed_records) {
     std::vector<size_t> rhs_column_ids;
     rhs_column_ids.reserve(rhs.count());
-    std::vector<size_t> rhs_ranks(compressed_records[0].size());
+    std::vector<size_t> rhs_ranks(compressed_records.GetNumColumns());
 
     for (size_t attr = rhs.find_first(); attr != boost::dynamic_bitset<>::npos;
          attr = rhs.find_next(attr)) {
@@ -47,7 +48,7 @@ void ValidateRhss(RhsRowId const& rhs_record, algos::hy::Rows const& compressed_
                   algos::hy::IdPairs& comparison_suggestions) {
     for (auto it = valid_rhs_ids.begin(); it != valid_rhs_ids.end();) {
         size_t const rhs_column = *it;
-        size_t const value = compressed_records[row][rhs_column];
+        size_t const value = compressed_records.Get(row, rhs_column);
 
         if (algos::hy::PLIUtil::IsSingletonCluster(value) ||
             value != rhs_record.first[rhs_ranks[rhs_column]]) {
@@ -67,7 +68,7 @@ RhsRowId BuildRhsRowId(algos::hy::Rows const& compressed_records,
                        std::vector<size_t> const& rhs_column_ids, size_t row) {
     std::vector<size_t> rhs_sub_cluster(rhs.count());
     for (size_t i = 0; i < rhs.count(); ++i) {
-        rhs_sub_cluster[i] = compressed_records[row][rhs_column_ids[i]];
+        rhs_sub_cluster[i] = compressed_records.Get(row, rhs_column_ids[i]);
     }
 
     return std::make_pair(std::move(rhs_sub_cluster), row);
@@ -87,7 +88,7 @@ boost::dynamic_bitset<> Refine(algos::hy::IdPairs& comparison_suggestions,
 
         for (size_t row : cluster) {
             auto lhs_row =
-                    algos::hy::BuildClustersIdentifier(compressed_records[row], lhs_column_ids);
+                    algos::hy::BuildClustersIdentifier(compressed_records, row, lhs_column_ids);
             if (lhs_row.empty()) {
                 continue;
             }
@@ -114,9 +115,13 @@ size_t AddExtendedCandidatesFromInvalid(std::vector<algos::hyfd::LhsPair>& next_
     size_t candidates = 0;
     for (auto const& [lhs, rhs] : invalid_fds) {
         for (size_t attr = 0; attr < num_attributes; ++attr) {
-            if (lhs.test(attr) || rhs == attr || fds_tree.FindFdOrGeneral(lhs, attr) ||
-                (fds_tree.GetRoot().HasChildren() && fds_tree.GetRoot().ContainsChildAt(attr) &&
-                 fds_tree.GetRoot().GetChild(attr)->IsFd(rhs))) {
+            if (lhs.test(attr) || rhs == attr || fds_tree.FindFdOrGeneral(lhs, attr)) {
+                continue;
+            }
+            algos::hyfd::fd_tree::VertexId const root_child =
+                    fds_tree.GetChild(algos::hyfd::fd_tree::FDTree::kRoot, attr);
+            if (root_child != algos::hyfd::fd_tree::FDTree::kNoVertex &&
+                fds_tree.IsFd(root_child, rhs)) {
                 continue;
             }
 
@@ -127,11 +132,11 @@ size_t AddExtendedCandidatesFromInvalid(std::vector<algos::hyfd::LhsPair>& next_
                 continue;
             }
 
-            auto child = fds_tree.AddFD(lhs_ext, rhs);
-            if (child == nullptr) {
+            algos::hyfd::fd_tree::VertexId const child = fds_tree.AddFD(lhs_ext, rhs);
+            if (child == algos::hyfd::fd_tree::FDTree::kNoVertex) {
                 continue;
             }
-            next_level.emplace_back(std::move(child), std::move(lhs_ext));
+            next_level.emplace_back(child, std::move(lhs_ext));
             candidates++;
         }
     }
@@ -145,9 +150,9 @@ namespace algos::hyfd {
 Validator::FDValidations Validator::ProcessZeroLevel(LhsPair const& lhsPair) {
     FDValidations result;
 
-    auto vertex = lhsPair.first;
+    fd_tree::VertexId const vertex = lhsPair.first;
     auto const lhs = lhsPair.second;
-    auto const rhs = vertex->GetFDs();
+    auto const rhs = fds_->GetFds(vertex);
     size_t const rhs_count = rhs.count();
 
     result.SetCountValidations(rhs_count);
@@ -156,7 +161,7 @@ Validator::FDValidations Validator::ProcessZeroLevel(LhsPair const& lhsPair) {
     for (size_t attr = rhs.find_first(); attr != boost::dynamic_bitset<>::npos;
          attr = rhs.find_next(attr)) {
         if (!(*plis_)[attr]->IsConstant()) {
-            vertex->RemoveFd(attr);
+            fds_->RemoveFd(vertex, attr);
             result.InvalidInstances().emplace_back(lhs, attr);
         }
     }
@@ -165,9 +170,9 @@ Validator::FDValidations Validator::ProcessZeroLevel(LhsPair const& lhsPair) {
 }
 
 Validator::FDValidations Validator::ProcessFirstLevel(LhsPair const& lhs_pair) {
-    auto vertex = lhs_pair.first;
+    fd_tree::VertexId const vertex = lhs_pair.first;
     auto const lhs = lhs_pair.second;
-    auto const rhs = vertex->GetFDs();
+    auto const rhs = fds_->GetFds(vertex);
     size_t const rhs_count = rhs.count();
 
     size_t const lhs_attr = lhs.find_first();
@@ -182,12 +187,12 @@ Validator::FDValidations Validator::ProcessFirstLevel(LhsPair const& lhs_pair) {
     for (size_t attr = rhs.find_first(); attr != boost::dynamic_bitset<>::npos;
          attr = rhs.find_next(attr)) {
         for (auto const& cluster : (*plis_)[lhs_attr]->GetIndex()) {
-            size_t const cluster_id = (*compressed_records_)[cluster[0]][attr];
+            size_t const cluster_id = compressed_records_->Get(cluster[0], attr);
             if (algos::hy::PLIUtil::IsSingletonCluster(cluster_id) ||
                 std::any_of(cluster.cbegin(), cluster.cend(), [this, attr, cluster_id](int id) {
-                    return (*compressed_records_)[id][attr] != cluster_id;
+                    return compressed_records_->Get(id, attr) != cluster_id;
                 })) {
-                vertex->RemoveFd(attr);
+                fds_->RemoveFd(vertex, attr);
                 result.InvalidInstances().emplace_back(lhs, attr);
                 break;
             }
@@ -197,9 +202,9 @@ Validator::FDValidations Validator::ProcessFirstLevel(LhsPair const& lhs_pair) {
 }
 
 Validator::FDValidations Validator::ProcessHigherLevel(LhsPair const& lhs_pair) {
-    auto vertex = lhs_pair.first;
+    fd_tree::VertexId const vertex = lhs_pair.first;
     auto lhs = lhs_pair.second;
-    auto rhs = vertex->GetFDs();
+    auto rhs = fds_->GetFds(vertex);
     size_t const rhs_count = rhs.count();
 
     if (rhs_count == 0) {
@@ -218,7 +223,7 @@ Validator::FDValidations Validator::ProcessHigherLevel(LhsPair const& lhs_pair)
     lhs.set(first_attr);
 
     rhs &= ~valid_rhss;
-    vertex->SetFds(valid_rhss);
+    fds_->SetFds(vertex, valid_rhss);
 
     for (size_t attr = rhs.find_first(); attr != boost::dynamic_bitset<>::npos;
          attr = rhs.find_next(attr)) {
@@ -256,7 +261,7 @@ algos::hy::IdPairs Validator::ValidateAndExtendCandidates() {
     if (current_level_number_ != 0) {
         cur_level_vertices = fds_->GetLevel(current_level_number_);
     } else {
-        cur_level_vertices.emplace_back(fds_->GetRootPtr(),
+        cur_level_vertices.emplace_back(fd_tree::FDTree::kRoot,
                                         boost::dynamic_bitset<>(num_attributes));
     }
 
@@ -272,8 +277,7 @@ algos::hy::IdPairs Validator::ValidateAndExtendCandidates() {
             break;
         }
 
-        std::vector<LhsPair> next_level =
-                algos::hy::CollectCurrentChildren(cur_level_vertices, num_attributes);
+        std::vector<LhsPair> next_level = fds_->GetNextLevel(cur_level_vertices);
         size_t candidates = AddExtendedCandidatesFromInvalid(
                 next_level, *fds_, result.InvalidInstances(), num_attributes);
         algos::hy::LogLevel(cur_level_vertices, result, candidates, current_level_number_, "FD");
@@ -283,6 +287,11 @@ algos::hy::IdPairs Validator::ValidateAndExtendCandidates() {
         cur_level_vertices = std::move(next_level);
         current_level_number_++;
 
+        if (is_cancelled_()) {
+            // The next call goes on from the next level
+            return comparison_suggestions;
+        }
+
         if (num_invalid_fds > (long double)hyfd::HyFDConfig::kEfficiencyThreshold * num_valid_fds &&
             previous_num_invalid_fds < num_invalid_fds) {
             return comparison_suggestions;
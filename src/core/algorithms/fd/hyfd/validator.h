@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -22,6 +23,8 @@ private:
 
     hy::PLIsPtr plis_;
     hy::RowsPtr compressed_records_;
+    // Polled between the levels, the validation stops once it returns true
+    std::function<bool()> is_cancelled_;
 
     unsigned current_level_number_ = 0;
 
@@ -33,18 +36,21 @@ private:
 
     FDValidations ValidateAndExtendSeq(std::vector<LhsPair> const& vertices);
 
-    [[nodiscard]] unsigned GetLevelNum() const {
-        return current_level_number_;
-    }
-
 public:
     Validator(std::shared_ptr<fd_tree::FDTree> fds, hy::PLIsPtr plis,
-              hy::RowsPtr compressed_records) noexcept
+              hy::RowsPtr compressed_records,
+              std::function<bool()> is_cancelled = [] { return false; }) noexcept
         : fds_(std::move(fds)),
           plis_(std::move(plis)),
-          compressed_records_(std::move(compressed_records)) {}
+          compressed_records_(std::move(compressed_records)),
+          is_cancelled_(std::move(is_cancelled)) {}
 
     hy::IdPairs ValidateAndExtendCandidates();
+
+    // FDs with fewer LHS columns than this have been validated
+    [[nodiscard]] unsigned GetLevelNum() const {
+        return current_level_number_;
+    }
 };
 
 }  // namespace algos::hyfd
@@ -6,6 +6,7 @@
 #include "config/tabular_data/input_table_type.h"
 #include "fd_algorithm.h"
 #include "model/table/column_layout_relation_data.h"
+#include "model/table/dataset_cache.h"
 
 namespace algos {
 
@@ -27,8 +28,8 @@ public:
 
         std::shared_ptr<ColumnLayoutRelationData> GetRelation() const {
             if (*relation_ == nullptr)
-                *relation_ =
-                        ColumnLayoutRelationData::CreateFrom(**input_table_, *is_null_equal_null_);
+                *relation_ = model::DatasetCache::Instance().GetRelation(**input_table_,
+                                                                         *is_null_equal_null_);
             return *relation_;
         }
     };
@@ -1,5 +1,6 @@
 #include "pyro.h"
 
+#include <atomic>
 #include <chrono>
 #include <mutex>
 #include <thread>
@@ -33,11 +34,13 @@ void Pyro::RegisterOptions() {
     RegisterOption(config::kErrorOpt(&parameters_.max_ucc_error));
     RegisterOption(config::kThreadNumberOpt(&parameters_.parallelism));
     RegisterOption(Option{&parameters_.seed, kSeed, kDSeed, 0});
+    RegisterBudgetOptions();
 }
 
 void Pyro::MakeExecuteOptsAvailableFDInternal() {
     using namespace config::names;
     MakeOptionsAvailable({config::kErrorOpt.GetName(), config::kThreadNumberOpt.GetName(), kSeed});
+    MakeBudgetOptionsAvailable();
 }
 
 void Pyro::ResetStateFd() {
@@ -62,6 +65,7 @@ unsigned long long Pyro::ExecuteInternal() {
         throw std::runtime_error("Unknown comparator type");
     }
 
+    auto is_cancelled = [this] { return IsCancelled(); };
     int next_id = 0;
     for (auto& rhs : schema->GetColumns()) {
         std::unique_ptr<DependencyStrategy> strategy;
@@ -71,8 +75,8 @@ unsigned long long Pyro::ExecuteInternal() {
         } else {
             throw std::runtime_error("Unknown key error measure.");
         }
-        search_spaces_.push_back(std::make_unique<SearchSpace>(next_id++, std::move(strategy),
-                                                               schema, launch_pad_order));
+        search_spaces_.push_back(std::make_unique<SearchSpace>(
+                next_id++, std::move(strategy), schema, launch_pad_order, is_cancelled));
     }
     unsigned long long init_time_millis = std::chrono::duration_cast<std::chrono::milliseconds>(
                                                   std::chrono::system_clock::now() - start_time)
@@ -84,10 +88,14 @@ unsigned long long Pyro::ExecuteInternal() {
     unsigned long long total_trickle = 0;
     double progress_step = 100.0 / search_spaces_.size();
 
+    // Threads left without search spaces run tasks of the others until the last one is done
+    std::atomic<int> num_busy_threads = parameters_.parallelism;
     auto const work_on_search_space =
-            [this, &progress_step](std::list<std::unique_ptr<SearchSpace>>& search_spaces,
-                                   ProfilingContext* profiling_context, int id) {
-                while (true) {
+            [this, &progress_step, &num_busy_threads](
+                    std::list<std::unique_ptr<SearchSpace>>& search_spaces,
+                    ProfilingContext* profiling_context, int id) {
+                util::MetricsScope metrics_scope(&GetRunMetrics());
+                while (!IsCancelled()) {
                     std::unique_ptr<SearchSpace> polled_space;
                     {
                         std::scoped_lock<std::mutex> lock(search_spaces_mutex);
@@ -103,6 +111,11 @@ unsigned long long Pyro::ExecuteInternal() {
                     polled_space->Discover();
                     AddProgress(progress_step);
                 }
+                if (--num_busy_threads == 0) {
+                    profiling_context->GetTaskPool().Close();
+                } else {
+                    profiling_context->GetTaskPool().Help();
+                }
             };
 
     std::vector<std::thread> threads;
@@ -114,6 +127,7 @@ unsigned long long Pyro::ExecuteInternal() {
     for (int i = 0; i < parameters_.parallelism; i++) {
         threads[i].join();
     }
+    CheckCancellation();
 
     SetProgress(100);
     auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -125,7 +139,11 @@ unsigned long long Pyro::ExecuteInternal() {
     LOG(INFO) << "Error calculation count: " << total_error_calc_count;
     LOG(INFO) << "Total ascension time: " << total_ascension << "ms";
     LOG(INFO) << "Total trickle time: " << total_trickle << "ms";
-    LOG(INFO) << "Total intersection time: " << model::PositionListIndex::micros_ / 1000 << "ms";
+    auto const intersection_time =
+            GetRunMetrics().GetTimerValue(model::PositionListIndex::kIntersectionTimeMetric).total;
+    LOG(INFO) << "Total intersection time: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(intersection_time).count()
+              << "ms";
     LOG(INFO) << "HASH: " << PliBasedFDAlgorithm::Fletcher16();
     return elapsed_milliseconds.count();
 }
@@ -1,4 +1,6 @@
 #pragma once
+#include <atomic>
+
 #include "dependency_candidate.h"
 #include "dependency_consumer.h"
 #include "model/table/vertical.h"
@@ -17,7 +19,8 @@ public:
     double min_non_dependency_error_;
     double max_dependency_error_;
     ProfilingContext* context_;
-    mutable unsigned int calc_count_ = 0;
+    // errors of one search space may be calculated by several threads
+    mutable std::atomic<unsigned int> calc_count_ = 0;
     /*
      * Create the initial candidate for the given SearchSpace
      * */
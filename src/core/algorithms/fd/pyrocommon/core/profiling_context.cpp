@@ -1,5 +1,6 @@
 #include "profiling_context.h"
 
+#include <algorithm>
 #include <utility>
 
 #include <easylogging++.h>
@@ -20,7 +21,8 @@ ProfilingContext::ProfilingContext(algos::pyro::Parameters parameters,
     : parameters_(std::move(parameters)),
       relation_data_(relation_data),
       random_(parameters_.seed == 0 ? std::mt19937() : std::mt19937(parameters_.seed)),
-      custom_random_(parameters_.seed == 0 ? CustomRandom() : CustomRandom(parameters_.seed)) {
+      custom_random_(parameters_.seed == 0 ? CustomRandom() : CustomRandom(parameters_.seed)),
+      task_pool_(std::min(parameters_.parallelism, parameters_.max_threads_per_search_space)) {
     ucc_consumer_ = ucc_consumer;
     fd_consumer_ = fd_consumer;
     // TODO: тут проявляется косяк, что unique_ptr<PLI> приходится отбирать у CLRD.
@@ -138,6 +140,13 @@ double ProfilingContext::SetMaximumEntropy(ColumnLayoutRelationData const* relat
 
 model::AgreeSetSample const* ProfilingContext::CreateFocusedSample(Vertical const& focus,
                                                                    double boost_factor) {
+    // Search spaces share the context, so another one may have sampled this focus already
+    if (shared_ptr<model::AgreeSetSample const> existing = agree_set_samples_->Get(focus);
+        existing != nullptr &&
+        (existing->IsExact() ||
+         existing->GetSampleSize() >= parameters_.sample_size * boost_factor)) {
+        return existing.get();
+    }
     auto pli = pli_cache_->GetOrCreateFor(focus, this);
     auto pli_pointer = std::holds_alternative<model::PositionListIndex*>(pli)
                                ? std::get<model::PositionListIndex*>(pli)
@@ -10,6 +10,7 @@
 #include "caching_method.h"
 #include "dependency_consumer.h"
 #include "parameters.h"
+#include "task_pool.h"
 #include "util/custom_random.h"
 
 namespace model {
@@ -31,6 +32,7 @@ private:
     ColumnLayoutRelationData* relation_data_;
     std::mt19937 random_;
     CustomRandom custom_random_;
+    TaskPool task_pool_;
 
     model::AgreeSetSample const* CreateColumnFocusedSample(
             Vertical const& focus, model::PositionListIndex const* restriction_pli,
@@ -49,6 +51,11 @@ public:
     model::AgreeSetSample const* CreateFocusedSample(Vertical const& focus, double boost_factor);
     std::shared_ptr<model::AgreeSetSample const> GetAgreeSetSample(Vertical const& focus) const;
 
+    /* Pool for the tasks a search space splits its work into, shared by all search spaces */
+    TaskPool& GetTaskPool() {
+        return task_pool_;
+    }
+
     model::PLICache* GetPliCache() {
         return pli_cache_.get();
     }
@@ -1,6 +1,8 @@
 #include "search_space.h"
 
+#include <optional>
 #include <queue>
+#include <vector>
 
 #include <easylogging++.h>
 
@@ -9,7 +11,7 @@
 
 void SearchSpace::Discover() {
     LOG(TRACE) << "Discovering in: " << static_cast<std::string>(*strategy_);
-    while (true) {  // на второй итерации дропается
+    while (!is_cancelled_()) {  // на второй итерации дропается
         auto now = std::chrono::system_clock::now();
         std::optional<DependencyCandidate> launch_pad = PollLaunchPad();
         if (!launch_pad.has_value()) break;
@@ -170,6 +172,8 @@ bool SearchSpace::Ascend(DependencyCandidate const& launch_pad) {
     boost::optional<double> error;
 
     while (true) {
+        // The launch pad is deferred, as it is when no dependency is found
+        if (is_cancelled_()) return false;
         LOG(TRACE) << boost::format{"-> %1%"} % traversal_candidate.vertical_.ToString();
 
         if (context_->GetParameters().is_check_estimates) {
@@ -217,8 +221,7 @@ bool SearchSpace::Ascend(DependencyCandidate const& launch_pad) {
             break;
         }
 
-        boost::optional<DependencyCandidate> next_candidate;
-        int num_seen_elements = is_ascend_randomly_ ? 1 : -1;
+        std::vector<Vertical> extended_verticals;
         for (auto& extension_column : context_->GetSchema()->GetColumns()) {
             if (traversal_candidate.vertical_.GetColumnIndices()[extension_column->GetIndex()] ||
                 strategy_->IsIrrelevantColumn(*extension_column)) {
@@ -235,10 +238,14 @@ bool SearchSpace::Ascend(DependencyCandidate const& launch_pad) {
             if (is_subset_pruned) {
                 continue;
             }
-            LOG(TRACE) << "CreateDependencyCandidate while ascending";
-            DependencyCandidate extended_candidate =
-                    strategy_->CreateDependencyCandidate(extended_vertical);
+            extended_verticals.push_back(std::move(extended_vertical));
+        }
+        std::vector<DependencyCandidate> extended_candidates =
+                CreateDependencyCandidates(extended_verticals, strategy_.get());
 
+        boost::optional<DependencyCandidate> next_candidate;
+        int num_seen_elements = is_ascend_randomly_ ? 1 : -1;
+        for (auto& extended_candidate : extended_candidates) {
             if (!next_candidate ||
                 (num_seen_elements == -1 &&
                  extended_candidate.error_.GetMean() < next_candidate->error_.GetMean()) ||
@@ -323,6 +330,8 @@ void SearchSpace::TrickleDown(Vertical const& main_peak, double main_peak_error)
     auto now = std::chrono::system_clock::now();
 
     while (!peaks.empty()) {
+        // The alleged minimum dependencies are not registered until the peaks are exhausted
+        if (is_cancelled_()) return;
         auto peak = peaks.front();
 
         auto subset_deps = GetSubsetDeps(peak.vertical_, alleged_min_deps.get());
@@ -421,6 +430,7 @@ void SearchSpace::TrickleDown(Vertical const& main_peak, double main_peak_error)
         throw std::runtime_error("Main peak should contain all alleged max non-dependencies");
     }
 
+    std::vector<Vertical> unknown_max_non_deps;
     for (auto& alleged_max_non_dep : alleged_max_non_deps) {
         if (alleged_max_non_dep.GetArity() == 0) continue;
 
@@ -429,11 +439,25 @@ void SearchSpace::TrickleDown(Vertical const& main_peak, double main_peak_error)
             IsKnownNonDependency(alleged_max_non_dep, global_visitees_.get())) {
             continue;
         }
+        unknown_max_non_deps.push_back(alleged_max_non_dep);
+    }
+
+    // The errors are independent, so they are calculated in parallel and then checked in order
+    std::vector<double> errors(unknown_max_non_deps.size());
+    context_->GetTaskPool().ParallelFor(errors.size(), [this, &unknown_max_non_deps,
+                                                         &errors](size_t i) {
+        errors[i] = context_->GetParameters().is_estimate_only
+                            ? strategy_->CreateDependencyCandidate(unknown_max_non_deps[i])
+                                      .error_.GetMean()
+                            : strategy_->CalculateError(unknown_max_non_deps[i]);
+    });
+
+    for (size_t i = 0; i < unknown_max_non_deps.size(); ++i) {
+        Vertical const& alleged_max_non_dep = unknown_max_non_deps[i];
+        double error = errors[i];
+        // A non-dependency found in this loop may imply the current one
+        if (IsKnownNonDependency(alleged_max_non_dep, local_visitees_.get())) continue;
 
-        double error =
-                context_->GetParameters().is_estimate_only
-                        ? strategy_->CreateDependencyCandidate(alleged_max_non_dep).error_.GetMean()
-                        : strategy_->CalculateError(alleged_max_non_dep);
         bool is_non_dep = error > strategy_->min_non_dependency_error_;
         LOG(TRACE) << boost::
                                       format{"* Alleged maximal non-dependency %1%: non-dep?: %2%, "
@@ -483,7 +507,7 @@ void SearchSpace::TrickleDown(Vertical const& main_peak, double main_peak_error)
         auto nested_search_space = std::make_unique<SearchSpace>(
                 -1, strategy_->CreateClone(), std::move(new_scope), std::move(global_visitees_),
                 context_->GetSchema(), launch_pads_.key_comp(), recursion_depth_ + 1,
-                sample_boost_ * context_->GetParameters().sample_booster);
+                sample_boost_ * context_->GetParameters().sample_booster, is_cancelled_);
         nested_search_space->SetContext(context_);
 
         std::unordered_set<Column> scope_columns;
@@ -513,6 +537,8 @@ void SearchSpace::TrickleDown(Vertical const& main_peak, double main_peak_error)
                                         .count();
         global_visitees_ = nested_search_space->MoveOutGlobalVisitees();
         local_visitees_ = nested_search_space->MoveOutLocalVisitees();
+        // A stopped nested search does not confirm the alleged minimum dependencies
+        if (is_cancelled_()) return;
 
         for (auto& [alleged_min_dep, info] : alleged_min_deps->EntrySet()) {
             if (!IsImpliedByMinDep(alleged_min_dep, global_visitees_.get())) {
@@ -548,6 +574,7 @@ std::optional<Vertical> SearchSpace::TrickleDownFrom(
                 parent_candidates([](auto& candidate1, auto& candidate2) {
                     return DependencyCandidate::MinErrorComparator(candidate1, candidate2);
                 });
+        std::vector<Vertical> parent_verticals;
         for (auto& parent_vertical : min_dep_candidate.vertical_.GetParents()) {
             if (IsKnownNonDependency(parent_vertical, local_visitees_.get()) ||
                 IsKnownNonDependency(parent_vertical, global_visitees))
@@ -556,12 +583,14 @@ std::optional<Vertical> SearchSpace::TrickleDownFrom(
                 are_all_parents_known_non_deps = false;
                 continue;
             }
-            // TODO: construction methods should return unique_ptr<...>
-            LOG(TRACE) << "CreateDependencyCandidate while trickling down from";
-            parent_candidates.push(strategy->CreateDependencyCandidate(parent_vertical));
+            parent_verticals.push_back(std::move(parent_vertical));
+        }
+        for (auto& parent_candidate : CreateDependencyCandidates(parent_verticals, strategy)) {
+            parent_candidates.push(std::move(parent_candidate));
         }
 
         while (!parent_candidates.empty()) {
+            if (is_cancelled_()) return std::optional<Vertical>();
             auto parent_candidate = parent_candidates.top();
             parent_candidates.pop();
 
@@ -642,6 +671,21 @@ std::optional<Vertical> SearchSpace::TrickleDownFrom(
     }
 }
 
+std::vector<DependencyCandidate> SearchSpace::CreateDependencyCandidates(
+        std::vector<Vertical> const& verticals, DependencyStrategy const* strategy) const {
+    std::vector<std::optional<DependencyCandidate>> candidates(verticals.size());
+    context_->GetTaskPool().ParallelFor(verticals.size(), [&](size_t i) {
+        LOG(TRACE) << "CreateDependencyCandidate for " << verticals[i].ToString();
+        candidates[i] = strategy->CreateDependencyCandidate(verticals[i]);
+    });
+    std::vector<DependencyCandidate> result;
+    result.reserve(candidates.size());
+    for (auto& candidate : candidates) {
+        result.push_back(std::move(*candidate));
+    }
+    return result;
+}
+
 void SearchSpace::RequireMinimalDependency(DependencyStrategy* strategy,
                                            Vertical const& min_dependency) {
     double error = strategy->CalculateError(min_dependency);
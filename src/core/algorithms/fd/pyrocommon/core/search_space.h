@@ -1,9 +1,11 @@
 #pragma once
 
+#include <functional>
 #include <list>
 #include <memory>
 #include <set>
 #include <utility>
+#include <vector>
 
 #include "dependency_candidate.h"
 #include "dependency_strategy.h"
@@ -28,6 +30,9 @@ private:
     double sample_boost_;
     int recursion_depth_;
     bool is_ascend_randomly_ = false;
+    // Polled between the launch pads and the visited candidates, the discovery stops once it
+    // returns true. Only the dependencies known to be minimal are registered by then.
+    std::function<bool()> is_cancelled_;
 
     int num_nested_ = 0;
 
@@ -62,6 +67,10 @@ private:
         local_visitees_ = std::move(local_visitees);
     }
 
+    /* Estimates the candidates on the task pool of the context, keeping the order of verticals */
+    std::vector<DependencyCandidate> CreateDependencyCandidates(
+            std::vector<Vertical> const& verticals, DependencyStrategy const* strategy) const;
+
     static void RequireMinimalDependency(DependencyStrategy* strategy,
                                          Vertical const& min_dependency);
     static std::vector<Vertical> GetSubsetDeps(Vertical const& vertical,
@@ -90,7 +99,7 @@ public:
                 std::unique_ptr<model::VerticalMap<VerticalInfo>> global_visitees,
                 RelationalSchema const* schema,
                 DependencyCandidateComp const& dependency_candidate_comparator, int recursion_depth,
-                double sample_boost)
+                double sample_boost, std::function<bool()> is_cancelled = [] { return false; })
         : strategy_(std::move(strategy)),
           global_visitees_(std::move(global_visitees)),
           launch_pads_(dependency_candidate_comparator),
@@ -98,14 +107,16 @@ public:
           scope_(std::move(scope)),
           sample_boost_(sample_boost),
           recursion_depth_(recursion_depth),
+          is_cancelled_(std::move(is_cancelled)),
           id_(id) {}
 
     SearchSpace(int id, std::unique_ptr<DependencyStrategy> strategy,
                 RelationalSchema const* schema,
-                DependencyCandidateComp const& dependency_candidate_comparator)
+                DependencyCandidateComp const& dependency_candidate_comparator,
+                std::function<bool()> is_cancelled = [] { return false; })
         : SearchSpace(id, std::move(strategy), nullptr,
                       std::make_unique<model::VerticalMap<VerticalInfo>>(schema), schema,
-                      dependency_candidate_comparator, 0, 1) {}
+                      dependency_candidate_comparator, 0, 1, std::move(is_cancelled)) {}
 
     void EnsureInitialized();
     void Discover();
@@ -0,0 +1,57 @@
+#include "task_pool.h"
+
+#include <utility>
+
+void TaskPool::RunTask(std::unique_lock<std::mutex>& lock) {
+    Task task = std::move(tasks_.front());
+    tasks_.pop_front();
+    lock.unlock();
+    std::exception_ptr exception;
+    try {
+        task.function();
+    } catch (...) {
+        exception = std::current_exception();
+    }
+    lock.lock();
+    if (exception != nullptr && task.group->exception == nullptr) {
+        task.group->exception = exception;
+    }
+    if (--task.group->num_pending == 0) {
+        state_changed_.notify_all();
+    }
+}
+
+void TaskPool::WaitFor(Group const& group) {
+    std::unique_lock lock(mutex_);
+    while (group.num_pending != 0) {
+        if (!tasks_.empty()) {
+            RunTask(lock);
+        } else {
+            state_changed_.wait(lock);
+        }
+    }
+    if (group.exception != nullptr) {
+        std::rethrow_exception(group.exception);
+    }
+}
+
+void TaskPool::Help() {
+    std::unique_lock lock(mutex_);
+    while (true) {
+        if (!tasks_.empty()) {
+            RunTask(lock);
+        } else if (is_closed_) {
+            return;
+        } else {
+            state_changed_.wait(lock);
+        }
+    }
+}
+
+void TaskPool::Close() {
+    {
+        std::scoped_lock lock(mutex_);
+        is_closed_ = true;
+    }
+    state_changed_.notify_all();
+}
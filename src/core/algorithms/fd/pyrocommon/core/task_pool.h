@@ -0,0 +1,72 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <utility>
+
+/* Queue of fine-grained tasks shared by all threads working on search spaces. A thread waiting for
+ * its tasks runs queued ones, whoever submitted them, and threads left without search spaces help
+ * the others until Close() is called, so a single hard search space still keeps all threads busy */
+class TaskPool {
+private:
+    struct Group {
+        std::size_t num_pending;
+        std::exception_ptr exception;
+    };
+
+    struct Task {
+        std::function<void()> function;
+        Group* group;
+    };
+
+    std::size_t num_threads_;
+    std::mutex mutex_;
+    std::condition_variable state_changed_;
+    std::deque<Task> tasks_;
+    bool is_closed_ = false;
+
+    /* Runs the first queued task with the lock released, the lock is held again on return */
+    void RunTask(std::unique_lock<std::mutex>& lock);
+    void WaitFor(Group const& group);
+
+public:
+    explicit TaskPool(std::size_t num_threads)
+        : num_threads_(std::max<std::size_t>(num_threads, 1)) {}
+
+    /* Calls f(i) for every i in [0, size), split into at most num_threads tasks, and returns when
+     * all calls are done. Runs sequentially in the calling thread if there is only one thread.
+     * Rethrows the first exception thrown by f */
+    template <typename F>
+    void ParallelFor(std::size_t size, F const& f) {
+        std::size_t const num_tasks = std::min(size, num_threads_);
+        if (num_tasks <= 1) {
+            for (std::size_t i = 0; i < size; ++i) f(i);
+            return;
+        }
+        Group group{num_tasks, nullptr};
+        {
+            std::scoped_lock lock(mutex_);
+            for (std::size_t task = 0; task < num_tasks; ++task) {
+                std::size_t const begin = size * task / num_tasks;
+                std::size_t const end = size * (task + 1) / num_tasks;
+                auto run_range = [&f, begin, end]() {
+                    for (std::size_t i = begin; i < end; ++i) f(i);
+                };
+                tasks_.push_back({std::move(run_range), &group});
+            }
+        }
+        state_changed_.notify_all();
+        WaitFor(group);
+    }
+
+    /* Runs queued tasks until Close() is called */
+    void Help();
+
+    /* Makes helping threads return once the queue is empty */
+    void Close();
+};
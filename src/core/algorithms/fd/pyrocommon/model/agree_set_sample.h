@@ -10,6 +10,7 @@
 #include "confidence_interval.h"
 #include "model/table/column_layout_relation_data.h"
 #include "model/table/vertical.h"
+#include "util/custom_hashes.h"
 #include "util/custom_random.h"
 
 namespace model {
@@ -32,6 +33,10 @@ public:
         return sample_size_ / static_cast<double>(population_size_);
     }
 
+    unsigned int GetSampleSize() const {
+        return sample_size_;
+    }
+
     bool IsExact() const {
         return population_size_ == sample_size_;
     }
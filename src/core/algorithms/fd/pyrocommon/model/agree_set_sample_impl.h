@@ -18,7 +18,7 @@ std::unique_ptr<T> AgreeSetSample::CreateFor(ColumnLayoutRelationData* relation_
     std::mt19937 gen(rd());
     std::uniform_int_distribution<> random(0, relation_data->GetNumRows());
 
-    std::unordered_map<boost::dynamic_bitset<>, int> agree_set_counters;
+    std::unordered_map<boost::dynamic_bitset<>, int, util::BitsetHash> agree_set_counters;
     sample_size = std::min((unsigned long long)sample_size, relation_data->GetNumTuplePairs());
 
     for (long i = 0; i < sample_size; i++) {
@@ -68,7 +68,7 @@ std::unique_ptr<T> AgreeSetSample::CreateFocusedFor(ColumnLayoutRelationData con
         relevant_column_data.emplace_back(relation->GetColumnData(column_index));
     }
     boost::dynamic_bitset<> agree_set_prototype(restriction_vertical.GetColumnIndices());
-    std::unordered_map<boost::dynamic_bitset<>, int> agree_set_counters;
+    std::unordered_map<boost::dynamic_bitset<>, int, util::BitsetHash> agree_set_counters;
 
     unsigned long long restriction_nep = restriction_pli->GetNepAsLong();
     sample_size = std::min(static_cast<unsigned long long>(sample_size), restriction_nep);
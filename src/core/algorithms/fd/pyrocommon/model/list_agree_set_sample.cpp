@@ -1,6 +1,55 @@
 #include "list_agree_set_sample.h"
 
-#include <easylogging++.h>
+#include <cassert>
+#include <limits>
+
+namespace {
+
+using Word = std::uint64_t;
+
+static_assert(std::numeric_limits<boost::dynamic_bitset<>::block_type>::digits ==
+              std::numeric_limits<Word>::digits);
+
+struct SupersetCounts {
+    unsigned long long agreeing = 0;
+    unsigned long long agreeing_and_disagreeing = 0;
+};
+
+/* Row r agrees if it contains all bits of agree_mask and disagrees if it contains none of
+ * disagree_mask. Both loops are branch-free so that they are vectorized */
+SupersetCounts CountSingleWord(Word const* agree_sets, unsigned long long const* counts,
+                               std::size_t num_rows, Word agree_mask, Word disagree_mask) {
+    SupersetCounts result;
+    for (std::size_t row = 0; row < num_rows; ++row) {
+        Word const agree_set = agree_sets[row];
+        unsigned long long const agrees = ((agree_set & agree_mask) ^ agree_mask) == 0;
+        unsigned long long const disagrees = (agree_set & disagree_mask) == 0;
+        result.agreeing += counts[row] & -agrees;
+        result.agreeing_and_disagreeing += counts[row] & -(agrees & disagrees);
+    }
+    return result;
+}
+
+SupersetCounts CountMultiWord(Word const* agree_sets, unsigned long long const* counts,
+                              std::size_t num_rows, std::size_t num_words,
+                              Word const* agree_mask, Word const* disagree_mask) {
+    SupersetCounts result;
+    for (std::size_t row = 0; row < num_rows; ++row, agree_sets += num_words) {
+        Word missing = 0;
+        Word conflicting = 0;
+        for (std::size_t word = 0; word < num_words; ++word) {
+            missing |= (agree_sets[word] & agree_mask[word]) ^ agree_mask[word];
+            conflicting |= agree_sets[word] & disagree_mask[word];
+        }
+        unsigned long long const agrees = missing == 0;
+        unsigned long long const disagrees = conflicting == 0;
+        result.agreeing += counts[row] & -agrees;
+        result.agreeing_and_disagreeing += counts[row] & -(agrees & disagrees);
+    }
+    return result;
+}
+
+}  // namespace
 
 namespace model {
 
@@ -13,128 +62,66 @@ std::unique_ptr<ListAgreeSetSample> ListAgreeSetSample::CreateFocusedFor(
 
 std::unique_ptr<std::vector<unsigned long long>> ListAgreeSetSample::BitSetToLongLongVector(
         boost::dynamic_bitset<> const& bitset) {
-    auto result = std::make_unique<std::vector<unsigned long long>>(
-            std::vector<unsigned long long>((bitset.size() + 63) / 64, 0));
-    for (size_t i = 0; i < bitset.size(); i++) {
-        // idea is: long long ~ 64 bits. shift i-th bit in the bitset i mod 64 times and set the
-        // corresponding bit
-        (*result)[i / 64] |= bitset[i] << i % 64;
-    }
+    auto result = std::make_unique<std::vector<unsigned long long>>(bitset.num_blocks());
+    boost::to_block_range(bitset, result->begin());
     return result;
 }
 
 ListAgreeSetSample::ListAgreeSetSample(
         ColumnLayoutRelationData const* relation, Vertical const& focus, unsigned int sample_size,
         unsigned long long population_size,
-        std::unordered_map<boost::dynamic_bitset<>, int> const& agree_set_counters)
-    : AgreeSetSample(relation, focus, sample_size, population_size) {
-    for (auto& el : agree_set_counters) {
-        agree_set_counters_.emplace_back(Entry(BitSetToLongLongVector(el.first), el.second));
+        std::unordered_map<boost::dynamic_bitset<>, int, util::BitsetHash> const&
+                agree_set_counters)
+    : AgreeSetSample(relation, focus, sample_size, population_size),
+      num_words_(focus.GetColumnIndicesRef().num_blocks()) {
+    agree_sets_.resize(agree_set_counters.size() * num_words_);
+    counts_.reserve(agree_set_counters.size());
+    auto row = agree_sets_.begin();
+    for (auto const& [agree_set, count] : agree_set_counters) {
+        assert(agree_set.num_blocks() == num_words_);
+        boost::to_block_range(agree_set, row);
+        row += num_words_;
+        counts_.push_back(count);
     }
 }
 
-unsigned long long ListAgreeSetSample::GetNumAgreeSupersets(Vertical const& agreement) const {
-    unsigned long long count = 0;
-    std::vector<unsigned long long> min_agree_set =
-            *BitSetToLongLongVector(agreement.GetColumnIndices());
-
-    for (auto const& agree_set_counter : agree_set_counters_) {
-        std::vector<unsigned long long> agree_set = *agree_set_counter.agree_set;
-        unsigned int i = 0;
-        unsigned int min_fields = std::min(agree_set.size(), min_agree_set.size());
-        while (i < min_fields) {
-            if ((agree_set[i] & min_agree_set[i]) != min_agree_set[i]) goto Entries;
-            i++;
-        }
-        while (i < min_agree_set.size()) {
-            if (min_agree_set[i] != 0) goto Entries;
-            i++;
+std::pair<unsigned long long, unsigned long long> ListAgreeSetSample::CountAgreeSupersets(
+        Vertical const& agreement, Vertical const* disagreement) const {
+    boost::dynamic_bitset<> const& agree_columns = agreement.GetColumnIndicesRef();
+    assert(agree_columns.num_blocks() == num_words_);
+    SupersetCounts counts;
+    if (num_words_ == 1) {
+        Word const agree_mask = agree_columns.to_ulong();
+        Word const disagree_mask =
+                disagreement == nullptr ? 0 : disagreement->GetColumnIndicesRef().to_ulong();
+        counts = CountSingleWord(agree_sets_.data(), counts_.data(), counts_.size(), agree_mask,
+                                 disagree_mask);
+    } else {
+        // Masks are reused across queries of the thread
+        thread_local std::vector<Word> masks;
+        masks.assign(2 * num_words_, 0);
+        boost::to_block_range(agree_columns, masks.begin());
+        if (disagreement != nullptr) {
+            boost::to_block_range(disagreement->GetColumnIndicesRef(), masks.begin() + num_words_);
         }
-        count += agree_set_counter.count;
-    Entries:
-        continue;
+        counts = CountMultiWord(agree_sets_.data(), counts_.data(), counts_.size(), num_words_,
+                                masks.data(), masks.data() + num_words_);
     }
-    return count;
+    return {counts.agreeing, counts.agreeing_and_disagreeing};
+}
+
+unsigned long long ListAgreeSetSample::GetNumAgreeSupersets(Vertical const& agreement) const {
+    return CountAgreeSupersets(agreement, nullptr).first;
 }
 
 unsigned long long ListAgreeSetSample::GetNumAgreeSupersets(Vertical const& agreement,
                                                             Vertical const& disagreement) const {
-    unsigned long long count = 0;
-    std::vector<unsigned long long> min_agree_set =
-            *BitSetToLongLongVector(agreement.GetColumnIndices());
-    std::vector<unsigned long long> min_disagree_set =
-            *BitSetToLongLongVector(disagreement.GetColumnIndices());
-    // std::cout << "-----------------------------------\n";
-    for (auto const& agree_set_counter : agree_set_counters_) {
-        /*for (auto const& el : *agree_set_counter.agreeSet_)
-            std::cout << el << ' ';
-        std::cout << agree_set_counter.count_ << "\n";*/
-        std::vector<unsigned long long> agree_set = *agree_set_counter.agree_set;
-        // check the agreement
-        unsigned int i = 0;
-        unsigned int min_fields = std::min(agree_set.size(), min_agree_set.size());
-        while (i < min_fields) {
-            if ((agree_set[i] & min_agree_set[i]) != min_agree_set[i]) goto Entries;
-            i++;
-        }
-        while (i < min_agree_set.size()) {
-            if (min_agree_set[i] != 0) goto Entries;
-            i++;
-        }
-        // check the disagreement
-        i = 0;
-        min_fields = std::min(agree_set.size(), min_disagree_set.size());
-        while (i < min_fields) {
-            if ((agree_set[i] & min_disagree_set[i]) != 0) goto Entries;
-            i++;
-        }
-
-        count += agree_set_counter.count;
-    Entries:
-        continue;
-    }
-    LOG(DEBUG) << boost::format{"AgreeSetSample for %1% against %2% returned %3% "} %
-                          agreement.ToString() % disagreement.ToString() % count;
-    // std::cout << '\n';
-    //_numQueries
-    //_nanoQueries
-    return count;
+    return CountAgreeSupersets(agreement, &disagreement).second;
 }
 
 std::unique_ptr<std::vector<unsigned long long>> ListAgreeSetSample::GetNumAgreeSupersetsExt(
         Vertical const& agreement, Vertical const& disagreement) const {
-    unsigned long long count = 0, count_agreements = 0;
-    std::vector<unsigned long long> min_agree_set =
-            *BitSetToLongLongVector(agreement.GetColumnIndices());
-    std::vector<unsigned long long> min_disagree_set =
-            *BitSetToLongLongVector(disagreement.GetColumnIndices());
-
-    for (auto const& agree_set_counter : agree_set_counters_) {
-        std::vector<unsigned long long> agree_set = *agree_set_counter.agree_set;
-        // check the agreement
-        unsigned int i = 0;
-        unsigned int min_fields = std::min(agree_set.size(), min_agree_set.size());
-        while (i < min_fields) {
-            if ((agree_set[i] & min_agree_set[i]) != min_agree_set[i]) goto Entries;
-            i++;
-        }
-        while (i < min_agree_set.size()) {
-            if (min_agree_set[i] != 0) goto Entries;
-            i++;
-        }
-        count_agreements += agree_set_counter.count;
-        // check the disagreement
-        i = 0;
-        min_fields = std::min(agree_set.size(), min_disagree_set.size());
-        while (i < min_fields) {
-            if ((agree_set[i] & min_disagree_set[i]) != 0) goto Entries;
-            i++;
-        }
-
-        count += agree_set_counter.count;
-    Entries:
-        continue;
-    }
+    auto [count_agreements, count] = CountAgreeSupersets(agreement, &disagreement);
     return std::make_unique<std::vector<unsigned long long>>(
             std::vector<unsigned long long>{count_agreements, count});
 }
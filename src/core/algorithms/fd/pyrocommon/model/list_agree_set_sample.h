@@ -1,6 +1,6 @@
 #pragma once
 
-#include <map>
+#include <cstdint>
 #include <utility>
 #include <vector>
 
@@ -8,18 +8,21 @@
 
 namespace model {
 
-// TODO: Java long ~ C++ long long => consider replacing ints with longlongs
+/* Sampled agree sets stored as a row-major bit matrix: row i holds the words of the i-th distinct
+ * agree set, counts_[i] is the number of sampled tuple pairs with that agree set. Queries scan the
+ * matrix with branch-free AND/compare loops that the compiler vectorizes and allocate nothing */
 class ListAgreeSetSample : public AgreeSetSample {
 private:
-    struct Entry {
-        unsigned int count;
-        std::shared_ptr<std::vector<unsigned long long>> agree_set;
+    using Word = std::uint64_t;
 
-        Entry(std::shared_ptr<std::vector<unsigned long long>> agree_set, unsigned int count)
-            : count(count), agree_set(std::move(agree_set)) {}
-    };
+    std::size_t num_words_;
+    std::vector<Word> agree_sets_;
+    std::vector<unsigned long long> counts_;
 
-    std::vector<Entry> agree_set_counters_;
+    /* Returns the number of sampled pairs agreeing on all columns of agreement and, if counted
+     * with disagreement, disagreeing on all columns of it */
+    std::pair<unsigned long long, unsigned long long> CountAgreeSupersets(
+            Vertical const& agreement, Vertical const* disagreement) const;
 
 public:
     static std::unique_ptr<std::vector<unsigned long long>> BitSetToLongLongVector(
@@ -32,7 +35,8 @@ public:
 
     ListAgreeSetSample(ColumnLayoutRelationData const* relation, Vertical const& focus,
                        unsigned int sample_size, unsigned long long population_size,
-                       std::unordered_map<boost::dynamic_bitset<>, int> const& agree_set_counters);
+                       std::unordered_map<boost::dynamic_bitset<>, int, util::BitsetHash> const&
+                               agree_set_counters);
 
     unsigned long long GetNumAgreeSupersets(Vertical const& agreement) const override;
     unsigned long long GetNumAgreeSupersets(Vertical const& agreement,
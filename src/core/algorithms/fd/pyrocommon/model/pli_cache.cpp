@@ -1,9 +1,29 @@
 #include "pli_cache.h"
 
+#include <string_view>
+
 #include <boost/optional.hpp>
 #include <easylogging++.h>
 
 #include "model/table/vertical_map.h"
+#include "util/metrics.h"
+
+namespace {
+
+/* Number of requested PLIs served from the cache and computed by intersections */
+constexpr std::string_view kCacheHitsMetric = "pli_cache.hits";
+constexpr std::string_view kCacheMissesMetric = "pli_cache.misses";
+
+struct CacheMetrics {
+    util::MetricCounter& hits;
+    util::MetricCounter& misses;
+
+    explicit CacheMetrics(util::Metrics& metrics)
+        : hits(metrics.GetCounter(kCacheHitsMetric)),
+          misses(metrics.GetCounter(kCacheMissesMetric)) {}
+};
+
+}  // namespace
 
 namespace model {
 
@@ -11,7 +31,7 @@ PositionListIndex* PLICache::Get(Vertical const& vertical) {
     return index_->Get(vertical).get();
 }
 
-PLICache::PLICache(ColumnLayoutRelationData* relation_data, CachingMethod caching_method,
+PLICache::PLICache(ColumnLayoutRelationData const* relation_data, CachingMethod caching_method,
                    CacheEvictionMethod eviction_method, double caching_method_value,
                    double min_entropy, double mean_entropy, double median_entropy,
                    double maximum_entropy, double median_gini, double median_inverted_entropy)
@@ -30,8 +50,10 @@ PLICache::PLICache(ColumnLayoutRelationData* relation_data, CachingMethod cachin
       median_gini_(median_gini),
       median_inverted_entropy_(median_inverted_entropy) {
     for (auto& column_ptr : relation_data->GetSchema()->GetColumns()) {
+        // The cache only reads the PLIs it holds
         index_->Put(static_cast<Vertical>(*column_ptr),
-                    relation_data->GetColumnData(column_ptr->GetIndex()).GetPliOwnership());
+                    std::const_pointer_cast<PositionListIndex>(
+                            relation_data->GetColumnData(column_ptr->GetIndex()).GetPliOwnership()));
     }
 }
 
@@ -46,17 +68,21 @@ PLICache::~PLICache() {
 // obtains or calculates a PositionListIndex using cache
 std::variant<PositionListIndex*, std::unique_ptr<PositionListIndex>> PLICache::GetOrCreateFor(
         Vertical const& vertical, ProfilingContext* profiling_context) {
-    std::scoped_lock lock(getting_pli_mutex_);
+    // The lock guards the choice of operands, intersections run concurrently without it
+    std::unique_lock lock(getting_pli_mutex_);
     LOG(DEBUG) << boost::format{"PLI for %1% requested: "} % vertical.ToString();
 
+    CacheMetrics* metrics = util::GetCurrentMetricHandles<CacheMetrics>();
+
     // is PLI already cached?
     PositionListIndex* pli = Get(vertical);
     if (pli != nullptr) {
-        pli->IncFreq();
+        ++usage_counts_[pli];
+        if (metrics != nullptr) metrics->hits.Add();
         LOG(DEBUG) << boost::format{"Served from PLI cache."};
-        // addToUsageCounter
         return pli;
     }
+    if (metrics != nullptr) metrics->misses.Add();
     // look for cached PLIs to construct the requested one
     auto subset_entries = index_->GetSubsetEntries(vertical);
     boost::optional<PositionListIndexRank> smallest_pli_rank;
@@ -80,7 +106,7 @@ std::variant<PositionListIndex*, std::unique_ptr<PositionListIndex>> PLICache::G
     boost::dynamic_bitset<> cover(relation_data_->GetNumColumns());
     boost::dynamic_bitset<> cover_tester(relation_data_->GetNumColumns());
     if (smallest_pli_rank) {
-        smallest_pli_rank->pli_->IncFreq();
+        ++usage_counts_[smallest_pli_rank->pli_.get()];
         operands.push_back(*smallest_pli_rank);
         cover |= smallest_pli_rank->vertical_->GetColumnIndices();
 
@@ -106,7 +132,7 @@ std::variant<PositionListIndex*, std::unique_ptr<PositionListIndex>> PLICache::G
             }
 
             if (best_rank) {
-                best_rank->pli_->IncFreq();
+                ++usage_counts_[best_rank->pli_.get()];
                 operands.push_back(*best_rank);
                 cover |= best_rank->vertical_->GetColumnIndices();
             }
@@ -121,7 +147,7 @@ std::variant<PositionListIndex*, std::unique_ptr<PositionListIndex>> PLICache::G
             vertical_columns.push_back(std::make_unique<Vertical>(static_cast<Vertical>(*column)));
             auto column_pli = index_->Get(**vertical_columns.rbegin());
             operands.emplace_back(vertical_columns.rbegin()->get(), column_pli, 1);
-            column_pli->IncFreq();
+            ++usage_counts_[column_pli.get()];
         }
     }
     // sort operands by ascending order
@@ -134,6 +160,7 @@ std::variant<PositionListIndex*, std::unique_ptr<PositionListIndex>> PLICache::G
     if (operands.empty()) {
         throw std::logic_error("Current implementation assumes operands.size() > 0");
     }
+    lock.unlock();
 
     // TODO: тут не очень понятно: CachingProcess может забрать себе PLI, а может и отдать обратно,
     //  поэтому приходится через variant разбирать. Проверить, насколько много платим за обёртку.
@@ -171,6 +198,18 @@ std::variant<PositionListIndex*, std::unique_ptr<PositionListIndex>> PLICache::G
     return variant_intersection_pli;
 }
 
+PositionListIndex* PLICache::PutIfAbsent(Vertical const& vertical,
+                                         std::unique_ptr<PositionListIndex> pli) {
+    // Another thread may have cached the same PLI meanwhile. Replacing it would free a PLI that
+    // thread may still use
+    if (PositionListIndex* cached_pli = Get(vertical); cached_pli != nullptr) {
+        return cached_pli;
+    }
+    PositionListIndex* pli_pointer = pli.get();
+    index_->Put(vertical, std::move(pli));
+    return pli_pointer;
+}
+
 size_t PLICache::Size() const {
     return index_->GetSize();
 }
@@ -178,21 +217,19 @@ size_t PLICache::Size() const {
 std::variant<PositionListIndex*, std::unique_ptr<PositionListIndex>> PLICache::CachingProcess(
         Vertical const& vertical, std::unique_ptr<PositionListIndex> pli,
         ProfilingContext* profiling_context) {
-    auto pli_pointer = pli.get();
+    std::scoped_lock lock(getting_pli_mutex_);
     switch (caching_method_) {
         case CachingMethod::kCoin:
             if (profiling_context->NextDouble() <
                 profiling_context->GetParameters().caching_probability) {
-                index_->Put(vertical, std::move(pli));
-                return pli_pointer;
+                return PutIfAbsent(vertical, std::move(pli));
             } else {
                 return pli;
             }
         case CachingMethod::kNoCaching:
             return pli;
         case CachingMethod::kAllCaching:
-            index_->Put(vertical, std::move(pli));
-            return pli_pointer;
+            return PutIfAbsent(vertical, std::move(pli));
         default:
             throw std::runtime_error(
                     "Only kNoCaching and kAllCaching strategies are currently available");
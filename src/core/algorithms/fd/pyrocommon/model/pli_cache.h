@@ -3,6 +3,7 @@
 class ProfilingContext;
 
 #include <mutex>
+#include <unordered_map>
 
 #include "../core/profiling_context.h"
 #include "cache_eviction_method.h"
@@ -25,9 +26,12 @@ private:
     };
 
     // using CacheMap = VerticalMap<PositionListIndex>;
-    ColumnLayoutRelationData* relation_data_;
+    // Shared with other runs through the dataset cache, so neither the relation nor its column
+    // PLIs are modified
+    ColumnLayoutRelationData const* relation_data_;
     std::unique_ptr<VerticalMap<PositionListIndex>> index_;
-    // usageCounter - for parallelism
+    // Number of requests every PLI has served in this run, guarded by getting_pli_mutex_
+    std::unordered_map<PositionListIndex const*, unsigned> usage_counts_;
 
     int saved_intersections_ = 0;
 
@@ -44,12 +48,15 @@ private:
     double median_gini_;
     double median_inverted_entropy_;
 
+    /* Caches the PLI unless the vertical is cached already and returns the cached one */
+    PositionListIndex* PutIfAbsent(Vertical const& vertical,
+                                   std::unique_ptr<PositionListIndex> pli);
     std::variant<PositionListIndex*, std::unique_ptr<PositionListIndex>> CachingProcess(
             Vertical const& vertical, std::unique_ptr<PositionListIndex> pli,
             ProfilingContext* profiling_context);
 
 public:
-    PLICache(ColumnLayoutRelationData* relation_data, CachingMethod caching_method,
+    PLICache(ColumnLayoutRelationData const* relation_data, CachingMethod caching_method,
              CacheEvictionMethod eviction_method, double caching_method_value, double min_entropy,
              double mean_entropy, double median_entropy, double maximum_entropy, double median_gini,
              double median_inverted_entropy);
@@ -1,54 +1,136 @@
 #include "lattice_level.h"
 
 #include <algorithm>
+#include <cassert>
 
 #include <easylogging++.h>
 
+#include "util/custom_hashes.h"
+#include "util/parallel_for.h"
+
 namespace model {
 
-using std::move, std::min, std::shared_ptr, std::vector, std::sort, std::make_shared;
+namespace {
+
+/* Creates the child of vertex1 and vertex2 sharing all columns but the last ones, returns nullptr
+ * if the child is pruned */
+std::unique_ptr<LatticeVertex> CreateChild(LatticeLevel const& level, LatticeVertex* vertex1,
+                                           LatticeVertex* vertex2) {
+    unsigned int arity = level.GetArity();
+    Vertical child_columns = vertex1->GetVertical().Union(vertex2->GetVertical());
+    std::unique_ptr<LatticeVertex> child_vertex = std::make_unique<LatticeVertex>(child_columns);
+
+    boost::dynamic_bitset<> parent_indices(vertex1->GetVertical().GetSchema()->GetNumColumns());
+    parent_indices |= vertex1->GetVertical().GetColumnIndices();
+    parent_indices |= vertex2->GetVertical().GetColumnIndices();
+
+    child_vertex->GetRhsCandidates() |= vertex1->GetRhsCandidates();
+    child_vertex->GetRhsCandidates() &= vertex2->GetRhsCandidates();
+    child_vertex->SetKeyCandidate(vertex1->GetIsKeyCandidate() && vertex2->GetIsKeyCandidate());
+    child_vertex->SetInvalid(vertex1->GetIsInvalid() || vertex2->GetIsInvalid());
+
+    for (unsigned int i = 0, skip_index = parent_indices.find_first(); i < arity - 1;
+         i++, skip_index = parent_indices.find_next(skip_index)) {
+        parent_indices[skip_index] = false;
+        LatticeVertex const* parent_vertex = level.GetLatticeVertex(parent_indices);
+
+        if (parent_vertex == nullptr) {
+            return nullptr;
+        }
+        child_vertex->GetRhsCandidates() &= parent_vertex->GetConstRhsCandidates();
+        if (child_vertex->GetRhsCandidates().none()) {
+            return nullptr;
+        }
+        child_vertex->GetParents().push_back(parent_vertex);
+        parent_indices[skip_index] = true;
+
+        child_vertex->SetKeyCandidate(child_vertex->GetIsKeyCandidate() &&
+                                      parent_vertex->GetIsKeyCandidate());
+        child_vertex->SetInvalid(child_vertex->GetIsInvalid() || parent_vertex->GetIsInvalid());
+
+        if (!child_vertex->GetIsKeyCandidate() && child_vertex->GetRhsCandidates().none()) {
+            return nullptr;
+        }
+    }
+
+    child_vertex->GetParents().push_back(vertex1);
+    child_vertex->GetParents().push_back(vertex2);
+    return child_vertex;
+}
+
+}  // namespace
+
+void LatticeLevel::Rehash(std::size_t num_slots) {
+    index_.assign(num_slots, 0);
+    for (unsigned int position = 0; position < vertices_.size(); ++position) {
+        AddToIndex(position);
+    }
+}
+
+void LatticeLevel::AddToIndex(unsigned int position) {
+    std::size_t const mask = index_.size() - 1;
+    std::size_t slot =
+            util::BitsetHash{}(vertices_[position]->GetVertical().GetColumnIndicesRef()) & mask;
+    while (index_[slot] != 0) {
+        slot = (slot + 1) & mask;
+    }
+    index_[slot] = position + 1;
+}
 
 void LatticeLevel::Add(std::unique_ptr<LatticeVertex> vertex) {
-    vertices_.emplace(vertex->GetVertical().GetColumnIndices(), std::move(vertex));
+    assert(vertices_.empty() || LatticeVertex::Comparator(vertices_.back().get(), vertex.get()));
+    vertices_.push_back(std::move(vertex));
+    // Keeps the load factor at most 1/2
+    if (vertices_.size() * 2 > index_.size()) {
+        Rehash(std::max<std::size_t>(16, index_.size() * 2));
+    } else {
+        AddToIndex(vertices_.size() - 1);
+    }
+}
+
+void LatticeLevel::Clear() {
+    vertices_.clear();
+    index_.clear();
 }
 
 LatticeVertex const* LatticeLevel::GetLatticeVertex(
         boost::dynamic_bitset<> const& column_indices) const {
-    auto it = vertices_.find(column_indices);
-    if (it != vertices_.end()) {
-        return it->second.get();
-    } else {
+    if (index_.empty()) {
         return nullptr;
     }
+    std::size_t const mask = index_.size() - 1;
+    for (std::size_t slot = util::BitsetHash{}(column_indices) & mask;
+         index_[slot] != 0; slot = (slot + 1) & mask) {
+        LatticeVertex const* vertex = vertices_[index_[slot] - 1].get();
+        if (vertex->GetVertical().GetColumnIndicesRef() == column_indices) {
+            return vertex;
+        }
+    }
+    return nullptr;
 }
 
-void LatticeLevel::GenerateNextLevel(std::vector<std::unique_ptr<LatticeLevel>>& levels) {
+void LatticeLevel::GenerateNextLevel(std::vector<std::unique_ptr<LatticeLevel>>& levels,
+                                     unsigned int threads_num) {
     unsigned int arity = levels.size() - 1;
     assert(arity >= 1);
     LOG(TRACE) << "-------------Creating level " << arity + 1 << "...-----------------\n";
 
-    LatticeLevel* current_level = levels[arity].get();
-
-    std::vector<LatticeVertex*> current_level_vertices;
-    for (auto const& [map_key, vertex] : current_level->GetVertices()) {
-        current_level_vertices.push_back(vertex.get());
-    }
-
-    std::sort(current_level_vertices.begin(), current_level_vertices.end(),
-              LatticeVertex::Comparator);
-    auto next_level = std::make_unique<LatticeLevel>(arity + 1);
-
-    for (unsigned int vertex_index_1 = 0; vertex_index_1 < current_level_vertices.size();
-         vertex_index_1++) {
-        LatticeVertex* vertex1 = current_level_vertices[vertex_index_1];
+    LatticeLevel const* current_level = levels[arity].get();
+    std::vector<std::unique_ptr<LatticeVertex>> const& current_level_vertices =
+            current_level->GetVertices();
 
+    // children[i] are the children of the i-th vertex with the vertices after it
+    std::vector<std::vector<std::unique_ptr<LatticeVertex>>> children(
+            current_level_vertices.size());
+    auto const generate_children = [&](std::unique_ptr<LatticeVertex> const& vertex1) {
+        std::size_t const vertex_index_1 = &vertex1 - current_level_vertices.data();
         if (vertex1->GetRhsCandidates().none() && !vertex1->GetIsKeyCandidate()) {
-            continue;
+            return;
         }
 
-        for (unsigned int vertex_index_2 = vertex_index_1 + 1;
+        for (std::size_t vertex_index_2 = vertex_index_1 + 1;
              vertex_index_2 < current_level_vertices.size(); vertex_index_2++) {
-            LatticeVertex* vertex2 = current_level_vertices[vertex_index_2];
+            LatticeVertex* vertex2 = current_level_vertices[vertex_index_2].get();
 
             if (!vertex1->ComesBeforeAndSharePrefixWith(*vertex2)) {
                 break;
@@ -59,57 +141,21 @@ void LatticeLevel::GenerateNextLevel(std::vector<std::unique_ptr<LatticeLevel>>&
                 continue;
             }
 
-            Vertical child_columns = vertex1->GetVertical().Union(vertex2->GetVertical());
-            std::unique_ptr<LatticeVertex> child_vertex =
-                    std::make_unique<LatticeVertex>(child_columns);
-
-            boost::dynamic_bitset<> parent_indices(
-                    vertex1->GetVertical().GetSchema()->GetNumColumns());
-            parent_indices |= vertex1->GetVertical().GetColumnIndices();
-            parent_indices |= vertex2->GetVertical().GetColumnIndices();
-
-            child_vertex->GetRhsCandidates() |= vertex1->GetRhsCandidates();
-            child_vertex->GetRhsCandidates() &= vertex2->GetRhsCandidates();
-            child_vertex->SetKeyCandidate(vertex1->GetIsKeyCandidate() &&
-                                          vertex2->GetIsKeyCandidate());
-            child_vertex->SetInvalid(vertex1->GetIsInvalid() || vertex2->GetIsInvalid());
-
-            for (unsigned int i = 0, skip_index = parent_indices.find_first(); i < arity - 1;
-                 i++, skip_index = parent_indices.find_next(skip_index)) {
-                parent_indices[skip_index] = false;
-                LatticeVertex const* parent_vertex =
-                        current_level->GetLatticeVertex(parent_indices);
-
-                if (parent_vertex == nullptr) {
-                    goto continueMidOuter;
-                }
-                child_vertex->GetRhsCandidates() &= parent_vertex->GetConstRhsCandidates();
-                if (child_vertex->GetRhsCandidates().none()) {
-                    goto continueMidOuter;
-                }
-                child_vertex->GetParents().push_back(parent_vertex);
-                parent_indices[skip_index] = true;
-
-                child_vertex->SetKeyCandidate(child_vertex->GetIsKeyCandidate() &&
-                                              parent_vertex->GetIsKeyCandidate());
-                child_vertex->SetInvalid(child_vertex->GetIsInvalid() ||
-                                         parent_vertex->GetIsInvalid());
-
-                if (!child_vertex->GetIsKeyCandidate() && child_vertex->GetRhsCandidates().none()) {
-                    goto continueMidOuter;
-                }
+            if (auto child = CreateChild(*current_level, vertex1.get(), vertex2)) {
+                children[vertex_index_1].push_back(std::move(child));
             }
+        }
+    };
+    util::ParallelForeach(current_level_vertices.begin(), current_level_vertices.end(),
+                          threads_num, generate_children);
 
-            child_vertex->GetParents().push_back(vertex1);
-            child_vertex->GetParents().push_back(vertex2);
-
-            next_level->Add(std::move(child_vertex));
-
-        continueMidOuter:
-            continue;
+    // Children of a vertex follow the children of the vertices before it in lexicographic order
+    auto next_level = std::make_unique<LatticeLevel>(arity + 1);
+    for (auto& vertex_children : children) {
+        for (auto& child : vertex_children) {
+            next_level->Add(std::move(child));
         }
     }
-
     levels.push_back(std::move(next_level));
 }
 
@@ -119,12 +165,12 @@ void LatticeLevel::ClearLevelsBelow(std::vector<std::unique_ptr<LatticeLevel>>&
     auto it = levels.begin();
 
     for (unsigned int i = 0; i < std::min((unsigned int)levels.size(), arity); i++) {
-        (*(it++))->GetVertices().clear();
+        (*(it++))->Clear();
     }
 
     // Clear child references
     if (arity < levels.size()) {
-        for (auto& [map_key, retained_vertex] : levels[arity]->GetVertices()) {
+        for (auto& retained_vertex : levels[arity]->GetVertices()) {
             retained_vertex->GetParents().clear();
         }
     }
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <map>
+#include <memory>
 #include <vector>
 
 #include "lattice_vertex.h"
@@ -10,7 +10,14 @@ namespace model {
 class LatticeLevel {
 private:
     unsigned int arity_;
-    std::map<boost::dynamic_bitset<>, std::unique_ptr<LatticeVertex>> vertices_;
+    /* Vertices in lexicographic order of their column indices */
+    std::vector<std::unique_ptr<LatticeVertex>> vertices_;
+    /* Open addressing hash table over the column indices of the vertices. A slot holds the
+     * position of a vertex in vertices_ plus one, 0 marks an empty slot */
+    std::vector<unsigned int> index_;
+
+    void Rehash(std::size_t num_slots);
+    void AddToIndex(unsigned int position);
 
 public:
     explicit LatticeLevel(unsigned int m_arity) : arity_(m_arity) {}
@@ -19,15 +26,21 @@ public:
         return arity_;
     }
 
-    std::map<boost::dynamic_bitset<>, std::unique_ptr<LatticeVertex>>& GetVertices() {
+    std::vector<std::unique_ptr<LatticeVertex>> const& GetVertices() const {
         return vertices_;
     }
 
     LatticeVertex const* GetLatticeVertex(boost::dynamic_bitset<> const& column_indices) const;
+    /* Vertices must be added in lexicographic order of their column indices */
     void Add(std::unique_ptr<LatticeVertex> vertex);
+    void Clear();
 
     // using vectors instead of lists because of .get()
-    static void GenerateNextLevel(std::vector<std::unique_ptr<LatticeLevel>>& levels);
+    /* Generates the children of the vertices of the last level on threads_num threads. Children
+     * of different vertices are independent, and they are added in the order of their parents, so
+     * the next level is the same for any number of threads */
+    static void GenerateNextLevel(std::vector<std::unique_ptr<LatticeLevel>>& levels,
+                                  unsigned int threads_num = 1);
     static void ClearLevelsBelow(std::vector<std::unique_ptr<LatticeLevel>>& levels,
                                  unsigned int arity);
 };
@@ -1,5 +1,7 @@
 #include "lattice_vertex.h"
 
+#include <cassert>
+
 namespace model {
 
 using boost::dynamic_bitset, std::vector, std::shared_ptr, std::make_shared, std::string;
@@ -68,9 +70,27 @@ std::ostream& operator<<(std::ostream& os, LatticeVertex& lv) {
 PositionListIndex const* LatticeVertex::GetPositionListIndex() const {
     if (std::holds_alternative<std::unique_ptr<PositionListIndex>>(position_list_index_)) {
         return std::get<std::unique_ptr<PositionListIndex>>(position_list_index_).get();
-    } else {
+    } else if (std::holds_alternative<PositionListIndex const*>(position_list_index_)) {
         return std::get<PositionListIndex const*>(position_list_index_);
+    } else {
+        return nullptr;
     }
 }
 
+std::size_t LatticeVertex::GetOwnedPositionListIndexMemoryUsage() const {
+    auto const* owned = std::get_if<std::unique_ptr<PositionListIndex>>(&position_list_index_);
+    return owned != nullptr && *owned != nullptr ? (*owned)->GetMemoryUsage() : 0;
+}
+
+void LatticeVertex::SpillPositionListIndex(PliSpillFile& file) {
+    auto& owned = std::get<std::unique_ptr<PositionListIndex>>(position_list_index_);
+    assert(owned != nullptr);
+    position_list_index_ = file.Write(*owned);
+}
+
+std::unique_ptr<PositionListIndex> LatticeVertex::ReadSpilledPositionListIndex() const {
+    PliSpillFile::Record const& record = std::get<PliSpillFile::Record>(position_list_index_);
+    return record.file->Read(record);
+}
+
 }  // namespace model
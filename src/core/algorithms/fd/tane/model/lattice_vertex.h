@@ -7,6 +7,7 @@
 
 #include <boost/dynamic_bitset.hpp>
 
+#include "algorithms/fd/tane/model/pli_spill_file.h"
 #include "model/table/position_list_index.h"
 #include "model/table/relational_schema.h"
 #include "model/table/vertical.h"
@@ -16,8 +17,10 @@ namespace model {
 class LatticeVertex {
 private:
     Vertical vertical_;
-    // holds either an owned PLI (unique_ptr) or a non-owned one (const*)
-    std::variant<std::unique_ptr<PositionListIndex>, PositionListIndex const*> position_list_index_;
+    // holds either an owned PLI (unique_ptr), a non-owned one (const*) or an owned PLI that has
+    // been moved to a swap file
+    std::variant<std::unique_ptr<PositionListIndex>, PositionListIndex const*, PliSpillFile::Record>
+            position_list_index_;
     boost::dynamic_bitset<> rhs_candidates_;
     bool is_key_candidate_ = false;
     std::vector<LatticeVertex const*> parents_;
@@ -63,8 +66,22 @@ public:
         is_invalid_ = m_is_invalid;
     }
 
+    /* Returns nullptr if the PLI has been spilled */
     PositionListIndex const* GetPositionListIndex() const;
 
+    bool IsPositionListIndexSpilled() const {
+        return std::holds_alternative<PliSpillFile::Record>(position_list_index_);
+    }
+
+    /* Bytes taken by the PLI if the vertex owns it and it is in memory, 0 otherwise */
+    std::size_t GetOwnedPositionListIndexMemoryUsage() const;
+
+    /* Moves the owned PLI to the file */
+    void SpillPositionListIndex(PliSpillFile& file);
+
+    /* Reads a copy of the spilled PLI from its file */
+    std::unique_ptr<PositionListIndex> ReadSpilledPositionListIndex() const;
+
     void SetPositionListIndex(PositionListIndex const* position_list_index) {
         position_list_index_ = position_list_index;
     }
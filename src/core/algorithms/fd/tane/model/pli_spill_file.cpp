@@ -0,0 +1,57 @@
+#include "pli_spill_file.h"
+
+#include <atomic>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+#include <easylogging++.h>
+
+namespace model {
+
+PliSpillFile::PliSpillFile() {
+    namespace fs = std::filesystem;
+    static std::atomic<unsigned> files_created = 0;
+    std::string const name = "desbordante_tane_" + std::to_string(std::random_device{}()) + "_" +
+                             std::to_string(files_created++) + ".pli";
+    path_ = fs::temp_directory_path() / name;
+    stream_.open(path_, std::ios::in | std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!stream_.is_open()) {
+        LOG(ERROR) << "unable to open file for swapping";
+        throw std::runtime_error("Cannot open file for swapping");
+    }
+}
+
+PliSpillFile::~PliSpillFile() {
+    stream_.close();
+    std::error_code ec;
+    std::filesystem::remove(path_, ec);
+}
+
+PliSpillFile::Record PliSpillFile::Write(PositionListIndex const& pli) {
+    std::string const data = pli.Serialize();
+    std::scoped_lock lock(mutex_);
+    Record record{this, end_, data.size()};
+    stream_.seekp(static_cast<std::streamoff>(end_));
+    stream_.write(data.data(), static_cast<std::streamsize>(data.size()));
+    if (!stream_) {
+        throw std::runtime_error("Cannot write PLI to the swap file");
+    }
+    end_ += data.size();
+    return record;
+}
+
+std::unique_ptr<PositionListIndex> PliSpillFile::Read(Record const& record) const {
+    std::string data(record.size, '\0');
+    {
+        std::scoped_lock lock(mutex_);
+        stream_.seekg(static_cast<std::streamoff>(record.offset));
+        stream_.read(data.data(), static_cast<std::streamsize>(record.size));
+        if (!stream_) {
+            throw std::runtime_error("Cannot read PLI from the swap file");
+        }
+    }
+    return PositionListIndex::Deserialize(data);
+}
+
+}  // namespace model
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+#include "model/table/position_list_index.h"
+
+namespace model {
+
+/* Temporary file keeping PLIs that do not fit into the memory limit. PLIs are only appended, the
+ * file is removed together with the object. Writing and reading are thread-safe */
+class PliSpillFile {
+public:
+    /* Location of a serialized PLI in a file */
+    struct Record {
+        PliSpillFile const* file;
+        std::uint64_t offset;
+        std::uint64_t size;
+    };
+
+private:
+    std::filesystem::path path_;
+    mutable std::fstream stream_;
+    mutable std::mutex mutex_;
+    std::uint64_t end_ = 0;
+
+public:
+    PliSpillFile();
+    PliSpillFile(PliSpillFile const&) = delete;
+    PliSpillFile& operator=(PliSpillFile const&) = delete;
+    ~PliSpillFile();
+
+    Record Write(PositionListIndex const& pli);
+    std::unique_ptr<PositionListIndex> Read(Record const& record) const;
+};
+
+}  // namespace model
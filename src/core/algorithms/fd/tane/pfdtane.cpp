@@ -2,6 +2,8 @@
 
 #include "config/error/option.h"
 #include "config/error_measure/option.h"
+#include "config/names.h"
+#include "config/thread_number/option.h"
 #include "enums.h"
 #include "fd/pli_based_fd_algorithm.h"
 #include "model/table/column_data.h"
@@ -14,7 +16,9 @@ void PFDTane::RegisterOptions() {
 }
 
 void PFDTane::MakeExecuteOptsAvailableFDInternal() {
-    MakeOptionsAvailable({config::kErrorOpt.GetName(), config::kErrorMeasureOpt.GetName()});
+    MakeOptionsAvailable({config::kErrorOpt.GetName(), config::kErrorMeasureOpt.GetName(),
+                          config::kThreadNumberOpt.GetName(), config::names::kPliSpillLimitKB});
+    MakeBudgetOptionsAvailable();
 }
 
 PFDTane::PFDTane(std::optional<ColumnLayoutRelationDataManager> relation_manager)
@@ -1,6 +1,8 @@
 #include "tane.h"
 
 #include "config/error/option.h"
+#include "config/names.h"
+#include "config/thread_number/option.h"
 #include "fd/pli_based_fd_algorithm.h"
 #include "model/table/column_data.h"
 
@@ -10,7 +12,9 @@ Tane::Tane(std::optional<ColumnLayoutRelationDataManager> relation_manager)
     : tane::TaneCommon(relation_manager) {}
 
 void Tane::MakeExecuteOptsAvailableFDInternal() {
-    MakeOptionsAvailable({config::kErrorOpt.GetName()});
+    MakeOptionsAvailable({config::kErrorOpt.GetName(), config::kThreadNumberOpt.GetName(),
+                          config::names::kPliSpillLimitKB});
+    MakeBudgetOptionsAvailable();
 }
 
 config::ErrorType Tane::CalculateZeroAryFdError(ColumnData const* rhs) {
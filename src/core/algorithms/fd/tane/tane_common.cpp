@@ -1,28 +1,57 @@
 #include "tane_common.h"
 
+#include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <iomanip>
 #include <list>
 #include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 #include <easylogging++.h>
 
 #include "config/error/option.h"
+#include "config/names_and_descriptions.h"
+#include "config/option_using.h"
+#include "config/thread_number/option.h"
 #include "fd/pli_based_fd_algorithm.h"
 #include "fd/tane/model/lattice_level.h"
 #include "fd/tane/model/lattice_vertex.h"
 #include "model/table/column_data.h"
 #include "model/table/column_layout_relation_data.h"
 #include "model/table/relational_schema.h"
+#include "util/parallel_for.h"
+#include "util/resource_usage.h"
 
 namespace algos {
 using boost::dynamic_bitset;
 
 namespace tane {
 
+namespace {
+
+/* PLI of the vertex, read into read_pli if the vertex has spilled it */
+model::PositionListIndex const* GetPli(model::LatticeVertex const& vertex,
+                                       std::unique_ptr<model::PositionListIndex>& read_pli) {
+    if (!vertex.IsPositionListIndexSpilled()) {
+        return vertex.GetPositionListIndex();
+    }
+    read_pli = vertex.ReadSpilledPositionListIndex();
+    return read_pli.get();
+}
+
+}  // namespace
+
 TaneCommon::TaneCommon(std::optional<ColumnLayoutRelationDataManager> relation_manager)
     : PliBasedFDAlgorithm({kDefaultPhaseName}, relation_manager) {
+    DESBORDANTE_OPTION_USING;
+
     RegisterOption(config::kErrorOpt(&max_ucc_error_));
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
+    RegisterOption(Option{&pli_spill_limit_kb_, kPliSpillLimitKB, kDPliSpillLimitKB, 0u});
+    RegisterBudgetOptions();
 }
 
 double TaneCommon::CalculateUccError(model::PositionListIndex const* pli,
@@ -38,11 +67,12 @@ void TaneCommon::RegisterAndCountFd(Vertical const& lhs, Column const* rhs) {
 void TaneCommon::Prune(model::LatticeLevel* level) {
     RelationalSchema const* schema = relation_->GetSchema();
     std::list<model::LatticeVertex*> key_vertices;
-    for (auto& [map_key, vertex] : level->GetVertices()) {
+    for (auto& vertex : level->GetVertices()) {
         Vertical columns = vertex->GetVertical();  // Originally it's a ColumnCombination
 
         if (vertex->GetIsKeyCandidate()) {
-            double ucc_error = CalculateUccError(vertex->GetPositionListIndex(), relation_.get());
+            std::unique_ptr<model::PositionListIndex> read_pli;
+            double ucc_error = CalculateUccError(GetPli(*vertex, read_pli), relation_.get());
             if (ucc_error <= max_ucc_error_) {  // If a key candidate is an approx UCC
 
                 vertex->SetKeyCandidate(false);
@@ -87,25 +117,58 @@ void TaneCommon::Prune(model::LatticeLevel* level) {
     }
 }
 
-void TaneCommon::ComputeDependencies(model::LatticeLevel* level) {
+void TaneCommon::ComputeDependencies(model::LatticeLevel* level,
+                                     model::LatticeLevel const& previous_level) {
     RelationalSchema const* schema = relation_->GetSchema();
-    for (auto& [key_map, xa_vertex] : level->GetVertices()) {
+    auto const& vertices = level->GetVertices();
+    // PLIs of the previous level stay in memory, unless they have been spilled, until the PLIs of
+    // this level are computed. New PLIs that do not fit into the limit after that are spilled, if
+    // a limit is set
+    bool const spilling_enabled = pli_spill_limit_kb_ != 0;
+    std::size_t const spill_limit = static_cast<std::size_t>(pli_spill_limit_kb_) << 10;
+    std::size_t previous_level_memory = 0;
+    for (auto const& vertex : previous_level.GetVertices()) {
+        previous_level_memory += vertex->GetOwnedPositionListIndexMemoryUsage();
+    }
+    std::atomic<std::size_t> resident_pli_memory = previous_level_memory;
+    std::once_flag spill_file_created;
+    util::MetricCounter& spilled_plis = GetRunMetrics().GetCounter(kSpilledPlisMetric);
+
+    // Vertices are independent, so they are processed in parallel, while the FDs found for them
+    // are registered afterwards in the order of the vertices
+    std::vector<std::vector<std::pair<Vertical const*, Column const*>>> found_fds(vertices.size());
+    auto const compute_vertex_dependencies = [&](std::unique_ptr<model::LatticeVertex> const&
+                                                         xa_vertex) {
         if (xa_vertex->GetIsInvalid()) {
-            continue;
+            return;
+        }
+        // The FDs of a vertex only depend on the previous levels, so the ones found before the
+        // stop are minimal
+        if (IsCancelled()) {
+            return;
         }
         Vertical xa = xa_vertex->GetVertical();
+        auto const& parents = xa_vertex->GetParents();
+        std::vector<std::unique_ptr<model::PositionListIndex>> read_parent_plis(parents.size());
+        std::vector<model::PositionListIndex const*> parent_plis(parents.size(), nullptr);
+        auto const get_parent_pli = [&](std::size_t parent_index) {
+            if (parent_plis[parent_index] == nullptr) {
+                parent_plis[parent_index] =
+                        GetPli(*parents[parent_index], read_parent_plis[parent_index]);
+            }
+            return parent_plis[parent_index];
+        };
         // Calculate XA PLI
         if (xa_vertex->GetPositionListIndex() == nullptr) {
-            auto parent_pli_1 = xa_vertex->GetParents()[0]->GetPositionListIndex();
-            auto parent_pli_2 = xa_vertex->GetParents()[1]->GetPositionListIndex();
-            xa_vertex->AcquirePositionListIndex(parent_pli_1->Intersect(parent_pli_2));
+            xa_vertex->AcquirePositionListIndex(get_parent_pli(0)->Intersect(get_parent_pli(1)));
         }
 
         dynamic_bitset<> xa_indices = xa.GetColumnIndices();
         dynamic_bitset<> a_candidates = xa_vertex->GetRhsCandidates();
         auto xa_pli = xa_vertex->GetPositionListIndex();
-        for (auto const& x_vertex : xa_vertex->GetParents()) {
-            Vertical const& lhs = x_vertex->GetVertical();
+        auto& vertex_fds = found_fds[&xa_vertex - vertices.data()];
+        for (std::size_t parent_index = 0; parent_index < parents.size(); ++parent_index) {
+            Vertical const& lhs = parents[parent_index]->GetVertical();
 
             // Find index of A in XA.
             dynamic_bitset<> differing_bits = xa_indices ^ lhs.GetColumnIndices();
@@ -113,20 +176,40 @@ void TaneCommon::ComputeDependencies(model::LatticeLevel* level) {
             if (!a_candidates[a_index]) {
                 continue;
             }
-            auto x_pli = x_vertex->GetPositionListIndex();
+            auto x_pli = get_parent_pli(parent_index);
 
             // Check X -> A
             config::ErrorType error = CalculateFdError(x_pli, xa_pli);
             if (error <= max_fd_error_) {
                 Column const* rhs = schema->GetColumns()[a_index].get();
 
-                RegisterAndCountFd(lhs, rhs);
+                vertex_fds.emplace_back(&lhs, rhs);
                 xa_vertex->GetRhsCandidates().set(rhs->GetIndex(), false);
                 if (error == 0) {
                     xa_vertex->GetRhsCandidates() &= lhs.GetColumnIndices();
                 }
             }
         }
+
+        if (!spilling_enabled) {
+            return;
+        }
+        std::size_t const xa_pli_memory = xa_vertex->GetOwnedPositionListIndexMemoryUsage();
+        if (resident_pli_memory.fetch_add(xa_pli_memory) + xa_pli_memory > spill_limit) {
+            resident_pli_memory -= xa_pli_memory;
+            std::call_once(spill_file_created,
+                           [this] { spill_file_ = std::make_unique<model::PliSpillFile>(); });
+            xa_vertex->SpillPositionListIndex(*spill_file_);
+            spilled_plis.Add();
+        }
+    };
+    util::ParallelForeach(vertices.begin(), vertices.end(), threads_num_,
+                          compute_vertex_dependencies);
+
+    for (auto const& vertex_fds : found_fds) {
+        for (auto const& [lhs, rhs] : vertex_fds) {
+            RegisterAndCountFd(*lhs, rhs);
+        }
     }
 }
 
@@ -155,7 +238,7 @@ unsigned long long TaneCommon::ExecuteInternal() {
     auto level0 = std::make_unique<model::LatticeLevel>(0);
     // TODO: через указатели кажется надо переделать
     level0->Add(std::make_unique<model::LatticeVertex>(*(schema->empty_vertical_)));
-    model::LatticeVertex const* empty_vertex = level0->GetVertices().begin()->second.get();
+    model::LatticeVertex const* empty_vertex = level0->GetVertices().front().get();
     levels.push_back(std::move(level0));
     AddProgress(progress_step);
 
@@ -187,7 +270,7 @@ unsigned long long TaneCommon::ExecuteInternal() {
         level1->Add(std::move(vertex));
     }
 
-    for (auto& [key_map, vertex] : level1->GetVertices()) {
+    for (auto& vertex : level1->GetVertices()) {
         Vertical column = vertex->GetVertical();
         vertex->GetRhsCandidates() &=
                 ~zeroary_fd_rhs;  //~ returns flipped copy <- removed already discovered zeroary FDs
@@ -220,8 +303,11 @@ unsigned long long TaneCommon::ExecuteInternal() {
     unsigned int max_arity =
             max_lhs_ == std::numeric_limits<unsigned int>::max() ? max_lhs_ : max_lhs_ + 1;
     for (unsigned int arity = 2; arity <= max_arity; arity++) {
+        CheckCancellation();
         model::LatticeLevel::ClearLevelsBelow(levels, arity - 1);
-        model::LatticeLevel::GenerateNextLevel(levels);
+        // Spilled PLIs of the cleared level are not needed anymore
+        previous_spill_file_ = std::move(spill_file_);
+        model::LatticeLevel::GenerateNextLevel(levels, threads_num_);
 
         model::LatticeLevel* level = levels[arity].get();
         LOG(TRACE) << "Checking " << level->GetVertices().size() << " " << arity
@@ -230,7 +316,9 @@ unsigned long long TaneCommon::ExecuteInternal() {
             break;
         }
 
-        ComputeDependencies(level);
+        ComputeDependencies(level, *levels[arity - 1]);
+        // Pruning relies on the RHS candidates of every vertex of the level
+        CheckCancellation();
 
         if (arity == max_arity) {
             break;
@@ -247,10 +335,21 @@ unsigned long long TaneCommon::ExecuteInternal() {
                                                                   start_time);
     apriori_millis += elapsed_milliseconds.count();
 
+    spill_file_.reset();
+    previous_spill_file_.reset();
+
     LOG(DEBUG) << "Time: " << apriori_millis << " milliseconds";
-    LOG(DEBUG) << "Intersection time: " << model::PositionListIndex::micros_ / 1000 << "ms";
-    LOG(DEBUG) << "Total intersections: " << model::PositionListIndex::intersection_count_
-               << std::endl;
+    using model::PositionListIndex;
+    util::Metrics& metrics = GetRunMetrics();
+    std::size_t const peak_rss = util::GetPeakResidentSetSize();
+    metrics.GetCounter(kPeakRssMetric).Add(peak_rss);
+    LOG(INFO) << "Peak RSS: " << (peak_rss >> 20) << "MB, "
+              << metrics.GetCounterValue(kSpilledPlisMetric) << " PLIs spilled";
+    auto const intersection_millis = std::chrono::duration_cast<std::chrono::milliseconds>(
+            metrics.GetTimerValue(PositionListIndex::kIntersectionTimeMetric).total);
+    LOG(DEBUG) << "Intersection time: " << intersection_millis.count() << "ms";
+    LOG(DEBUG) << "Total intersections: "
+               << metrics.GetCounterValue(PositionListIndex::kIntersectionsMetric) << std::endl;
     LOG(DEBUG) << "Total FD count: " << fd_collection_.Size();
     LOG(DEBUG) << "HASH: " << Fletcher16();
     return apriori_millis;
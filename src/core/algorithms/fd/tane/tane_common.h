@@ -1,8 +1,12 @@
 #pragma once
 
+#include <memory>
+
 #include "algorithms/fd/pli_based_fd_algorithm.h"
 #include "algorithms/fd/tane/model/lattice_level.h"
+#include "algorithms/fd/tane/model/pli_spill_file.h"
 #include "config/error/type.h"
+#include "config/thread_number/type.h"
 #include "model/table/column_data.h"
 #include "model/table/column_layout_relation_data.h"
 #include "model/table/position_list_index.h"
@@ -10,15 +14,27 @@
 namespace algos::tane {
 
 class TaneCommon : public PliBasedFDAlgorithm {
+public:
+    /* Counters of the run metrics */
+    static constexpr auto kSpilledPlisMetric = "tane.spilled_plis";
+    static constexpr auto kPeakRssMetric = "tane.peak_rss_bytes";
+
 protected:
     config::ErrorType max_fd_error_;
     config::ErrorType max_ucc_error_;
+    config::ThreadNumType threads_num_ = 1;
+    /* PLIs that do not fit into the limit are spilled to disk, 0 if they are never spilled */
+    unsigned int pli_spill_limit_kb_ = 0;
 
 private:
+    /* Spilled PLIs of the current and of the previous levels */
+    std::unique_ptr<model::PliSpillFile> spill_file_;
+    std::unique_ptr<model::PliSpillFile> previous_spill_file_;
+
     void ResetStateFd() final {}
 
     void Prune(model::LatticeLevel* level);
-    void ComputeDependencies(model::LatticeLevel* level);
+    void ComputeDependencies(model::LatticeLevel* level, model::LatticeLevel const& previous_level);
     unsigned long long ExecuteInternal() final;
     virtual config::ErrorType CalculateZeroAryFdError(ColumnData const* rhs) = 0;
     virtual config::ErrorType CalculateFdError(model::PositionListIndex const* lhs_pli,
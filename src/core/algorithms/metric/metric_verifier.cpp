@@ -16,6 +16,7 @@
 #include "config/names_and_descriptions.h"
 #include "config/option_using.h"
 #include "config/tabular_data/input_table/option.h"
+#include "model/table/dataset_cache.h"
 
 namespace algos::metric {
 
@@ -127,13 +128,13 @@ void MetricVerifier::MakeExecuteOptsAvailable() {
 }
 
 void MetricVerifier::LoadDataInternal() {
-    relation_ = ColumnLayoutRelationData::CreateFrom(*input_table_, is_null_equal_null_);
-    input_table_->Reset();
+    model::SharedRelationData data = model::DatasetCache::Instance().Get(
+            *input_table_, is_null_equal_null_, {.relation = true, .typed_relation = true});
+    relation_ = std::move(data.relation);
     if (relation_->GetColumnData().empty()) {
         throw std::runtime_error("Got an empty dataset: metric FD verifying is meaningless.");
     }
-    typed_relation_ =
-            model::ColumnLayoutTypedRelationData::CreateFrom(*input_table_, is_null_equal_null_);
+    typed_relation_ = std::move(data.typed_relation);
 }
 
 void MetricVerifier::ResetState() {
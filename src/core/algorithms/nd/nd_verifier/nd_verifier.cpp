@@ -20,6 +20,7 @@
 #include "config/option_using.h"
 #include "config/tabular_data/input_table/option.h"
 #include "model/table/column_layout_typed_relation_data.h"
+#include "model/table/dataset_cache.h"
 #include "model/table/typed_column_data.h"
 #include "model/types/builtin.h"
 #include "model/types/type.h"
@@ -46,7 +47,7 @@ void NDVerifier::RegisterOptions() {
 
 void NDVerifier::LoadDataInternal() {
     typed_relation_ =
-            model::ColumnLayoutTypedRelationData::CreateFrom(*input_table_, is_null_equal_null_);
+            model::DatasetCache::Instance().GetTypedRelation(*input_table_, is_null_equal_null_);
     input_table_->Reset();
     if (typed_relation_->GetColumnData().empty()) {
         throw std::runtime_error("Got an empty dataset: ND verifying is meaningless.");
@@ -6,7 +6,6 @@
 #include <easylogging++.h>
 
 #include "config/tabular_data/input_table/option.h"
-#include "config/time_limit/option.h"
 #include "util/timed_invoke.h"
 
 namespace algos {
@@ -15,10 +14,6 @@ Fastod::Fastod() : Algorithm({}) {
     PrepareOptions();
 }
 
-bool Fastod::IsTimeUp() const {
-    return time_limit_seconds_ > 0 && timer_.GetElapsedSeconds() >= time_limit_seconds_;
-}
-
 void Fastod::CCPut(AttributeSet const& key, AttributeSet attribute_set) {
     cc_[key] = std::move(attribute_set);
 }
@@ -34,7 +29,7 @@ void Fastod::PrepareOptions() {
 
 void Fastod::RegisterOptions() {
     RegisterOption(config::kTableOpt(&input_table_));
-    RegisterOption(config::kTimeLimitSecondsOpt(&time_limit_seconds_));
+    RegisterBudgetOptions();
 }
 
 void Fastod::MakeLoadOptionsAvailable() {
@@ -42,7 +37,7 @@ void Fastod::MakeLoadOptionsAvailable() {
 }
 
 void Fastod::MakeExecuteOptsAvailable() {
-    MakeOptionsAvailable({config::kTimeLimitSecondsOpt.GetName()});
+    MakeBudgetOptionsAvailable();
 }
 
 void Fastod::LoadDataInternal() {
@@ -50,7 +45,6 @@ void Fastod::LoadDataInternal() {
 }
 
 void Fastod::ResetState() {
-    is_complete_ = false;
     level_ = 1;
 
     result_asc_.clear();
@@ -94,10 +88,6 @@ void Fastod::PrintStatistics() const {
                << "OCD=" << ocd_count;
 }
 
-bool Fastod::IsComplete() const {
-    return is_complete_;
-}
-
 std::vector<fastod::AscCanonicalOD> const& Fastod::GetAscendingDependencies() const {
     return result_asc_;
 }
@@ -135,10 +125,7 @@ void Fastod::ComputeODs() {
             del_attrs.push_back(fastod::DeleteAttribute(context, column));
         }
 
-        if (IsTimeUp()) {
-            is_complete_ = false;
-            return;
-        }
+        CheckCancellation();
 
         AttributeSet context_cc = schema_;
 
@@ -157,10 +144,7 @@ void Fastod::ComputeODs() {
     for (AttributeSet const& context : context_in_current_level_) {
         auto const& del_attrs = deleted_attrs[delete_index++];
 
-        if (IsTimeUp()) {
-            is_complete_ = false;
-            return;
-        }
+        CheckCancellation();
 
         AttributeSet const& cc = CCGet(context);
         AttributeSet context_intersect_cc_context = fastod::Intersect(context, cc);
@@ -213,10 +197,7 @@ void Fastod::CalculateNextLevel() {
     }
 
     for (auto const& [prefix, single_attributes] : prefix_blocks) {
-        if (IsTimeUp()) {
-            is_complete_ = false;
-            return;
-        }
+        CheckCancellation();
 
         if (single_attributes.size() <= 1) {
             continue;
@@ -253,27 +234,19 @@ void Fastod::Discover() {
     while (!context_in_current_level_.empty()) {
         ComputeODs();
 
-        if (IsTimeUp()) {
-            break;
-        }
+        CheckCancellation();
 
         PruneLevels();
         CalculateNextLevel();
 
-        if (IsTimeUp()) {
-            break;
-        }
+        CheckCancellation();
 
         level_++;
     }
 
     timer_.Stop();
 
-    if (IsComplete()) {
-        LOG(DEBUG) << "FastOD finished successfully";
-    } else {
-        LOG(DEBUG) << "FastOD finished with a time-out";
-    }
+    LOG(DEBUG) << "FastOD finished successfully";
 
     PrintStatistics();
 }
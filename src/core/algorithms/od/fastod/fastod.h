@@ -13,7 +13,6 @@
 #include "algorithms/od/fastod/storage/partition_cache.h"
 #include "algorithms/od/fastod/util/timer.h"
 #include "config/tabular_data/input_table_type.h"
-#include "config/time_limit/type.h"
 
 namespace algos {
 
@@ -28,8 +27,6 @@ private:
     using DataFrame = fastod::DataFrame;
     using Timer = fastod::Timer;
 
-    config::TimeLimitSecondsType time_limit_seconds_ = 0u;
-    bool is_complete_ = true;
     size_t level_ = 1;
 
     std::vector<AscCanonicalOD> result_asc_;
@@ -57,8 +54,6 @@ private:
     void RegisterOptions();
     void MakeLoadOptionsAvailable();
 
-    bool IsTimeUp() const;
-
     void Initialize();
     void ComputeODs();
     void PruneLevels();
@@ -177,7 +172,6 @@ public:
     Fastod();
 
     void PrintStatistics() const;
-    bool IsComplete() const;
 
     std::vector<AscCanonicalOD> const& GetAscendingDependencies() const;
     std::vector<DescCanonicalOD> const& GetDescendingDependencies() const;
@@ -5,6 +5,7 @@
 
 #include "algorithms/od/fastod/util/type_util.h"
 #include "csv_parser/csv_parser.h"
+#include "model/table/dataset_cache.h"
 
 namespace algos::fastod {
 
@@ -91,10 +92,10 @@ DataFrame DataFrame::FromCsv(std::filesystem::path const& path, char separator,
 
 DataFrame DataFrame::FromInputTable(config::InputTable input_table,
                                     config::EqNullsType is_null_equal_null) {
-    std::vector<model::TypedColumnData> columns_data =
-            model::CreateTypedColumnData(*input_table, is_null_equal_null);
+    std::shared_ptr<model::ColumnLayoutTypedRelationData> const typed_relation =
+            model::DatasetCache::Instance().GetTypedRelation(*input_table, is_null_equal_null);
 
-    return DataFrame(std::move(columns_data));
+    return DataFrame(typed_relation->GetColumnData());
 }
 
 void DataFrame::RecognizeAttributesWithRanges() {
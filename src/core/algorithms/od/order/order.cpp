@@ -11,6 +11,7 @@
 #include "config/tabular_data/input_table/option.h"
 #include "dependency_checker.h"
 #include "list_lattice.h"
+#include "model/table/dataset_cache.h"
 #include "model/table/tuple_index.h"
 #include "model/types/types.h"
 #include "order_utility.h"
@@ -28,10 +29,15 @@ void Order::RegisterOptions() {
     using config::Option;
 
     RegisterOption(config::kTableOpt(&input_table_));
+    RegisterBudgetOptions();
+}
+
+void Order::MakeExecuteOptsAvailable() {
+    MakeBudgetOptionsAvailable();
 }
 
 void Order::LoadDataInternal() {
-    typed_relation_ = model::ColumnLayoutTypedRelationData::CreateFrom(*input_table_, false);
+    typed_relation_ = model::DatasetCache::Instance().GetTypedRelation(*input_table_, false);
 }
 
 void Order::ResetState() {}
@@ -362,6 +368,7 @@ unsigned long long Order::ExecuteInternal() {
     CreateSingleColumnSortedPartitions();
     lattice_ = std::make_unique<ListLattice>(candidate_sets_, single_attributes_);
     while (!lattice_->IsEmpty()) {
+        CheckCancellation();
         ComputeDependencies(lattice_->GetLatticeLevel());
         lattice_->Prune(candidate_sets_);
         lattice_->GenerateNextLevel(candidate_sets_);
@@ -20,7 +20,7 @@ public:
     using TypedRelation = model::ColumnLayoutTypedRelationData;
 
     config::InputTable input_table_;
-    std::unique_ptr<TypedRelation> typed_relation_;
+    std::shared_ptr<TypedRelation> typed_relation_;
     SortedPartitions sorted_partitions_;
     std::vector<AttributeList> single_attributes_;
     CandidateSets previous_candidate_sets_;
@@ -30,6 +30,7 @@ public:
     std::unique_ptr<ListLattice> lattice_;
 
     void RegisterOptions();
+    void MakeExecuteOptsAvailable() override;
     void LoadDataInternal() override;
     void ResetState() override;
     void PruneSingleEqClassPartitions();
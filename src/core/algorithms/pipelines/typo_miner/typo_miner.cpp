@@ -6,6 +6,7 @@
 #include "config/names_and_descriptions.h"
 #include "config/option_using.h"
 #include "config/tabular_data/input_table/option.h"
+#include "model/table/dataset_cache.h"
 
 namespace {
 using namespace algos;
@@ -31,8 +32,7 @@ TypoMiner::TypoMiner(GetPrecise get_precise, GetApprox get_approx)
         : Algorithm({/*"Precise fd algorithm execution", "Approximate fd algoritm execution",
                      "Extracting fds with non-zero error"*/}),
           precise_algo_(get_precise()),
-          approx_algo_(get_approx()),
-          relation_manager_(MakeRelationManager()) {
+          approx_algo_(get_approx()) {
     RegisterOptions();
     MakeOptionsAvailable({config::kTableOpt.GetName(), config::kEqualNullsOpt.GetName()});
 }
@@ -109,10 +109,12 @@ void TypoMiner::AddSpecificNeededOptions(
 }
 
 void TypoMiner::LoadDataInternal() {
-    relation_ = relation_manager_.GetRelation();
-    input_table_->Reset();
-    typed_relation_ =
-            model::ColumnLayoutTypedRelationData::CreateFrom(*input_table_, is_null_equal_null_);
+    model::SharedRelationData data = model::DatasetCache::Instance().Get(
+            *input_table_, is_null_equal_null_, {.relation = true, .typed_relation = true});
+    // Relation managers of the PLI-based algorithms hand them this relation, so they do not parse
+    // the table again
+    relation_ = std::move(data.relation);
+    typed_relation_ = std::move(data.typed_relation);
 
     for (Algorithm* algo : {precise_algo_.get(), approx_algo_.get()}) {
         input_table_->Reset();
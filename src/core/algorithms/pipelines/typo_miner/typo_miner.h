@@ -18,7 +18,7 @@ private:
     std::unique_ptr<FDAlgorithm> precise_algo_;
     std::unique_ptr<FDAlgorithm> approx_algo_;
     std::vector<FD> approx_fds_;
-    std::unique_ptr<model::ColumnLayoutTypedRelationData> typed_relation_;
+    std::shared_ptr<model::ColumnLayoutTypedRelationData> typed_relation_;
     /* Config members */
     double radius_; /* Maximal distance between two values to consider one of them a typo */
     double ratio_;  /* Maximal fraction of deviations per cluster to flag the cluster as
@@ -28,8 +28,6 @@ private:
     config::EqNullsType is_null_equal_null_;
     std::shared_ptr<ColumnLayoutRelationData> relation_;
 
-    PliBasedFDAlgorithm::ColumnLayoutRelationDataManager const relation_manager_;
-
     PliBasedFDAlgorithm::ColumnLayoutRelationDataManager MakeRelationManager() {
         return {&input_table_, &is_null_equal_null_, &relation_};
     }
@@ -9,6 +9,7 @@
 #include "config/equal_nulls/option.h"
 #include "config/tabular_data/input_table/option.h"
 #include "config/thread_number/option.h"
+#include "model/table/dataset_cache.h"
 
 namespace algos {
 
@@ -17,7 +18,8 @@ namespace mo = model;
 
 DataStats::DataStats() : Algorithm({"Calculating statistics"}) {
     RegisterOptions();
-    MakeOptionsAvailable({config::kTableOpt.GetName(), config::kEqualNullsOpt.GetName()});
+    MakeOptionsAvailable({config::kTableOpt.GetName(), config::kEqualNullsOpt.GetName(),
+                          config::kThreadNumberOpt.GetName()});
 }
 
 void DataStats::RegisterOptions() {
@@ -31,11 +33,11 @@ void DataStats::MakeExecuteOptsAvailable() {
 }
 
 void DataStats::ResetState() {
-    all_stats_.assign(col_data_.size(), ColumnStats{});
+    all_stats_.assign(GetData().size(), ColumnStats{});
 }
 
 Statistic DataStats::GetMin(size_t index, mo::CompareResult order) const {
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (!mo::Type::IsOrdered(col.GetTypeId())) return {};
 
     mo::Type const& type = col.GetType();
@@ -58,7 +60,7 @@ Statistic DataStats::GetMax(size_t index) const {
 
 Statistic DataStats::GetSum(size_t index) const {
     if (all_stats_[index].sum.HasValue()) return all_stats_[index].sum;
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (!col.IsNumeric()) return {};
 
     std::vector<std::byte const*> const& data = col.GetData();
@@ -72,7 +74,7 @@ Statistic DataStats::GetSum(size_t index) const {
 
 Statistic DataStats::GetAvg(size_t index) const {
     if (all_stats_[index].avg.HasValue()) return all_stats_[index].avg;
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (!col.IsNumeric()) return {};
     mo::DoubleType double_type;
 
@@ -89,7 +91,7 @@ Statistic DataStats::GetAvg(size_t index) const {
 
 Statistic DataStats::CalculateCentralMoment(size_t index, int number,
                                             bool bessel_correction) const {
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (!col.IsNumeric()) return {};
     std::vector<std::byte const*> const& data = col.GetData();
     mo::DoubleType double_type;
@@ -122,7 +124,7 @@ Statistic DataStats::CalculateCentralMoment(size_t index, int number,
 }
 
 Statistic DataStats::GetCorrectedSTD(size_t index) const {
-    if (!col_data_[index].IsNumeric()) return {};
+    if (!GetData()[index].IsNumeric()) return {};
     mo::DoubleType double_type;
     std::byte* result = double_type.Allocate();
     double_type.Power(CalculateCentralMoment(index, 2, true).GetData(), 0.5, result);
@@ -147,14 +149,14 @@ Statistic DataStats::GetStandardizedCentralMomentOfDist(size_t index, int number
 
 Statistic DataStats::GetSkewness(size_t index) const {
     if (all_stats_[index].skewness.HasValue()) return all_stats_[index].skewness;
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (!col.IsNumeric()) return {};
     return GetStandardizedCentralMomentOfDist(index, 3);
 }
 
 Statistic DataStats::GetKurtosis(size_t index) const {
     if (all_stats_[index].kurtosis.HasValue()) return all_stats_[index].kurtosis;
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (!col.IsNumeric()) return {};
     Statistic result = GetStandardizedCentralMomentOfDist(index, 4);
     mo::DoubleType double_type;
@@ -166,7 +168,7 @@ Statistic DataStats::GetKurtosis(size_t index) const {
 }
 
 size_t DataStats::NumberOfValues(size_t index) const {
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     return col.GetNumRows() - col.GetNumNulls() - col.GetNumEmpties();
 };
 
@@ -180,7 +182,7 @@ inline static size_t CountDistinctInSortedData(std::vector<std::byte const*> con
 }
 
 size_t DataStats::MixedDistinct(size_t index) const {
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     std::vector<std::byte const*> const& data = col.GetData();
     mo::MixedType mixed_type(is_null_equal_null_);
 
@@ -201,7 +203,7 @@ size_t DataStats::MixedDistinct(size_t index) const {
 
 size_t DataStats::Distinct(size_t index) {
     if (all_stats_[index].distinct != 0) return all_stats_[index].distinct;
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() == +mo::TypeId::kMixed) {
         all_stats_[index].distinct = MixedDistinct(index);
         return all_stats_[index].distinct;
@@ -220,7 +222,7 @@ std::vector<std::vector<std::string>> DataStats::ShowSample(size_t start_row, si
                                               std::vector<std::string>(end_col - start_col + 1));
 
     for (size_t j = start_col - 1; j < end_col; ++j) {
-        mo::TypedColumnData const& col = col_data_[j];
+        mo::TypedColumnData const& col = GetData()[j];
         for (size_t i = start_row - 1; i < end_row; ++i) res[i][j] = col.GetDataAsString(i);
     }
 
@@ -232,7 +234,7 @@ bool DataStats::IsCategorical(size_t index, size_t quantity) {
 }
 
 std::vector<std::byte const*> DataStats::DeleteNullAndEmpties(size_t index) const {
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     mo::TypeId type_id = col.GetTypeId();
     if (type_id == +mo::TypeId::kNull || type_id == +mo::TypeId::kEmpty ||
         type_id == +mo::TypeId::kUndefined)
@@ -247,7 +249,7 @@ std::vector<std::byte const*> DataStats::DeleteNullAndEmpties(size_t index) cons
 }
 
 Statistic DataStats::GetQuantile(double part, size_t index, bool calc_all) {
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (!mo::Type::IsOrdered(col.GetTypeId())) return {};
     mo::Type const& type = col.GetType();
     std::vector<std::byte const*> data = DeleteNullAndEmpties(index);
@@ -301,7 +303,7 @@ Statistic DataStats::CountIfInBinaryRelationWithZero(size_t index, mo::CompareRe
     auto const& type = static_cast<mo::INumericType const&>(col.GetType());
     std::byte* zero = type.MakeValueOfInt(0);
     mo::IntType int_type;
-    std::vector<std::byte const*> const& data = col_data_[index].GetData();
+    std::vector<std::byte const*> const& data = GetData()[index].GetData();
 
     auto pred = [&zero, &type, &res](std::byte const* el) {
         return el && type.Compare(el, zero) == res;
@@ -325,7 +327,7 @@ Statistic DataStats::GetNumberOfNegatives(size_t index) const {
 
 Statistic DataStats::GetSumOfSquares(size_t index) const {
     if (all_stats_[index].sum_of_squares.HasValue()) return all_stats_[index].sum_of_squares;
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (!col.IsNumeric()) return {};
 
     auto const& type = static_cast<mo::INumericType const&>(col.GetType());
@@ -346,7 +348,7 @@ Statistic DataStats::GetSumOfSquares(size_t index) const {
 
 Statistic DataStats::GetGeometricMean(size_t index) const {
     if (all_stats_[index].geometric_mean.HasValue()) return all_stats_[index].geometric_mean;
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (!col.IsNumeric()) return {};
 
     auto const& type = static_cast<mo::INumericType const&>(col.GetType());
@@ -378,7 +380,7 @@ Statistic DataStats::GetGeometricMean(size_t index) const {
 
 Statistic DataStats::GetMeanAD(size_t index) const {
     if (all_stats_[index].mean_ad.HasValue()) return all_stats_[index].mean_ad;
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (!col.IsNumeric()) return {};
 
     // Convert each summand to DoubleType
@@ -448,7 +450,7 @@ std::byte* DataStats::MedianOfNumericVector(std::vector<std::byte const*> const&
 
 Statistic DataStats::GetMedian(size_t index) const {
     if (all_stats_[index].median.HasValue()) return all_stats_[index].median;
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (!col.IsNumeric()) return {};
 
     auto const& type = static_cast<mo::INumericType const&>(col.GetType());
@@ -463,7 +465,7 @@ Statistic DataStats::GetMedianAD(size_t index) const {
     if (all_stats_[index].median_ad.HasValue()) {
         return all_stats_[index].median_ad;
     }
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     auto const& type = static_cast<mo::INumericType const&>(col.GetType());
     if (!col.IsNumeric()) return {};
 
@@ -491,7 +493,7 @@ Statistic DataStats::GetMedianAD(size_t index) const {
 
 Statistic DataStats::GetVocab(size_t index) const {
     if (all_stats_[index].vocab.HasValue()) return all_stats_[index].vocab;
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() != +mo::TypeId::kString) return {};
 
     mo::StringType string_type;
@@ -547,7 +549,7 @@ Statistic DataStats::GetNumberOfUppercaseChars(size_t index) const {
 
 template <class Pred>
 Statistic DataStats::CountIfInColumn(Pred pred, size_t index) const {
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() != +mo::TypeId::kString) return {};
 
     size_t count = 0;
@@ -566,7 +568,7 @@ Statistic DataStats::CountIfInColumn(Pred pred, size_t index) const {
 }
 
 Statistic DataStats::GetNumberOfChars(size_t index) const {
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() != +mo::TypeId::kString) return {};
 
     return GetStringSumOf(index, [](std::string const& line) { return line.size(); });
@@ -575,7 +577,7 @@ Statistic DataStats::GetNumberOfChars(size_t index) const {
 Statistic DataStats::GetAvgNumberOfChars(size_t index) const {
     if (all_stats_[index].num_avg_chars.HasValue()) return all_stats_[index].num_avg_chars;
 
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() != +mo::TypeId::kString) return {};
 
     mo::DoubleType double_type;
@@ -596,7 +598,7 @@ Statistic DataStats::GetAvgNumberOfChars(size_t index) const {
 
 template <class Pred>
 Statistic DataStats::GetStringMinOf(size_t index, Pred pred) const {
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     mo::IntType int_type;
 
     size_t result = std::numeric_limits<size_t>::max();
@@ -616,7 +618,7 @@ Statistic DataStats::GetStringMinOf(size_t index, Pred pred) const {
 
 template <class Pred>
 Statistic DataStats::GetStringMaxOf(size_t index, Pred pred) const {
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     mo::IntType int_type;
 
     size_t result = 0;
@@ -636,7 +638,7 @@ Statistic DataStats::GetStringMaxOf(size_t index, Pred pred) const {
 
 template <class Pred>
 Statistic DataStats::GetStringSumOf(size_t index, Pred pred) const {
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     mo::IntType int_type;
 
     size_t result = 0;
@@ -655,7 +657,7 @@ Statistic DataStats::GetStringSumOf(size_t index, Pred pred) const {
 
 Statistic DataStats::GetMinNumberOfChars(size_t index) const {
     if (all_stats_[index].min_num_chars.HasValue()) return all_stats_[index].min_num_chars;
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() != +mo::TypeId::kString) return {};
 
     return GetStringMinOf(index, [](std::string const& line) { return line.size(); });
@@ -663,7 +665,7 @@ Statistic DataStats::GetMinNumberOfChars(size_t index) const {
 
 Statistic DataStats::GetMaxNumberOfChars(size_t index) const {
     if (all_stats_[index].max_num_chars.HasValue()) return all_stats_[index].max_num_chars;
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() != +mo::TypeId::kString) return {};
 
     return GetStringMaxOf(index, [](std::string const& line) { return line.size(); });
@@ -677,7 +679,7 @@ std::vector<std::string> DataStats::GetWordsInString(std::string line) {
 }
 
 std::set<std::string> DataStats::GetWords(size_t index) const {
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() != +mo::TypeId::kString) return {};
 
     mo::StringType string_type;
@@ -706,7 +708,7 @@ size_t DataStats::GetNumberOfWordsInString(std::string line) {
 Statistic DataStats::GetMinNumberOfWords(size_t index) const {
     if (all_stats_[index].min_num_words.HasValue()) return all_stats_[index].min_num_words;
 
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() != +mo::TypeId::kString) return {};
 
     return GetStringMinOf(index,
@@ -715,7 +717,7 @@ Statistic DataStats::GetMinNumberOfWords(size_t index) const {
 
 Statistic DataStats::GetMaxNumberOfWords(size_t index) const {
     if (all_stats_[index].max_num_words.HasValue()) return all_stats_[index].max_num_words;
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() != +mo::TypeId::kString) return {};
 
     return GetStringMaxOf(index,
@@ -724,7 +726,7 @@ Statistic DataStats::GetMaxNumberOfWords(size_t index) const {
 
 Statistic DataStats::GetNumberOfWords(size_t index) const {
     if (all_stats_[index].num_words.HasValue()) return all_stats_[index].num_words;
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() != +mo::TypeId::kString) return {};
 
     return GetStringSumOf(index,
@@ -732,7 +734,7 @@ Statistic DataStats::GetNumberOfWords(size_t index) const {
 }
 
 std::vector<char> DataStats::GetTopKChars(size_t index, size_t k) const {
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() != +mo::TypeId::kString) return {};
 
     mo::StringType string_type;
@@ -767,7 +769,7 @@ std::vector<char> DataStats::GetTopKChars(size_t index, size_t k) const {
 }
 
 std::vector<std::string> DataStats::GetTopKWords(size_t index, size_t k) const {
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() != +mo::TypeId::kString) return {};
 
     mo::StringType string_type;
@@ -843,7 +845,7 @@ bool DataStats::IsEntirelyLowercase(std::string word) {
 
 template <class Pred>
 Statistic DataStats::CountIfInColumnForWords(Pred pred, size_t index) const {
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() != +mo::TypeId::kString) return {};
 
     std::size_t count = 0;
@@ -873,7 +875,7 @@ unsigned long long DataStats::ExecuteInternal() {
     double percent_per_col = kTotalProgressPercent / all_stats_.size();
     auto task = [percent_per_col, this](size_t index) {
         all_stats_[index].count = NumberOfValues(index);
-        if (this->col_data_[index].GetTypeId() != +mo::TypeId::kMixed) {
+        if (GetData()[index].GetTypeId() != +mo::TypeId::kMixed) {
             all_stats_[index].min = GetMin(index);
             all_stats_[index].max = GetMax(index);
             all_stats_[index].sum = GetSum(index);
@@ -910,7 +912,7 @@ unsigned long long DataStats::ExecuteInternal() {
         // distinct for mixed type will be calculated here
         all_stats_[index].is_categorical = IsCategorical(
                 index, std::min(all_stats_[index].count - 1, 10 + all_stats_[index].count / 1000));
-        all_stats_[index].type = this->col_data_[index].GetType().ToString().substr(1);
+        all_stats_[index].type = GetData()[index].GetType().ToString().substr(1);
         AddProgress(percent_per_col);
     };
 
@@ -930,34 +932,34 @@ unsigned long long DataStats::ExecuteInternal() {
 }
 
 size_t DataStats::GetNumNulls(size_t index) const {
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     return col.GetNumNulls();
 }
 
 std::vector<size_t> DataStats::GetNullColumns() const {
-    auto pred = [this, num_rows = col_data_[0].GetNumRows()](size_t index) {
-        return col_data_[index].GetNumNulls() == num_rows;
+    auto pred = [this, num_rows = GetData()[0].GetNumRows()](size_t index) {
+        return GetData()[index].GetNumNulls() == num_rows;
     };
 
-    return FilterIndices(pred, col_data_);
+    return FilterIndices(pred, GetData());
 }
 
 std::vector<size_t> DataStats::GetColumnsWithNull() const {
-    auto pred = [this](size_t index) { return col_data_[index].GetNumNulls() != 0; };
+    auto pred = [this](size_t index) { return GetData()[index].GetNumNulls() != 0; };
 
-    return FilterIndices(pred, col_data_);
+    return FilterIndices(pred, GetData());
 }
 
 std::vector<size_t> DataStats::GetColumnsWithUniqueValues() {
-    auto pred = [this, num_rows = col_data_[0].GetNumRows()](size_t index) {
+    auto pred = [this, num_rows = GetData()[0].GetNumRows()](size_t index) {
         return Distinct(index) == num_rows;
     };
 
-    return FilterIndices(pred, col_data_);
+    return FilterIndices(pred, GetData());
 }
 
 size_t DataStats::GetNumberOfColumns() const {
-    return col_data_.size();
+    return GetData().size();
 }
 
 ColumnStats const& DataStats::GetAllStats(size_t index) const {
@@ -969,7 +971,8 @@ std::vector<ColumnStats> const& DataStats::GetAllStats() const {
 }
 
 std::vector<model::TypedColumnData> const& DataStats::GetData() const noexcept {
-    return col_data_;
+    static std::vector<model::TypedColumnData> const kNoData;
+    return typed_relation_ != nullptr ? typed_relation_->GetColumnData() : kNoData;
 }
 
 std::string DataStats::ToString() const {
@@ -982,8 +985,10 @@ std::string DataStats::ToString() const {
 }
 
 void DataStats::LoadDataInternal() {
-    col_data_ = mo::CreateTypedColumnData(*input_table_, is_null_equal_null_);
-    all_stats_ = std::vector<ColumnStats>{col_data_.size()};
+    typed_relation_ =
+            mo::DatasetCache::Instance().GetTypedRelation(*input_table_, is_null_equal_null_,
+                                                          threads_num_);
+    all_stats_ = std::vector<ColumnStats>{GetData().size()};
 }
 
 }  // namespace algos
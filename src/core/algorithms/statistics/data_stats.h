@@ -15,7 +15,7 @@ class DataStats : public Algorithm {
     config::EqNullsType is_null_equal_null_;
     config::ThreadNumType threads_num_;
 
-    std::vector<model::TypedColumnData> col_data_;
+    std::shared_ptr<model::ColumnLayoutTypedRelationData> typed_relation_;
     std::vector<ColumnStats> all_stats_;
 
     size_t MixedDistinct(size_t index) const;
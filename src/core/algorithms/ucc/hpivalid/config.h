@@ -1,6 +1,9 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
+
+#include "config/thread_number/type.h"
 
 // see algorithms/ucc/hpivalid/LICENSE
 
@@ -15,6 +18,13 @@ struct Config {
 
     // whether or not to use the tiebreaker heuristic
     bool tiebreaker_heuristic = true;
+
+    // number of threads intersecting large PLIs
+    config::ThreadNumType threads = 1;
+
+    // PLIs with fewer records are intersected on one thread, splitting them
+    // costs more than it saves
+    std::size_t min_parallel_intersection_records = 1 << 15;
 };
 
 }  // namespace algos::hpiv
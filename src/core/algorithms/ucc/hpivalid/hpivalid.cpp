@@ -11,13 +11,14 @@
 #include "algorithms/ucc/hpivalid/config.h"
 #include "algorithms/ucc/hpivalid/result_collector.h"
 #include "algorithms/ucc/hpivalid/tree_search.h"
+#include "model/table/dataset_cache.h"
 
 // see algorithms/ucc/hpivalid/LICENSE
 
 namespace algos {
 
 void HPIValid::LoadDataInternal() {
-    relation_ = ColumnLayoutRelationData::CreateFrom(*input_table_, is_null_equal_null_);
+    relation_ = model::DatasetCache::Instance().GetRelation(*input_table_, is_null_equal_null_);
 
     if (relation_->GetColumnData().empty()) {
         throw std::runtime_error("Got an empty dataset: UCC mining is meaningless.");
@@ -46,6 +47,7 @@ hpiv::PLITable HPIValid::Preprocess(hpiv::ResultCollector& rc) {
 
 unsigned long long HPIValid::ExecuteInternal() {
     hpiv::Config cfg;
+    cfg.threads = threads_num_;
     hpiv::ResultCollector rc(3600);
 
     rc.StartTimer(hpiv::timer::TimerName::total);
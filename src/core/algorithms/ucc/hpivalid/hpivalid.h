@@ -6,6 +6,8 @@
 #include "algorithms/ucc/hpivalid/pli_table.h"
 #include "algorithms/ucc/hpivalid/result_collector.h"
 #include "algorithms/ucc/ucc_algorithm.h"
+#include "config/thread_number/option.h"
+#include "config/thread_number/type.h"
 #include "model/table/column_layout_relation_data.h"
 
 // see algorithms/ucc/hpivalid/LICENSE
@@ -15,6 +17,7 @@ namespace algos {
 class HPIValid : public UCCAlgorithm {
 private:
     std::shared_ptr<ColumnLayoutRelationData> relation_;
+    config::ThreadNumType threads_num_ = 1;
 
     void LoadDataInternal() override;
     unsigned long long ExecuteInternal() override;
@@ -24,8 +27,14 @@ private:
 
     void ResetUCCAlgorithmState() override {}
 
+    void MakeExecuteOptsAvailable() final {
+        MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
+    }
+
 public:
-    HPIValid() : UCCAlgorithm({}) {}
+    HPIValid() : UCCAlgorithm({}) {
+        RegisterOption(config::kThreadNumberOpt(&threads_num_));
+    }
 };
 
 }  // namespace algos
@@ -3,13 +3,17 @@
 #include <algorithm>
 #include <cstddef>
 #include <deque>
+#include <iterator>
 #include <limits>
+#include <memory>
 #include <random>
-#include <stack>
 #include <tuple>
 #include <utility>
 #include <vector>
 
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <boost/thread/future.hpp>
 #include <easylogging++.h>
 
 #include "algorithms/ucc/hpivalid/config.h"
@@ -25,7 +29,7 @@ TreeSearch::TreeSearch(PLITable const& tab, Config const& cfg, ResultCollector&
       cfg_(cfg),
       rc_(rc),
       partial_hg_(tab.nr_cols),
-      clusterid_to_recordindices_(tab.nr_rows),
+      clusterid_to_recordindices_(1),
       gen_(cfg.seed) {
     // add single edge containing all vertices to partial hypergraph
     partial_hg_.AddEdge(~Edge(partial_hg_.NumVertices()));
@@ -33,6 +37,16 @@ TreeSearch::TreeSearch(PLITable const& tab, Config const& cfg, ResultCollector&
     if (cfg_.tiebreaker_heuristic) {
         ComputeNiceness();
     }
+
+    if (cfg_.threads > 1) {
+        pool_ = std::make_unique<boost::asio::thread_pool>(cfg_.threads);
+    }
+}
+
+TreeSearch::~TreeSearch() {
+    if (pool_ != nullptr) {
+        pool_->join();
+    }
 }
 
 void TreeSearch::Run() {
@@ -69,7 +83,6 @@ void TreeSearch::Run() {
     std::vector<std::vector<Edgemark>> removed_criticals_stack;
 
     // intersections
-    std::stack<std::deque<model::PLI::Cluster>> intersection_stack;
     std::deque<Edge::size_type> tointersect_queue;
 
     // Searching
@@ -91,10 +104,9 @@ void TreeSearch::Run() {
 
             // branch
             s.set(v);
-            intersection_stack.push(tab_.plis[v]);
+            IntersectionStack intersection_stack(tab_.plis[v]);
             ExtendOrConfirmS(s, cand, crit, uncov, vertexhittings, removed_criticals_stack,
                              intersection_stack, tointersect_queue);
-            intersection_stack.pop();
             s.reset(v);
 
             // reset update of crit and uncov
@@ -241,13 +253,13 @@ inline bool TreeSearch::ExtendOrConfirmS(
         Edge& s, Edge& cand, std::vector<Edgemark>& crit, Edgemark& uncov,
         std::vector<Edgemark>& vertexhittings,
         std::vector<std::vector<Edgemark>>& removed_criticals_stack,
-        std::stack<std::deque<model::PLI::Cluster>>& intersection_stack,
+        IntersectionStack& intersection_stack,
         std::deque<Edge::size_type>& tointersect_queue) {
     rc_.CountTreeNode();
     if (uncov.none()) {
         PullUpIntersections(intersection_stack, tointersect_queue);
 
-        if (intersection_stack.top().empty()) {
+        if (intersection_stack.Top().empty()) {
             if (!rc_.UCCFound(s)) {
                 // timeout
                 throw timeout_;
@@ -256,7 +268,7 @@ inline bool TreeSearch::ExtendOrConfirmS(
         }
 
         // gain new edges and minimize
-        UpdateEdges(crit, uncov, vertexhittings, removed_criticals_stack, intersection_stack.top());
+        UpdateEdges(crit, uncov, vertexhittings, removed_criticals_stack, intersection_stack.Top());
 
         // check if minimality still holds
         if (!SFulfillsMinimalityCondition(crit)) {
@@ -292,7 +304,7 @@ inline bool TreeSearch::ExtendOrConfirmS(
         bool check = ExtendOrConfirmS(s, cand, crit, uncov, vertexhittings, removed_criticals_stack,
                                       intersection_stack, tointersect_queue);
         if (tointersect_queue.empty()) {
-            intersection_stack.pop();
+            intersection_stack.Pop();
         } else {
             tointersect_queue.pop_back();
         }
@@ -320,12 +332,12 @@ inline bool TreeSearch::ExtendOrConfirmS(
 }
 
 inline void TreeSearch::PullUpIntersections(
-        std::stack<std::deque<model::PLI::Cluster>>& intersection_stack,
+        IntersectionStack& intersection_stack,
         std::deque<Edge::size_type>& tointersect_queue) {
     rc_.StartTimer(timer::TimerName::cluster_intersect);
     while (!tointersect_queue.empty()) {
-        intersection_stack.push(IntersectClusterListAndClusterMapping(
-                intersection_stack.top(), tab_.inverse_mapping[tointersect_queue.front()]));
+        intersection_stack.Push(IntersectClusterListAndClusterMapping(intersection_stack.Top(),
+                                                                      tointersect_queue.front()));
 
         tointersect_queue.pop_front();
     }
@@ -333,17 +345,83 @@ inline void TreeSearch::PullUpIntersections(
 }
 
 std::deque<model::PLI::Cluster> TreeSearch::IntersectClusterListAndClusterMapping(
-        std::deque<model::PLI::Cluster> const& pli, std::vector<unsigned> const& inverse_mapping) {
+        std::deque<model::PLI::Cluster> const& pli, Edge::size_type column) {
     rc_.CountIntersections();
+    std::vector<unsigned> const& inverse_mapping = tab_.inverse_mapping[column];
+    // the mappings are indexed by the cluster ids of the column
+    std::size_t const nr_clusters = tab_.plis[column].size();
     std::deque<model::PLI::Cluster> intersection;
 
-    std::vector<unsigned long> clusterids;
+    std::size_t records = 0;
     for (auto const& cluster : pli) {
         rc_.CountIntersectionClusterSize(cluster.size());
+        records += cluster.size();
+    }
+
+    if (pool_ == nullptr || records < cfg_.min_parallel_intersection_records) {
+        std::vector<model::PLI::Cluster>& clusterid_to_recordindices =
+                clusterid_to_recordindices_.front();
+        if (clusterid_to_recordindices.size() < nr_clusters) {
+            clusterid_to_recordindices.resize(nr_clusters);
+        }
+        IntersectClusters(pli, 0, pli.size(), inverse_mapping, clusterid_to_recordindices,
+                          intersection);
+        return intersection;
+    }
+
+    // split the clusters into ranges with about the same number of records,
+    // the clusters are intersected independently, so concatenating the
+    // intersections of the ranges gives the same result as above
+    std::vector<std::size_t> bounds = {0};
+    std::size_t prefix_records = 0;
+    for (std::size_t i = 0; i + 1 < pli.size(); ++i) {
+        prefix_records += pli[i].size();
+        if (prefix_records * cfg_.threads >= records * bounds.size()) {
+            bounds.push_back(i + 1);
+        }
+    }
+    bounds.push_back(pli.size());
+
+    std::size_t const ranges = bounds.size() - 1;
+    if (clusterid_to_recordindices_.size() < ranges) {
+        clusterid_to_recordindices_.resize(ranges);
+    }
+    for (std::size_t i = 0; i < ranges; ++i) {
+        if (clusterid_to_recordindices_[i].size() < nr_clusters) {
+            clusterid_to_recordindices_[i].resize(nr_clusters);
+        }
+    }
+    std::vector<std::deque<model::PLI::Cluster>> range_intersections(ranges);
+    std::vector<boost::unique_future<void>> futures;
+    for (std::size_t i = 0; i < ranges; ++i) {
+        boost::packaged_task<void> task([&, i]() {
+            IntersectClusters(pli, bounds[i], bounds[i + 1], inverse_mapping,
+                              clusterid_to_recordindices_[i], range_intersections[i]);
+        });
+        futures.push_back(task.get_future());
+        boost::asio::post(*pool_, std::move(task));
+    }
+    for (auto& future : futures) {
+        future.get();
+    }
+
+    for (auto& range_intersection : range_intersections) {
+        std::move(range_intersection.begin(), range_intersection.end(),
+                  std::back_inserter(intersection));
+    }
+    return intersection;
+}
+
+void TreeSearch::IntersectClusters(std::deque<model::PLI::Cluster> const& pli, std::size_t first,
+                                   std::size_t last, std::vector<unsigned> const& inverse_mapping,
+                                   std::vector<model::PLI::Cluster>& clusterid_to_recordindices,
+                                   std::deque<model::PLI::Cluster>& intersection) {
+    std::vector<unsigned long> clusterids;
+    for (std::size_t i = first; i < last; ++i) {
         clusterids.clear();
-        for (std::vector<unsigned>::size_type i_r : cluster) {
+        for (std::vector<unsigned>::size_type i_r : pli[i]) {
             if (inverse_mapping[i_r] != kSizeOneCluster) {
-                auto& map_entry = clusterid_to_recordindices_[inverse_mapping[i_r]];
+                auto& map_entry = clusterid_to_recordindices[inverse_mapping[i_r]];
                 if (map_entry.size() == 0) {
                     clusterids.push_back(inverse_mapping[i_r]);
                 }
@@ -351,15 +429,13 @@ std::deque<model::PLI::Cluster> TreeSearch::IntersectClusterListAndClusterMappin
             }
         }
         for (auto clusterid : clusterids) {
-            auto& map_entry = clusterid_to_recordindices_[clusterid];
+            auto& map_entry = clusterid_to_recordindices[clusterid];
             if (map_entry.size() != 1) {
                 intersection.emplace_back(std::move(map_entry));
             }
-            clusterid_to_recordindices_[clusterid] = {};
+            clusterid_to_recordindices[clusterid] = {};
         }
     }
-
-    return intersection;
 }
 
 inline void TreeSearch::UpdateEdges(std::vector<Edgemark>& crit, Edgemark& uncov,
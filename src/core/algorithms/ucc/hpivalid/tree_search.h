@@ -1,8 +1,9 @@
 #pragma once
 
+#include <cstddef>
 #include <deque>
+#include <memory>
 #include <random>
-#include <stack>
 #include <vector>
 
 #include "algorithms/ucc/hpivalid/hypergraph.h"
@@ -10,6 +11,12 @@
 
 // see algorithms/ucc/hpivalid/LICENSE
 
+namespace boost::asio {
+// Forward declare thread_pool to avoid including boost::asio::thread_pool implementation since
+// it's not needed here and to avoid transitevly pollute all other files with it
+class thread_pool;
+}  // namespace boost::asio
+
 namespace algos::hpiv {
 
 struct Config;
@@ -18,6 +25,30 @@ class ResultCollector;
 
 class TreeSearch {
 private:
+    // PLIs of the prefixes of S, the PLI of the first vertex of S is
+    // referenced instead of being copied
+    class IntersectionStack {
+    private:
+        std::deque<model::PLI::Cluster> const* first_;
+        std::vector<std::deque<model::PLI::Cluster>> intersections_;
+
+    public:
+        explicit IntersectionStack(std::deque<model::PLI::Cluster> const& first)
+            : first_(&first) {}
+
+        std::deque<model::PLI::Cluster> const& Top() const {
+            return intersections_.empty() ? *first_ : intersections_.back();
+        }
+
+        void Push(std::deque<model::PLI::Cluster>&& pli) {
+            intersections_.push_back(std::move(pli));
+        }
+
+        void Pop() {
+            intersections_.pop_back();
+        }
+    };
+
     PLITable const& tab_;
     Config const& cfg_;
     ResultCollector& rc_;
@@ -28,9 +59,14 @@ private:
     // exception to throw, when timeout happens
     unsigned const timeout_ = 10;
 
-    // a mapping from clusterid to record indices that is used for the
-    // intersection of PLIs with single-column PLIs
-    std::vector<model::PLI::Cluster> clusterid_to_recordindices_;
+    // mappings from clusterid to record indices that are used for the
+    // intersection of PLIs with single-column PLIs, one for every range of
+    // clusters intersected in parallel, grown to the largest number of
+    // clusters of the columns intersected so far
+    std::vector<std::vector<model::PLI::Cluster>> clusterid_to_recordindices_;
+
+    // threads intersecting large PLIs, only created for cfg.threads > 1
+    std::unique_ptr<boost::asio::thread_pool> pool_;
 
     // mapping from column to niceness (in [0, nr_cols)) with smaller
     // values being nicer columns
@@ -50,15 +86,22 @@ private:
     inline bool ExtendOrConfirmS(Edge& s, Edge& cand, std::vector<Edgemark>& crit, Edgemark& uncov,
                                  std::vector<Edgemark>& vertexhittings,
                                  std::vector<std::vector<Edgemark>>& removed_criticals_stack,
-                                 std::stack<std::deque<model::PLI::Cluster>>& intersection_stack,
+                                 IntersectionStack& intersection_stack,
                                  std::deque<Edge::size_type>& tointersect_queue);
 
-    inline void PullUpIntersections(std::stack<std::deque<model::PLI::Cluster>>& intersection_stack,
+    inline void PullUpIntersections(IntersectionStack& intersection_stack,
                                     std::deque<Edge::size_type>& tointersect_queue);
 
+    // intersects pli with the single-column PLI of column
     std::deque<model::PLI::Cluster> IntersectClusterListAndClusterMapping(
-            std::deque<model::PLI::Cluster> const& pli,
-            std::vector<unsigned> const& inverse_mapping);
+            std::deque<model::PLI::Cluster> const& pli, Edge::size_type column);
+
+    // intersects the clusters of pli in [first, last) and appends the
+    // resulting clusters to intersection
+    static void IntersectClusters(std::deque<model::PLI::Cluster> const& pli, std::size_t first,
+                                  std::size_t last, std::vector<unsigned> const& inverse_mapping,
+                                  std::vector<model::PLI::Cluster>& clusterid_to_recordindices,
+                                  std::deque<model::PLI::Cluster>& intersection);
 
     inline void UpdateEdges(std::vector<Edgemark>& crit, Edgemark& uncov,
                             std::vector<Edgemark>& vertexhittings,
@@ -71,6 +114,7 @@ private:
 
 public:
     TreeSearch(PLITable const& tab, Config const& cfg, ResultCollector& rc);
+    ~TreeSearch();
 
     void Run();
 };
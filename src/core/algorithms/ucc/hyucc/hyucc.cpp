@@ -1,11 +1,13 @@
 #include "hyucc.h"
 
 #include <chrono>
+#include <vector>
 
 #include <easylogging++.h>
 
 #include "fd/hycommon/types.h"
 #include "inductor.h"
+#include "model/table/dataset_cache.h"
 #include "preprocessor.h"
 #include "sampler.h"
 #include "validator.h"
@@ -13,7 +15,7 @@
 namespace algos {
 
 void HyUCC::LoadDataInternal() {
-    relation_ = ColumnLayoutRelationData::CreateFrom(*input_table_, is_null_equal_null_);
+    relation_ = model::DatasetCache::Instance().GetRelation(*input_table_, is_null_equal_null_);
 
     if (relation_->GetColumnData().empty()) {
         throw std::runtime_error("Got an empty dataset: UCC mining is meaningless.");
@@ -25,19 +27,30 @@ unsigned long long HyUCC::ExecuteInternal() {
     using namespace hyucc;
     auto const start_time = std::chrono::system_clock::now();
 
-    auto [plis, pli_records, og_mapping] = Preprocess(relation_.get());
+    auto [plis, pli_records, og_mapping] = Preprocess(relation_.get(), threads_num_);
     auto const plis_shared = std::make_shared<PLIs>(std::move(plis));
     auto const pli_records_shared = std::make_shared<Rows>(std::move(pli_records));
 
     hyucc::Sampler sampler(plis_shared, pli_records_shared, threads_num_);
 
     auto ucc_tree = std::make_unique<UCCTree>(relation_->GetNumColumns());
-    Inductor inductor(ucc_tree.get());
-    Validator validator(ucc_tree.get(), plis_shared, pli_records_shared, threads_num_);
+    auto is_cancelled = [this] { return IsCancelled(); };
+    Inductor inductor(ucc_tree.get(), is_cancelled);
+    Validator validator(ucc_tree.get(), plis_shared, pli_records_shared, threads_num_,
+                        is_cancelled);
 
     IdPairs comparison_suggestions;
 
     while (true) {
+        if (IsBudgetExceeded()) {
+            // Only the levels the validator has gone through hold on the whole table
+            auto uccs = ucc_tree->FillUCCs();
+            std::erase_if(uccs, [&validator](boost::dynamic_bitset<> const& ucc) {
+                return ucc.count() >= validator.GetLevelNum();
+            });
+            RegisterUCCs(std::move(uccs), og_mapping);
+        }
+        CheckCancellation();
         LOG(DEBUG) << "Sampling...";
         NonUCCList non_uccs = sampler.GetNonUCCs(comparison_suggestions);
 
@@ -46,6 +59,9 @@ unsigned long long HyUCC::ExecuteInternal() {
 
         LOG(DEBUG) << "Validating...";
         comparison_suggestions = validator.ValidateAndExtendCandidates();
+        // The inductor and the validator stop early once the run is cancelled, the UCCs of the
+        // validated levels are registered above then
+        if (IsCancelled()) continue;
 
         if (comparison_suggestions.empty()) {
             break;
@@ -13,7 +13,7 @@ namespace algos {
 
 class HyUCC : public UCCAlgorithm {
 private:
-    std::unique_ptr<ColumnLayoutRelationData> relation_;
+    std::shared_ptr<ColumnLayoutRelationData> relation_;
     config::ThreadNumType threads_num_ = 1;
 
     void LoadDataInternal() override;
@@ -26,11 +26,13 @@ private:
 
     void MakeExecuteOptsAvailable() final {
         MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
+        MakeBudgetOptionsAvailable();
     }
 
 public:
     HyUCC() : UCCAlgorithm({}) {
         RegisterOption(config::kThreadNumberOpt(&threads_num_));
+        RegisterBudgetOptions();
     }
 };
 
@@ -8,6 +8,8 @@ void Inductor::UpdateUCCTree(NonUCCList&& non_uccs) {
     for (unsigned level = max_level; level != 0; --level) {
         std::vector<model::RawUCC> cur_level = non_uccs.GetLevel(level);
         for (auto const& non_ucc : cur_level) {
+            // The tree is left with unvalidated candidates, as it is after any update
+            if (is_cancelled_()) return;
             SpecializeUCCTree(non_ucc);
         }
     }
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <functional>
+#include <utility>
+
 #include <boost/dynamic_bitset.hpp>
 
 #include "algorithms/ucc/hyucc/model/non_ucc_list.h"
@@ -11,11 +14,15 @@ namespace algos::hyucc {
 class Inductor {
 private:
     UCCTree* tree_;
+    // Polled between the non-UCCs, the update stops once it returns true
+    std::function<bool()> is_cancelled_;
 
     void SpecializeUCCTree(model::RawUCC const& non_ucc);
 
 public:
-    explicit Inductor(UCCTree* tree) noexcept : tree_(tree) {}
+    explicit Inductor(UCCTree* tree,
+                      std::function<bool()> is_cancelled = [] { return false; }) noexcept
+        : tree_(tree), is_cancelled_(std::move(is_cancelled)) {}
 
     void UpdateUCCTree(NonUCCList&& non_uccs);
 };
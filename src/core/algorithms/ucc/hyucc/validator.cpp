@@ -5,6 +5,7 @@
 #include <boost/asio/post.hpp>
 #include <boost/asio/thread_pool.hpp>
 
+#include "fd/hycommon/compressed_records.h"
 #include "fd/hycommon/efficiency_threshold.h"
 #include "fd/hycommon/validator_helpers.h"
 #include "ucc/hyucc/model/ucc_tree_vertex.h"
@@ -58,7 +59,7 @@ bool Validator::IsUnique(model::PLI const& pivot_pli, RawUCC const& ucc,
                 hy::MakeClusterIdentifierToTMap<model::PLI::Cluster::value_type>(cluster.size());
         for (auto const record_id : cluster) {
             std::vector<hy::ClusterId> cluster_id =
-                    hy::BuildClustersIdentifier((*compressed_records_)[record_id], indices);
+                    hy::BuildClustersIdentifier(*compressed_records_, record_id, indices);
             if (cluster_id.empty()) {
                 continue;
             }
@@ -107,6 +108,9 @@ Validator::UCCValidations Validator::ValidateAndExtendSeq(
         std::vector<LhsPair> const& current_level) {
     UCCValidations result;
     for (auto const& vertex_and_ucc : current_level) {
+        if (is_cancelled_()) {
+            break;
+        }
         if (!vertex_and_ucc.first->IsUCC()) {
             continue;
         }
@@ -127,7 +131,9 @@ Validator::UCCValidations Validator::ValidateAndExtendParallel(
         }
 
         std::packaged_task<UCCValidations()> task(
-                [this, &vertex_and_ucc]() { return GetValidations(vertex_and_ucc); });
+                [this, &vertex_and_ucc]() {
+                    return is_cancelled_() ? UCCValidations{} : GetValidations(vertex_and_ucc);
+                });
         validation_futures.push_back(task.get_future());
         boost::asio::post(pool, std::move(task));
     }
@@ -165,6 +171,10 @@ hy::IdPairs Validator::ValidateAndExtendCandidates() {
     hy::IdPairs comparison_suggestions;
     while (!current_level.empty()) {
         UCCValidations result = ValidateAndExtend(current_level);
+        if (is_cancelled_()) {
+            // The level may have been validated in part, so it is not counted as validated
+            return comparison_suggestions;
+        }
         comparison_suggestions.insert(comparison_suggestions.end(),
                                       result.ComparisonSuggestions().begin(),
                                       result.ComparisonSuggestions().end());
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cassert>
+#include <functional>
 #include <utility>
 #include <vector>
 
@@ -22,6 +23,8 @@ private:
     hy::RowsPtr compressed_records_;
     unsigned current_level_number_ = 1;
     config::ThreadNumType threads_num_ = 1;
+    // Polled between the candidates, the validation stops once it returns true
+    std::function<bool()> is_cancelled_;
 
     bool IsUnique(model::PLI const& pivot_pli, model::RawUCC const& ucc,
                   hy::IdPairs& comparison_suggestions);
@@ -32,13 +35,20 @@ private:
 
 public:
     Validator(UCCTree* tree, hy::PLIsPtr plis, hy::RowsPtr compressed_records,
-              config::ThreadNumType threads_num) noexcept
+              config::ThreadNumType threads_num,
+              std::function<bool()> is_cancelled = [] { return false; }) noexcept
         : tree_(tree),
           plis_(std::move(plis)),
           compressed_records_(std::move(compressed_records)),
-          threads_num_(threads_num) {}
+          threads_num_(threads_num),
+          is_cancelled_(std::move(is_cancelled)) {}
 
     hy::IdPairs ValidateAndExtendCandidates();
+
+    // UCCs with fewer columns than this have been validated
+    [[nodiscard]] unsigned GetLevelNum() const {
+        return current_level_number_;
+    }
 };
 
 }  // namespace algos::hyucc
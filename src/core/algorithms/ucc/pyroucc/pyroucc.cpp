@@ -11,6 +11,7 @@
 #include "config/max_lhs/option.h"
 #include "config/names_and_descriptions.h"
 #include "config/option_using.h"
+#include "model/table/dataset_cache.h"
 
 namespace algos {
 
@@ -37,7 +38,7 @@ void PyroUCC::MakeExecuteOptsAvailable() {
 }
 
 void PyroUCC::LoadDataInternal() {
-    relation_ = ColumnLayoutRelationData::CreateFrom(*input_table_, is_null_equal_null_);
+    relation_ = model::DatasetCache::Instance().GetRelation(*input_table_, is_null_equal_null_);
 
     if (relation_->GetColumnData().empty()) {
         throw std::runtime_error("Got an empty dataset: UCC mining is meaningless.");
@@ -90,7 +91,11 @@ unsigned long long PyroUCC::ExecuteInternal() {
 
     LOG(INFO) << "Init time: " << init_time_millis << "ms";
     LOG(INFO) << "Time: " << elapsed_milliseconds.count() << " milliseconds";
-    LOG(INFO) << "Total intersection time: " << model::PositionListIndex::micros_ / 1000 << "ms";
+    auto const intersection_time =
+            GetRunMetrics().GetTimerValue(model::PositionListIndex::kIntersectionTimeMetric).total;
+    LOG(INFO) << "Total intersection time: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(intersection_time).count()
+              << "ms";
     return elapsed_milliseconds.count();
 }
 
@@ -9,6 +9,7 @@
 #include "config/names_and_descriptions.h"
 #include "config/option_using.h"
 #include "config/tabular_data/input_table/option.h"
+#include "model/table/dataset_cache.h"
 
 namespace algos {
 
@@ -37,7 +38,7 @@ void UCCVerifier::MakeExecuteOptsAvailable() {
 }
 
 void UCCVerifier::LoadDataInternal() {
-    relation_ = ColumnLayoutRelationData::CreateFrom(*input_table_, is_null_equal_null_);
+    relation_ = model::DatasetCache::Instance().GetRelation(*input_table_, is_null_equal_null_);
 
     if (relation_->GetColumnData().empty()) {
         throw std::runtime_error("Got an empty dataset: UCC verifying is meaningless.");
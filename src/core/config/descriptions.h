@@ -84,7 +84,12 @@ constexpr auto kDWeight =
         "value lies in (0, 1]. Closer to 0 - many short intervals. "
         "Closer to 1 - small number of long intervals";
 constexpr auto kDBumpsLimit = "max considered intervals amount. Pass 0 to remove limit";
-constexpr auto kDTimeLimitSeconds = "max running time of the algorithm. Pass 0 to remove limit";
+constexpr auto kDTimeLimitSeconds =
+        "max running time of the algorithm in seconds. Once it is exceeded, the algorithm stops "
+        "and keeps the results found so far. Pass 0 to remove limit";
+constexpr auto kDMemoryBudgetMB =
+        "max memory taken by the process while the algorithm runs, in MBs. Once it is exceeded, "
+        "the algorithm stops and keeps the results found so far. Pass 0 to remove limit";
 constexpr auto kDIterationsLimit = "limit for iterations of sampling";
 constexpr auto kDACSeed = "seed, needed for choosing a data sample";
 constexpr auto kDHllAccuracy =
@@ -102,11 +107,16 @@ constexpr auto kDIgnoreConstantCols =
 constexpr auto kDGraphData = "Path to dot-file with graph";
 constexpr auto kDGfdData = "Path to file with GFD";
 constexpr auto kDMemLimitMB = "memory limit im MBs";
+constexpr auto kDPliSpillLimitKB =
+        "memory in KBs that PLIs of two adjacent lattice levels may take before new PLIs are "
+        "spilled to a temporary file, 0 disables spilling";
 constexpr auto kDDifferenceTable = "CSV table containing difference limits for each column";
 constexpr auto kDNumRows = "Use only first N rows of the table";
 constexpr auto kDNUmColumns = "Use only first N columns of the table";
 constexpr auto kDInsertStatements = "Rows to be inserted into the table using the insert operation";
 constexpr auto kDDeleteStatements = "Rows to be deleted from the table using the delete operation";
 constexpr auto kDUpdateStatements = "Rows to be replaced in the table using the update operation";
+constexpr auto kDFDs = "FDs to verify, given as pairs of LHS and RHS column indices";
+constexpr auto kDUCCs = "UCCs to verify, given as collections of column indices";
 constexpr auto kDNDWeight = "Weight of ND to verify (positive integer)";
 }  // namespace config::descriptions
@@ -0,0 +1,9 @@
+#include "config/memory_budget/option.h"
+
+#include "config/names_and_descriptions.h"
+
+namespace config {
+using names::kMemoryBudgetMB, descriptions::kDMemoryBudgetMB;
+extern CommonOption<MemoryBudgetMBType> const kMemoryBudgetMBOpt{kMemoryBudgetMB,
+                                                                 kDMemoryBudgetMB, 0u};
+}  // namespace config
@@ -0,0 +1,8 @@
+#pragma once
+
+#include "config/common_option.h"
+#include "config/memory_budget/type.h"
+
+namespace config {
+extern CommonOption<MemoryBudgetMBType> const kMemoryBudgetMBOpt;
+}  // namespace config
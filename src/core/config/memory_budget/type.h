@@ -0,0 +1,5 @@
+#pragma once
+
+namespace config {
+using MemoryBudgetMBType = unsigned int;
+}  // namespace config
@@ -39,6 +39,7 @@ constexpr auto kFuzzinessProbability = "p_fuzz";
 constexpr auto kWeight = "weight";
 constexpr auto kBumpsLimit = "bumps_limit";
 constexpr auto kTimeLimitSeconds = "time_limit";
+constexpr auto kMemoryBudgetMB = "memory_budget";
 constexpr auto kIterationsLimit = "iterations_limit";
 constexpr auto kACSeed = "ac_seed";
 constexpr auto kPreciseAlgorithm = "precise_algorithm";
@@ -56,10 +57,13 @@ constexpr auto kIgnoreConstantCols = "ignore_constant_cols";
 constexpr auto kGraphData = "graph";
 constexpr auto kGfdData = "gfd";
 constexpr auto kMemLimitMB = "mem_limit";
+constexpr auto kPliSpillLimitKB = "pli_spill_limit";
 constexpr auto kDifferenceTable = "difference_table";
 constexpr auto kNumRows = "num_rows";
 constexpr auto kNumColumns = "num_columns";
 constexpr auto kInsertStatements = "insert";
 constexpr auto kDeleteStatements = "delete";
 constexpr auto kUpdateStatements = "update";
+constexpr auto kFDs = "fds";
+constexpr auto kUCCs = "uccs";
 }  // namespace config::names
@@ -1,18 +1,14 @@
 #include "agree_set_factory.h"
 
+#include <algorithm>
 #include <atomic>
 #include <condition_variable>
-#include <shared_mutex>
+#include <map>
+#include <mutex>
+#include <numeric>
 #include <thread>
 #include <unordered_set>
 
-#include <boost/asio/post.hpp>
-#include <boost/asio/thread_pool.hpp>
-#include <boost/thread/shared_mutex.hpp>
-
-#define BOOST_THREAD_PROVIDES_FUTURE_WHEN_ALL_WHEN_ANY
-#include <boost/thread.hpp>
-#include <boost/thread/future.hpp>
 #include <easylogging++.h>
 
 #include "identifier_set.h"
@@ -51,7 +47,7 @@ AgreeSetFactory::SetOfAgreeSets AgreeSetFactory::GenAgreeSets() const {
     }
 
     // metanome kostil, doesn't work properly in general
-    agree_sets.insert(*relation_->GetSchema()->empty_vertical_);
+    agree_sets.insert(AgreeSet(relation_->GetNumColumns()));
 
     auto elapsed_mills_to_gen_agree_sets = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::system_clock::now() - start_time);
@@ -99,8 +95,9 @@ AgreeSetFactory::SetOfAgreeSets AgreeSetFactory::GenAsUsingVectorOfIdSets() cons
                                  : algos::FDAlgorithm::kTotalProgressPercent / pairs_num;
         auto back_it = std::prev(identifier_sets.end());
         for (auto p = identifier_sets.begin(); p != back_it; ++p) {
+            CheckCancellation();
             for (auto q = std::next(p); q != identifier_sets.end(); ++q) {
-                agree_sets.insert(p->Intersect(*q));
+                agree_sets.insert(p->IntersectIndices(*q));
                 AddProgress(percent_per_idset);
             }
         }
@@ -146,7 +143,7 @@ AgreeSetFactory::SetOfAgreeSets AgreeSetFactory::GenAsUsingMapOfIdSets() const {
          * max_representation. Leads to the bulky code with synchronization primitives or to
          * the copying of util::ParallelForeach code.
          */
-        std::map<std::thread::id, std::unordered_set<AgreeSet>> threads_agree_sets;
+        std::map<std::thread::id, SetOfAgreeSets> threads_agree_sets;
         std::condition_variable map_init_cv;
         bool map_initialized = false;
         std::mutex map_init_mutex;
@@ -166,7 +163,7 @@ AgreeSetFactory::SetOfAgreeSets AgreeSetFactory::GenAsUsingMapOfIdSets() const {
 
             if (!map_initialized) {
                 std::unique_lock lock(map_init_mutex);
-                threads_agree_sets.insert({thread_id, std::unordered_set<AgreeSet>()});
+                threads_agree_sets.insert({thread_id, SetOfAgreeSets()});
                 if (threads_agree_sets.size() != actual_threads_num) {
                     map_init_cv.wait(lock, [&map_initialized]() { return map_initialized; });
                 } else {
@@ -174,13 +171,14 @@ AgreeSetFactory::SetOfAgreeSets AgreeSetFactory::GenAsUsingMapOfIdSets() const {
                     map_init_cv.notify_all();
                 }
             }
+            if (IsCancelled()) return;
 
             auto back_it = std::prev(cluster.cend());
             for (auto p = cluster.cbegin(); p != back_it; ++p) {
                 for (auto q = std::next(p); q != cluster.end(); ++q) {
                     IdentifierSet const& id_set1 = identifier_sets.at(*p);
                     IdentifierSet const& id_set2 = identifier_sets.at(*q);
-                    threads_agree_sets[thread_id].insert(id_set1.Intersect(id_set2));
+                    threads_agree_sets[thread_id].insert(id_set1.IntersectIndices(id_set2));
                 }
             }
             AddProgress(percent_per_cluster);
@@ -188,6 +186,7 @@ AgreeSetFactory::SetOfAgreeSets AgreeSetFactory::GenAsUsingMapOfIdSets() const {
 
         util::ParallelForeach(max_representation.begin(), max_representation.end(),
                               config_.threads_num, task);
+        CheckCancellation();
 
         for (auto& [thread_id, thread_as] : threads_agree_sets) {
             agree_sets.insert(std::make_move_iterator(thread_as.begin()),
@@ -195,12 +194,13 @@ AgreeSetFactory::SetOfAgreeSets AgreeSetFactory::GenAsUsingMapOfIdSets() const {
         }
     } else {
         for (auto const& cluster : max_representation) {
+            CheckCancellation();
             auto back_it = std::prev(cluster.end());
             for (auto p = cluster.begin(); p != back_it; ++p) {
                 for (auto q = std::next(p); q != cluster.end(); ++q) {
                     IdentifierSet const& id_set1 = identifier_sets.at(*p);
                     IdentifierSet const& id_set2 = identifier_sets.at(*q);
-                    agree_sets.insert(id_set1.Intersect(id_set2));
+                    agree_sets.insert(id_set1.IntersectIndices(id_set2));
                 }
             }
             AddProgress(percent_per_cluster);
@@ -217,6 +217,7 @@ AgreeSetFactory::SetOfAgreeSets AgreeSetFactory::GenAsUsingMcAndGetAgreeSets() c
     // Compute agree sets from maximal representation using GetAgreeSet()
     // ~3300 ms on CIPublicHighway700 (Debug build), ~250 ms (Release)
     for (auto const& cluster : max_representation) {
+        CheckCancellation();
         for (auto p = cluster.begin(); p != cluster.end(); ++p) {
             for (auto q = std::next(p); q != cluster.end(); ++q) {
                 agree_sets.insert(GetAgreeSet(*p, *q));
@@ -258,7 +259,7 @@ AgreeSet AgreeSetFactory::GetAgreeSet(int const tuple1_index, int const tuple2_i
         }
     }
 
-    return relation_->GetSchema()->GetVertical(agree_set_indices);
+    return agree_set_indices;
 }
 
 AgreeSetFactory::SetOfVectors AgreeSetFactory::GenPliMaxRepresentation() const {
@@ -418,74 +419,62 @@ AgreeSetFactory::SetOfVectors AgreeSetFactory::GenMcUsingHandlePartition() const
     return max_representation;
 }
 
-/* This code has false positive helgrind data race error in the unique_future-packaged_task
- * interaction. Also it is slow due to the way it enforces thread safety on index and
- * max_representation access (shared_mutex.lock/unlock). Need to fix it first with
- * concurrency hash map, check out libcds.
- */
 AgreeSetFactory::SetOfVectors AgreeSetFactory::GenMcParallel() const {
-    throw std::runtime_error("MCParallel max representation method is not implemented yet.");
-#if 0
-    if (config_.threads_num == 1) {
-        LOG(WARNING) << "Using parallel max representation generation"
-                        " method with 1 thread specified";
+    vector<ColumnData> const& columns_data = relation_->GetColumnData();
+    SetOfVectors max_representation;
+
+    // Equivalence classes of all partitions without duplicates
+    SetOfVectors distinct_eqv_classes;
+    for (ColumnData const& data : columns_data) {
+        std::deque<vector<int>> const& index = data.GetPositionListIndex()->GetIndex();
+        distinct_eqv_classes.insert(index.begin(), index.end());
+    }
+    vector<vector<int> const*> eqv_classes;
+    eqv_classes.reserve(distinct_eqv_classes.size());
+    for (vector<int> const& eqv_class : distinct_eqv_classes) {
+        eqv_classes.push_back(&eqv_class);
     }
 
-    SetOfVectors max_representation;
-    auto greater = [](vector<int> const& lhs, vector<int> const& rhs) {
-        if (lhs.size() != rhs.size()) {
-            return lhs.size() > rhs.size();
+    // tuple_classes[t] are the indices of equivalence classes containing tuple t
+    vector<vector<size_t>> tuple_classes(relation_->GetNumRows());
+    for (size_t i = 0; i < eqv_classes.size(); ++i) {
+        for (int tuple_index : *eqv_classes[i]) {
+            tuple_classes[tuple_index].push_back(i);
         }
-        return std::lexicographical_compare(lhs.begin(), lhs.end(),
-                                            rhs.begin(), rhs.end(),
-                                            std::greater<int>());
-    };
-    auto sorted_eqv_classes = genSortedEqvClasses(greater);
-    std::unordered_map<int, unordered_set<size_t>> index;
+    }
 
-    boost::asio::thread_pool pool(config_.threads_num);
-    boost::shared_mutex mutex;
-    auto handle_partition = [this, &index, &max_representation, &mutex]
-                            (vector<int>&& cur_eqv_class, size_t const eqv_class_index) {
-        boost::shared_lock read_lock(mutex);
-        bool is_subset = isSubset(cur_eqv_class, index);
-        if (!is_subset) {
-            read_lock.unlock();
-            // At every moment in time only one thread can modify index and max_representation
-            boost::unique_lock write_lock(mutex);
-
-            for (int tuple_index : cur_eqv_class) {
-                index[tuple_index].insert(eqv_class_index);
-            }
-            max_representation.insert(std::move(cur_eqv_class));
-        }
+    vector<char> is_maximal(eqv_classes.size());
+    auto check_eqv_class = [&eqv_classes, &tuple_classes, &is_maximal](size_t const& i) {
+        vector<int> const& eqv_class = *eqv_classes[i];
+        // Every superset of the class contains each of its tuples, the rarest one gives the
+        // fewest candidates
+        auto rarest_tuple = std::min_element(
+                eqv_class.begin(), eqv_class.end(), [&tuple_classes](int lhs, int rhs) {
+                    return tuple_classes[lhs].size() < tuple_classes[rhs].size();
+                });
+        is_maximal[i] = std::none_of(
+                tuple_classes[*rarest_tuple].begin(), tuple_classes[*rarest_tuple].end(),
+                [&eqv_classes, &eqv_class](size_t candidate) {
+                    vector<int> const& other = *eqv_classes[candidate];
+                    // Clusters are sorted, equal classes are merged above
+                    return other.size() > eqv_class.size() &&
+                           std::includes(other.begin(), other.end(), eqv_class.begin(),
+                                         eqv_class.end());
+                });
     };
 
-    using Task = boost::packaged_task<void>;
-    std::vector<boost::unique_future<Task::result_type>> futures;
-    size_t eqv_class_index = 0;
-    size_t cur_size = 0;
-    for (auto it = sorted_eqv_classes.begin();
-         it != sorted_eqv_classes.end();
-         ++eqv_class_index) {
-        if (cur_size != it->size()) {
-            cur_size = it->size();
-            boost::wait_for_all(futures.begin(), futures.end());
-            futures.clear();
-        }
+    vector<size_t> indices(eqv_classes.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    unsigned const threads_num = std::max<unsigned>(config_.threads_num, 1);
+    util::ParallelForeach(indices.begin(), indices.end(), threads_num, check_eqv_class);
 
-        Task t([eqv_class = std::move(sorted_eqv_classes.extract(it++).value()),
-                eqv_class_index, &handle_partition] () mutable
-                { handle_partition(std::move(eqv_class), eqv_class_index); }
-        );
-        futures.push_back(t.get_future());
-        boost::asio::post(pool, std::move(t));
+    for (size_t i = 0; i < eqv_classes.size(); ++i) {
+        if (is_maximal[i]) {
+            max_representation.insert(*eqv_classes[i]);
+        }
     }
 
-    pool.join();
-
     return max_representation;
-#endif
 }
 
 bool AgreeSetFactory::IsSubset(vector<int> const& eqv_class,
@@ -6,6 +6,7 @@
 #include <unordered_set>
 #include <vector>
 
+#include <boost/dynamic_bitset.hpp>
 #include <boost/functional/hash.hpp>
 
 #include "algorithms/fd/fd_algorithm.h"
@@ -15,7 +16,8 @@
 
 namespace model {
 
-using AgreeSet = Vertical;
+/* Agree set of two tuples packed into a bitset, bit i is set iff the tuples agree on column i */
+using AgreeSet = boost::dynamic_bitset<>;
 
 enum class AgreeSetsGenMethod {
     kUsingVectorOfIDSets = 0, /*< Generates agree sets using identifier sets.
@@ -104,9 +106,13 @@ enum class MCGenMethod {
                                *     And adds (also delayed) appropriate equivalence class to
                                *     max_representation.
                                */
-    kParallel                 /*< Algorithm is the same as in kUsingHandlePartition method.
-                               *  Uses thread pool of config_.threads_num threads to perform
-                               *  'handlePartition' part on equivalence classes of the same size.
+    kParallel                 /*< Indexes all equivalence classes of all partitions by the tuples
+                               *  they contain. An equivalence class belongs to the maximal
+                               *  representation iff no larger class contains it, so the candidate
+                               *  supersets of a class are the larger classes containing its tuple
+                               *  which occurs in the fewest classes. Classes are checked
+                               *  independently on config_.threads_num threads, the index is only
+                               *  read while checking.
                                */
 };
 
@@ -134,7 +140,8 @@ public:
     };
 
     using SetOfVectors = std::unordered_set<std::vector<int>, boost::hash<std::vector<int>>>;
-    using SetOfAgreeSets = std::unordered_set<AgreeSet>;
+    /* Distinct agree sets, hashed by all words of the bitset */
+    using SetOfAgreeSets = std::unordered_set<AgreeSet, util::BitsetHash>;
 
     explicit AgreeSetFactory(ColumnLayoutRelationData const* const rel,
                              Configuration const& c = Configuration(),
@@ -196,6 +203,16 @@ private:
         }
     }
 
+    bool IsCancelled() const noexcept {
+        return algo_ != nullptr && algo_->IsCancelled();
+    }
+
+    void CheckCancellation() const {
+        if (algo_ != nullptr) {
+            algo_->CheckCancellation();
+        }
+    }
+
     ColumnLayoutRelationData const* const relation_;
 
     Configuration config_;
@@ -0,0 +1,181 @@
+#include "model/table/column_buffer.h"
+
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <utility>
+
+#include "model/types/builtin.h"
+
+namespace {
+
+/* Formats a double the way Python's repr does: the shortest round-trip digits, in positional
+ * notation with at least one fractional digit for decimal exponents in [-4, 16) and in scientific
+ * notation otherwise */
+std::string FormatDouble(double value) {
+    if (std::isinf(value)) {
+        return value > 0 ? "inf" : "-inf";
+    }
+    char buffer[32];
+    auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value,
+                                   std::chars_format::scientific);
+    assert(ec == std::errc{});
+    std::string_view const scientific(buffer, end - buffer);
+    std::size_t const exponent_pos = scientific.find('e');
+    int exponent = 0;
+    std::string_view exponent_str = scientific.substr(exponent_pos + 1);
+    bool const negative_exponent = exponent_str.front() == '-';
+    std::from_chars(exponent_str.data() + 1, exponent_str.data() + exponent_str.size(), exponent);
+    if (negative_exponent) exponent = -exponent;
+    if (exponent < -4 || exponent >= 16) {
+        return std::string(scientific);
+    }
+
+    std::string digits;
+    for (char c : scientific.substr(0, exponent_pos)) {
+        if (c != '-' && c != '.') digits.push_back(c);
+    }
+    std::string result = scientific.front() == '-' ? "-" : "";
+    if (exponent < 0) {
+        result.append("0.");
+        result.append(-exponent - 1, '0');
+        result.append(digits);
+    } else if (digits.size() <= static_cast<std::size_t>(exponent) + 1) {
+        result.append(digits);
+        result.append(exponent + 1 - digits.size(), '0');
+        result.append(".0");
+    } else {
+        result.append(digits, 0, exponent + 1);
+        result.push_back('.');
+        result.append(digits, exponent + 1);
+    }
+    return result;
+}
+
+}  // namespace
+
+namespace model {
+
+ColumnBuffer ColumnBuffer::Numeric(ElementType type, std::size_t size, void const* data,
+                                   std::ptrdiff_t stride, std::uint8_t const* validity,
+                                   std::size_t validity_offset, std::shared_ptr<void const> owner) {
+    ColumnBuffer buffer(type, size);
+    assert(buffer.IsNumeric());
+    buffer.data_ = static_cast<std::byte const*>(data);
+    buffer.stride_ = stride;
+    buffer.validity_ = validity;
+    buffer.offset_ = validity_offset;
+    buffer.owner_ = std::move(owner);
+    return buffer;
+}
+
+ColumnBuffer ColumnBuffer::Strings(ElementType type, std::size_t size, char const* data,
+                                   void const* offsets, std::uint8_t const* validity,
+                                   std::size_t offset, std::shared_ptr<void const> owner) {
+    assert(type == ElementType::kUtf8 || type == ElementType::kLargeUtf8);
+    ColumnBuffer buffer(type, size);
+    buffer.data_ = reinterpret_cast<std::byte const*>(data);
+    buffer.offsets_ = offsets;
+    buffer.validity_ = validity;
+    buffer.offset_ = offset;
+    buffer.owner_ = std::move(owner);
+    return buffer;
+}
+
+ColumnBuffer ColumnBuffer::Materialized(std::vector<std::string> values) {
+    ColumnBuffer buffer(ElementType::kMaterialized, values.size());
+    buffer.materialized_ = std::move(values);
+    return buffer;
+}
+
+std::size_t ColumnBuffer::GetElementSize(ElementType type) noexcept {
+    switch (type) {
+        case ElementType::kInt8:
+        case ElementType::kUInt8:
+            return 1;
+        case ElementType::kInt16:
+        case ElementType::kUInt16:
+            return 2;
+        case ElementType::kInt32:
+        case ElementType::kUInt32:
+        case ElementType::kFloat32:
+            return 4;
+        case ElementType::kInt64:
+        case ElementType::kUInt64:
+        case ElementType::kFloat64:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+std::int64_t ColumnBuffer::GetSignedInteger(std::size_t index) const noexcept {
+    assert(index < size_);
+    switch (type_) {
+        case ElementType::kInt8:
+            return Load<std::int8_t>(index);
+        case ElementType::kInt16:
+            return Load<std::int16_t>(index);
+        case ElementType::kInt32:
+            return Load<std::int32_t>(index);
+        case ElementType::kInt64:
+            return Load<std::int64_t>(index);
+        default:
+            assert(false);
+            return 0;
+    }
+}
+
+std::uint64_t ColumnBuffer::GetUnsignedInteger(std::size_t index) const noexcept {
+    assert(index < size_);
+    switch (type_) {
+        case ElementType::kUInt8:
+            return Load<std::uint8_t>(index);
+        case ElementType::kUInt16:
+            return Load<std::uint16_t>(index);
+        case ElementType::kUInt32:
+            return Load<std::uint32_t>(index);
+        case ElementType::kUInt64:
+            return Load<std::uint64_t>(index);
+        default:
+            assert(false);
+            return 0;
+    }
+}
+
+double ColumnBuffer::GetFloatingPoint(std::size_t index) const noexcept {
+    assert(index < size_);
+    if (type_ == ElementType::kFloat32) {
+        return Load<float>(index);
+    }
+    assert(type_ == ElementType::kFloat64);
+    return Load<double>(index);
+}
+
+std::uint64_t ColumnBuffer::GetNumericBits(std::size_t index) const noexcept {
+    if (IsSignedInteger()) {
+        return static_cast<std::uint64_t>(GetSignedInteger(index));
+    }
+    if (IsUnsignedInteger()) {
+        return GetUnsignedInteger(index);
+    }
+    return std::bit_cast<std::uint64_t>(GetFloatingPoint(index));
+}
+
+std::string ColumnBuffer::ToString(std::size_t index) const {
+    if (IsNull(index)) {
+        return std::string(Null::kValue);
+    }
+    if (IsSignedInteger()) {
+        return std::to_string(GetSignedInteger(index));
+    }
+    if (IsUnsignedInteger()) {
+        return std::to_string(GetUnsignedInteger(index));
+    }
+    if (IsFloatingPoint()) {
+        return FormatDouble(GetFloatingPoint(index));
+    }
+    return std::string(GetString(index));
+}
+
+}  // namespace model
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace model {
+
+/* Read-only view of one column stored in contiguous memory owned by someone else, e.g. a NumPy
+ * array or an Arrow array. Numeric values are fixed-size elements separated by a byte stride, as
+ * in NumPy. String values follow the Arrow layout: characters of element i are
+ * data[offsets[i], offsets[i + 1]). An optional validity bitmap follows Arrow too: element i is
+ * null if bit i (least significant bit first) is not set. NaN floating point values are nulls as
+ * well.
+ * Columns that cannot be viewed in place are stored as materialized strings. */
+class ColumnBuffer {
+public:
+    enum class ElementType {
+        kInt8,
+        kInt16,
+        kInt32,
+        kInt64,
+        kUInt8,
+        kUInt16,
+        kUInt32,
+        kUInt64,
+        kFloat32,
+        kFloat64,
+        kUtf8,      /* Arrow string with 32-bit offsets */
+        kLargeUtf8, /* Arrow string with 64-bit offsets */
+        kMaterialized
+    };
+
+private:
+    ElementType type_;
+    std::size_t size_;
+    std::byte const* data_ = nullptr;
+    std::ptrdiff_t stride_ = 0;
+    void const* offsets_ = nullptr;
+    std::uint8_t const* validity_ = nullptr;
+    /* Index of the first element in the offsets and validity buffers (Arrow array offset) */
+    std::size_t offset_ = 0;
+    std::vector<std::string> materialized_;
+    int const* codes_ = nullptr;
+    /* Keeps the viewed memory alive */
+    std::shared_ptr<void const> owner_;
+
+    ColumnBuffer(ElementType type, std::size_t size) : type_(type), size_(size) {}
+
+    template <typename T>
+    T Load(std::size_t index) const noexcept {
+        T value;
+        std::memcpy(&value, data_ + static_cast<std::ptrdiff_t>(index) * stride_, sizeof(T));
+        return value;
+    }
+
+    std::int64_t GetStringOffset(std::size_t index) const noexcept {
+        if (type_ == ElementType::kUtf8) {
+            return static_cast<std::int32_t const*>(offsets_)[offset_ + index];
+        }
+        return static_cast<std::int64_t const*>(offsets_)[offset_ + index];
+    }
+
+public:
+    /* data points to the first element, validity may be null if there are no nulls */
+    static ColumnBuffer Numeric(ElementType type, std::size_t size, void const* data,
+                                std::ptrdiff_t stride, std::uint8_t const* validity,
+                                std::size_t validity_offset, std::shared_ptr<void const> owner);
+
+    /* offsets and validity are indexed from offset, the characters of data are indexed by the
+     * offsets themselves */
+    static ColumnBuffer Strings(ElementType type, std::size_t size, char const* data,
+                                void const* offsets, std::uint8_t const* validity,
+                                std::size_t offset, std::shared_ptr<void const> owner);
+
+    static ColumnBuffer Materialized(std::vector<std::string> values);
+
+    static std::size_t GetElementSize(ElementType type) noexcept;
+
+    /* Value ids of the elements, computed beforehand: equal values have equal ids and empty
+     * strings have ColumnLayoutRelationData::kNullValueId. Relation data is built from them
+     * without comparing the values. The ids are viewed in place as well */
+    void SetCodes(int const* codes) noexcept {
+        codes_ = codes;
+    }
+
+    int const* GetCodes() const noexcept {
+        return codes_;
+    }
+
+    ElementType GetElementType() const noexcept {
+        return type_;
+    }
+
+    std::size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    bool IsSignedInteger() const noexcept {
+        return type_ >= ElementType::kInt8 && type_ <= ElementType::kInt64;
+    }
+
+    bool IsUnsignedInteger() const noexcept {
+        return type_ >= ElementType::kUInt8 && type_ <= ElementType::kUInt64;
+    }
+
+    bool IsFloatingPoint() const noexcept {
+        return type_ == ElementType::kFloat32 || type_ == ElementType::kFloat64;
+    }
+
+    bool IsNumeric() const noexcept {
+        return IsSignedInteger() || IsUnsignedInteger() || IsFloatingPoint();
+    }
+
+    bool IsNull(std::size_t index) const noexcept {
+        assert(index < size_);
+        if (validity_ != nullptr) {
+            std::size_t const bit = offset_ + index;
+            if ((validity_[bit / 8] & (1u << (bit % 8))) == 0) return true;
+        }
+        if (type_ == ElementType::kFloat32 || type_ == ElementType::kFloat64) {
+            double const value = GetFloatingPoint(index);
+            return value != value;
+        }
+        return false;
+    }
+
+    std::int64_t GetSignedInteger(std::size_t index) const noexcept;
+    std::uint64_t GetUnsignedInteger(std::size_t index) const noexcept;
+    double GetFloatingPoint(std::size_t index) const noexcept;
+
+    /* Bit pattern of a numeric value, equal for equal values and different for different ones */
+    std::uint64_t GetNumericBits(std::size_t index) const noexcept;
+
+    std::string_view GetString(std::size_t index) const noexcept {
+        assert(index < size_);
+        if (type_ == ElementType::kMaterialized) {
+            return materialized_[index];
+        }
+        std::int64_t const begin = GetStringOffset(index);
+        std::int64_t const end = GetStringOffset(index + 1);
+        return {reinterpret_cast<char const*>(data_) + begin,
+                static_cast<std::size_t>(end - begin)};
+    }
+
+    /* Textual representation of a value, as produced by the row-wise dataframe readers: nulls are
+     * Null::kValue and floating point values use the shortest round-trip notation of Python's
+     * repr */
+    std::string ToString(std::size_t index) const;
+};
+
+}  // namespace model
@@ -4,11 +4,58 @@
 //
 #include "column_layout_relation_data.h"
 
+#include <cstdint>
 #include <map>
 #include <memory>
+#include <string_view>
+#include <unordered_map>
 #include <utility>
 
-#include <easylogging++.h>
+#include "model/table/relation_data_loader.h"
+#include "model/types/builtin.h"
+
+namespace {
+
+/* Gives equal cells of the column equal ids, as the row-wise encoding of their string
+ * representations does: nulls are equal to the "NULL" string, empty strings get kNullValueId */
+std::vector<int> EncodeColumn(model::ColumnBuffer const& column) {
+    if (int const* precomputed = column.GetCodes(); precomputed != nullptr) {
+        return std::vector<int>(precomputed, precomputed + column.GetSize());
+    }
+    std::vector<int> codes(column.GetSize());
+    int next_value_id = 1;
+    if (!column.IsNumeric()) {
+        std::unordered_map<std::string_view, int> value_dictionary;
+        for (size_t row = 0; row < codes.size(); ++row) {
+            std::string_view const value =
+                    column.IsNull(row) ? model::Null::kValue : column.GetString(row);
+            if (value.empty()) {
+                codes[row] = ColumnLayoutRelationData::kNullValueId;
+                continue;
+            }
+            auto [it, is_new] = value_dictionary.try_emplace(value, next_value_id);
+            if (is_new) ++next_value_id;
+            codes[row] = it->second;
+        }
+        return codes;
+    }
+
+    std::unordered_map<std::uint64_t, int> value_dictionary;
+    int null_value_id = 0;
+    for (size_t row = 0; row < codes.size(); ++row) {
+        if (column.IsNull(row)) {
+            if (null_value_id == 0) null_value_id = next_value_id++;
+            codes[row] = null_value_id;
+            continue;
+        }
+        auto [it, is_new] = value_dictionary.try_emplace(column.GetNumericBits(row), next_value_id);
+        if (is_new) ++next_value_id;
+        codes[row] = it->second;
+    }
+    return codes;
+}
+
+}  // namespace
 
 std::vector<int> ColumnLayoutRelationData::GetTuple(int tuple_index) const {
     int num_columns = schema_->GetNumColumns();
@@ -21,47 +68,38 @@ std::vector<int> ColumnLayoutRelationData::GetTuple(int tuple_index) const {
 
 std::unique_ptr<ColumnLayoutRelationData> ColumnLayoutRelationData::CreateFrom(
         model::IDatasetStream& data_stream, bool is_null_eq_null) {
-    auto schema = std::make_unique<RelationalSchema>(data_stream.GetRelationName());
-    std::unordered_map<std::string, int> value_dictionary;
-    int next_value_id = 1;
-    int const null_value_id = kNullValueId;
-    size_t const num_columns = data_stream.GetNumberOfColumns();
-    std::vector<std::vector<int>> column_vectors = std::vector<std::vector<int>>(num_columns);
-    std::vector<std::string> row;
+    return model::LoadRelationData(data_stream, is_null_eq_null, {.relation = true}).relation;
+}
 
-    while (data_stream.HasNextRow()) {
-        row = data_stream.GetNextRow();
+std::unique_ptr<ColumnLayoutRelationData> ColumnLayoutRelationData::CreateFrom(
+        std::string relation_name, std::vector<std::string> const& column_names,
+        std::vector<std::vector<int>> column_codes, bool is_null_eq_null) {
+    auto schema = std::make_unique<RelationalSchema>(std::move(relation_name));
+    std::vector<ColumnData> column_data;
+    for (size_t i = 0; i < column_names.size(); ++i) {
+        auto column = Column(schema.get(), column_names[i], i);
+        schema->AppendColumn(std::move(column));
+        auto pli = model::PositionListIndex::CreateFor(column_codes[i], is_null_eq_null);
+        std::vector<int>().swap(column_codes[i]);
+        column_data.emplace_back(schema->GetColumn(i), std::move(pli));
+    }
 
-        if (row.size() != num_columns) {
-            LOG(WARNING) << "Unexpected number of columns for a row, skipping (expected "
-                         << num_columns << ", got " << row.size() << ")";
-            continue;
-        }
+    schema->Init();
 
-        for (size_t index = 0; index < row.size(); ++index) {
-            std::string const& field = row[index];
-            if (field.empty()) {
-                column_vectors[index].push_back(null_value_id);
-            } else {
-                auto location = value_dictionary.find(field);
-                int value_id;
-                if (location == value_dictionary.end()) {
-                    value_dictionary[field] = next_value_id;
-                    value_id = next_value_id;
-                    next_value_id++;
-                } else {
-                    value_id = location->second;
-                }
-                column_vectors[index].push_back(value_id);
-            }
-        }
-    }
+    return std::make_unique<ColumnLayoutRelationData>(std::move(schema), std::move(column_data));
+}
+
+std::unique_ptr<ColumnLayoutRelationData> ColumnLayoutRelationData::CreateFrom(
+        model::ColumnarDatasetStream const& dataset, bool is_null_eq_null) {
+    auto schema = std::make_unique<RelationalSchema>(dataset.GetRelationName());
+    size_t const num_columns = dataset.GetNumberOfColumns();
 
     std::vector<ColumnData> column_data;
     for (size_t i = 0; i < num_columns; ++i) {
-        auto column = Column(schema.get(), data_stream.GetColumnName(i), i);
+        auto column = Column(schema.get(), dataset.GetColumnName(i), i);
         schema->AppendColumn(std::move(column));
-        auto pli = model::PositionListIndex::CreateFor(column_vectors[i], is_null_eq_null);
+        std::vector<int> codes = EncodeColumn(dataset.GetColumn(i));
+        auto pli = model::PositionListIndex::CreateFor(codes, is_null_eq_null);
         column_data.emplace_back(schema->GetColumn(i), std::move(pli));
     }
 
@@ -6,9 +6,11 @@
 #pragma once
 
 #include <cmath>
+#include <string>
 #include <vector>
 
 #include "column_data.h"
+#include "columnar_dataset_stream.h"
 #include "idataset_stream.h"
 #include "relation_data.h"
 #include "relational_schema.h"
@@ -30,4 +32,13 @@ public:
 
     static std::unique_ptr<ColumnLayoutRelationData> CreateFrom(model::IDatasetStream& data_stream,
                                                                 bool is_null_eq_null);
+    /* Builds the relation from the value ids of the cells: equal cells of a column have equal ids,
+     * empty cells have kNullValueId */
+    static std::unique_ptr<ColumnLayoutRelationData> CreateFrom(
+            std::string relation_name, std::vector<std::string> const& column_names,
+            std::vector<std::vector<int>> column_codes, bool is_null_eq_null);
+    /* Encodes every column straight from its buffer, cells are compared in place without being
+     * converted to strings */
+    static std::unique_ptr<ColumnLayoutRelationData> CreateFrom(
+            model::ColumnarDatasetStream const& dataset, bool is_null_eq_null);
 };
@@ -1,43 +1,89 @@
 #include "column_layout_typed_relation_data.h"
 
-#include <easylogging++.h>
+#include <algorithm>
+#include <exception>
+#include <numeric>
+#include <optional>
+
+#include "relation_data_loader.h"
+#include "util/parallel_for.h"
+
+namespace {
+
+/* Types of the columns are inferred independently, so every column is created by its own task */
+template <typename CreateColumn>
+std::vector<model::TypedColumnData> CreateColumnsInParallel(size_t num_columns,
+                                                            config::ThreadNumType threads,
+                                                            CreateColumn create_column) {
+    std::vector<std::optional<model::TypedColumnData>> created(num_columns);
+    std::vector<std::exception_ptr> errors(num_columns);
+    std::vector<size_t> indices(num_columns);
+    std::iota(indices.begin(), indices.end(), 0);
+    unsigned const threads_num = std::max<unsigned>(threads, 1);
+    util::ParallelForeach(indices.begin(), indices.end(), threads_num, [&](size_t i) {
+        try {
+            created[i].emplace(create_column(i));
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+    });
+
+    std::vector<model::TypedColumnData> column_data;
+    column_data.reserve(num_columns);
+    for (size_t i = 0; i != num_columns; ++i) {
+        if (errors[i]) std::rethrow_exception(errors[i]);
+        column_data.push_back(std::move(*created[i]));
+    }
+    return column_data;
+}
+
+}  // namespace
 
 namespace model {
 
 std::unique_ptr<ColumnLayoutTypedRelationData> ColumnLayoutTypedRelationData::CreateFrom(
-        IDatasetStream& data_stream, bool is_null_eq_null) {
-    auto schema = std::make_unique<RelationalSchema>(data_stream.GetRelationName());
-    size_t const num_columns = data_stream.GetNumberOfColumns();
-
-    std::vector<std::vector<std::string>> columns(num_columns);
-    std::vector<std::string> row;
-
-    /* Parsing is very similar to ColumnLayoutRelationData::CreateFrom().
-     * Maybe we need column-based parsing in addition to row-based in CSVParser
-     * (now IDatasetStream) */
-    while (data_stream.HasNextRow()) {
-        row = data_stream.GetNextRow();
-
-        if (row.size() != num_columns) {
-            LOG(WARNING) << "Unexpected number of columns for a row, skipping (expected "
-                         << num_columns << ", got " << row.size() << ")";
-            continue;
-        }
+        IDatasetStream& data_stream, bool is_null_eq_null, config::ThreadNumType threads) {
+    return LoadRelationData(data_stream, is_null_eq_null, {.typed_relation = true}, threads)
+            .typed_relation;
+}
 
-        for (size_t index = 0; index < row.size(); ++index) {
-            std::string& field = row[index];
-            columns[index].push_back(std::move(field));
-        }
+std::unique_ptr<ColumnLayoutTypedRelationData> ColumnLayoutTypedRelationData::CreateFrom(
+        std::string relation_name, std::vector<std::string> const& column_names,
+        std::vector<std::vector<std::string>> columns, bool is_null_eq_null,
+        config::ThreadNumType threads) {
+    auto schema = std::make_unique<RelationalSchema>(std::move(relation_name));
+    size_t const num_columns = column_names.size();
+    for (size_t i = 0; i < num_columns; ++i) {
+        Column column(schema.get(), column_names[i], i);
+        schema->AppendColumn(std::move(column));
     }
+    std::vector<TypedColumnData> column_data =
+            CreateColumnsInParallel(num_columns, threads, [&](size_t i) {
+                return model::TypedColumnDataFactory::CreateFrom(
+                        schema->GetColumn(i), std::move(columns[i]), is_null_eq_null);
+            });
+
+    schema->Init();
+
+    return std::make_unique<ColumnLayoutTypedRelationData>(std::move(schema),
+                                                           std::move(column_data));
+}
+
+std::unique_ptr<ColumnLayoutTypedRelationData> ColumnLayoutTypedRelationData::CreateFrom(
+        ColumnarDatasetStream const& dataset, bool is_null_eq_null,
+        config::ThreadNumType threads) {
+    auto schema = std::make_unique<RelationalSchema>(dataset.GetRelationName());
+    size_t const num_columns = dataset.GetNumberOfColumns();
 
-    std::vector<TypedColumnData> column_data;
     for (size_t i = 0; i < num_columns; ++i) {
-        Column column(schema.get(), data_stream.GetColumnName(i), i);
+        Column column(schema.get(), dataset.GetColumnName(i), i);
         schema->AppendColumn(std::move(column));
-        TypedColumnData typed_column_data = model::TypedColumnDataFactory::CreateFrom(
-                schema->GetColumn(i), std::move(columns[i]), is_null_eq_null);
-        column_data.emplace_back(std::move(typed_column_data));
     }
+    std::vector<TypedColumnData> column_data =
+            CreateColumnsInParallel(num_columns, threads, [&](size_t i) {
+                return model::TypedColumnDataFactory::CreateFrom(
+                        schema->GetColumn(i), dataset.GetColumn(i), is_null_eq_null);
+            });
 
     schema->Init();
 
@@ -1,5 +1,10 @@
 #pragma once
 
+#include <string>
+#include <vector>
+
+#include "columnar_dataset_stream.h"
+#include "config/thread_number/type.h"
 #include "idataset_stream.h"
 #include "relation_data.h"
 #include "typed_column_data.h"
@@ -20,8 +25,19 @@ public:
         }
     }
 
+    /* The types of the columns are inferred by up to threads threads */
+    static std::unique_ptr<ColumnLayoutTypedRelationData> CreateFrom(
+            model::IDatasetStream& data_stream, bool is_null_eq_null,
+            config::ThreadNumType threads = 1);
+    /* Builds typed columns from the cells of every column */
+    static std::unique_ptr<ColumnLayoutTypedRelationData> CreateFrom(
+            std::string relation_name, std::vector<std::string> const& column_names,
+            std::vector<std::vector<std::string>> columns, bool is_null_eq_null,
+            config::ThreadNumType threads = 1);
+    /* Builds typed columns straight from the column buffers */
     static std::unique_ptr<ColumnLayoutTypedRelationData> CreateFrom(
-            model::IDatasetStream& data_stream, bool is_null_eq_null);
+            model::ColumnarDatasetStream const& dataset, bool is_null_eq_null,
+            config::ThreadNumType threads = 1);
 };
 
 }  // namespace model
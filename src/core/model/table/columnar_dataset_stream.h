@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cassert>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "model/table/column_buffer.h"
+#include "model/table/idataset_stream.h"
+
+namespace model {
+
+/* Dataset held column-wise in buffers that are viewed in place. Relation data builders read the
+ * columns directly, without materializing rows; the row interface is still provided for the
+ * algorithms that consume the stream row by row */
+class ColumnarDatasetStream final : public IDatasetStream {
+public:
+    /* Throws if the column with the given index is malformed */
+    using ColumnCheck = std::function<void(size_t index)>;
+
+private:
+    std::string relation_name_;
+    std::vector<std::string> column_names_;
+    std::vector<ColumnBuffer> columns_;
+    size_t num_rows_;
+    size_t next_row_ = 0;
+    std::string identity_;
+    ColumnCheck check_column_;
+    /* Every column is checked once, before it is read for the first time */
+    std::unique_ptr<std::once_flag[]> column_checked_;
+
+public:
+    /* identity is empty if the buffers are not known to stay unchanged. check_column is called
+     * for the columns that are actually read, so the buffers are not scanned in advance */
+    ColumnarDatasetStream(std::string relation_name, std::vector<std::string> column_names,
+                          std::vector<ColumnBuffer> columns, size_t num_rows,
+                          std::string identity = {}, ColumnCheck check_column = {})
+        : relation_name_(std::move(relation_name)),
+          column_names_(std::move(column_names)),
+          columns_(std::move(columns)),
+          num_rows_(num_rows),
+          identity_(std::move(identity)),
+          check_column_(std::move(check_column)),
+          column_checked_(std::make_unique<std::once_flag[]>(columns_.size())) {
+        assert(column_names_.size() == columns_.size());
+        for ([[maybe_unused]] ColumnBuffer const& column : columns_) {
+            assert(column.GetSize() == num_rows_);
+        }
+    }
+
+    Row GetNextRow() final {
+        assert(HasNextRow());
+        Row row;
+        row.reserve(columns_.size());
+        for (size_t i = 0; i != columns_.size(); ++i) {
+            row.push_back(GetColumn(i).ToString(next_row_));
+        }
+        ++next_row_;
+        return row;
+    }
+
+    [[nodiscard]] bool HasNextRow() const final {
+        return next_row_ < num_rows_;
+    }
+
+    [[nodiscard]] size_t GetNumberOfColumns() const final {
+        return columns_.size();
+    }
+
+    [[nodiscard]] std::string GetColumnName(size_t index) const final {
+        return column_names_.at(index);
+    }
+
+    [[nodiscard]] std::string GetRelationName() const final {
+        return relation_name_;
+    }
+
+    void Reset() final {
+        next_row_ = 0;
+    }
+
+    [[nodiscard]] std::string GetIdentity() const final {
+        return identity_;
+    }
+
+    [[nodiscard]] size_t GetNumRows() const noexcept {
+        return num_rows_;
+    }
+
+    [[nodiscard]] ColumnBuffer const& GetColumn(size_t index) const {
+        ColumnBuffer const& column = columns_.at(index);
+        if (check_column_) {
+            std::call_once(column_checked_[index], check_column_, index);
+        }
+        return column;
+    }
+};
+
+}  // namespace model
@@ -0,0 +1,181 @@
+#include "dataset_cache.h"
+
+#include <limits>
+#include <utility>
+
+#include "util/metrics.h"
+
+namespace {
+
+/* Probing table and clusters of every column hold an int per row */
+std::size_t EstimateSize(ColumnLayoutRelationData const& relation) {
+    std::size_t size = 0;
+    for (ColumnData const& column : relation.GetColumnData()) {
+        size += 2 * column.GetProbingTable().size() * sizeof(int);
+    }
+    return size;
+}
+
+/* Strings are counted by the size of their objects only */
+std::size_t EstimateSize(model::ColumnLayoutTypedRelationData const& relation) {
+    std::size_t size = 0;
+    for (model::TypedColumnData const& column : relation.GetColumnData()) {
+        std::size_t const rows_num = column.GetNumRows();
+        size += rows_num * sizeof(std::byte const*);
+        if (column.IsMixed()) {
+            size += rows_num * sizeof(std::string);
+        } else if (column.GetTypeId() != +model::TypeId::kUndefined) {
+            std::size_t const values_num =
+                    rows_num - column.GetNumNulls() - column.GetNumEmpties();
+            size += values_num * column.GetType().GetSize();
+        }
+    }
+    return size;
+}
+
+}  // namespace
+
+namespace model {
+
+DatasetCache& DatasetCache::Instance() {
+    static DatasetCache cache;
+    return cache;
+}
+
+template <typename Data>
+std::shared_ptr<Data> DatasetCache::Use(CachedPart<Data>& part) {
+    std::shared_ptr<Data> data = part.shared.lock();
+    if (data != nullptr) part.last_use = ++use_count_;
+    return data;
+}
+
+template <typename Data>
+std::shared_ptr<Data> DatasetCache::Store(CachedPart<Data>& part, std::unique_ptr<Data> data,
+                                          std::size_t size) {
+    std::shared_ptr<Data> shared = std::move(data);
+    part.shared = shared;
+    part.size = size;
+    part.last_use = ++use_count_;
+    if (size <= memory_budget_) {
+        part.retained = shared;
+        retained_size_ += size;
+    }
+    return shared;
+}
+
+void DatasetCache::EvictOverBudget() {
+    while (retained_size_ > memory_budget_) {
+        std::uint64_t oldest_use = std::numeric_limits<std::uint64_t>::max();
+        Entry* oldest_entry = nullptr;
+        bool is_relation = false;
+        for (auto& [identity, entry] : entries_) {
+            if (entry.relation.retained != nullptr && entry.relation.last_use < oldest_use) {
+                oldest_use = entry.relation.last_use;
+                oldest_entry = &entry;
+                is_relation = true;
+            }
+            if (entry.typed_relation.retained != nullptr &&
+                entry.typed_relation.last_use < oldest_use) {
+                oldest_use = entry.typed_relation.last_use;
+                oldest_entry = &entry;
+                is_relation = false;
+            }
+        }
+        if (is_relation) {
+            oldest_entry->relation.retained.reset();
+            retained_size_ -= oldest_entry->relation.size;
+        } else {
+            oldest_entry->typed_relation.retained.reset();
+            retained_size_ -= oldest_entry->typed_relation.size;
+        }
+    }
+    std::erase_if(entries_, [](auto const& identity_and_entry) {
+        Entry const& entry = identity_and_entry.second;
+        return !entry.loading && entry.relation.shared.expired() &&
+               entry.typed_relation.shared.expired();
+    });
+}
+
+SharedRelationData DatasetCache::Get(IDatasetStream& data_stream, bool is_null_eq_null,
+                                     RelationDataParts parts, config::ThreadNumType threads) {
+    std::string const identity = data_stream.GetIdentity();
+    if (identity.empty()) {
+        LoadedRelationData loaded = LoadRelationData(data_stream, is_null_eq_null, parts, threads);
+        return {std::move(loaded.relation), std::move(loaded.typed_relation)};
+    }
+
+    std::string const key = identity + (is_null_eq_null ? "\nnull=null" : "\nnull!=null");
+    std::unique_lock lock(mutex_);
+    // Another thread may be parsing the dataset, its data is looked up again after it is done
+    loaded_.wait(lock, [this, &key] { return !entries_[key].loading; });
+    // Not erased while it is loading, so the reference outlives the unlocked parsing
+    Entry& entry = entries_[key];
+    SharedRelationData data;
+    RelationDataParts missing;
+    if (parts.relation) {
+        data.relation = Use(entry.relation);
+        missing.relation = data.relation == nullptr;
+    }
+    if (parts.typed_relation) {
+        data.typed_relation = Use(entry.typed_relation);
+        missing.typed_relation = data.typed_relation == nullptr;
+    }
+
+    if (!missing.relation && !missing.typed_relation) {
+        util::AddToCounter("dataset_cache.hits");
+        return data;
+    }
+    util::AddToCounter("dataset_cache.misses");
+    entry.loading = true;
+    lock.unlock();
+    LoadedRelationData loaded;
+    try {
+        loaded = LoadRelationData(data_stream, is_null_eq_null, missing, threads);
+    } catch (...) {
+        lock.lock();
+        entry.loading = false;
+        loaded_.notify_all();
+        throw;
+    }
+    lock.lock();
+    entry.loading = false;
+    loaded_.notify_all();
+    if (loaded.relation != nullptr) {
+        std::size_t const size = EstimateSize(*loaded.relation);
+        data.relation = Store(entry.relation, std::move(loaded.relation), size);
+    }
+    if (loaded.typed_relation != nullptr) {
+        std::size_t const size = EstimateSize(*loaded.typed_relation);
+        data.typed_relation = Store(entry.typed_relation, std::move(loaded.typed_relation), size);
+    }
+    EvictOverBudget();
+    return data;
+}
+
+void DatasetCache::SetMemoryBudget(std::size_t bytes) {
+    std::scoped_lock lock(mutex_);
+    memory_budget_ = bytes;
+    EvictOverBudget();
+}
+
+std::size_t DatasetCache::GetMemoryBudget() const {
+    std::scoped_lock lock(mutex_);
+    return memory_budget_;
+}
+
+std::size_t DatasetCache::GetRetainedSize() const {
+    std::scoped_lock lock(mutex_);
+    return retained_size_;
+}
+
+void DatasetCache::Clear() {
+    std::scoped_lock lock(mutex_);
+    for (auto& [identity, entry] : entries_) {
+        entry.relation.retained.reset();
+        entry.typed_relation.retained.reset();
+    }
+    retained_size_ = 0;
+    EvictOverBudget();
+}
+
+}  // namespace model
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "column_layout_relation_data.h"
+#include "column_layout_typed_relation_data.h"
+#include "config/thread_number/type.h"
+#include "idataset_stream.h"
+#include "relation_data_loader.h"
+
+namespace model {
+
+/* Relation data of a dataset, shared by the algorithms that use it. Only the requested parts are
+ * set */
+struct SharedRelationData {
+    std::shared_ptr<ColumnLayoutRelationData> relation;
+    std::shared_ptr<ColumnLayoutTypedRelationData> typed_relation;
+};
+
+/* Process-wide cache of the relation data built from datasets. Streams with equal identities (see
+ * IDatasetStream::GetIdentity) get the same data while any algorithm holds it, so algorithms run
+ * over one table parse it once. Data no algorithm holds anymore is kept for later runs as long as
+ * its estimated size fits into the memory budget, the least recently used data is dropped first.
+ * The budget is zero by default. Streams without an identity are parsed every time. A dataset is
+ * parsed by one thread at a time, the others wait for its data instead of parsing it again */
+class DatasetCache {
+private:
+    template <typename Data>
+    struct CachedPart {
+        std::weak_ptr<Data> shared;
+        /* Set only while the part is kept within the budget */
+        std::shared_ptr<Data> retained;
+        std::size_t size = 0;
+        std::uint64_t last_use = 0;
+    };
+
+    struct Entry {
+        CachedPart<ColumnLayoutRelationData> relation;
+        CachedPart<ColumnLayoutTypedRelationData> typed_relation;
+        /* Some thread is parsing the dataset with the mutex unlocked */
+        bool loading = false;
+    };
+
+    mutable std::mutex mutex_;
+    /* Notified when a dataset has been parsed */
+    std::condition_variable loaded_;
+    std::unordered_map<std::string, Entry> entries_;
+    std::size_t memory_budget_ = 0;
+    std::size_t retained_size_ = 0;
+    std::uint64_t use_count_ = 0;
+
+    template <typename Data>
+    std::shared_ptr<Data> Use(CachedPart<Data>& part);
+    template <typename Data>
+    std::shared_ptr<Data> Store(CachedPart<Data>& part, std::unique_ptr<Data> data,
+                                std::size_t size);
+    void EvictOverBudget();
+
+    DatasetCache() = default;
+
+public:
+    DatasetCache(DatasetCache const&) = delete;
+    DatasetCache& operator=(DatasetCache const&) = delete;
+
+    static DatasetCache& Instance();
+
+    /* Reads the stream only if some of the requested parts are not cached, see LoadRelationData
+     * for threads */
+    SharedRelationData Get(IDatasetStream& data_stream, bool is_null_eq_null,
+                           RelationDataParts parts, config::ThreadNumType threads = 1);
+
+    std::shared_ptr<ColumnLayoutRelationData> GetRelation(IDatasetStream& data_stream,
+                                                          bool is_null_eq_null) {
+        return Get(data_stream, is_null_eq_null, {.relation = true}).relation;
+    }
+
+    std::shared_ptr<ColumnLayoutTypedRelationData> GetTypedRelation(
+            IDatasetStream& data_stream, bool is_null_eq_null, config::ThreadNumType threads = 1) {
+        return Get(data_stream, is_null_eq_null, {.typed_relation = true}, threads).typed_relation;
+    }
+
+    /* Size in bytes of the data kept for later runs */
+    void SetMemoryBudget(std::size_t bytes);
+    std::size_t GetMemoryBudget() const;
+    std::size_t GetRetainedSize() const;
+
+    /* Drops the data kept for later runs, the data algorithms hold stays with them */
+    void Clear();
+};
+
+}  // namespace model
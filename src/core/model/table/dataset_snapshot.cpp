@@ -0,0 +1,417 @@
+#include "dataset_snapshot.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <easylogging++.h>
+
+#include "model/table/column_layout_relation_data.h"
+#include "model/types/builtin.h"
+#include "model/types/value_parsing.h"
+
+namespace {
+
+constexpr std::array<char, 8> kMagic = {'D', 'E', 'S', 'B', 'S', 'N', 'A', 'P'};
+constexpr std::uint32_t kVersion = 2;
+constexpr std::uint32_t kByteOrderMark = 0x01020304;
+/* Every section starts at a multiple of it, so the mapped values are aligned */
+constexpr std::uint64_t kSectionAlignment = 8;
+
+enum class ColumnKind : std::uint32_t {
+    /* 64-bit integers, values: one per row, aux: validity bitmap */
+    kInt64 = 1,
+    /* values: characters, aux: 64-bit offsets, one per row and one past the end */
+    kStrings = 2,
+    /* doubles, values: one per row, aux: validity bitmap */
+    kFloat64 = 3
+};
+
+struct SnapshotHeader {
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t byte_order_mark;
+    std::uint64_t num_rows;
+    std::uint64_t num_columns;
+    std::uint64_t relation_name_offset;
+    std::uint64_t relation_name_size;
+    /* num_columns ColumnDescriptors */
+    std::uint64_t columns_offset;
+};
+
+struct ColumnDescriptor {
+    std::uint64_t name_offset;
+    std::uint64_t name_size;
+    ColumnKind kind;
+    std::uint32_t padding;
+    /* One int per row */
+    std::uint64_t codes_offset;
+    std::uint64_t values_offset;
+    std::uint64_t values_size;
+    std::uint64_t aux_offset;
+    std::uint64_t aux_size;
+};
+
+/* Appends aligned sections to the file and returns their offsets */
+class SectionWriter {
+private:
+    std::ofstream out_;
+    std::uint64_t size_ = 0;
+
+public:
+    explicit SectionWriter(std::filesystem::path const& path)
+        : out_(path, std::ios::binary | std::ios::trunc) {
+        if (!out_) {
+            throw std::runtime_error("Error: couldn't create file " + path.string());
+        }
+    }
+
+    std::uint64_t Write(void const* data, std::uint64_t size) {
+        static constexpr std::array<char, kSectionAlignment> kZeros{};
+        std::uint64_t const padding = (kSectionAlignment - size_ % kSectionAlignment) %
+                                      kSectionAlignment;
+        out_.write(kZeros.data(), static_cast<std::streamsize>(padding));
+        size_ += padding;
+        std::uint64_t const offset = size_;
+        out_.write(static_cast<char const*>(data), static_cast<std::streamsize>(size));
+        size_ += size;
+        return offset;
+    }
+
+    template <typename T>
+    std::uint64_t Write(std::vector<T> const& values) {
+        return Write(values.data(), values.size() * sizeof(T));
+    }
+
+    void WriteAt(std::uint64_t offset, void const* data, std::uint64_t size) {
+        out_.seekp(static_cast<std::streamoff>(offset));
+        out_.write(static_cast<char const*>(data), static_cast<std::streamsize>(size));
+        out_.seekp(static_cast<std::streamoff>(size_));
+    }
+
+    void Finish(std::filesystem::path const& path) {
+        out_.close();
+        if (!out_) {
+            throw std::runtime_error("Error: couldn't write file " + path.string());
+        }
+    }
+};
+
+/* Integers are stored as such only if their strings are restored exactly and the column is typed
+ * as Int when parsed, so the snapshot gives the same data as the original dataset */
+bool IsInt64Column(std::vector<std::string> const& column) {
+    bool has_value = false;
+    for (std::string const& value : column) {
+        if (model::IsNullString(value)) continue;
+        if (!model::IsIntString(value) || model::IsUndelimitedDateString(value) ||
+            std::to_string(*model::ParseInt(value)) != value) {
+            return false;
+        }
+        has_value = true;
+    }
+    return has_value;
+}
+
+/* Doubles are stored as such only if they are printed as their original strings and the column is
+ * typed as Double when parsed */
+bool IsFloat64Column(std::vector<std::string> const& column) {
+    bool has_value = false;
+    for (std::string const& value : column) {
+        if (model::IsNullString(value)) continue;
+        if (!model::IsDoubleString(value)) return false;
+        model::Double const parsed = model::TypeConverter<model::Double>::kConvert(value);
+        model::ColumnBuffer const printed = model::ColumnBuffer::Numeric(
+                model::ColumnBuffer::ElementType::kFloat64, 1, &parsed, sizeof(parsed), nullptr,
+                0, nullptr);
+        if (printed.ToString(0) != value) return false;
+        has_value = true;
+    }
+    return has_value;
+}
+
+/* Writes the non-null values of the column converted by parse and their validity bitmap */
+template <typename T, typename Parse>
+void WriteNumericValues(SectionWriter& writer, std::vector<std::string> const& column,
+                        Parse parse, ColumnDescriptor& descriptor) {
+    std::vector<T> values(column.size());
+    std::vector<std::uint8_t> validity((column.size() + 7) / 8);
+    for (std::size_t i = 0; i != column.size(); ++i) {
+        if (model::IsNullString(column[i])) continue;
+        values[i] = parse(column[i]);
+        validity[i / 8] |= static_cast<std::uint8_t>(1u << (i % 8));
+    }
+    descriptor.values_offset = writer.Write(values);
+    descriptor.values_size = values.size() * sizeof(T);
+    descriptor.aux_offset = writer.Write(validity);
+    descriptor.aux_size = validity.size();
+}
+
+ColumnDescriptor WriteColumn(SectionWriter& writer, std::string const& name,
+                             std::vector<std::string> const& column) {
+    ColumnDescriptor descriptor{};
+    descriptor.name_offset = writer.Write(name.data(), name.size());
+    descriptor.name_size = name.size();
+
+    std::vector<int> codes;
+    codes.reserve(column.size());
+    std::unordered_map<std::string_view, int> value_ids;
+    int next_value_id = 1;
+    for (std::string const& value : column) {
+        if (value.empty()) {
+            codes.push_back(ColumnLayoutRelationData::kNullValueId);
+            continue;
+        }
+        auto [it, is_new] = value_ids.try_emplace(value, next_value_id);
+        if (is_new) ++next_value_id;
+        codes.push_back(it->second);
+    }
+    descriptor.codes_offset = writer.Write(codes);
+
+    if (IsInt64Column(column)) {
+        descriptor.kind = ColumnKind::kInt64;
+        WriteNumericValues<std::int64_t>(
+                writer, column, [](std::string const& value) { return *model::ParseInt(value); },
+                descriptor);
+        return descriptor;
+    }
+    if (IsFloat64Column(column)) {
+        descriptor.kind = ColumnKind::kFloat64;
+        WriteNumericValues<double>(writer, column, model::TypeConverter<model::Double>::kConvert,
+                                   descriptor);
+        return descriptor;
+    }
+
+    descriptor.kind = ColumnKind::kStrings;
+    std::vector<std::int64_t> offsets;
+    offsets.reserve(column.size() + 1);
+    std::string chars;
+    offsets.push_back(0);
+    for (std::string const& value : column) {
+        chars += value;
+        offsets.push_back(static_cast<std::int64_t>(chars.size()));
+    }
+    descriptor.values_offset = writer.Write(chars.data(), chars.size());
+    descriptor.values_size = chars.size();
+    descriptor.aux_offset = writer.Write(offsets);
+    descriptor.aux_size = offsets.size() * sizeof(std::int64_t);
+    return descriptor;
+}
+
+struct MappedSnapshot {
+    boost::interprocess::file_mapping file;
+    boost::interprocess::mapped_region region;
+};
+
+class SnapshotReader {
+private:
+    std::filesystem::path const& path_;
+    std::byte const* data_;
+    std::uint64_t size_;
+
+    [[noreturn]] void Fail(std::string const& reason) const {
+        throw std::runtime_error("Error: " + path_.string() + " is not a valid dataset snapshot (" +
+                                 reason + ")");
+    }
+
+public:
+    SnapshotReader(std::filesystem::path const& path, void const* data, std::uint64_t size)
+        : path_(path), data_(static_cast<std::byte const*>(data)), size_(size) {}
+
+    template <typename T>
+    T const* Get(std::uint64_t offset, std::uint64_t count) const {
+        if (offset % alignof(T) != 0 || offset > size_ || count > (size_ - offset) / sizeof(T)) {
+            Fail("section out of bounds");
+        }
+        return reinterpret_cast<T const*>(data_ + offset);
+    }
+
+    std::string GetString(std::uint64_t offset, std::uint64_t size) const {
+        return {Get<char>(offset, size), size};
+    }
+
+    template <typename T>
+    model::ColumnBuffer GetNumericColumn(model::ColumnBuffer::ElementType type,
+                                         ColumnDescriptor const& descriptor,
+                                         std::uint64_t num_rows,
+                                         std::shared_ptr<void const> const& owner) const {
+        if (descriptor.values_size != num_rows * sizeof(T) ||
+            descriptor.aux_size != (num_rows + 7) / 8) {
+            Fail("wrong column size");
+        }
+        return model::ColumnBuffer::Numeric(
+                type, num_rows, Get<T>(descriptor.values_offset, num_rows), sizeof(T),
+                Get<std::uint8_t>(descriptor.aux_offset, descriptor.aux_size), 0, owner);
+    }
+
+    /* Checks the sections of the column only, the values are checked by CheckColumn */
+    model::ColumnBuffer GetColumn(ColumnDescriptor const& descriptor, std::uint64_t num_rows,
+                                  std::shared_ptr<void const> const& owner) const {
+        using ElementType = model::ColumnBuffer::ElementType;
+        model::ColumnBuffer column = [&] {
+            switch (descriptor.kind) {
+                case ColumnKind::kInt64:
+                    return GetNumericColumn<std::int64_t>(ElementType::kInt64, descriptor,
+                                                          num_rows, owner);
+                case ColumnKind::kFloat64:
+                    return GetNumericColumn<double>(ElementType::kFloat64, descriptor, num_rows,
+                                                    owner);
+                case ColumnKind::kStrings: {
+                    if (descriptor.aux_size != (num_rows + 1) * sizeof(std::int64_t)) {
+                        Fail("wrong column size");
+                    }
+                    return model::ColumnBuffer::Strings(
+                            ElementType::kLargeUtf8, num_rows,
+                            Get<char>(descriptor.values_offset, descriptor.values_size),
+                            Get<std::int64_t>(descriptor.aux_offset, num_rows + 1), nullptr, 0,
+                            owner);
+                }
+            }
+            Fail("unknown column kind");
+        }();
+        column.SetCodes(Get<int>(descriptor.codes_offset, num_rows));
+        return column;
+    }
+
+    /* Reads the whole column, so it is done only for the columns that are used */
+    void CheckColumn(ColumnDescriptor const& descriptor, std::uint64_t num_rows) const {
+        int const* codes = Get<int>(descriptor.codes_offset, num_rows);
+        if (std::any_of(codes, codes + num_rows, [](int code) {
+                return code < ColumnLayoutRelationData::kNullValueId;
+            })) {
+            Fail("negative value id");
+        }
+        if (descriptor.kind != ColumnKind::kStrings) return;
+        auto const* offsets = Get<std::int64_t>(descriptor.aux_offset, num_rows + 1);
+        if (offsets[0] != 0 ||
+            static_cast<std::uint64_t>(offsets[num_rows]) != descriptor.values_size ||
+            !std::is_sorted(offsets, offsets + num_rows + 1)) {
+            Fail("wrong string offsets");
+        }
+    }
+};
+
+}  // namespace
+
+namespace model {
+
+void WriteDatasetSnapshot(IDatasetStream& data_stream, std::filesystem::path const& path) {
+    std::size_t const num_columns = data_stream.GetNumberOfColumns();
+    std::vector<std::vector<std::string>> columns(num_columns);
+    std::uint64_t num_rows = 0;
+    while (data_stream.HasNextRow()) {
+        std::vector<std::string> row = data_stream.GetNextRow();
+        if (row.size() != num_columns) {
+            LOG(WARNING) << "Unexpected number of columns for a row, skipping (expected "
+                         << num_columns << ", got " << row.size() << ")";
+            continue;
+        }
+        for (std::size_t i = 0; i != num_columns; ++i) {
+            columns[i].push_back(std::move(row[i]));
+        }
+        ++num_rows;
+    }
+
+    SectionWriter writer(path);
+    SnapshotHeader header{};
+    writer.Write(&header, sizeof(header));
+    std::string const relation_name = data_stream.GetRelationName();
+    header.relation_name_offset = writer.Write(relation_name.data(), relation_name.size());
+    header.relation_name_size = relation_name.size();
+
+    std::vector<ColumnDescriptor> descriptors;
+    descriptors.reserve(num_columns);
+    for (std::size_t i = 0; i != num_columns; ++i) {
+        descriptors.push_back(WriteColumn(writer, data_stream.GetColumnName(i), columns[i]));
+        columns[i] = {};
+    }
+    header.columns_offset = writer.Write(descriptors);
+
+    header.magic = kMagic;
+    header.version = kVersion;
+    header.byte_order_mark = kByteOrderMark;
+    header.num_rows = num_rows;
+    header.num_columns = num_columns;
+    writer.WriteAt(0, &header, sizeof(header));
+    writer.Finish(path);
+}
+
+std::shared_ptr<ColumnarDatasetStream> OpenDatasetSnapshot(std::filesystem::path const& path) {
+    namespace bip = boost::interprocess;
+    auto mapped = std::make_shared<MappedSnapshot>();
+    try {
+        mapped->file = bip::file_mapping(path.c_str(), bip::read_only);
+        mapped->region = bip::mapped_region(mapped->file, bip::read_only);
+    } catch (bip::interprocess_exception const& e) {
+        throw std::runtime_error("Error: couldn't map file " + path.string() + ": " + e.what());
+    }
+    SnapshotReader const reader(path, mapped->region.get_address(), mapped->region.get_size());
+
+    SnapshotHeader header;
+    std::memcpy(&header, reader.Get<std::byte>(0, sizeof(header)), sizeof(header));
+    if (header.magic != kMagic) {
+        throw std::runtime_error("Error: " + path.string() + " is not a dataset snapshot");
+    }
+    if (header.byte_order_mark != kByteOrderMark) {
+        throw std::runtime_error("Error: dataset snapshot " + path.string() +
+                                 " was written on a machine with a different byte order");
+    }
+    if (header.version != kVersion) {
+        throw std::runtime_error("Error: unsupported version " + std::to_string(header.version) +
+                                 " of dataset snapshot " + path.string());
+    }
+
+    ColumnDescriptor const* first_descriptor =
+            reader.Get<ColumnDescriptor>(header.columns_offset, header.num_columns);
+    std::vector<ColumnDescriptor> descriptors(first_descriptor,
+                                              first_descriptor + header.num_columns);
+    std::vector<std::string> column_names;
+    std::vector<ColumnBuffer> columns;
+    column_names.reserve(header.num_columns);
+    columns.reserve(header.num_columns);
+    std::shared_ptr<void const> const owner = mapped;
+    for (std::uint64_t i = 0; i != header.num_columns; ++i) {
+        column_names.push_back(
+                reader.GetString(descriptors[i].name_offset, descriptors[i].name_size));
+        columns.push_back(reader.GetColumn(descriptors[i], header.num_rows, owner));
+    }
+
+    std::string identity;
+    std::error_code path_error, size_error, time_error;
+    std::filesystem::path const absolute_path = std::filesystem::absolute(path, path_error);
+    auto const file_size = std::filesystem::file_size(path, size_error);
+    auto const write_time = std::filesystem::last_write_time(path, time_error);
+    if (!path_error && !size_error && !time_error) {
+        identity = "snapshot\n" + absolute_path.string() + '\n' + std::to_string(file_size) +
+                   '\n' + std::to_string(write_time.time_since_epoch().count());
+    }
+    std::string relation_name =
+            reader.GetString(header.relation_name_offset, header.relation_name_size);
+    auto check_column = [mapped, path, descriptors = std::move(descriptors),
+                         num_rows = header.num_rows](std::size_t index) {
+        SnapshotReader const reader(path, mapped->region.get_address(),
+                                    mapped->region.get_size());
+        reader.CheckColumn(descriptors[index], num_rows);
+    };
+    return std::make_shared<ColumnarDatasetStream>(std::move(relation_name),
+                                                   std::move(column_names), std::move(columns),
+                                                   header.num_rows, std::move(identity),
+                                                   std::move(check_column));
+}
+
+bool IsDatasetSnapshot(std::filesystem::path const& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::array<char, kMagic.size()> magic{};
+    return in.read(magic.data(), magic.size()) && magic == kMagic;
+}
+
+}  // namespace model
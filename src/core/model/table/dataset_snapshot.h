@@ -0,0 +1,26 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+
+#include "columnar_dataset_stream.h"
+#include "idataset_stream.h"
+
+namespace model {
+
+/* Binary snapshot of a dataset, read back without parsing. Every column is stored with the value
+ * ids ColumnLayoutRelationData is built from, and either as 64-bit integers or doubles with a
+ * validity bitmap, if the column consists of such numbers and nulls only, or as strings in the
+ * Arrow layout. The snapshot is memory-mapped when opened, so processes that open the same
+ * snapshot share its pages. A column is validated when it is first read, not when the snapshot is
+ * opened. The format is versioned and is read only on machines with the same byte order */
+
+/* Writes the rows left in the stream */
+void WriteDatasetSnapshot(IDatasetStream& data_stream, std::filesystem::path const& path);
+
+/* The columns of the stream view the mapped file, algorithms read them in place */
+std::shared_ptr<ColumnarDatasetStream> OpenDatasetSnapshot(std::filesystem::path const& path);
+
+bool IsDatasetSnapshot(std::filesystem::path const& path);
+
+}  // namespace model
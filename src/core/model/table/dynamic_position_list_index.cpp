@@ -1,82 +1,154 @@
 #include "model/table/dynamic_position_list_index.h"
 
-#include <algorithm>
-#include <chrono>
-#include <cmath>
-#include <map>
+#include <cassert>
 #include <memory>
-#include <stack>
 #include <utility>
 
-#include <boost/dynamic_bitset.hpp>
-#include <easylogging++.h>
-
-namespace {
-// O(cluster)
-void ProcessDeleteToCluster(model::DynamicPositionListIndex::Cluster& cluster,
-                            std::unordered_set<size_t>& deleted_records_ids) {
-    auto records_pred = [&](size_t element) {
-        return static_cast<bool>(deleted_records_ids.erase(element));
-    };
-    std::erase_if(cluster, records_pred);
-}
-
-}  // namespace
-
 namespace model {
 
-DynamicPositionListIndex::DynamicPositionListIndex(ClusterCollection clusters, size_t size,
-                                                   size_t relation_size)
-    : clusters_(std::move(clusters)),
-      valid_records_number_(size),
-      next_record_id_(relation_size),
-      probing_table_cache_() {
-    ForceCacheProbingTable();
+std::uint64_t DynamicPositionListIndex::HashValue(ClusterValue const& value) noexcept {
+    std::uint64_t hash = 0x9e3779b97f4a7c15ULL ^ value.size();
+    for (int element : value) {
+        hash ^= static_cast<std::uint32_t>(element);
+        hash *= 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 32;
+    }
+    // Final avalanche step of MurmurHash3
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
 }
 
 std::unique_ptr<DynamicPositionListIndex> DynamicPositionListIndex::CreateFor(
-        std::vector<ClusterValue>& records) {
-    ClusterCollection clusters;
-    for (size_t record_id = 0; record_id < records.size(); ++record_id) {
-        ClusterValue const& value = records[record_id];
-        clusters[value].push_back(record_id);
+        std::vector<ClusterValue> const& records) {
+    auto pli = std::make_unique<DynamicPositionListIndex>();
+    pli->probing_table_.reserve(records.size());
+    pli->positions_.reserve(records.size());
+    for (std::size_t record_id = 0; record_id < records.size(); ++record_id) {
+        pli->AddRecord(record_id, records[record_id]);
     }
-
-    return std::make_unique<DynamicPositionListIndex>(std::move(clusters), records.size(),
-                                                      records.size());
+    return pli;
 }
 
-void DynamicPositionListIndex::UpdateWith(
-        std::vector<std::pair<std::optional<size_t>, ClusterValue>>& inserted_records,
-        std::unordered_set<size_t> deleted_records_ids) {
-    if (inserted_records.empty() && deleted_records_ids.empty()) {
-        return;
-    }
-    valid_records_number_ -= deleted_records_ids.size();
-    for (auto it = clusters_.begin(); it != clusters_.end();) {
-        auto& [cluster_value, cluster] = *it;
-        ProcessDeleteToCluster(cluster, deleted_records_ids);
-        if (cluster.empty()) {
-            it = clusters_.erase(it);
-        } else {
-            ++it;
+auto DynamicPositionListIndex::FindCluster(ClusterValue const& value,
+                                           std::uint64_t fingerprint) const
+        -> std::optional<ClusterId> {
+    auto [begin, end] = clusters_by_fingerprint_.equal_range(fingerprint);
+    for (auto it = begin; it != end; ++it) {
+        if (cluster_values_[it->second] == value) {
+            return it->second;
         }
-        if (deleted_records_ids.empty()) break;
-    }
-    for (auto const& [encoded_value_opt, cluster_value] : inserted_records) {
-        if (encoded_value_opt.has_value()) {
-            clusters_[cluster_value].emplace_back(*encoded_value_opt);
-        } else {
-            clusters_[cluster_value].emplace_back(next_record_id_++);
-            ++valid_records_number_;
+    }
+    return std::nullopt;
+}
+
+auto DynamicPositionListIndex::GetOrCreateCluster(ClusterValue const& value) -> ClusterId {
+    std::uint64_t const fingerprint = HashValue(value);
+    if (std::optional<ClusterId> cluster_id = FindCluster(value, fingerprint)) {
+        return *cluster_id;
+    }
+
+    ClusterId cluster_id;
+    if (free_cluster_ids_.empty()) {
+        cluster_id = clusters_.size();
+        clusters_.emplace_back();
+        cluster_values_.push_back(value);
+        cluster_fingerprints_.push_back(fingerprint);
+    } else {
+        // The slab keeps the capacity it had before the cluster was released
+        cluster_id = free_cluster_ids_.back();
+        free_cluster_ids_.pop_back();
+        cluster_values_[cluster_id] = value;
+        cluster_fingerprints_[cluster_id] = fingerprint;
+    }
+    clusters_by_fingerprint_.emplace(fingerprint, cluster_id);
+    ++num_clusters_;
+    return cluster_id;
+}
+
+void DynamicPositionListIndex::ReleaseCluster(ClusterId cluster_id) {
+    assert(clusters_[cluster_id].empty());
+    auto [begin, end] = clusters_by_fingerprint_.equal_range(cluster_fingerprints_[cluster_id]);
+    for (auto it = begin; it != end; ++it) {
+        if (it->second == cluster_id) {
+            clusters_by_fingerprint_.erase(it);
+            break;
         }
     }
+    cluster_values_[cluster_id].clear();
+    free_cluster_ids_.push_back(cluster_id);
+    --num_clusters_;
+}
+
+auto DynamicPositionListIndex::AddToCluster(ClusterId cluster_id, std::size_t record_id)
+        -> RecordPosition {
+    if (record_id >= probing_table_.size()) {
+        probing_table_.resize(record_id + 1, kNoCluster);
+        positions_.resize(record_id + 1);
+    }
+    assert(probing_table_[record_id] == kNoCluster);
+    Cluster& cluster = clusters_[cluster_id];
+    std::size_t const position = cluster.size();
+    positions_[record_id] = position;
+    cluster.push_back(record_id);
+    probing_table_[record_id] = cluster_id;
+    ++valid_records_number_;
+    return {record_id, cluster_id, position};
+}
+
+auto DynamicPositionListIndex::AddRecord(std::size_t record_id, ClusterValue const& value)
+        -> RecordPosition {
+    return AddToCluster(GetOrCreateCluster(value), record_id);
+}
+
+auto DynamicPositionListIndex::RemoveRecord(std::size_t record_id) -> RecordPosition {
+    assert(GetClusterId(record_id) != kNoCluster);
+    ClusterId const cluster_id = probing_table_[record_id];
+    Cluster& cluster = clusters_[cluster_id];
+    // The last record of the cluster takes the place of the removed one
+    std::size_t const position = positions_[record_id];
+    int const moved_record = cluster.back();
+    cluster[position] = moved_record;
+    positions_[moved_record] = position;
+    cluster.pop_back();
+
+    probing_table_[record_id] = kNoCluster;
+    --valid_records_number_;
+    if (cluster.empty()) {
+        ReleaseCluster(cluster_id);
+    }
+    return {record_id, cluster_id, position};
+}
 
-    ForceCacheProbingTable();
+auto DynamicPositionListIndex::ApplyChanges(
+        std::vector<std::size_t> const& removed_records_ids,
+        std::vector<std::pair<std::size_t, ClusterValue>> const& added_records) -> Changes {
+    Changes changes;
+    changes.removed.reserve(removed_records_ids.size());
+    changes.added.reserve(added_records.size());
+    for (std::size_t record_id : removed_records_ids) {
+        changes.removed.push_back(RemoveRecord(record_id));
+    }
+    for (auto const& [record_id, value] : added_records) {
+        changes.added.push_back(AddRecord(record_id, value));
+    }
+    return changes;
+}
+
+void DynamicPositionListIndex::UpdateWith(
+        std::vector<std::pair<std::optional<std::size_t>, ClusterValue>> const& inserted_records,
+        std::unordered_set<std::size_t> const& deleted_records_ids) {
+    for (std::size_t record_id : deleted_records_ids) {
+        RemoveRecord(record_id);
+    }
+    for (auto const& [record_id_opt, cluster_value] : inserted_records) {
+        AddRecord(record_id_opt.value_or(probing_table_.size()), cluster_value);
+    }
 }
 
 std::unordered_map<int, unsigned> DynamicPositionListIndex::CreateFrequencies(
-        Cluster const& cluster, std::vector<int> const& probing_table) {
+        Cluster const& cluster, std::vector<ClusterId> const& probing_table) {
     std::unordered_map<int, unsigned> frequencies;
 
     for (int index : cluster) {
@@ -86,26 +158,9 @@ std::unordered_map<int, unsigned> DynamicPositionListIndex::CreateFrequencies(
     return frequencies;
 }
 
-std::shared_ptr<std::vector<int> const> DynamicPositionListIndex::CalculateAndGetProbingTable()
-        const {
-    // cluster values cache: used in the Probe() method
-    cluster_values_cache_.clear();
-    std::vector<int> probing_table = std::vector<int>(next_record_id_);
-    int next_cluster_id = 0;
-    for (auto& [value, cluster] : clusters_) {
-        int value_id = next_cluster_id++;
-        for (int position : cluster) {
-            probing_table[position] = value_id;
-        }
-        cluster_values_cache_.emplace_back(value);
-    }
-
-    return std::make_shared<std::vector<int>>(probing_table);
-}
-
 std::unique_ptr<DynamicPositionListIndex> DynamicPositionListIndex::Intersect(
         DynamicPositionListIndex const* that) const {
-    assert(this->next_record_id_ == that->next_record_id_);
+    assert(this->GetRelationSize() == that->GetRelationSize());
 
     if (this->valid_records_number_ > that->valid_records_number_) {
         return that->Probe(this);
@@ -116,45 +171,37 @@ std::unique_ptr<DynamicPositionListIndex> DynamicPositionListIndex::Intersect(
 
 std::unique_ptr<DynamicPositionListIndex> DynamicPositionListIndex::Probe(
         DynamicPositionListIndex const* that) const {
-    std::shared_ptr<std::vector<int> const> probing_table = that->GetCachedProbingTable();
-    std::vector<ClusterValue> const& cluster_values = that->GetClusterValuesCache();
-    assert(this->next_record_id_ == probing_table->size());
-    ClusterCollection new_clusters;
-    unsigned int new_size = 0;
-
-    std::unordered_map<int, std::pair<ClusterValue, Cluster>> partial_clusters;
-
-    for (auto const& [value, cluster] : clusters_) {
-        for (int position : cluster) {
-            int probing_table_value_id = (*probing_table)[position];
-            auto partial_cluster = partial_clusters.find(probing_table_value_id);
-            if (partial_cluster != partial_clusters.end()) {
-                auto& [key, positions] = partial_cluster->second;
-                positions.emplace_back(position);
-            } else {
-                ClusterValue key = value;
-                auto& cluster_value = cluster_values[probing_table_value_id];
-                key.insert(key.end(), cluster_value.begin(), cluster_value.end());
-                partial_clusters[probing_table_value_id] = {std::move(key), {position}};
+    assert(this->GetRelationSize() == that->GetRelationSize());
+    auto result = std::make_unique<DynamicPositionListIndex>();
+    result->probing_table_.assign(probing_table_.size(), kNoCluster);
+    result->positions_.resize(probing_table_.size());
+
+    // Maps a cluster id of that index to the id of the intersection cluster
+    std::unordered_map<ClusterId, ClusterId> partial_clusters;
+    for (std::size_t cluster_id = 0; cluster_id < clusters_.size(); ++cluster_id) {
+        for (int position : clusters_[cluster_id]) {
+            ClusterId const that_cluster_id = that->probing_table_[position];
+            auto [it, is_new] = partial_clusters.try_emplace(that_cluster_id, kNoCluster);
+            if (is_new) {
+                ClusterValue key = cluster_values_[cluster_id];
+                ClusterValue const& that_value = that->cluster_values_[that_cluster_id];
+                key.insert(key.end(), that_value.begin(), that_value.end());
+                it->second = result->GetOrCreateCluster(key);
             }
-        }
-
-        for (auto& [_, new_cluster] : partial_clusters) {
-            new_size += new_cluster.second.size();
-            new_clusters.emplace(std::move(new_cluster));
+            result->AddToCluster(it->second, position);
         }
         partial_clusters.clear();
     }
 
-    return std::make_unique<DynamicPositionListIndex>(std::move(new_clusters), new_size,
-                                                      next_record_id_);
+    return result;
 }
 
 std::string DynamicPositionListIndex::ToString() const {
     std::string res = "[";
-    for (auto& cluster : clusters_) {
+    for (Cluster const& cluster : clusters_) {
+        if (cluster.empty()) continue;
         res.push_back('[');
-        for (int v : cluster.second) {
+        for (int v : cluster) {
             res.append(std::to_string(v) + ",");
         }
         if (res.find(',') != std::string::npos) res.erase(res.find_last_of(','));
@@ -1,75 +1,134 @@
 #pragma once
+#include <cstdint>
 #include <memory>
+#include <optional>
+#include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
-#include "model/table/column.h"
-
-class ColumnLayoutRelationData;
-
-template <>
-struct std::hash<std::vector<int>> {
-    std::size_t operator()(std::vector<int> const& vec) const noexcept {
-        std::size_t secret = vec.size();
-        std::size_t hash = (1 << secret) ^ secret;
-        for (auto const& el : vec) {
-            hash ^= (el << secret) - (hash >> secret);
-        }
-        return hash;
-    }
-};
-
 namespace model {
+
+/* Position list index that supports insertion and deletion of records.
+ * Multi-column cluster values are mapped to dense cluster ids through a 64-bit hash of the value;
+ * the hash serves as a fingerprint, and the stored value is compared only when fingerprints match.
+ * Clusters are kept in slabs indexed by cluster id, and slabs of clusters that become empty are
+ * reused by new ones. Every record has back-pointers to its cluster and position in it, so records
+ * are removed in O(1), and the probing table is kept up to date on every change */
 class DynamicPositionListIndex {
 public:
     using Cluster = std::vector<int>;
     using ClusterValue = std::vector<int>;
-    using ClusterCollection = std::unordered_map<ClusterValue, Cluster>;
+    using ClusterId = int;
+
+    static constexpr ClusterId kNoCluster = -1;
+
+    /* Where a record was before it was removed or where it went when it was added */
+    struct RecordPosition {
+        std::size_t record_id;
+        ClusterId cluster_id;
+        std::size_t position;
+    };
+
+    /* Records a batch has removed and added, in the order the index has processed them.
+     * Structures kept over the clusters, e.g. copies of some of them, follow the index by
+     * replaying these: a removal moves the last record of the cluster to the position of the
+     * removed one, an addition appends the record */
+    struct Changes {
+        std::vector<RecordPosition> removed;
+        std::vector<RecordPosition> added;
+    };
+
+    struct ClusterValueHash {
+        std::size_t operator()(ClusterValue const& value) const noexcept {
+            return HashValue(value);
+        }
+    };
 
 private:
-    ClusterCollection clusters_;
-    size_t valid_records_number_;
-    size_t next_record_id_;
+    struct FingerprintHash {
+        std::size_t operator()(std::uint64_t fingerprint) const noexcept {
+            return fingerprint;
+        }
+    };
+
+    /* Slabs, indexed by cluster id. Slabs of deleted clusters are empty and listed in
+     * free_cluster_ids_ */
+    std::vector<Cluster> clusters_;
+    std::vector<ClusterValue> cluster_values_;
+    std::vector<std::uint64_t> cluster_fingerprints_;
+    std::vector<ClusterId> free_cluster_ids_;
+    std::unordered_multimap<std::uint64_t, ClusterId, FingerprintHash> clusters_by_fingerprint_;
+
+    /* probing_table_[record] is the id of the record's cluster or kNoCluster for deleted records,
+     * positions_[record] is the position of the record in its cluster */
+    std::vector<ClusterId> probing_table_;
+    std::vector<std::size_t> positions_;
 
-    std::shared_ptr<std::vector<int> const> probing_table_cache_;
-    mutable std::vector<ClusterValue> cluster_values_cache_;
+    std::size_t num_clusters_ = 0;
+    std::size_t valid_records_number_ = 0;
+
+    std::optional<ClusterId> FindCluster(ClusterValue const& value,
+                                         std::uint64_t fingerprint) const;
+    ClusterId GetOrCreateCluster(ClusterValue const& value);
+    void ReleaseCluster(ClusterId cluster_id);
+    RecordPosition AddToCluster(ClusterId cluster_id, std::size_t record_id);
 
 public:
-    DynamicPositionListIndex(ClusterCollection clusters, size_t size, size_t relation_size);
+    DynamicPositionListIndex() = default;
 
     static std::unique_ptr<DynamicPositionListIndex> CreateFor(
-            std::vector<std::vector<int>>& records);
+            std::vector<ClusterValue> const& records);
 
-    void UpdateWith(std::vector<std::pair<std::optional<size_t>, ClusterValue>>& inserted_records,
-                    std::unordered_set<size_t> deleted_records_ids);
+    /* 64-bit hash of a cluster value, mixing every element */
+    static std::uint64_t HashValue(ClusterValue const& value) noexcept;
 
-    static std::unordered_map<int, unsigned> CreateFrequencies(
-            Cluster const& cluster, std::vector<int> const& probing_table);
+    /* Adds a record with the given id, which must not belong to the index */
+    RecordPosition AddRecord(std::size_t record_id, ClusterValue const& value);
 
-    // Calculates PT -- heavy operation
-    std::shared_ptr<std::vector<int> const> CalculateAndGetProbingTable() const;
+    /* Removes a record from the index in O(1) */
+    RecordPosition RemoveRecord(std::size_t record_id);
 
-    // Returns cached PT or nullptr, if PT has not been cached yet
-    std::shared_ptr<std::vector<int> const> GetCachedProbingTable() const {
-        return probing_table_cache_;
-    };
+    /* Removes records, then adds records. An updated record is both removed and added */
+    Changes ApplyChanges(std::vector<std::size_t> const& removed_records_ids,
+                         std::vector<std::pair<std::size_t, ClusterValue>> const& added_records);
 
-    // Calculates PT and cache it
-    void ForceCacheProbingTable() {
-        probing_table_cache_ = CalculateAndGetProbingTable();
-    };
+    /* Records with an id are updated ones and keep it, others get new ids after the largest one */
+    void UpdateWith(std::vector<std::pair<std::optional<std::size_t>, ClusterValue>> const&
+                            inserted_records,
+                    std::unordered_set<std::size_t> const& deleted_records_ids);
 
-    ClusterCollection const& GetClusters() const noexcept {
-        return clusters_;
-    };
+    static std::unordered_map<int, unsigned> CreateFrequencies(
+            Cluster const& cluster, std::vector<ClusterId> const& probing_table);
 
-    /* If you use this method and change index in any way, all other methods will become invalid */
-    ClusterCollection& GetClusters() noexcept {
+    std::optional<ClusterId> FindCluster(ClusterValue const& value) const {
+        return FindCluster(value, HashValue(value));
+    }
+
+    std::vector<ClusterId> const& GetProbingTable() const noexcept {
+        return probing_table_;
+    }
+
+    /* Slabs indexed by cluster id, empty slabs are unused */
+    std::vector<Cluster> const& GetClusters() const noexcept {
         return clusters_;
     }
 
+    Cluster const& GetCluster(ClusterId cluster_id) const {
+        return clusters_[cluster_id];
+    }
+
+    ClusterValue const& GetClusterValue(ClusterId cluster_id) const {
+        return cluster_values_[cluster_id];
+    }
+
+    ClusterId GetClusterId(std::size_t record_id) const {
+        return record_id < probing_table_.size() ? probing_table_[record_id] : kNoCluster;
+    }
+
     unsigned int GetNumCluster() const {
-        return clusters_.size();
+        return num_clusters_;
     }
 
     unsigned int GetSize() const {
@@ -77,11 +136,7 @@ public:
     }
 
     unsigned int GetRelationSize() const {
-        return next_record_id_;
-    }
-
-    std::vector<ClusterValue> const& GetClusterValuesCache() const {
-        return cluster_values_cache_;
+        return probing_table_.size();
     }
 
     std::unique_ptr<DynamicPositionListIndex> Intersect(DynamicPositionListIndex const* that) const;
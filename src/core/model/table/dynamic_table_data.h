@@ -15,11 +15,15 @@ namespace model {
 struct DynamicTableData {
 private:
     std::vector<std::vector<std::string>> columns_;
+    std::vector<std::string> column_names_;
     std::unordered_set<size_t> deleted_rows_{};
 
 public:
     DynamicTableData(IDatasetStream& input_table) {
         columns_.resize(input_table.GetNumberOfColumns());
+        for (size_t i = 0; i < columns_.size(); ++i) {
+            column_names_.push_back(input_table.GetColumnName(i));
+        }
         while (input_table.HasNextRow()) {
             std::vector<std::string> row = input_table.GetNextRow();
             if (row.size() != columns_.size()) {
@@ -49,6 +53,71 @@ public:
         return !(deleted_rows_.contains(row_index) || row_index >= GetNumRowsTotal());
     }
 
+    size_t GetNumColumns() const {
+        return columns_.size();
+    }
+
+    /* Throws config::ConfigurationError if insert statements do not match the table schema */
+    void CheckInsertStatements(config::InputTable const& insert_batch) const {
+        if (insert_batch == nullptr || !insert_batch->HasNextRow()) {
+            return;
+        }
+        if (insert_batch->GetNumberOfColumns() != GetNumColumns()) {
+            throw config::ConfigurationError(
+                    "Schema mismatch: insert statements must have the same number of columns as "
+                    "the input table");
+        }
+        for (size_t i = 0; i < GetNumColumns(); ++i) {
+            if (insert_batch->GetColumnName(i) != column_names_[i]) {
+                throw config::ConfigurationError(
+                        "Schema mismatch: insert statements' column names must match the input "
+                        "table");
+            }
+        }
+    }
+
+    /* Throws config::ConfigurationError if some of the rows to delete do not exist */
+    void CheckDeleteStatements(std::unordered_set<size_t> const& delete_batch) {
+        for (size_t id : delete_batch) {
+            if (!IsRowIndexValid(id)) {
+                throw config::ConfigurationError("Attempt to delete a non-existing row");
+            }
+        }
+    }
+
+    /* Throws config::ConfigurationError if update statements do not match the table schema,
+     * refer to non-existing rows or contain duplicates. Resets the update batch afterwards */
+    void CheckUpdateStatements(config::InputTable const& update_batch) {
+        if (update_batch == nullptr || !update_batch->HasNextRow()) {
+            return;
+        }
+        if (update_batch->GetNumberOfColumns() != GetNumColumns() + 1) {
+            throw config::ConfigurationError(
+                    "Schema mismatch: update statements must have the number of columns one more "
+                    "than the input table");
+        }
+        for (size_t i = 0; i < GetNumColumns(); ++i) {
+            if (update_batch->GetColumnName(i + 1) != column_names_[i]) {
+                throw config::ConfigurationError(
+                        "Schema mismatch: update statements column names, except of first one, "
+                        "must match the input table");
+            }
+        }
+        std::unordered_set<size_t> rows_to_update;
+        while (update_batch->HasNextRow()) {
+            auto row = update_batch->GetNextRow();
+            size_t id = std::stoull(row.front());
+            if (!IsRowIndexValid(id)) {
+                throw config::ConfigurationError("Attempt to update a non-existing row");
+            }
+            if (rows_to_update.contains(id)) {
+                throw config::ConfigurationError("Update statements have duplicates");
+            }
+            rows_to_update.emplace(id);
+        }
+        update_batch->Reset();
+    }
+
     void Update(config::InputTable insert_data, config::InputTable update_data,
                 std::unordered_set<size_t> const& delete_data) {
         for (size_t row_id : delete_data) {
@@ -15,6 +15,13 @@ public:
     [[nodiscard]] virtual std::string GetColumnName(size_t index) const = 0;
     [[nodiscard]] virtual std::string GetRelationName() const = 0;
     virtual void Reset() = 0;
+
+    /* Streams with equal non-empty identities yield the same rows, so data built from one of them
+     * may be reused for the others. Empty if the contents cannot be identified */
+    [[nodiscard]] virtual std::string GetIdentity() const {
+        return {};
+    }
+
     virtual ~IDatasetStream() = default;
 };
 
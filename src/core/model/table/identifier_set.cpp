@@ -1,27 +1,41 @@
 #include "identifier_set.h"
 
+#include "util/agree_mask.h"
+
 namespace model {
 
 IdentifierSet::IdentifierSet(ColumnLayoutRelationData const* const relation, int index)
     : relation_(relation), tuple_index_(index) {
-    data_.reserve(relation_->GetNumColumns());
+    cluster_indices_.reserve(relation_->GetNumColumns());
     for (ColumnData const& col : relation_->GetColumnData()) {
-        data_.push_back({.attribute = col.GetColumn(),
-                         .cluster_index = col.GetProbingTableValue(tuple_index_)});
+        cluster_indices_.push_back(col.GetProbingTableValue(tuple_index_));
     }
 }
 
+boost::dynamic_bitset<> IdentifierSet::IntersectIndices(IdentifierSet const& other) const {
+    size_t const num_columns = cluster_indices_.size();
+    thread_local std::vector<std::uint64_t> mask;
+    mask.assign(util::GetAgreeMaskWords(num_columns), 0);
+    util::AddAgreeMask(cluster_indices_.data(), other.cluster_indices_.data(), num_columns,
+                       std::uint32_t{0}, mask.data());
+
+    boost::dynamic_bitset<> intersection(num_columns);
+    util::AgreeMaskToBitset(mask.data(), intersection);
+    return intersection;
+}
+
 std::string IdentifierSet::ToString() const {
-    if (data_.empty()) {
+    if (cluster_indices_.empty()) {
         return "[]";
     }
 
     std::string str = "[";
-    for (auto p = data_.begin(); p != data_.end() - 1; ++p) {
-        str += "(" + p->attribute->GetName() + ", " + std::to_string(p->cluster_index) + "), ";
+    for (size_t i = 0; i != cluster_indices_.size(); ++i) {
+        if (i != 0) str += ", ";
+        str += "(" + relation_->GetColumnData(i).GetColumn()->GetName() + ", " +
+               std::to_string(cluster_indices_[i]) + ")";
     }
-    str += "(" + data_.back().attribute->GetName() + ", " +
-           std::to_string(data_.back().cluster_index) + ")]";
+    str += "]";
     return str;
 }
 
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 
+#include <boost/dynamic_bitset.hpp>
+
 #include "model/table/column_data.h"
 #include "model/table/column_layout_relation_data.h"
 #include "model/table/vertical.h"
@@ -15,10 +18,8 @@ namespace model {
  * is the index of cluster in `attribute` pli the t belongs to.
  * Intersection of two identifier sets is the agree set for appropriate tuples.
  * For more information check out http://www.vldb.org/pvldb/vol8/p1082-papenbrock.pdf
- * TODO: consider using Vertical + vector<int> indices
- * instead of vector<IdentitfierSetValue>. Probably it will be faster
- * but also maybe will hurt readability.
- * UPD: Did not notice any difference in perfmormance.
+ * The cluster indices are stored in the order of the attributes, so that the sets
+ * are intersected by comparing whole rows of indices with util::AddAgreeMask.
  */
 class IdentifierSet {
 public:
@@ -30,37 +31,18 @@ public:
 
     // Returns an intersection (agree_set(tuple, other.tuple)) of two IndetifierSets
     Vertical Intersect(IdentifierSet const& other) const;
+    // Same as Intersect, but returns indices of columns of the agree set
+    boost::dynamic_bitset<> IntersectIndices(IdentifierSet const& other) const;
 
 private:
-    struct IdentifierSetValue {
-        Column const* attribute;
-        int cluster_index;
-    };
-
     ColumnLayoutRelationData const* const relation_;
-    std::vector<IdentifierSetValue> data_;
+    // cluster index of the tuple for every attribute, 0 for singleton clusters
+    std::vector<std::uint32_t> cluster_indices_;
     int const tuple_index_;
 };
 
 inline Vertical IdentifierSet::Intersect(IdentifierSet const& other) const {
-    boost::dynamic_bitset<> intersection(relation_->GetNumColumns());
-    auto p = data_.begin();
-    auto q = other.data_.begin();
-
-    while (p != data_.end() && q != other.data_.end()) {
-        if (p->attribute->GetIndex() < q->attribute->GetIndex()) {
-            ++p;
-        } else {
-            if (q->attribute->GetIndex() == p->attribute->GetIndex() && p->cluster_index != 0 &&
-                p->cluster_index == q->cluster_index) {
-                intersection.set(p->attribute->GetIndex());
-                ++p;
-            }
-            ++q;
-        }
-    }
-
-    return relation_->GetSchema()->GetVertical(intersection);
+    return relation_->GetSchema()->GetVertical(IntersectIndices(other));
 }
 
 }  // namespace model
@@ -6,8 +6,11 @@
 #include "position_list_index.h"
 
 #include <algorithm>
+#include <cassert>
 #include <chrono>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <deque>
 #include <map>
 #include <memory>
@@ -18,12 +21,90 @@
 
 #include "model/table/column_layout_relation_data.h"
 #include "model/table/vertical.h"
+#include "util/metrics.h"
+
+namespace {
+
+void WriteVarint(std::string& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+std::uint64_t ReadVarint(std::string_view& in) {
+    std::uint64_t value = 0;
+    for (unsigned shift = 0;; shift += 7) {
+        assert(!in.empty());
+        auto const byte = static_cast<std::uint8_t>(in.front());
+        in.remove_prefix(1);
+        value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) return value;
+    }
+}
+
+void WriteDouble(std::string& out, double value) {
+    char bytes[sizeof(double)];
+    std::memcpy(bytes, &value, sizeof(double));
+    out.append(bytes, sizeof(double));
+}
+
+double ReadDouble(std::string_view& in) {
+    assert(in.size() >= sizeof(double));
+    double value;
+    std::memcpy(&value, in.data(), sizeof(double));
+    in.remove_prefix(sizeof(double));
+    return value;
+}
+
+/* Row ids are written as zigzag encoded differences with the previous one, so ascending ids take
+ * one or two bytes each */
+void WriteCluster(std::string& out, std::vector<int> const& cluster) {
+    WriteVarint(out, cluster.size());
+    std::int64_t previous = 0;
+    for (int position : cluster) {
+        std::int64_t const delta = position - previous;
+        WriteVarint(out, (static_cast<std::uint64_t>(delta) << 1) ^ (delta >> 63));
+        previous = position;
+    }
+}
+
+std::vector<int> ReadCluster(std::string_view& in) {
+    std::vector<int> cluster(ReadVarint(in));
+    std::int64_t previous = 0;
+    for (int& position : cluster) {
+        std::uint64_t const zigzag = ReadVarint(in);
+        previous += static_cast<std::int64_t>(zigzag >> 1) ^
+                    -static_cast<std::int64_t>(zigzag & 1);
+        position = static_cast<int>(previous);
+    }
+    return cluster;
+}
+
+}  // namespace
 
 namespace model {
 
+namespace {
+
+/* Metrics every intersection updates, resolved once per thread and run */
+struct IntersectionMetrics {
+    util::MetricTimer& time;
+    util::MetricCounter& intersections;
+    util::MetricCounter& probed_positions;
+    util::MetricHistogram& sizes;
+
+    explicit IntersectionMetrics(util::Metrics& metrics)
+        : time(metrics.GetTimer(PositionListIndex::kIntersectionTimeMetric)),
+          intersections(metrics.GetCounter(PositionListIndex::kIntersectionsMetric)),
+          probed_positions(metrics.GetCounter(PositionListIndex::kProbedPositionsMetric)),
+          sizes(metrics.GetHistogram(PositionListIndex::kIntersectionSizeMetric)) {}
+};
+
+}  // namespace
+
 int const PositionListIndex::kSingletonValueId = 0;
-unsigned long long PositionListIndex::micros_ = 0;
-int PositionListIndex::intersection_count_ = 0;
 
 PositionListIndex::PositionListIndex(std::deque<std::vector<int>> index,
                                      std::vector<int> null_cluster, unsigned int size,
@@ -162,6 +243,8 @@ std::unique_ptr<PositionListIndex> PositionListIndex::Intersect(
 std::unique_ptr<PositionListIndex> PositionListIndex::Probe(
         std::shared_ptr<std::vector<int> const> probing_table) const {
     assert(this->relation_size_ == probing_table->size());
+    IntersectionMetrics* metrics = util::GetCurrentMetricHandles<IntersectionMetrics>();
+    util::ScopedMetricTimer timer(metrics == nullptr ? nullptr : &metrics->time);
     std::deque<std::vector<int>> new_index;
     unsigned int new_size = 0;
     double new_key_gap = 0.0;
@@ -169,6 +252,7 @@ std::unique_ptr<PositionListIndex> PositionListIndex::Probe(
     std::vector<int> null_cluster;
 
     std::unordered_map<int, std::vector<int>> partial_index;
+    int intersection_count = 0;
 
     for (auto& positions : index_) {
         for (int position : positions) {
@@ -182,7 +266,7 @@ std::unique_ptr<PositionListIndex> PositionListIndex::Probe(
             }
             int probing_table_value_id = (*probing_table)[position];
             if (probing_table_value_id == kSingletonValueId) continue;
-            intersection_count_++;
+            intersection_count++;
             partial_index[probing_table_value_id].push_back(position);
         }
 
@@ -198,6 +282,11 @@ std::unique_ptr<PositionListIndex> PositionListIndex::Probe(
         }
         partial_index.clear();
     }
+    if (metrics != nullptr) {
+        metrics->intersections.Add();
+        metrics->probed_positions.Add(intersection_count);
+        metrics->sizes.Record(new_size);
+    }
 
     double new_entropy = log(relation_size_) - new_key_gap / relation_size_;
     SortClusters(new_index);
@@ -209,7 +298,7 @@ std::unique_ptr<PositionListIndex> PositionListIndex::Probe(
 
 // TODO: null_cluster_ не поддерживается
 std::unique_ptr<PositionListIndex> PositionListIndex::ProbeAll(
-        Vertical const& probing_columns, ColumnLayoutRelationData& relation_data) {
+        Vertical const& probing_columns, ColumnLayoutRelationData const& relation_data) const {
     assert(this->relation_size_ == relation_data.GetNumRows());
     std::deque<std::vector<int>> new_index;
     unsigned int new_size = 0;
@@ -220,7 +309,7 @@ std::unique_ptr<PositionListIndex> PositionListIndex::ProbeAll(
     std::vector<int> null_cluster;
     std::vector<int> probe;
 
-    for (auto& cluster : this->index_) {
+    for (auto const& cluster : this->index_) {
         for (int position : cluster) {
             if (!TakeProbe(position, relation_data, probing_columns, probe)) {
                 probe.clear();
@@ -253,7 +342,7 @@ std::unique_ptr<PositionListIndex> PositionListIndex::ProbeAll(
                                                this->relation_size_);
 }
 
-bool PositionListIndex::TakeProbe(int position, ColumnLayoutRelationData& relation_data,
+bool PositionListIndex::TakeProbe(int position, ColumnLayoutRelationData const& relation_data,
                                   Vertical const& probing_columns, std::vector<int>& probe) {
     boost::dynamic_bitset<> probing_indices = probing_columns.GetColumnIndices();
     for (unsigned long index = probing_indices.find_first(); index < probing_indices.size();
@@ -265,6 +354,51 @@ bool PositionListIndex::TakeProbe(int position, ColumnLayoutRelationData& relati
     return true;
 }
 
+std::size_t PositionListIndex::GetMemoryUsage() const {
+    std::size_t usage = sizeof(PositionListIndex) + null_cluster_.capacity() * sizeof(int);
+    for (Cluster const& cluster : index_) {
+        usage += sizeof(Cluster) + cluster.capacity() * sizeof(int);
+    }
+    return usage;
+}
+
+std::string PositionListIndex::Serialize() const {
+    std::string data;
+    WriteVarint(data, size_);
+    WriteDouble(data, entropy_);
+    WriteDouble(data, inverted_entropy_);
+    WriteDouble(data, gini_impurity_);
+    WriteVarint(data, nep_);
+    WriteVarint(data, relation_size_);
+    WriteVarint(data, original_relation_size_);
+    WriteCluster(data, null_cluster_);
+    WriteVarint(data, index_.size());
+    for (Cluster const& cluster : index_) {
+        WriteCluster(data, cluster);
+    }
+    return data;
+}
+
+std::unique_ptr<PositionListIndex> PositionListIndex::Deserialize(std::string_view data) {
+    unsigned int const size = ReadVarint(data);
+    double const entropy = ReadDouble(data);
+    double const inverted_entropy = ReadDouble(data);
+    double const gini_impurity = ReadDouble(data);
+    unsigned long long const nep = ReadVarint(data);
+    unsigned int const relation_size = ReadVarint(data);
+    unsigned int const original_relation_size = ReadVarint(data);
+    Cluster null_cluster = ReadCluster(data);
+    std::deque<Cluster> index(ReadVarint(data));
+    for (Cluster& cluster : index) {
+        cluster = ReadCluster(data);
+    }
+    assert(data.empty());
+
+    return std::make_unique<PositionListIndex>(
+            std::move(index), std::move(null_cluster), size, entropy, nep, relation_size,
+            original_relation_size, inverted_entropy, gini_impurity);
+}
+
 std::string PositionListIndex::ToString() const {
     std::string res = "[";
     for (auto& cluster : index_) {
@@ -6,6 +6,8 @@
 #pragma once
 #include <deque>
 #include <memory>
+#include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -31,20 +33,24 @@ private:
     unsigned int relation_size_;
     unsigned int original_relation_size_;
     std::shared_ptr<std::vector<int> const> probing_table_cache_;
-    unsigned int freq_ = 0;
 
     static unsigned long long CalculateNep(unsigned int num_elements) {
         return static_cast<unsigned long long>(num_elements) * (num_elements - 1) / 2;
     }
 
     static void SortClusters(std::deque<Cluster>& clusters);
-    static bool TakeProbe(int position, ColumnLayoutRelationData& relation_data,
+    static bool TakeProbe(int position, ColumnLayoutRelationData const& relation_data,
                           Vertical const& probing_columns, std::vector<int>& probe);
 
 public:
-    static int intersection_count_;
-    static unsigned long long micros_;
     static int const kSingletonValueId;
+    /* Metrics reported to the current run (see util::GetCurrentMetrics): number of
+     * intersections, number of probed positions outside of singleton clusters, intersection time
+     * and distribution of the sizes of intersection results */
+    static constexpr std::string_view kIntersectionsMetric = "pli.intersections";
+    static constexpr std::string_view kProbedPositionsMetric = "pli.probed_positions";
+    static constexpr std::string_view kIntersectionTimeMetric = "pli.intersection_time";
+    static constexpr std::string_view kIntersectionSizeMetric = "pli.intersection_size";
 
     PositionListIndex(std::deque<Cluster> index, Cluster null_cluster, unsigned int size,
                       double entropy, unsigned long long nep, unsigned int relation_size,
@@ -101,10 +107,6 @@ public:
         return index_.size() + original_relation_size_ - size_;
     }
 
-    unsigned int GetFreq() const {
-        return freq_;
-    }
-
     unsigned int GetSize() const {
         return size_;
     }
@@ -141,15 +143,20 @@ public:
         return relation_size_ <= 1 || (GetNumNonSingletonCluster() == 1 && size_ == relation_size_);
     }
 
-    void IncFreq() {
-        freq_++;
-    }
+    /* Approximate number of bytes the index occupies in memory */
+    std::size_t GetMemoryUsage() const;
+
+    /* Compact binary representation of the index, e.g. to keep it on disk: row ids of every
+     * cluster are delta encoded as variable length integers. The probing table cache is not
+     * serialized */
+    std::string Serialize() const;
+    static std::unique_ptr<PositionListIndex> Deserialize(std::string_view data);
 
     std::unique_ptr<PositionListIndex> Intersect(PositionListIndex const* that) const;
     std::unique_ptr<PositionListIndex> Probe(
             std::shared_ptr<std::vector<int> const> probing_table) const;
     std::unique_ptr<PositionListIndex> ProbeAll(Vertical const& probing_columns,
-                                                ColumnLayoutRelationData& relation_data);
+                                                ColumnLayoutRelationData const& relation_data) const;
     std::string ToString() const;
 };
 
@@ -0,0 +1,80 @@
+#include "relation_data_loader.h"
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <easylogging++.h>
+
+#include "columnar_dataset_stream.h"
+
+namespace model {
+
+LoadedRelationData LoadRelationData(IDatasetStream& data_stream, bool is_null_eq_null,
+                                    RelationDataParts parts, config::ThreadNumType threads) {
+    LoadedRelationData loaded;
+    if (auto const* dataset = dynamic_cast<ColumnarDatasetStream const*>(&data_stream)) {
+        if (parts.relation) {
+            loaded.relation = ColumnLayoutRelationData::CreateFrom(*dataset, is_null_eq_null);
+        }
+        if (parts.typed_relation) {
+            loaded.typed_relation =
+                    ColumnLayoutTypedRelationData::CreateFrom(*dataset, is_null_eq_null, threads);
+        }
+        return loaded;
+    }
+
+    size_t const num_columns = data_stream.GetNumberOfColumns();
+    std::unordered_map<std::string, int> value_dictionary;
+    int next_value_id = 1;
+    std::vector<std::vector<int>> column_codes(parts.relation ? num_columns : 0);
+    std::vector<std::vector<std::string>> columns(parts.typed_relation ? num_columns : 0);
+    std::vector<std::string> row;
+
+    while (data_stream.HasNextRow()) {
+        row = data_stream.GetNextRow();
+
+        if (row.size() != num_columns) {
+            LOG(WARNING) << "Unexpected number of columns for a row, skipping (expected "
+                         << num_columns << ", got " << row.size() << ")";
+            continue;
+        }
+
+        for (size_t index = 0; index < row.size(); ++index) {
+            std::string& field = row[index];
+            if (parts.relation) {
+                int value_id = ColumnLayoutRelationData::kNullValueId;
+                if (!field.empty()) {
+                    auto [it, is_new] = value_dictionary.try_emplace(field, next_value_id);
+                    if (is_new) ++next_value_id;
+                    value_id = it->second;
+                }
+                column_codes[index].push_back(value_id);
+            }
+            if (parts.typed_relation) {
+                columns[index].push_back(std::move(field));
+            }
+        }
+    }
+    value_dictionary.clear();
+
+    std::vector<std::string> column_names;
+    column_names.reserve(num_columns);
+    for (size_t i = 0; i < num_columns; ++i) {
+        column_names.push_back(data_stream.GetColumnName(i));
+    }
+    if (parts.relation) {
+        loaded.relation = ColumnLayoutRelationData::CreateFrom(
+                data_stream.GetRelationName(), column_names, std::move(column_codes),
+                is_null_eq_null);
+    }
+    if (parts.typed_relation) {
+        loaded.typed_relation = ColumnLayoutTypedRelationData::CreateFrom(
+                data_stream.GetRelationName(), column_names, std::move(columns), is_null_eq_null,
+                threads);
+    }
+    return loaded;
+}
+
+}  // namespace model
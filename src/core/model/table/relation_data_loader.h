@@ -0,0 +1,32 @@
+#pragma once
+
+#include <memory>
+
+#include "column_layout_relation_data.h"
+#include "column_layout_typed_relation_data.h"
+#include "config/thread_number/type.h"
+#include "idataset_stream.h"
+
+namespace model {
+
+/* Representations of a dataset to build */
+struct RelationDataParts {
+    /* Dictionary codes and PLIs of the columns */
+    bool relation = false;
+    /* Parsed values of the columns */
+    bool typed_relation = false;
+};
+
+/* Only the requested parts are set */
+struct LoadedRelationData {
+    std::unique_ptr<ColumnLayoutRelationData> relation;
+    std::unique_ptr<ColumnLayoutTypedRelationData> typed_relation;
+};
+
+/* Builds the requested representations from a single scan of the stream, so algorithms that need
+ * both of them do not parse the dataset twice. The stream is read from its current position. Up to
+ * threads threads infer the types of the columns */
+LoadedRelationData LoadRelationData(IDatasetStream& data_stream, bool is_null_eq_null,
+                                    RelationDataParts parts, config::ThreadNumType threads = 1);
+
+}  // namespace model
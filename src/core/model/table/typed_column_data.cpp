@@ -1,13 +1,22 @@
 #include "typed_column_data.h"
 
+#include <algorithm>
+#include <array>
 #include <bitset>
 #include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <utility>
 
 #include "column_layout_typed_relation_data.h"
 #include "create_type.h"
+#include "model/types/value_parsing.h"
 
 namespace {
 
+using model::TypeId;
+
 size_t GetNextAlignedOffset(size_t cur_offset, size_t align) {
     // alignment should be power of 2
     assert(align != 0 && (align & (align - 1)) == 0);
@@ -17,53 +26,87 @@ size_t GetNextAlignedOffset(size_t cur_offset, size_t align) {
     return cur_offset;
 }
 
+/* Bit i stands for the i-th of kAllCandidateTypes */
+using CandidateTypes = std::bitset<5>;
+
+std::array<TypeId, 5> const kAllCandidateTypes = {+TypeId::kDate, +TypeId::kInt, +TypeId::kBigInt,
+                                                  +TypeId::kDouble, +TypeId::kString};
+
+struct TypeChecker {
+    TypeId type_id;
+    bool (*check)(std::string const&);
+    /* Types every value that passes the check may belong to */
+    CandidateTypes candidates;
+};
+
+/* Values of mixed columns get the type of the first check they pass, a string otherwise */
+std::array<TypeChecker, 4> const kTypeCheckers = {{
+        {+TypeId::kDate, [](std::string const& val) { return model::IsDateString(val); },
+         CandidateTypes("00001")},
+        {+TypeId::kInt, [](std::string const& val) { return model::IsIntString(val); },
+         CandidateTypes("01110")},
+        {+TypeId::kBigInt, [](std::string const& val) { return model::IsBigIntString(val); },
+         CandidateTypes("01100")},
+        {+TypeId::kDouble, [](std::string const& val) { return model::IsDoubleString(val); },
+         CandidateTypes("01000")},
+}};
+
+CandidateTypes const kStringCandidates("10000");
+
+TypeChecker const& GetTypeChecker(TypeId type_id) {
+    return *std::find_if(kTypeCheckers.begin(), kTypeCheckers.end(),
+                         [type_id](TypeChecker const& checker) {
+                             return checker.type_id == type_id;
+                         });
+}
+
+TypeId MatchValueType(std::string const& val) {
+    for (TypeChecker const& checker : kTypeCheckers) {
+        if (checker.check(val)) return checker.type_id;
+    }
+    return TypeId::kString;
+}
+
 }  // namespace
 
 namespace model {
 
 TypeId TypedColumnDataFactory::DeduceColumnType() const {
     bool is_undefined = true;
-    std::bitset<5> candidate_types_bitset("11111");
+    CandidateTypes candidate_types_bitset("11111");
     TypeId first_type_id = +TypeId::kUndefined;
-    for (std::size_t i = 0; i != unparsed_.size(); ++i) {
-        if (!kNullCheck(unparsed_[i]) && !kEmptyCheck(unparsed_[i])) {
-            is_undefined = false;
-            if (first_type_id != +TypeId::kUndefined) {
-                auto& type_check = kTypeIdToChecker.at(first_type_id);
-                if (type_check(unparsed_[i])) {
-                    // undelimited and delimited dates have different bitsets
-                    if (first_type_id == +TypeId::kDate && kDelimitedDateCheck(unparsed_[i])) {
-                        candidate_types_bitset &= kTypeIdToBitset.at(first_type_id);
-                    }
-                    continue;
+    for (std::string const& val : unparsed_) {
+        if (IsNullString(val) || IsEmptyString(val)) continue;
+        is_undefined = false;
+        if (first_type_id != +TypeId::kUndefined) {
+            if (GetTypeChecker(first_type_id).check(val)) {
+                // undelimited and delimited dates have different bitsets
+                if (first_type_id == +TypeId::kDate && IsDelimitedDateString(val)) {
+                    candidate_types_bitset &= GetTypeChecker(first_type_id).candidates;
                 }
+                continue;
             }
+        }
 
-            std::bitset<5> new_candidate_types_bitset("00000");
-            bool matched = false;
-            for (auto const& [type_id, type_check] : kTypeIdToChecker) {
-                if (type_id != first_type_id && type_check(unparsed_[i])) {
-                    if (first_type_id == +TypeId::kUndefined && !matched) {
-                        first_type_id = type_id;
-                    }
-                    matched = true;
-                    new_candidate_types_bitset |= kTypeIdToBitset.at(type_id);
-                    // possible value types are known at the first match except for dates
-                    // (undelimited dates could be ints or doubles and delimited couldn't)
-                    if (type_id == +TypeId::kDate && kUndelimitedDateCheck(unparsed_[i])) {
-                        new_candidate_types_bitset |= kTypeIdToBitset.at(+TypeId::kInt);
-                    }
-                    break;
+        CandidateTypes new_candidate_types_bitset = kStringCandidates;
+        for (TypeChecker const& checker : kTypeCheckers) {
+            if (checker.type_id != first_type_id && checker.check(val)) {
+                if (first_type_id == +TypeId::kUndefined) {
+                    first_type_id = checker.type_id;
                 }
+                new_candidate_types_bitset = checker.candidates;
+                // possible value types are known at the first match except for dates
+                // (undelimited dates could be ints or doubles and delimited couldn't)
+                if (checker.type_id == +TypeId::kDate && IsUndelimitedDateString(val)) {
+                    new_candidate_types_bitset |= GetTypeChecker(TypeId::kInt).candidates;
+                }
+                break;
             }
-            if (!matched) {
-                new_candidate_types_bitset = kTypeIdToBitset.at(+TypeId::kString);
-            }
+        }
 
-            candidate_types_bitset &= new_candidate_types_bitset;
-            if (candidate_types_bitset.none()) {
-                return +TypeId::kMixed;
-            }
+        candidate_types_bitset &= new_candidate_types_bitset;
+        if (candidate_types_bitset.none()) {
+            return +TypeId::kMixed;
         }
     }
 
@@ -71,7 +114,7 @@ TypeId TypedColumnDataFactory::DeduceColumnType() const {
         return +TypeId::kUndefined;
     }
 
-    for (std::size_t i = 0; i < 5; i++) {
+    for (std::size_t i = 0; i < kAllCandidateTypes.size(); i++) {
         if (candidate_types_bitset[i]) {
             return kAllCandidateTypes[i];
         }
@@ -80,60 +123,40 @@ TypeId TypedColumnDataFactory::DeduceColumnType() const {
     return +TypeId::kMixed;
 }
 
-TypedColumnDataFactory::TypeMap TypedColumnDataFactory::CreateTypeMap(TypeId const type_id) const {
-    TypeMap type_map;
-    auto const match = [&type_map, type_id](std::string const& val, size_t const row) {
-        if (kNullCheck(val)) {
-            type_map[+TypeId::kNull].insert(row);
-        } else if (kEmptyCheck(val)) {
-            type_map[+TypeId::kEmpty].insert(row);
+std::vector<TypeId> TypedColumnDataFactory::GetTypesLayout(TypeId const type_id) const {
+    std::vector<TypeId> types_layout;
+    types_layout.reserve(unparsed_.size());
+    bool has_ints = false;
+    bool has_big_ints = false;
+    for (std::string const& val : unparsed_) {
+        if (IsNullString(val)) {
+            types_layout.push_back(TypeId::kNull);
+        } else if (IsEmptyString(val)) {
+            types_layout.push_back(TypeId::kEmpty);
         } else if (type_id != +TypeId::kMixed) {
-            type_map[type_id].insert(row);
+            types_layout.push_back(type_id);
         } else {
-            bool matched = false;
-            for (auto const& [type_id, type_check] : kTypeIdToChecker) {
-                if (type_check(val)) {
-                    type_map[type_id].insert(row);
-                    matched = true;
-                    break;
-                }
-            }
-            if (!matched) {
-                type_map[TypeId::kString].insert(row);
-            }
+            TypeId const value_type_id = MatchValueType(val);
+            has_ints |= value_type_id == +TypeId::kInt;
+            has_big_ints |= value_type_id == +TypeId::kBigInt;
+            types_layout.push_back(value_type_id);
         }
-    };
-
-    for (std::size_t i = 0; i != unparsed_.size(); ++i) {
-        match(unparsed_[i], i);
     }
 
-    if (type_map.count(TypeId::kBigInt) && type_map.count(TypeId::kInt)) {
-        std::unordered_set<size_t>& big_ints = type_map[TypeId::kBigInt];
-        std::unordered_set<size_t> ints = std::move(type_map.extract(TypeId::kInt).mapped());
-        big_ints.insert(ints.begin(), ints.end());
-    }
-
-    return type_map;
-}
-
-std::vector<TypeId> TypedColumnDataFactory::GetTypesLayout(TypeMap const& tm) const {
-    std::vector<TypeId> types_layout(unparsed_.size(), TypeId::kString);
-
-    for (auto const& [type_id, indices] : tm) {
-        for (size_t const index : indices) {
-            types_layout[index] = type_id;
-        }
+    if (has_ints && has_big_ints) {
+        std::replace(types_layout.begin(), types_layout.end(), +TypeId::kInt, +TypeId::kBigInt);
     }
 
     return types_layout;
 }
 
 TypedColumnDataFactory::TypeIdToType TypedColumnDataFactory::MapTypeIdsToTypes(
-        TypeMap const& tm) const {
-    std::unordered_map<TypeId, std::unique_ptr<Type>> type_id_to_type;
-    for (auto const& [type_id, indices] : tm) {
-        type_id_to_type.emplace(type_id, CreateType(type_id, is_null_equal_null_));
+        std::vector<TypeId> const& types_layout) const {
+    TypeIdToType type_id_to_type;
+    for (TypeId const type_id : types_layout) {
+        if (type_id_to_type.find(type_id) == type_id_to_type.end()) {
+            type_id_to_type.emplace(type_id, CreateType(type_id, is_null_equal_null_));
+        }
     }
     return type_id_to_type;
 }
@@ -150,27 +173,24 @@ size_t TypedColumnDataFactory::CalculateMixedBufSize(
     return buf_size;
 }
 
-TypedColumnData TypedColumnDataFactory::CreateMixedFromTypeMap(std::unique_ptr<Type const> type,
-                                                               TypeMap type_map) {
+TypedColumnData TypedColumnDataFactory::CreateMixedFromTypesLayout(
+        std::unique_ptr<Type const> type, std::vector<TypeId> types_layout) {
     assert(type->GetTypeId() == +TypeId::kMixed);
     MixedType const* mixed_type = static_cast<MixedType const*>(type.get());
     std::vector<std::byte const*> data;
     data.reserve(unparsed_.size());
 
-    std::unordered_set<size_t> const& nulls = type_map[TypeId::kNull];
-    std::unordered_set<size_t> const& empties = type_map[TypeId::kEmpty];
     size_t const rows_num = unparsed_.size();
-    size_t const nulls_num = nulls.size();
-    size_t const empties_num = empties.size();
+    size_t const nulls_num = std::count(types_layout.begin(), types_layout.end(), +TypeId::kNull);
+    size_t const empties_num =
+            std::count(types_layout.begin(), types_layout.end(), +TypeId::kEmpty);
 
-    TypeIdToType type_id_to_type = MapTypeIdsToTypes(type_map);
-    std::vector<TypeId> types_layout = GetTypesLayout(type_map);
+    TypeIdToType type_id_to_type = MapTypeIdsToTypes(types_layout);
     size_t const buf_size = CalculateMixedBufSize(types_layout, type_id_to_type);
     static_assert(kTypesMaxAlignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
                   "Overaligned types lead to a missaligned accesses to values in the current "
                   "implementation, which is UB");
     std::unique_ptr<std::byte[]> buf(new std::byte[buf_size]);
-    type_map.clear(); /* type_map is no longer needed, so saving space */
 
     size_t buf_index = 0;
     for (size_t i = 0; i != types_layout.size(); ++i) {
@@ -193,20 +213,27 @@ TypedColumnData TypedColumnDataFactory::CreateMixedFromTypeMap(std::unique_ptr<T
                            std::move(buf), std::move(data), {}, {});
 }
 
-TypedColumnData TypedColumnDataFactory::CreateConcreteFromTypeMap(std::unique_ptr<Type const> type,
-                                                                  TypeMap type_map) {
+TypedColumnData TypedColumnDataFactory::CreateConcreteFromTypesLayout(
+        std::unique_ptr<Type const> type, std::vector<TypeId> const& types_layout) {
     TypeId const type_id = type->GetTypeId();
 
     if (type_id == +TypeId::kMixed) {
-        /* For mixed type use CreateMixedFromTypeMap. */
+        /* For mixed type use CreateMixedFromTypesLayout. */
         assert(0);
     }
 
-    std::unordered_set<size_t> nulls = std::move(type_map[TypeId::kNull]);
-    std::unordered_set<size_t> empties = std::move(type_map[TypeId::kEmpty]);
     size_t const rows_num = unparsed_.size();
-    size_t const nulls_num = nulls.size();
-    size_t const empties_num = empties.size();
+    boost::dynamic_bitset<> nulls(rows_num);
+    boost::dynamic_bitset<> empties(rows_num);
+    for (size_t i = 0; i != rows_num; ++i) {
+        if (types_layout[i] == +TypeId::kNull) {
+            nulls.set(i);
+        } else if (types_layout[i] == +TypeId::kEmpty) {
+            empties.set(i);
+        }
+    }
+    size_t const nulls_num = nulls.count();
+    size_t const empties_num = empties.count();
     assert(rows_num >= nulls_num + empties_num);
 
     std::vector<std::byte const*> data(unparsed_.size());
@@ -216,14 +243,21 @@ TypedColumnData TypedColumnDataFactory::CreateConcreteFromTypeMap(std::unique_pt
                                std::move(data), std::move(nulls), std::move(empties));
     }
 
-    std::unique_ptr<std::byte[]> buf(type->Allocate(rows_num - nulls_num - empties_num));
+    size_t const values_num = rows_num - nulls_num - empties_num;
+    std::unique_ptr<std::byte[]> buf(type->Allocate(values_num));
 
     size_t buf_index = 0;
     size_t const value_size = type->GetSize();
-    for (size_t i : type_map.at(type_id)) {
-        assert(buf_index <= type->GetSize() * type_map.at(type_id).size());
+    for (size_t i = 0; i != rows_num; ++i) {
+        if (types_layout[i] != type_id) continue;
+        assert(buf_index < value_size * values_num);
         std::byte* next = buf.get() + buf_index;
-        type->ValueFromStr(next, std::move(unparsed_[i]));
+        std::optional<Int> int_value;
+        if (type_id == +TypeId::kInt && (int_value = ParseInt(unparsed_[i]))) {
+            Type::GetValue<Int>(next) = *int_value;
+        } else {
+            type->ValueFromStr(next, std::move(unparsed_[i]));
+        }
         data[i] = next;
         buf_index += value_size;
     }
@@ -232,20 +266,81 @@ TypedColumnData TypedColumnDataFactory::CreateConcreteFromTypeMap(std::unique_pt
                            std::move(buf), std::move(data), std::move(nulls), std::move(empties));
 }
 
-TypedColumnData TypedColumnDataFactory::CreateFromTypeMap(std::unique_ptr<Type const> type,
-                                                          TypeMap type_map) {
+TypedColumnData TypedColumnDataFactory::CreateFromTypesLayout(std::unique_ptr<Type const> type,
+                                                              std::vector<TypeId> types_layout) {
     if (type->GetTypeId() == +TypeId::kMixed) {
-        return CreateMixedFromTypeMap(std::move(type), std::move(type_map));
+        return CreateMixedFromTypesLayout(std::move(type), std::move(types_layout));
     } else {
-        return CreateConcreteFromTypeMap(std::move(type), std::move(type_map));
+        return CreateConcreteFromTypesLayout(std::move(type), types_layout);
     }
 }
 
 TypedColumnData TypedColumnDataFactory::CreateFrom() {
     TypeId const type_id = DeduceColumnType();
-    TypeMap type_map = CreateTypeMap(type_id);
+    std::vector<TypeId> types_layout = GetTypesLayout(type_id);
+
+    return CreateFromTypesLayout(CreateType(type_id, is_null_equal_null_),
+                                 std::move(types_layout));
+}
 
-    return CreateFromTypeMap(CreateType(type_id, is_null_equal_null_), std::move(type_map));
+TypedColumnData TypedColumnDataFactory::CreateNumericFrom(Column const* col,
+                                                          ColumnBuffer const& buffer,
+                                                          bool is_null_equal_null) {
+    size_t const rows_num = buffer.GetSize();
+    boost::dynamic_bitset<> nulls(rows_num);
+    for (size_t i = 0; i != rows_num; ++i) {
+        if (buffer.IsNull(i)) nulls.set(i);
+    }
+    size_t const nulls_num = nulls.count();
+    std::vector<std::byte const*> data(rows_num);
+
+    if (nulls_num == rows_num) {
+        return TypedColumnData(col, CreateType(TypeId::kUndefined, is_null_equal_null), rows_num,
+                               nulls_num, 0, nullptr, std::move(data), std::move(nulls),
+                               boost::dynamic_bitset<>(rows_num));
+    }
+
+    TypeId const type_id = buffer.IsFloatingPoint() ? TypeId::kDouble : TypeId::kInt;
+    std::unique_ptr<Type const> type = CreateType(type_id, is_null_equal_null);
+    std::unique_ptr<std::byte[]> buf(type->Allocate(rows_num - nulls_num));
+    std::byte* next = buf.get();
+    for (size_t i = 0; i != rows_num; ++i) {
+        if (nulls.test(i)) continue;
+        if (type_id == +TypeId::kDouble) {
+            Type::GetValue<Double>(next) = buffer.GetFloatingPoint(i);
+        } else if (buffer.IsSignedInteger()) {
+            Type::GetValue<Int>(next) = buffer.GetSignedInteger(i);
+        } else {
+            Type::GetValue<Int>(next) = static_cast<Int>(buffer.GetUnsignedInteger(i));
+        }
+        data[i] = next;
+        next += type->GetSize();
+    }
+
+    return TypedColumnData(col, std::move(type), rows_num, nulls_num, 0, std::move(buf),
+                           std::move(data), std::move(nulls), boost::dynamic_bitset<>(rows_num));
+}
+
+TypedColumnData TypedColumnDataFactory::CreateFrom(Column const* col, ColumnBuffer const& buffer,
+                                                   bool is_null_equal_null) {
+    bool fits_int = true;
+    if (buffer.IsUnsignedInteger()) {
+        for (size_t i = 0; i != buffer.GetSize() && fits_int; ++i) {
+            fits_int = buffer.IsNull(i) || buffer.GetUnsignedInteger(i) <=
+                                                   std::numeric_limits<Int>::max();
+        }
+    }
+    if (buffer.IsNumeric() && fits_int) {
+        return CreateNumericFrom(col, buffer, is_null_equal_null);
+    }
+
+    // Unsigned values that do not fit into Int are big ints, their strings are parsed as usual
+    std::vector<std::string> unparsed;
+    unparsed.reserve(buffer.GetSize());
+    for (size_t i = 0; i != buffer.GetSize(); ++i) {
+        unparsed.push_back(buffer.ToString(i));
+    }
+    return CreateFrom(col, std::move(unparsed), is_null_equal_null);
 }
 
 std::vector<TypedColumnData> CreateTypedColumnData(IDatasetStream& dataset_stream,
@@ -1,11 +1,13 @@
 #pragma once
 
-#include <bitset>
-#include <regex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include <boost/dynamic_bitset.hpp>
+
 #include "abstract_column_data.h"
+#include "column_buffer.h"
 #include "idataset_stream.h"
 #include "model/types/types.h"
 #include "relation_data.h"
@@ -20,14 +22,14 @@ private:
     size_t empties_num_;
     std::unique_ptr<std::byte[]> buffer_;
     std::vector<std::byte const*> data_;
-    /* For non-mixed type only */
-    std::unordered_set<size_t> nulls_;
-    std::unordered_set<size_t> empties_;
+    /* For non-mixed type only, a bit for every row */
+    boost::dynamic_bitset<> nulls_;
+    boost::dynamic_bitset<> empties_;
 
     TypedColumnData(Column const* column, std::unique_ptr<Type const> type, size_t const rows_num,
                     size_t nulls_num, size_t empties_num, std::unique_ptr<std::byte[]> buffer,
-                    std::vector<std::byte const*> data, std::unordered_set<size_t> nulls,
-                    std::unordered_set<size_t> empties) noexcept
+                    std::vector<std::byte const*> data, boost::dynamic_bitset<> nulls,
+                    boost::dynamic_bitset<> empties) noexcept
         : AbstractColumnData(column),
           type_(std::move(type)),
           rows_num_(rows_num),
@@ -110,7 +112,7 @@ public:
         if (mixed != nullptr) {
             return mixed->RetrieveTypeId(data_[index]) == +TypeId::kNull;
         } else {
-            return nulls_.find(index) != nulls_.end();
+            return nulls_.test(index);
         }
     }
 
@@ -119,7 +121,7 @@ public:
         if (mixed != nullptr) {
             return mixed->RetrieveTypeId(data_[index]) == +TypeId::kEmpty;
         } else {
-            return empties_.find(index) != empties_.end();
+            return empties_.test(index);
         }
     }
 
@@ -164,90 +166,27 @@ public:
 
 class TypedColumnDataFactory {
 private:
-    using TypeMap = std::unordered_map<TypeId, std::unordered_set<size_t>>;
     using TypeIdToType = std::unordered_map<TypeId, std::unique_ptr<Type>>;
 
     Column const* column_;
     std::vector<std::string> unparsed_;
     bool is_null_equal_null_;
 
-    inline static std::vector<TypeId> const kAllCandidateTypes = {
-            +TypeId::kDate, +TypeId::kInt, +TypeId::kBigInt, +TypeId::kDouble, +TypeId::kString};
-    inline static std::unordered_map<TypeId, std::regex> const kTypeIdToRegex = {
-            {+TypeId::kBigInt, std::regex(R"(^(\+|-)?\d{20,}$)")},
-            {+TypeId::kInt, std::regex(R"(^(\+|-)?\d{1,19}$)")},
-            {+TypeId::kNull, std::regex(Null::kValue.data())},
-            {+TypeId::kEmpty, std::regex(R"(^$)")}};
-    inline static auto const kNullCheck = [](std::string const& val) {
-        return std::regex_match(val, kTypeIdToRegex.at(+TypeId::kNull));
-    };
-    inline static auto const kEmptyCheck = [](std::string const& val) {
-        return std::regex_match(val, kTypeIdToRegex.at(+TypeId::kEmpty));
-    };
-    inline static std::function<bool(std::string const&)> const kUndelimitedDateCheck =
-            [](std::string const& val) {
-                bool is_undelimited_date = false;
-                try {
-                    boost::gregorian::from_undelimited_string(val);
-                    is_undelimited_date = true;
-                } catch (...) {
-                }
-                return is_undelimited_date;
-            };
-    inline static std::function<bool(std::string const&)> const kDelimitedDateCheck =
-            [](std::string const& val) {
-                bool is_simple_date = false;
-                try {
-                    boost::gregorian::from_simple_string(val);
-                    is_simple_date = true;
-                } catch (...) {
-                }
-                return is_simple_date;
-            };
-    inline static std::unordered_map<TypeId, std::function<bool(std::string const&)>> const
-            kTypeIdToChecker = {{TypeId::kDouble,
-                                 [](std::string const& val) {
-                                     bool is_double = false;
-                                     try {
-                                         std::size_t pos = 0;
-                                         std::stod(val, &pos);
-                                         if (pos == val.size()) {
-                                             is_double = true;
-                                         }
-                                     } catch (...) {
-                                     }
-                                     return is_double;
-                                 }},
-                                {TypeId::kBigInt,
-                                 [](std::string const& val) {
-                                     return std::regex_match(val,
-                                                             kTypeIdToRegex.at(+TypeId::kBigInt));
-                                 }},
-                                {TypeId::kInt,
-                                 [](std::string const& val) {
-                                     return std::regex_match(val, kTypeIdToRegex.at(+TypeId::kInt));
-                                 }},
-                                {TypeId::kDate, [](std::string const& val) {
-                                     return kDelimitedDateCheck(val) || kUndelimitedDateCheck(val);
-                                 }}};
-    // each 1 represents a possible type from kAllCandidateTypes
-    inline static std::unordered_map<TypeId, std::bitset<5>> const kTypeIdToBitset = {
-            {+TypeId::kDate, std::bitset<5>("00001")},  // bitset for delimited dates
-            {+TypeId::kInt, std::bitset<5>("01110")},
-            {+TypeId::kBigInt, std::bitset<5>("01100")},
-            {+TypeId::kDouble, std::bitset<5>("01000")},
-            {+TypeId::kString, std::bitset<5>("10000")}};
-
     size_t CalculateMixedBufSize(std::vector<TypeId> const& types_layout,
                                  TypeIdToType const& type_id_to_type) const noexcept;
-    std::vector<TypeId> GetTypesLayout(TypeMap const& tm) const;
-    TypeIdToType MapTypeIdsToTypes(TypeMap const& tm) const;
+    /* Type of every value of a column of the given type */
+    std::vector<TypeId> GetTypesLayout(TypeId const type_id) const;
+    TypeIdToType MapTypeIdsToTypes(std::vector<TypeId> const& types_layout) const;
     TypeId DeduceColumnType() const;
-    TypeMap CreateTypeMap(TypeId const type_id) const;
-    TypedColumnData CreateMixedFromTypeMap(std::unique_ptr<Type const> type, TypeMap type_map);
-    TypedColumnData CreateConcreteFromTypeMap(std::unique_ptr<Type const> type, TypeMap type_map);
-    TypedColumnData CreateFromTypeMap(std::unique_ptr<Type const> type, TypeMap type_map);
+    TypedColumnData CreateMixedFromTypesLayout(std::unique_ptr<Type const> type,
+                                               std::vector<TypeId> types_layout);
+    TypedColumnData CreateConcreteFromTypesLayout(std::unique_ptr<Type const> type,
+                                                  std::vector<TypeId> const& types_layout);
+    TypedColumnData CreateFromTypesLayout(std::unique_ptr<Type const> type,
+                                          std::vector<TypeId> types_layout);
     TypedColumnData CreateFrom();
+    static TypedColumnData CreateNumericFrom(Column const* col, ColumnBuffer const& buffer,
+                                             bool is_null_equal_null);
 
     TypedColumnDataFactory(Column const* col, std::vector<std::string> unparsed,
                            bool is_null_equal_null)
@@ -259,6 +198,11 @@ public:
         TypedColumnDataFactory f(col, std::move(unparsed), is_null_equal_null);
         return f.CreateFrom();
     }
+
+    /* Integer and floating point buffers become int and double columns without type inference,
+     * other columns are inferred from the string representations of their values */
+    static TypedColumnData CreateFrom(Column const* col, ColumnBuffer const& buffer,
+                                      bool is_null_equal_null);
 };
 
 std::vector<TypedColumnData> CreateTypedColumnData(IDatasetStream& dataset_stream,
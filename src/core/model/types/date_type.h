@@ -2,12 +2,14 @@
 #include <cstddef>
 #include <cstdlib>
 #include <memory>
+#include <optional>
 #include <string>
 
 #include <boost/date_time/gregorian/gregorian.hpp>
 
 #include "imetrizable_type.h"
 #include "type.h"
+#include "value_parsing.h"
 
 namespace model {
 
@@ -31,9 +33,12 @@ public:
     }
 
     void ValueFromStr(std::byte* dest, std::string s) const override {
-        try {
-            new (dest) Date(boost::gregorian::from_simple_string(s));
-        } catch (...) {
+        if (std::optional<Date> date = ParseDelimitedDate(s)) {
+            new (dest) Date(*date);
+        } else if (std::optional<Date> date = ParseUndelimitedDate(s)) {
+            new (dest) Date(*date);
+        } else {
+            // Throws the same exception as before
             new (dest) Date(boost::gregorian::from_undelimited_string(s));
         }
     }
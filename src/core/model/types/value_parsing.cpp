@@ -0,0 +1,219 @@
+#include "value_parsing.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+using model::Date;
+using model::Int;
+
+constexpr std::uint64_t kInt64Magnitude = std::uint64_t{1} << 63;
+// Any number of at most this many digits fits into std::uint64_t
+constexpr std::size_t kMaxSafeDigits = 19;
+
+bool IsDigit(char c) noexcept {
+    return c >= '0' && c <= '9';
+}
+
+std::uint64_t LoadWord(char const* chars) noexcept {
+    std::uint64_t word;
+    std::memcpy(&word, chars, sizeof(word));
+    return word;
+}
+
+// Checks eight characters at once: every byte must lie in ['0', '9']
+bool AreEightDigits(std::uint64_t word) noexcept {
+    return ((word & 0xF0F0F0F0F0F0F0F0) |
+            (((word + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) == 0x3333333333333333;
+}
+
+// Value of eight digits loaded from memory on a little-endian machine
+std::uint32_t ParseEightDigits(std::uint64_t word) noexcept {
+    word = ((word & 0x0F0F0F0F0F0F0F0F) * 2561) >> 8;
+    word = ((word & 0x00FF00FF00FF00FF) * 6553601) >> 16;
+    return static_cast<std::uint32_t>(((word & 0x0000FFFF0000FFFF) * 42949672960001) >> 32);
+}
+
+bool AreDigits(std::string_view chars) noexcept {
+    std::size_t i = 0;
+    for (; i + 8 <= chars.size(); i += 8) {
+        if (!AreEightDigits(LoadWord(chars.data() + i))) return false;
+    }
+    for (; i != chars.size(); ++i) {
+        if (!IsDigit(chars[i])) return false;
+    }
+    return true;
+}
+
+// Value of at most kMaxSafeDigits digits
+std::uint64_t ParseDigits(std::string_view digits) noexcept {
+    std::uint64_t value = 0;
+    std::size_t i = 0;
+    if constexpr (std::endian::native == std::endian::little) {
+        for (; i + 8 <= digits.size(); i += 8) {
+            value = value * 100000000 + ParseEightDigits(LoadWord(digits.data() + i));
+        }
+    }
+    for (; i != digits.size(); ++i) {
+        value = value * 10 + static_cast<std::uint64_t>(digits[i] - '0');
+    }
+    return value;
+}
+
+struct SignedDigits {
+    bool negative;
+    std::string_view digits;
+};
+
+// Splits an integer into its sign and digits, nullopt if it is not an integer
+std::optional<SignedDigits> SplitInteger(std::string_view value) noexcept {
+    bool negative = false;
+    if (!value.empty() && (value.front() == '+' || value.front() == '-')) {
+        negative = value.front() == '-';
+        value.remove_prefix(1);
+    }
+    if (value.empty() || !AreDigits(value)) return std::nullopt;
+    return SignedDigits{negative, value};
+}
+
+bool FitsInt(SignedDigits const& integer) noexcept {
+    if (integer.digits.size() > kMaxSafeDigits) return false;
+    std::uint64_t const magnitude = ParseDigits(integer.digits);
+    return integer.negative ? magnitude <= kInt64Magnitude : magnitude < kInt64Magnitude;
+}
+
+// Same as boost::lexical_cast<unsigned short>: an optional sign and digits, a minus negates the
+// value modulo 2^16
+std::optional<unsigned short> ParseUShort(std::string_view token) noexcept {
+    std::optional<SignedDigits> const integer = SplitInteger(token);
+    if (!integer) return std::nullopt;
+    unsigned value = 0;
+    for (char c : integer->digits) {
+        value = value * 10 + static_cast<unsigned>(c - '0');
+        if (value > std::numeric_limits<unsigned short>::max()) return std::nullopt;
+    }
+    if (integer->negative) value = (0u - value) & std::numeric_limits<unsigned short>::max();
+    return static_cast<unsigned short>(value);
+}
+
+// Same as the month parsing of boost::gregorian::from_simple_string, 13 for unknown names
+unsigned short ParseMonth(std::string_view token) noexcept {
+    if (IsDigit(token.front())) return ParseUShort(token).value_or(13);
+    static constexpr std::array<std::string_view, 12> kShortNames = {
+            "jan", "feb", "mar", "apr", "may", "jun", "jul", "aug", "sep", "oct", "nov", "dec"};
+    static constexpr std::array<std::string_view, 12> kFullNames = {
+            "january", "february", "march",     "april",   "may",      "june",
+            "july",    "august",   "september", "october", "november", "december"};
+    std::array<char, 9> lowered{};
+    if (token.size() > lowered.size()) return 13;
+    for (std::size_t i = 0; i != token.size(); ++i) {
+        char const c = token[i];
+        lowered[i] = (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+    std::string_view const name(lowered.data(), token.size());
+    for (unsigned short month = 0; month != 12; ++month) {
+        if (name == kShortNames[month] || name == kFullNames[month]) return month + 1;
+    }
+    return 13;
+}
+
+// Checks what the constructor of boost::gregorian::date would throw for
+std::optional<Date> MakeDate(unsigned short year, unsigned short month, unsigned short day) {
+    using Calendar = boost::gregorian::gregorian_calendar;
+    if (year < 1400 || year > 9999 || month < 1 || month > 12 || day < 1 ||
+        day > Calendar::end_of_month_day(year, month)) {
+        return std::nullopt;
+    }
+    return Date(year, month, day);
+}
+
+}  // namespace
+
+namespace model {
+
+bool IsNullString(std::string_view value) noexcept {
+    return value == Null::kValue;
+}
+
+bool IsEmptyString(std::string_view value) noexcept {
+    return value.empty();
+}
+
+bool IsIntString(std::string_view value) noexcept {
+    std::optional<SignedDigits> const integer = SplitInteger(value);
+    return integer && FitsInt(*integer);
+}
+
+bool IsBigIntString(std::string_view value) noexcept {
+    std::optional<SignedDigits> const integer = SplitInteger(value);
+    return integer && !FitsInt(*integer);
+}
+
+bool IsDoubleString(std::string const& value) noexcept {
+    char const* const begin = value.c_str();
+    char* end = nullptr;
+    int const saved_errno = errno;
+    errno = 0;
+    std::strtod(begin, &end);
+    bool const out_of_range = errno == ERANGE;
+    errno = saved_errno;
+    return end != begin && end == begin + value.size() && !out_of_range;
+}
+
+std::optional<Int> ParseInt(std::string_view value) noexcept {
+    std::optional<SignedDigits> const integer = SplitInteger(value);
+    if (!integer || !FitsInt(*integer)) return std::nullopt;
+    std::uint64_t const magnitude = ParseDigits(integer->digits);
+    return integer->negative ? static_cast<Int>(0 - magnitude) : static_cast<Int>(magnitude);
+}
+
+std::optional<Date> ParseDelimitedDate(std::string_view value) noexcept {
+    // Year, month and day separated by any number of these, the rest of the string is ignored
+    constexpr std::string_view kSeparators = ",-. /";
+    std::array<std::string_view, 3> tokens;
+    std::size_t token_count = 0;
+    std::size_t pos = value.find_first_not_of(kSeparators);
+    while (pos != std::string_view::npos && token_count != tokens.size()) {
+        std::size_t const end = std::min(value.find_first_of(kSeparators, pos), value.size());
+        tokens[token_count++] = value.substr(pos, end - pos);
+        pos = value.find_first_not_of(kSeparators, end);
+    }
+    if (token_count != tokens.size()) return std::nullopt;
+
+    std::optional<unsigned short> const year = ParseUShort(tokens[0]);
+    std::optional<unsigned short> const day = ParseUShort(tokens[2]);
+    if (!year || !day) return std::nullopt;
+    return MakeDate(*year, ParseMonth(tokens[1]), *day);
+}
+
+std::optional<Date> ParseUndelimitedDate(std::string_view value) noexcept {
+    // Four digits of the year, two of the month and two of the day, the last of them may be
+    // shorter. The rest of the string is ignored
+    if (value.size() <= 6) return std::nullopt;
+    std::optional<unsigned short> const year = ParseUShort(value.substr(0, 4));
+    std::optional<unsigned short> const month = ParseUShort(value.substr(4, 2));
+    std::optional<unsigned short> const day = ParseUShort(value.substr(6, 2));
+    if (!year || !month || !day) return std::nullopt;
+    return MakeDate(*year, *month, *day);
+}
+
+bool IsDelimitedDateString(std::string_view value) noexcept {
+    return ParseDelimitedDate(value).has_value();
+}
+
+bool IsUndelimitedDateString(std::string_view value) noexcept {
+    return ParseUndelimitedDate(value).has_value();
+}
+
+bool IsDateString(std::string_view value) noexcept {
+    return IsDelimitedDateString(value) || IsUndelimitedDateString(value);
+}
+
+}  // namespace model
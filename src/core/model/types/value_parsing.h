@@ -0,0 +1,44 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "builtin.h"
+
+namespace model {
+
+/* Recognize the values of each type in their string form without regular expressions or parsing
+ * attempts that throw. Every check accepts the same strings as the conversion used for the type
+ * (the Int and BigInt patterns, std::stod, boost::gregorian::from_simple_string and
+ * from_undelimited_string), so type inference does not depend on which of them is used */
+
+bool IsNullString(std::string_view value) noexcept;
+
+bool IsEmptyString(std::string_view value) noexcept;
+
+/* Optional sign and digits of a value that fits into Int */
+bool IsIntString(std::string_view value) noexcept;
+
+/* Optional sign and digits of a value that does not fit into Int */
+bool IsBigIntString(std::string_view value) noexcept;
+
+/* Strings std::stod converts as a whole without going out of range */
+bool IsDoubleString(std::string const& value) noexcept;
+
+/* Dates like 2024-01-31, 2024/Jan/31 or 2024.january.31 */
+bool IsDelimitedDateString(std::string_view value) noexcept;
+
+/* Dates like 20240131 */
+bool IsUndelimitedDateString(std::string_view value) noexcept;
+
+bool IsDateString(std::string_view value) noexcept;
+
+/* Value of a string that IsIntString accepts */
+std::optional<Int> ParseInt(std::string_view value) noexcept;
+
+std::optional<Date> ParseDelimitedDate(std::string_view value) noexcept;
+
+std::optional<Date> ParseUndelimitedDate(std::string_view value) noexcept;
+
+}  // namespace model
@@ -5,6 +5,7 @@
 #include <filesystem>
 #include <fstream>
 #include <string>
+#include <system_error>
 #include <utility>
 #include <vector>
 
@@ -34,6 +35,15 @@ CSVParser::CSVParser(std::filesystem::path const& path, char separator, bool has
     if (separator == '\0') {
         throw std::invalid_argument("Invalid separator");
     }
+    std::error_code path_error, size_error, time_error;
+    std::filesystem::path const absolute_path = std::filesystem::absolute(path, path_error);
+    auto const file_size = std::filesystem::file_size(path, size_error);
+    auto const write_time = std::filesystem::last_write_time(path, time_error);
+    if (!path_error && !size_error && !time_error) {
+        identity_ = "csv\n" + absolute_path.string() + '\n' + separator + '\n' +
+                    (has_header ? "header" : "no header") + '\n' + std::to_string(file_size) +
+                    '\n' + std::to_string(write_time.time_since_epoch().count());
+    }
     if (has_header) {
         GetNext();
     } else {
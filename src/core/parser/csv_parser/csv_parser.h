@@ -30,6 +30,8 @@ private:
     int number_of_columns_;
     std::vector<std::string> column_names_;
     std::string relation_name_;
+    /* Path, format and the state of the file at the time it was opened */
+    std::string identity_;
     void GetNext();
     void PeekNext();
     void GetLine(unsigned long long const line_index);
@@ -70,4 +72,8 @@ public:
     }
 
     void Reset() override;
+
+    std::string GetIdentity() const override {
+        return identity_;
+    }
 };
@@ -0,0 +1,209 @@
+#include "util/agree_mask.h"
+
+#include <algorithm>
+#include <cassert>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define AGREE_MASK_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+
+using Word = std::uint64_t;
+using util::AgreeMaskIsa;
+
+constexpr std::size_t kWordBits = 64;
+
+template <typename Code>
+using Kernel = void (*)(Code const*, Code const*, std::size_t, Code, Word*, std::size_t) noexcept;
+
+// ORs bits into mask starting at bit position. The bits past the mask are zero, so the next word
+// is only touched when a set bit falls into it
+inline void OrBits(Word* mask, std::size_t position, Word bits) noexcept {
+    std::size_t const word = position / kWordBits;
+    std::size_t const shift = position % kWordBits;
+    mask[word] |= bits << shift;
+    if (shift != 0) {
+        Word const high_bits = bits >> (kWordBits - shift);
+        if (high_bits != 0) mask[word + 1] |= high_bits;
+    }
+}
+
+template <typename Code>
+void AddAgreeMaskScalar(Code const* first, Code const* second, std::size_t count, Code null_code,
+                        Word* mask, std::size_t first_bit) noexcept {
+    for (std::size_t i = 0; i < count; i += kWordBits) {
+        std::size_t const end = std::min(count, i + kWordBits);
+        Word bits = 0;
+        for (std::size_t j = i; j != end; ++j) {
+            bits |= static_cast<Word>((first[j] == second[j]) & (first[j] != null_code)) << (j - i);
+        }
+        OrBits(mask, first_bit + i, bits);
+    }
+}
+
+#ifdef AGREE_MASK_X86
+
+template <typename Code>
+__attribute__((target("avx2"))) void AddAgreeMaskAvx2(Code const* first, Code const* second,
+                                                      std::size_t count, Code null_code,
+                                                      Word* mask, std::size_t first_bit) noexcept {
+    constexpr std::size_t kLanes = sizeof(__m256i) / sizeof(Code);
+    __m256i nulls;
+    if constexpr (sizeof(Code) == 1) {
+        nulls = _mm256_set1_epi8(static_cast<char>(null_code));
+    } else if constexpr (sizeof(Code) == 2) {
+        nulls = _mm256_set1_epi16(static_cast<short>(null_code));
+    } else {
+        nulls = _mm256_set1_epi32(static_cast<int>(null_code));
+    }
+
+    std::size_t i = 0;
+    for (; i + kLanes <= count; i += kLanes) {
+        __m256i const a = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(first + i));
+        __m256i const b = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(second + i));
+        Word bits;
+        if constexpr (sizeof(Code) == 1) {
+            __m256i const agree =
+                    _mm256_andnot_si256(_mm256_cmpeq_epi8(a, nulls), _mm256_cmpeq_epi8(a, b));
+            bits = static_cast<std::uint32_t>(_mm256_movemask_epi8(agree));
+        } else if constexpr (sizeof(Code) == 2) {
+            __m256i const agree =
+                    _mm256_andnot_si256(_mm256_cmpeq_epi16(a, nulls), _mm256_cmpeq_epi16(a, b));
+            // Narrows the lanes to bytes in order, so there is a single bit per lane
+            __m128i const bytes = _mm_packs_epi16(_mm256_castsi256_si128(agree),
+                                                  _mm256_extracti128_si256(agree, 1));
+            bits = static_cast<std::uint16_t>(_mm_movemask_epi8(bytes));
+        } else {
+            __m256i const agree =
+                    _mm256_andnot_si256(_mm256_cmpeq_epi32(a, nulls), _mm256_cmpeq_epi32(a, b));
+            bits = static_cast<std::uint8_t>(_mm256_movemask_ps(_mm256_castsi256_ps(agree)));
+        }
+        OrBits(mask, first_bit + i, bits);
+    }
+    if (constexpr std::size_t kHalfLanes = kLanes / 2; i + kHalfLanes <= count) {
+        __m128i const a = _mm_loadu_si128(reinterpret_cast<__m128i const*>(first + i));
+        __m128i const b = _mm_loadu_si128(reinterpret_cast<__m128i const*>(second + i));
+        __m128i const half_nulls = _mm256_castsi256_si128(nulls);
+        Word bits;
+        if constexpr (sizeof(Code) == 1) {
+            __m128i const agree =
+                    _mm_andnot_si128(_mm_cmpeq_epi8(a, half_nulls), _mm_cmpeq_epi8(a, b));
+            bits = static_cast<std::uint16_t>(_mm_movemask_epi8(agree));
+        } else if constexpr (sizeof(Code) == 2) {
+            __m128i const agree =
+                    _mm_andnot_si128(_mm_cmpeq_epi16(a, half_nulls), _mm_cmpeq_epi16(a, b));
+            bits = static_cast<std::uint8_t>(
+                    _mm_movemask_epi8(_mm_packs_epi16(agree, _mm_setzero_si128())));
+        } else {
+            __m128i const agree =
+                    _mm_andnot_si128(_mm_cmpeq_epi32(a, half_nulls), _mm_cmpeq_epi32(a, b));
+            bits = static_cast<std::uint8_t>(_mm_movemask_ps(_mm_castsi128_ps(agree)));
+        }
+        OrBits(mask, first_bit + i, bits);
+        i += kHalfLanes;
+    }
+    // The tail is compared by code built without AVX, not emitted by the compiler before the tail
+    // call, switching from AVX to SSE with the upper halves of the registers set is slow
+    _mm256_zeroupper();
+    AddAgreeMaskScalar(first + i, second + i, count - i, null_code, mask, first_bit + i);
+}
+
+template <typename Code>
+__attribute__((target("avx512f,avx512bw"))) void AddAgreeMaskAvx512(
+        Code const* first, Code const* second, std::size_t count, Code null_code, Word* mask,
+        std::size_t first_bit) noexcept {
+    constexpr std::size_t kLanes = sizeof(__m512i) / sizeof(Code);
+    for (std::size_t i = 0; i < count; i += kLanes) {
+        // The lanes past the end of the rows are neither loaded nor compared
+        std::size_t const lanes = std::min(count - i, kLanes);
+        Word const active = lanes == kWordBits ? ~Word{0} : (Word{1} << lanes) - 1;
+        Word bits;
+        if constexpr (sizeof(Code) == 1) {
+            __m512i const a = _mm512_maskz_loadu_epi8(active, first + i);
+            __m512i const b = _mm512_maskz_loadu_epi8(active, second + i);
+            __m512i const nulls = _mm512_set1_epi8(static_cast<char>(null_code));
+            bits = _mm512_mask_cmpeq_epi8_mask(_mm512_mask_cmpneq_epi8_mask(active, a, nulls), a,
+                                               b);
+        } else if constexpr (sizeof(Code) == 2) {
+            __mmask32 const k = static_cast<__mmask32>(active);
+            __m512i const a = _mm512_maskz_loadu_epi16(k, first + i);
+            __m512i const b = _mm512_maskz_loadu_epi16(k, second + i);
+            __m512i const nulls = _mm512_set1_epi16(static_cast<short>(null_code));
+            bits = _mm512_mask_cmpeq_epi16_mask(_mm512_mask_cmpneq_epi16_mask(k, a, nulls), a, b);
+        } else {
+            __mmask16 const k = static_cast<__mmask16>(active);
+            __m512i const a = _mm512_maskz_loadu_epi32(k, first + i);
+            __m512i const b = _mm512_maskz_loadu_epi32(k, second + i);
+            __m512i const nulls = _mm512_set1_epi32(static_cast<int>(null_code));
+            bits = _mm512_mask_cmpeq_epi32_mask(_mm512_mask_cmpneq_epi32_mask(k, a, nulls), a, b);
+        }
+        OrBits(mask, first_bit + i, bits);
+    }
+}
+
+#endif
+
+AgreeMaskIsa DetectIsa() noexcept {
+#ifdef AGREE_MASK_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+        return AgreeMaskIsa::kAvx512;
+    }
+    if (__builtin_cpu_supports("avx2")) return AgreeMaskIsa::kAvx2;
+#endif
+    return AgreeMaskIsa::kScalar;
+}
+
+template <typename Code>
+Kernel<Code> GetKernel(AgreeMaskIsa isa) noexcept {
+    assert(util::IsAgreeMaskIsaSupported(isa));
+    switch (isa) {
+#ifdef AGREE_MASK_X86
+        case AgreeMaskIsa::kAvx512:
+            return AddAgreeMaskAvx512<Code>;
+        case AgreeMaskIsa::kAvx2:
+            return AddAgreeMaskAvx2<Code>;
+#endif
+        default:
+            return AddAgreeMaskScalar<Code>;
+    }
+}
+
+}  // namespace
+
+namespace util {
+
+AgreeMaskIsa GetAgreeMaskIsa() noexcept {
+    static AgreeMaskIsa const isa = DetectIsa();
+    return isa;
+}
+
+template <typename Code>
+void AddAgreeMask(Code const* first, Code const* second, std::size_t count, Code null_code,
+                  std::uint64_t* mask, std::size_t first_bit) noexcept {
+    static Kernel<Code> const kernel = GetKernel<Code>(GetAgreeMaskIsa());
+    kernel(first, second, count, null_code, mask, first_bit);
+}
+
+template <typename Code>
+void AddAgreeMask(AgreeMaskIsa isa, Code const* first, Code const* second, std::size_t count,
+                  Code null_code, std::uint64_t* mask, std::size_t first_bit) noexcept {
+    GetKernel<Code>(isa)(first, second, count, null_code, mask, first_bit);
+}
+
+template void AddAgreeMask(std::uint8_t const*, std::uint8_t const*, std::size_t, std::uint8_t,
+                           std::uint64_t*, std::size_t) noexcept;
+template void AddAgreeMask(std::uint16_t const*, std::uint16_t const*, std::size_t, std::uint16_t,
+                           std::uint64_t*, std::size_t) noexcept;
+template void AddAgreeMask(std::uint32_t const*, std::uint32_t const*, std::size_t, std::uint32_t,
+                           std::uint64_t*, std::size_t) noexcept;
+template void AddAgreeMask(AgreeMaskIsa, std::uint8_t const*, std::uint8_t const*, std::size_t,
+                           std::uint8_t, std::uint64_t*, std::size_t) noexcept;
+template void AddAgreeMask(AgreeMaskIsa, std::uint16_t const*, std::uint16_t const*, std::size_t,
+                           std::uint16_t, std::uint64_t*, std::size_t) noexcept;
+template void AddAgreeMask(AgreeMaskIsa, std::uint32_t const*, std::uint32_t const*, std::size_t,
+                           std::uint32_t, std::uint64_t*, std::size_t) noexcept;
+
+}  // namespace util
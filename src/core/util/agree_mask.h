@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <boost/dynamic_bitset.hpp>
+
+namespace util {
+
+/* Instruction sets the agree mask of two rows can be computed with, from the narrowest */
+enum class AgreeMaskIsa { kScalar, kAvx2, kAvx512 };
+
+/* Widest instruction set supported by the CPU, detected on the first call */
+AgreeMaskIsa GetAgreeMaskIsa() noexcept;
+
+inline bool IsAgreeMaskIsaSupported(AgreeMaskIsa isa) noexcept {
+    return isa <= GetAgreeMaskIsa();
+}
+
+/* Words needed for the agree mask of count codes */
+constexpr std::size_t GetAgreeMaskWords(std::size_t count) noexcept {
+    return (count + 63) / 64;
+}
+
+/* Compares the first count codes of two rows. Sets bit first_bit + i of mask when the i-th codes
+ * are equal and are not null_code (the code of values agreeing with nothing, e.g. singleton
+ * clusters), leaves the other bits as they are. Code is std::uint8_t, std::uint16_t or
+ * std::uint32_t. */
+template <typename Code>
+void AddAgreeMask(Code const* first, Code const* second, std::size_t count, Code null_code,
+                  std::uint64_t* mask, std::size_t first_bit = 0) noexcept;
+
+/* Same with the given instruction set, which has to be supported */
+template <typename Code>
+void AddAgreeMask(AgreeMaskIsa isa, Code const* first, Code const* second, std::size_t count,
+                  Code null_code, std::uint64_t* mask, std::size_t first_bit = 0) noexcept;
+
+/* Replaces the bits of bitset with the first bitset.size() bits of mask */
+inline void AgreeMaskToBitset(std::uint64_t const* mask, boost::dynamic_bitset<>& bitset) {
+    if constexpr (boost::dynamic_bitset<>::bits_per_block == 64) {
+        boost::from_block_range(mask, mask + bitset.num_blocks(), bitset);
+    } else {
+        for (std::size_t i = 0; i != bitset.size(); ++i) {
+            bitset[i] = (mask[i / 64] >> (i % 64)) & 1;
+        }
+    }
+}
+
+}  // namespace util
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+
+namespace util {
+
+/* Thrown by an algorithm that noticed its cancellation token had been cancelled */
+class ExecutionCancelled : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/* Thrown by an algorithm that has run out of its time or memory budget. Algorithm::Execute catches
+ * it and ends the run with the results found so far */
+class BudgetExceeded : public ExecutionCancelled {
+public:
+    using ExecutionCancelled::ExecutionCancelled;
+};
+
+/* Flag through which a running algorithm is asked to stop. Copies share the flag, so a token can
+ * be cancelled from any thread while the algorithm polls its own copy. A cancelled token stays
+ * cancelled, a new one should be used for every run */
+class CancellationToken {
+private:
+    std::shared_ptr<std::atomic<bool>> cancelled_ = std::make_shared<std::atomic<bool>>(false);
+
+public:
+    void Cancel() const noexcept {
+        cancelled_->store(true, std::memory_order_relaxed);
+    }
+
+    bool IsCancelled() const noexcept {
+        return cancelled_->load(std::memory_order_relaxed);
+    }
+};
+
+}  // namespace util
@@ -1,45 +1,35 @@
 #pragma once
 
-#include "model/table/relational_schema.h"
-#include "model/table/vertical.h"
+#include <cstdint>
 
-class CustomHashing {
-private:
-    enum class BitsetHashingMethod { kTryConvertToUlong, kTrimAndConvertToUlong };
+#include <boost/dynamic_bitset.hpp>
+#include <boost/iterator/function_output_iterator.hpp>
 
-    static constexpr BitsetHashingMethod kDefaultHashingMethod =
-#ifdef SAFE_VERTICAL_HASHING
-            BitsetHashingMethod::kTrimAndConvertToUlong;
-#else
-            BitsetHashingMethod::kTryConvertToUlong;
-#endif
+#include "model/table/relational_schema.h"
+#include "model/table/vertical.h"
 
-    template <auto BitsetHashingMethod = kDefaultHashingMethod>
-    static size_t BitsetHash(boost::dynamic_bitset<> const& bitset);
+namespace util {
 
-    friend std::hash<Vertical>;
-    friend std::hash<Column>;
+/* Hashes all words of a bitset in place, so that sets of columns of any width are told apart */
+struct BitsetHash {
+    size_t operator()(boost::dynamic_bitset<> const& bitset) const {
+        std::uint64_t hash = bitset.size();
+        auto mix_word = [&hash](boost::dynamic_bitset<>::block_type word) {
+            hash = (hash ^ word) * 0x9e3779b97f4a7c15ULL;
+            hash ^= hash >> 32;
+        };
+        boost::to_block_range(bitset, boost::make_function_output_iterator(mix_word));
+        return hash;
+    }
 };
 
-template <>
-inline size_t CustomHashing::BitsetHash<CustomHashing::BitsetHashingMethod::kTryConvertToUlong>(
-        boost::dynamic_bitset<> const& bitset) {
-    return bitset.to_ulong();
-}
-
-template <>
-inline size_t CustomHashing::BitsetHash<CustomHashing::BitsetHashingMethod::kTrimAndConvertToUlong>(
-        boost::dynamic_bitset<> const& bitset) {
-    boost::dynamic_bitset<> copy_bitset = bitset;
-    copy_bitset.resize(std::numeric_limits<unsigned long>::digits);
-    return copy_bitset.to_ulong();
-}
+}  // namespace util
 
 namespace std {
 template <>
 struct hash<Vertical> {
     size_t operator()(Vertical const& k) const {
-        return CustomHashing::BitsetHash(k.GetColumnIndicesRef());
+        return util::BitsetHash{}(k.GetColumnIndicesRef());
     }
 };
 
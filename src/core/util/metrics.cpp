@@ -0,0 +1,156 @@
+#include "util/metrics.h"
+
+#include <mutex>
+
+namespace {
+
+thread_local util::Metrics* current_metrics = nullptr;
+
+std::uint64_t NextRunId() noexcept {
+    // 0 is never given out, handles cached for it are never used
+    static std::atomic<std::uint64_t> next_run_id = 1;
+    return next_run_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+}  // namespace
+
+namespace util {
+
+std::size_t detail::AssignMetricShard() noexcept {
+    static std::atomic<std::size_t> next_shard = 0;
+    return next_shard.fetch_add(1, std::memory_order_relaxed) % MetricCounter::kShards;
+}
+
+std::uint64_t MetricCounter::Get() const noexcept {
+    std::uint64_t sum = 0;
+    for (Shard const& shard : shards_) {
+        sum += shard.value.load(std::memory_order_relaxed);
+    }
+    return sum;
+}
+
+std::vector<std::uint64_t> MetricHistogram::Get() const {
+    std::vector<std::uint64_t> buckets;
+    for (auto const& bucket : buckets_) {
+        buckets.push_back(bucket.load(std::memory_order_relaxed));
+    }
+    while (!buckets.empty() && buckets.back() == 0) {
+        buckets.pop_back();
+    }
+    return buckets;
+}
+
+template <typename Metric>
+Metric& Metrics::GetOrCreate(Registry<Metric>& registry, std::string_view name) {
+    {
+        std::shared_lock lock(mutex_);
+        if (auto it = registry.find(name); it != registry.end()) {
+            return *it->second;
+        }
+    }
+    std::unique_lock lock(mutex_);
+    auto it = registry.find(name);
+    if (it == registry.end()) {
+        it = registry.emplace(std::string(name), std::make_unique<Metric>()).first;
+    }
+    return *it->second;
+}
+
+template <typename Metric>
+Metric const* Metrics::Find(Registry<Metric> const& registry, std::string_view name) const {
+    std::shared_lock lock(mutex_);
+    auto it = registry.find(name);
+    return it == registry.end() ? nullptr : it->second.get();
+}
+
+Metrics::Metrics() : run_id_(NextRunId()) {}
+
+MetricCounter& Metrics::GetCounter(std::string_view name) {
+    return GetOrCreate(counters_, name);
+}
+
+MetricTimer& Metrics::GetTimer(std::string_view name) {
+    return GetOrCreate(timers_, name);
+}
+
+MetricHistogram& Metrics::GetHistogram(std::string_view name) {
+    return GetOrCreate(histograms_, name);
+}
+
+std::uint64_t Metrics::GetCounterValue(std::string_view name) const {
+    MetricCounter const* counter = Find(counters_, name);
+    return counter == nullptr ? 0 : counter->Get();
+}
+
+MetricTimer::Value Metrics::GetTimerValue(std::string_view name) const {
+    MetricTimer const* timer = Find(timers_, name);
+    return timer == nullptr ? MetricTimer::Value{} : timer->Get();
+}
+
+MetricsSnapshot Metrics::Snapshot() const {
+    MetricsSnapshot snapshot;
+    std::shared_lock lock(mutex_);
+    for (auto const& [name, counter] : counters_) {
+        snapshot.counters.emplace(name, counter->Get());
+    }
+    for (auto const& [name, timer] : timers_) {
+        snapshot.timers.emplace(name, timer->Get());
+    }
+    for (auto const& [name, histogram] : histograms_) {
+        snapshot.histograms.emplace(name, histogram->Get());
+    }
+    return snapshot;
+}
+
+void Metrics::Reset() {
+    std::unique_lock lock(mutex_);
+    counters_.clear();
+    timers_.clear();
+    histograms_.clear();
+    run_id_ = NextRunId();
+}
+
+Metrics* GetCurrentMetrics() noexcept {
+    return current_metrics;
+}
+
+MetricsScope::MetricsScope(Metrics* metrics) noexcept : previous_(current_metrics) {
+    current_metrics = metrics;
+}
+
+MetricsScope::~MetricsScope() {
+    current_metrics = previous_;
+}
+
+void AddToCounter(std::string_view name, std::uint64_t value) {
+    if (Metrics* metrics = GetCurrentMetrics(); metrics != nullptr) {
+        metrics->GetCounter(name).Add(value);
+    }
+}
+
+void RecordInHistogram(std::string_view name, std::uint64_t value) {
+    if (Metrics* metrics = GetCurrentMetrics(); metrics != nullptr) {
+        metrics->GetHistogram(name).Record(value);
+    }
+}
+
+ScopedMetricTimer::ScopedMetricTimer(std::string_view name) {
+    if (Metrics* metrics = GetCurrentMetrics(); metrics != nullptr) {
+        timer_ = &metrics->GetTimer(name);
+        start_ = std::chrono::steady_clock::now();
+    }
+}
+
+ScopedMetricTimer::ScopedMetricTimer(MetricTimer* timer) : timer_(timer) {
+    if (timer_ != nullptr) {
+        start_ = std::chrono::steady_clock::now();
+    }
+}
+
+ScopedMetricTimer::~ScopedMetricTimer() {
+    if (timer_ != nullptr) {
+        timer_->Add(std::chrono::steady_clock::now() - start_);
+    }
+}
+
+}  // namespace util
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace util {
+
+namespace detail {
+std::size_t AssignMetricShard() noexcept;
+inline thread_local std::size_t const kThreadMetricShard = AssignMetricShard();
+}  // namespace detail
+
+/* Counter that threads increment without contending: every thread adds to its own shard, the
+ * shards are summed on read */
+class MetricCounter {
+public:
+    static constexpr std::size_t kShards = 16;
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<std::uint64_t> value{0};
+    };
+
+    std::array<Shard, kShards> shards_;
+
+public:
+    void Add(std::uint64_t value = 1) noexcept {
+        shards_[detail::kThreadMetricShard].value.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    std::uint64_t Get() const noexcept;
+};
+
+/* Total time spent in some code and the number of times it was measured */
+class MetricTimer {
+private:
+    MetricCounter nanos_;
+    MetricCounter count_;
+
+public:
+    struct Value {
+        std::chrono::nanoseconds total{0};
+        std::uint64_t count = 0;
+    };
+
+    void Add(std::chrono::nanoseconds time) noexcept {
+        nanos_.Add(static_cast<std::uint64_t>(time.count()));
+        count_.Add();
+    }
+
+    Value Get() const noexcept {
+        return {std::chrono::nanoseconds(nanos_.Get()), count_.Get()};
+    }
+};
+
+/* Distribution of values over power of two buckets: bucket 0 counts zeros, bucket i > 0 counts
+ * values in [2^(i-1), 2^i) */
+class MetricHistogram {
+private:
+    std::array<std::atomic<std::uint64_t>, 65> buckets_{};
+
+public:
+    void Record(std::uint64_t value) noexcept {
+        buckets_[std::bit_width(value)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /* Bucket counts up to the last non-empty bucket */
+    std::vector<std::uint64_t> Get() const;
+};
+
+struct MetricsSnapshot {
+    std::map<std::string, std::uint64_t> counters;
+    std::map<std::string, MetricTimer::Value> timers;
+    std::map<std::string, std::vector<std::uint64_t>> histograms;
+};
+
+/* Named metrics of one algorithm run. Getting a metric creates it on first use, references to
+ * metrics stay valid until Reset. Getting a metric by name takes a lock, so hot code resolves the
+ * metrics it updates once per run (see GetCurrentMetricHandles) */
+class Metrics {
+private:
+    template <typename Metric>
+    using Registry = std::map<std::string, std::unique_ptr<Metric>, std::less<>>;
+
+    std::shared_mutex mutable mutex_;
+    Registry<MetricCounter> counters_;
+    Registry<MetricTimer> timers_;
+    Registry<MetricHistogram> histograms_;
+    /* Unique among all metrics objects, changes on Reset */
+    std::uint64_t run_id_;
+
+    template <typename Metric>
+    Metric& GetOrCreate(Registry<Metric>& registry, std::string_view name);
+    template <typename Metric>
+    Metric const* Find(Registry<Metric> const& registry, std::string_view name) const;
+
+public:
+    Metrics();
+
+    MetricCounter& GetCounter(std::string_view name);
+    MetricTimer& GetTimer(std::string_view name);
+    MetricHistogram& GetHistogram(std::string_view name);
+
+    /* Values of the metrics, zero if a metric has not been created. Unlike the getters above,
+     * these do not create metrics */
+    std::uint64_t GetCounterValue(std::string_view name) const;
+    MetricTimer::Value GetTimerValue(std::string_view name) const;
+
+    std::uint64_t GetRunId() const noexcept {
+        return run_id_;
+    }
+
+    /* May be called while the metrics are being updated */
+    MetricsSnapshot Snapshot() const;
+
+    /* Must not be called while the metrics are in use */
+    void Reset();
+};
+
+/* Metrics of the algorithm run the current thread works for, null if there is none. Code that
+ * does not know its algorithm, e.g. PLI intersection, reports through these */
+Metrics* GetCurrentMetrics() noexcept;
+
+/* Makes metrics current on this thread for the lifetime of the scope. Threads started by a run
+ * should open a scope with the metrics of the thread that started them */
+class MetricsScope {
+private:
+    Metrics* previous_;
+
+public:
+    explicit MetricsScope(Metrics* metrics) noexcept;
+    ~MetricsScope();
+
+    MetricsScope(MetricsScope const&) = delete;
+    MetricsScope& operator=(MetricsScope const&) = delete;
+};
+
+/* Handles of metrics of the current run, cached by the calling thread: Handles is constructed from
+ * the current metrics once per thread and run, so code called many times resolves the metrics it
+ * updates by name only once. Null if there are no current metrics. Each call site should use a
+ * Handles type of its own */
+template <typename Handles>
+Handles* GetCurrentMetricHandles() {
+    thread_local std::uint64_t run_id = 0;
+    thread_local std::optional<Handles> handles;
+    Metrics* metrics = GetCurrentMetrics();
+    if (metrics == nullptr) {
+        return nullptr;
+    }
+    if (metrics->GetRunId() != run_id) {
+        handles.emplace(*metrics);
+        run_id = metrics->GetRunId();
+    }
+    return &*handles;
+}
+
+/* Update the current metrics, nothing is done if there are none */
+void AddToCounter(std::string_view name, std::uint64_t value = 1);
+void RecordInHistogram(std::string_view name, std::uint64_t value);
+
+/* Adds the lifetime of the object to a timer of the current metrics */
+class ScopedMetricTimer {
+private:
+    MetricTimer* timer_ = nullptr;
+    std::chrono::steady_clock::time_point start_;
+
+public:
+    explicit ScopedMetricTimer(std::string_view name);
+    /* Nothing is measured if timer is null */
+    explicit ScopedMetricTimer(MetricTimer* timer);
+    ~ScopedMetricTimer();
+
+    ScopedMetricTimer(ScopedMetricTimer const&) = delete;
+    ScopedMetricTimer& operator=(ScopedMetricTimer const&) = delete;
+};
+
+}  // namespace util
@@ -7,6 +7,8 @@
 
 #include <easylogging++.h>
 
+#include "util/metrics.h"
+
 namespace util {
 
 /* Parallel version of std::for_each which allows to specify the number of threads to use.
@@ -27,7 +29,9 @@ inline void ParallelForeach(It begin, It end, unsigned const threads_num_max, Un
     std::vector<std::thread> threads;
     threads.reserve(threads_num_actual);
 
-    auto const task = [&f](It first, It last) {
+    /* Worker threads report to the metrics of the calling thread */
+    auto const task = [&f, metrics = GetCurrentMetrics()](It first, It last) {
+        MetricsScope metrics_scope(metrics);
         for (; first != last; ++first) {
             f(*first);
         }
@@ -4,36 +4,39 @@ namespace util {
 
 void Progress::AddProgress(double val) noexcept {
     assert(val >= 0);
-    std::scoped_lock lock(progress_mutex_);
-    cur_phase_progress_ += val;
-    assert(cur_phase_progress_ < 101);
+    [[maybe_unused]] std::uint64_t const old_state =
+            state_.fetch_add(ToUnits(val), std::memory_order_relaxed);
+    assert((old_state & kProgressMask) + ToUnits(val) < ToUnits(101));
 }
 
 void Progress::SetProgress(double val) noexcept {
     assert(0 <= val && val < 101);
-    std::scoped_lock lock(progress_mutex_);
-    cur_phase_progress_ = val;
+    std::uint64_t state = state_.load(std::memory_order_relaxed);
+    while (!state_.compare_exchange_weak(state, (state & ~kProgressMask) | ToUnits(val),
+                                         std::memory_order_relaxed)) {
+    }
 }
 
 std::pair<uint8_t, double> Progress::GetProgress() const noexcept {
-    std::scoped_lock lock(progress_mutex_);
-    return std::make_pair(cur_phase_id_, cur_phase_progress_);
+    std::uint64_t const state = state_.load(std::memory_order_relaxed);
+    return std::make_pair(static_cast<uint8_t>(state >> kPhaseIdShift),
+                          static_cast<double>(state & kProgressMask) / kUnitsPerPercent);
 }
 
 void Progress::ResetProgress() noexcept {
-    std::scoped_lock lock(progress_mutex_);
-    cur_phase_progress_ = 0;
-    cur_phase_id_ = 0;
+    state_.store(0, std::memory_order_relaxed);
 }
 
 void Progress::ToNextProgressPhase() noexcept {
     // Current phase is done, ensure that this is displayed in the progress bar
     SetProgress(kTotalProgressPercent);
 
-    std::scoped_lock lock(progress_mutex_);
-    ++cur_phase_id_;
-    assert(cur_phase_id_ < phase_names_.size());
-    cur_phase_progress_ = 0;
+    // The next phase starts with zero progress
+    std::uint64_t state = state_.load(std::memory_order_relaxed);
+    while (!state_.compare_exchange_weak(state, ((state >> kPhaseIdShift) + 1) << kPhaseIdShift,
+                                         std::memory_order_relaxed)) {
+    }
+    assert((state >> kPhaseIdShift) + 1 < phase_names_.size());
 }
 
 }  // namespace util
@@ -1,7 +1,8 @@
 #pragma once
 
+#include <atomic>
 #include <cassert>
-#include <mutex>
+#include <cstdint>
 #include <string_view>
 #include <utility>
 #include <vector>
@@ -13,13 +14,22 @@ namespace util {
 // value between 0 and 100. This value descibes progress of specific phase in natural way:
 // 0 - nothing done yet, 100 - the phase is finished and each value in between represents the
 // percentage of the work associated with the phase done.
+// Progress is updated without locks, so it may be reported from the hot loops of worker threads.
 class Progress {
 private:
-    std::mutex mutable progress_mutex_;
-    double cur_phase_progress_ = 0;
-    uint8_t cur_phase_id_ = 0;
+    // Current phase id in the highest bits and its progress in fractions of a percent in the rest,
+    // so that both are read and updated together
+    static constexpr int kPhaseIdShift = 56;
+    static constexpr std::uint64_t kProgressMask = (std::uint64_t{1} << kPhaseIdShift) - 1;
+    static constexpr double kUnitsPerPercent = 1e12;
+
+    std::atomic<std::uint64_t> state_ = 0;
     std::vector<std::string_view> phase_names_;
 
+    static std::uint64_t ToUnits(double percent) noexcept {
+        return static_cast<std::uint64_t>(percent * kUnitsPerPercent + 0.5);
+    }
+
 public:
     constexpr static double kTotalProgressPercent = 100.0;
 
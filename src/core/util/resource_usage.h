@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstddef>
+
+namespace util {
+
+/* Largest amount of physical memory taken by the process so far, in bytes. 0 if the platform
+ * does not report it */
+std::size_t GetPeakResidentSetSize();
+
+/* Physical memory taken by the process at the moment, in bytes. 0 if the platform does not report
+ * it */
+std::size_t GetResidentSetSize();
+
+}  // namespace util
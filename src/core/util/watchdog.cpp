@@ -0,0 +1,62 @@
+#include "util/watchdog.h"
+
+#include <utility>
+
+#include "util/resource_usage.h"
+
+namespace util {
+
+Watchdog::Watchdog(CancellationToken token, std::chrono::steady_clock::duration time_limit,
+                   std::size_t memory_limit_bytes)
+    : token_(std::move(token)) {
+    // Checked right away, so a run that starts over its budget does not get to do any work
+    if (memory_limit_bytes != 0 && GetResidentSetSize() > memory_limit_bytes) {
+        Exceed(Limit::kMemory);
+        return;
+    }
+    thread_ = std::thread([this, time_limit, memory_limit_bytes]() {
+        Watch(time_limit, memory_limit_bytes);
+    });
+}
+
+void Watchdog::Exceed(Limit limit) noexcept {
+    exceeded_limit_.store(limit);
+    token_.Cancel();
+}
+
+void Watchdog::Watch(std::chrono::steady_clock::duration time_limit,
+                     std::size_t memory_limit_bytes) {
+    using Clock = std::chrono::steady_clock;
+    bool const limit_time = time_limit != Clock::duration::zero();
+    if (!limit_time && memory_limit_bytes == 0) return;
+    auto const deadline = Clock::now() + time_limit;
+
+    std::unique_lock lock(mutex_);
+    while (true) {
+        auto wake_up = deadline;
+        if (memory_limit_bytes != 0) {
+            auto const next_poll = Clock::now() + kMemoryPollInterval;
+            if (!limit_time || next_poll < deadline) wake_up = next_poll;
+        }
+        if (stop_cv_.wait_until(lock, wake_up, [this]() { return stopped_; })) return;
+        if (limit_time && Clock::now() >= deadline) {
+            Exceed(Limit::kTime);
+            return;
+        }
+        if (memory_limit_bytes != 0 && GetResidentSetSize() > memory_limit_bytes) {
+            Exceed(Limit::kMemory);
+            return;
+        }
+    }
+}
+
+Watchdog::~Watchdog() {
+    {
+        std::scoped_lock lock(mutex_);
+        stopped_ = true;
+    }
+    stop_cv_.notify_one();
+    if (thread_.joinable()) thread_.join();
+}
+
+}  // namespace util
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+
+#include "util/cancellation.h"
+
+namespace util {
+
+/* Thread that cancels a token once a time limit has passed since the watchdog was created or the
+ * process has taken more memory than its budget. A zero limit is not enforced. The thread is
+ * stopped when the watchdog is destroyed */
+class Watchdog {
+public:
+    enum class Limit { kNone, kTime, kMemory };
+
+    // How often the memory taken by the process is checked
+    static constexpr std::chrono::milliseconds kMemoryPollInterval{50};
+
+private:
+    CancellationToken token_;
+    std::mutex mutex_;
+    std::condition_variable stop_cv_;
+    bool stopped_ = false;
+    std::atomic<Limit> exceeded_limit_ = Limit::kNone;
+    std::thread thread_;
+
+    void Exceed(Limit limit) noexcept;
+    void Watch(std::chrono::steady_clock::duration time_limit, std::size_t memory_limit_bytes);
+
+public:
+    Watchdog(CancellationToken token, std::chrono::steady_clock::duration time_limit,
+             std::size_t memory_limit_bytes = 0);
+    ~Watchdog();
+
+    Watchdog(Watchdog const&) = delete;
+    Watchdog& operator=(Watchdog const&) = delete;
+
+    // The limit the token has been cancelled for
+    Limit GetExceededLimit() const noexcept {
+        return exceeded_limit_.load();
+    }
+};
+
+}  // namespace util
@@ -1,18 +1,33 @@
 #include "bind_main_classes.h"
 
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
 #include <typeindex>
 #include <typeinfo>
 
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <pybind11/stl/filesystem.h>
 
 #include "algorithms/algo_factory.h"
 #include "algorithms/algorithm.h"
 #include "config/exceptions.h"
 #include "config/names.h"
+#include "config/tabular_data/input_table_type.h"
+#include "model/table/dataset_cache.h"
+#include "model/table/dataset_snapshot.h"
 #include "py_util/get_py_type.h"
 #include "py_util/opt_to_py.h"
 #include "py_util/py_to_any.h"
+#include "util/cancellation.h"
+#include "util/metrics.h"
 
 namespace {
 namespace py = pybind11;
@@ -30,6 +45,112 @@ void ConfigureAlgo(Algorithm& algorithm, py::kwargs const& kwargs) {
                                : boost::any{};
             });
 }
+
+// Execution of an algorithm in a separate thread, returned by Algorithm.execute_async. The
+// algorithm runs without the GIL, so other Python threads, including the one polling this object,
+// are not blocked.
+class AsyncExecution {
+private:
+    // Keeps the algorithm alive while it is running
+    py::object algorithm_object_;
+    Algorithm& algorithm_;
+    util::CancellationToken cancellation_token_;
+
+    std::mutex mutex_;
+    std::condition_variable done_cv_;
+    bool done_ = false;
+    unsigned long long time_ms_ = 0;
+    std::exception_ptr exception_;
+
+    std::thread thread_;
+
+public:
+    AsyncExecution(py::object algorithm_object, Algorithm& algorithm)
+        : algorithm_object_(std::move(algorithm_object)), algorithm_(algorithm) {
+        algorithm_.SetCancellationToken(cancellation_token_);
+        thread_ = std::thread([this]() {
+            unsigned long long time_ms = 0;
+            std::exception_ptr exception;
+            try {
+                time_ms = algorithm_.Execute();
+            } catch (...) {
+                exception = std::current_exception();
+            }
+            {
+                std::scoped_lock lock(mutex_);
+                time_ms_ = time_ms;
+                exception_ = exception;
+                done_ = true;
+            }
+            done_cv_.notify_all();
+        });
+    }
+
+    AsyncExecution(AsyncExecution const&) = delete;
+    AsyncExecution& operator=(AsyncExecution const&) = delete;
+
+    // Dropping an unfinished execution cancels it, since nothing could get its results.
+    ~AsyncExecution() {
+        cancellation_token_.Cancel();
+        py::gil_scoped_release release;
+        thread_.join();
+    }
+
+    void Cancel() const noexcept {
+        cancellation_token_.Cancel();
+    }
+
+    bool IsCancelled() const noexcept {
+        return cancellation_token_.IsCancelled();
+    }
+
+    bool IsDone() {
+        std::scoped_lock lock(mutex_);
+        return done_;
+    }
+
+    std::pair<uint8_t, double> GetProgress() const noexcept {
+        return algorithm_.GetProgress();
+    }
+
+    // Waits for the execution to finish and returns its time in milliseconds, rethrowing the
+    // exception the execution ended with, if any.
+    unsigned long long GetResult(std::optional<double> timeout) {
+        bool done;
+        {
+            py::gil_scoped_release release;
+            std::unique_lock lock(mutex_);
+            auto is_done = [this]() { return done_; };
+            if (timeout) {
+                done = done_cv_.wait_for(lock, std::chrono::duration<double>(*timeout), is_done);
+            } else {
+                done_cv_.wait(lock, is_done);
+                done = true;
+            }
+        }
+        if (!done) {
+            PyErr_SetString(PyExc_TimeoutError, "Execution has not finished in time");
+            throw py::error_already_set();
+        }
+        if (exception_) std::rethrow_exception(exception_);
+        return time_ms_;
+    }
+};
+
+py::dict MetricsToPy(util::MetricsSnapshot const& snapshot) {
+    py::dict timers;
+    for (auto const& [name, value] : snapshot.timers) {
+        py::dict timer;
+        timer["seconds"] = std::chrono::duration<double>(value.total).count();
+        timer["count"] = value.count;
+        timers[py::str(name)] = std::move(timer);
+    }
+    py::dict metrics;
+    metrics["counters"] = py::cast(snapshot.counters);
+    metrics["timers"] = std::move(timers);
+    metrics["histograms"] = py::cast(snapshot.histograms);
+    return metrics;
+}
 }  // namespace
 
 namespace python_bindings {
@@ -41,6 +162,21 @@ void BindMainClasses(py::module_& main_module) {
 
     py::register_exception<config::ConfigurationError>(main_module, "ConfigurationError",
                                                        PyExc_ValueError);
+    py::register_exception<util::ExecutionCancelled>(main_module, "ExecutionCancelled");
+
+    py::class_<AsyncExecution>(main_module, "AsyncExecution")
+            .def("cancel", &AsyncExecution::Cancel,
+                 "Ask the algorithm to stop. The execution then ends with ExecutionCancelled "
+                 "as soon as the algorithm reaches a cancellation point.")
+            .def("cancelled", &AsyncExecution::IsCancelled,
+                 "Whether cancellation has been requested.")
+            .def("done", &AsyncExecution::IsDone, "Whether the execution has finished.")
+            .def("get_progress", &AsyncExecution::GetProgress,
+                 "Get the current phase index and its progress in percent.")
+            .def("result", &AsyncExecution::GetResult, "timeout"_a = py::none(),
+                 "Wait for the execution to finish and return its time in milliseconds. "
+                 "Raises the exception the execution ended with, or TimeoutError if it has "
+                 "not finished in timeout seconds.");
 
 #define CERTAIN_SCRIPTS_ONLY                                                       \
     "\nThis option is only expected to be used by Python scripts in which it is\n" \
@@ -51,6 +187,7 @@ void BindMainClasses(py::module_& main_module) {
                     "load_data",
                     [](Algorithm& algo, py::kwargs const& kwargs) {
                         ConfigureAlgo(algo, kwargs);
+                        py::gil_scoped_release release;
                         algo.LoadData();
                     },
                     "Load data for execution")
@@ -106,9 +243,63 @@ void BindMainClasses(py::module_& main_module) {
                     "execute",
                     [](Algorithm& algo, py::kwargs const& kwargs) {
                         ConfigureAlgo(algo, kwargs);
+                        algo.SetCancellationToken({});
+                        py::gil_scoped_release release;
                         algo.Execute();
                     },
-                    "Process data.");
+                    "Process data.")
+            .def(
+                    "execute_async",
+                    [](py::object self, py::kwargs const& kwargs) {
+                        Algorithm& algo = self.cast<Algorithm&>();
+                        ConfigureAlgo(algo, kwargs);
+                        return std::make_unique<AsyncExecution>(std::move(self), algo);
+                    },
+                    "Start processing data in a separate thread. Returns an AsyncExecution "
+                    "object to poll, wait for or cancel the execution. The algorithm must not "
+                    "be used until the execution finishes.")
+            .def("get_progress", &Algorithm::GetProgress,
+                 "Get the current phase index and its progress in percent. May be called from "
+                 "another thread while the algorithm is running.")
+            .def("get_phase_names", &Algorithm::GetPhaseNames,
+                 "Get names of the algorithm's progress phases.")
+            .def("is_complete", &Algorithm::IsComplete,
+                 "Whether the last execution has finished. An execution stopped by its "
+                 "time_limit or memory_budget keeps the results found before the stop, "
+                 "they are partial then.")
+            .def(
+                    "get_metrics",
+                    [](Algorithm const& algo) { return MetricsToPy(algo.GetMetrics()); },
+                    "Get metrics of the last execution as a dict with \"counters\" (name to "
+                    "value), \"timers\" (name to a dict of total \"seconds\" and \"count\" of "
+                    "measurements, including the whole execution and each progress phase) and "
+                    "\"histograms\" (name to counts of values in power of two buckets: zeros, "
+                    "[1, 2), [2, 4), ...).");
+
+    main_module.def(
+            "set_dataset_cache_budget",
+            [](std::size_t megabytes) {
+                model::DatasetCache::Instance().SetMemoryBudget(megabytes << 20);
+            },
+            "megabytes"_a,
+            "Set how much of the data parsed from CSV files is kept for later algorithms "
+            "after the algorithms that loaded it are gone. Algorithms loading the same file "
+            "share its data anyway while any of them is alive. Zero by default.");
+    main_module.def(
+            "clear_dataset_cache", []() { model::DatasetCache::Instance().Clear(); },
+            "Drop the data kept by set_dataset_cache_budget.");
+    main_module.def(
+            "write_dataset_snapshot",
+            [](py::handle table_obj, std::filesystem::path const& path) {
+                auto const table = boost::any_cast<config::InputTable>(
+                        PyToAny("table", typeid(config::InputTable), table_obj));
+                table->Reset();
+                model::WriteDatasetSnapshot(*table, path);
+                table->Reset();
+            },
+            "table"_a, "path"_a,
+            "Save a table in a binary snapshot. Passing the snapshot path as a table loads it "
+            "without parsing, the file is memory-mapped and shared between processes.");
 #undef CERTAIN_SCRIPTS_ONLY
 }
 }  // namespace python_bindings
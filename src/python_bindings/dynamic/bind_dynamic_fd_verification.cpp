@@ -5,6 +5,8 @@
 
 #include "algorithms/algo_factory.h"
 #include "algorithms/fd/fd_verifier/dynamic_fd_verifier.h"
+#include "algorithms/fd/fd_verifier/dynamic_multi_fd_verifier.h"
+#include "algorithms/fd/fd_verifier/dynamic_stats_calculator.h"
 #include "algorithms/fd/verification_algorithms.h"
 #include "config/names.h"
 #include "config/tabular_data/crud_operations/operations.h"
@@ -26,5 +28,21 @@ void BindDynamicFdVerification(pybind11::module_& main_module) {
             .def("get_error", &DynamicFDVerifier::GetError)
             .def("get_num_error_clusters", &DynamicFDVerifier::GetNumErrorClusters)
             .def("get_highlights", &DynamicFDVerifier::GetHighlights);
+    py::class_<DynamicStatsCalculator>(dynamic_fd_verification_module, "DynamicStatistics")
+            .def("holds", &DynamicStatsCalculator::FDHolds)
+            .def("get_error", &DynamicStatsCalculator::GetError)
+            .def("get_num_error_clusters", &DynamicStatsCalculator::GetNumErrorClusters)
+            .def("get_num_error_rows", &DynamicStatsCalculator::GetNumErrorRows)
+            .def("get_highlights", &DynamicStatsCalculator::GetHighlights);
+    BindPrimitiveNoBase<DynamicMultiFDVerifier>(dynamic_fd_verification_module,
+                                                "DynamicMultiFDVerifier")
+            .def("fd_holds", &DynamicMultiFDVerifier::FDHolds)
+            .def("ucc_holds", &DynamicMultiFDVerifier::UCCHolds)
+            .def("get_num_fds", &DynamicMultiFDVerifier::GetNumFDs)
+            .def("get_num_uccs", &DynamicMultiFDVerifier::GetNumUCCs)
+            .def("get_fd_statistics", &DynamicMultiFDVerifier::GetFDStatistics,
+                 py::return_value_policy::reference_internal)
+            .def("get_ucc_statistics", &DynamicMultiFDVerifier::GetUCCStatistics,
+                 py::return_value_policy::reference_internal);
 }
 }  // namespace python_bindings
@@ -0,0 +1,231 @@
+#include "columnar_dataframe_reader.h"
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <Python.h>
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+#include "model/types/builtin.h"
+#include "py_util/dataframe_reader.h"
+
+namespace {
+
+// Structures of the Arrow C data interface, see
+// https://arrow.apache.org/docs/format/CDataInterface.html
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+struct ArrowSchema {
+    char const* format;
+    char const* name;
+    char const* metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema* dictionary;
+    void (*release)(struct ArrowSchema*);
+    void* private_data;
+};
+
+struct ArrowArray {
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    void const** buffers;
+    struct ArrowArray** children;
+    struct ArrowArray* dictionary;
+    void (*release)(struct ArrowArray*);
+    void* private_data;
+};
+
+#endif  // ARROW_C_DATA_INTERFACE
+
+}  // namespace
+
+namespace python_bindings {
+
+namespace py = pybind11;
+
+using model::ColumnBuffer;
+using ElementType = ColumnBuffer::ElementType;
+
+// Keeps a Python object alive for as long as a column views its memory.
+static std::shared_ptr<void const> HoldObject(py::object object) {
+    return std::shared_ptr<void const>(new py::object(std::move(object)), [](void const* held) {
+        py::gil_scoped_acquire gil;
+        delete static_cast<py::object const*>(held);
+    });
+}
+
+static std::optional<ElementType> GetNumpyElementType(py::dtype const& dtype) {
+    if (!dtype.attr("isnative").cast<bool>()) return std::nullopt;
+    switch (dtype.kind()) {
+        case 'i':
+            switch (dtype.itemsize()) {
+                case 1:
+                    return ElementType::kInt8;
+                case 2:
+                    return ElementType::kInt16;
+                case 4:
+                    return ElementType::kInt32;
+                case 8:
+                    return ElementType::kInt64;
+            }
+            break;
+        case 'u':
+            switch (dtype.itemsize()) {
+                case 1:
+                    return ElementType::kUInt8;
+                case 2:
+                    return ElementType::kUInt16;
+                case 4:
+                    return ElementType::kUInt32;
+                case 8:
+                    return ElementType::kUInt64;
+            }
+            break;
+        case 'f':
+            switch (dtype.itemsize()) {
+                case 4:
+                    return ElementType::kFloat32;
+                case 8:
+                    return ElementType::kFloat64;
+            }
+            break;
+    }
+    return std::nullopt;
+}
+
+static std::optional<ElementType> GetArrowElementType(std::string_view format) {
+    if (format == "c") return ElementType::kInt8;
+    if (format == "s") return ElementType::kInt16;
+    if (format == "i") return ElementType::kInt32;
+    if (format == "l") return ElementType::kInt64;
+    if (format == "C") return ElementType::kUInt8;
+    if (format == "S") return ElementType::kUInt16;
+    if (format == "I") return ElementType::kUInt32;
+    if (format == "L") return ElementType::kUInt64;
+    if (format == "f") return ElementType::kFloat32;
+    if (format == "g") return ElementType::kFloat64;
+    if (format == "u") return ElementType::kUtf8;
+    if (format == "U") return ElementType::kLargeUtf8;
+    return std::nullopt;
+}
+
+// NumPy-backed numeric columns are viewed through the array buffer, strides included.
+static std::optional<ColumnBuffer> ViewNumpyColumn(py::handle column) {
+    py::object dtype = column.attr("dtype");
+    if (!py::isinstance<py::dtype>(dtype)) return std::nullopt;
+    std::optional<ElementType> type = GetNumpyElementType(py::reinterpret_borrow<py::dtype>(dtype));
+    if (!type) return std::nullopt;
+
+    // Does not copy, since the column is backed by a NumPy array of the same dtype.
+    py::array array = column.attr("to_numpy")();
+    return ColumnBuffer::Numeric(*type, array.shape(0), array.data(), array.strides(0), nullptr, 0,
+                                 HoldObject(array));
+}
+
+// Arrow-backed columns (ArrowDtype, "string[pyarrow]", and masked nullable dtypes, which are
+// converted to Arrow without copying the values) are imported through the Arrow C data interface.
+static std::optional<ColumnBuffer> ViewArrowColumn(py::handle column) {
+    py::object values = column.attr("array");
+    if (!py::hasattr(values, "__arrow_array__")) return std::nullopt;
+
+    py::object arrow_array;
+    try {
+        arrow_array = values.attr("__arrow_array__")();
+    } catch (py::error_already_set& e) {
+        // Masked arrays need pyarrow for the conversion.
+        if (e.matches(PyExc_ImportError)) return std::nullopt;
+        throw;
+    }
+    if (py::hasattr(arrow_array, "num_chunks")) {
+        // A chunked array is viewed in place if it has a single chunk and concatenated otherwise.
+        arrow_array = arrow_array.attr("num_chunks").cast<int>() == 1
+                              ? arrow_array.attr("chunk")(0)
+                              : arrow_array.attr("combine_chunks")();
+    }
+    if (!py::hasattr(arrow_array, "__arrow_c_array__")) return std::nullopt;
+
+    py::tuple capsules = arrow_array.attr("__arrow_c_array__")();
+    auto* schema =
+            static_cast<ArrowSchema*>(PyCapsule_GetPointer(capsules[0].ptr(), "arrow_schema"));
+    auto* c_array =
+            static_cast<ArrowArray*>(PyCapsule_GetPointer(capsules[1].ptr(), "arrow_array"));
+    if (schema == nullptr || c_array == nullptr) throw py::error_already_set();
+
+    // Dictionary-encoded arrays and extension types (e.g. periods stored as integers) are left to
+    // the string conversion.
+    std::optional<ElementType> type;
+    if (schema->dictionary == nullptr && schema->metadata == nullptr) {
+        type = GetArrowElementType(schema->format);
+    }
+    if (!type) return std::nullopt;
+
+    // The array is moved out of its capsule and released when the column is destroyed.
+    std::shared_ptr<ArrowArray> owned(new ArrowArray(*c_array), [](ArrowArray* array) {
+        py::gil_scoped_acquire gil;
+        if (array->release != nullptr) array->release(array);
+        delete array;
+    });
+    c_array->release = nullptr;
+
+    auto const size = static_cast<size_t>(owned->length);
+    auto const offset = static_cast<size_t>(owned->offset);
+    auto const* validity = static_cast<std::uint8_t const*>(owned->buffers[0]);
+    if (*type == ElementType::kUtf8 || *type == ElementType::kLargeUtf8) {
+        return ColumnBuffer::Strings(*type, size, static_cast<char const*>(owned->buffers[2]),
+                                     owned->buffers[1], validity, offset, owned);
+    }
+    size_t const element_size = ColumnBuffer::GetElementSize(*type);
+    auto const* data = static_cast<std::byte const*>(owned->buffers[1]) + offset * element_size;
+    return ColumnBuffer::Numeric(*type, size, data, element_size, validity, offset, owned);
+}
+
+// Same conversion as in ArbitraryDataframeReader, applied to one column.
+static ColumnBuffer MaterializeColumn(py::handle column, py::handle is_null) {
+    std::vector<std::string> values;
+    values.reserve(py::len(column));
+    for (py::handle value : column) {
+        values.emplace_back(is_null(value).cast<bool>() ? model::Null::kValue : py::str(value));
+    }
+    return ColumnBuffer::Materialized(std::move(values));
+}
+
+std::shared_ptr<model::ColumnarDatasetStream> CreateColumnarDataset(py::handle dataframe,
+                                                                    std::string name) {
+    std::vector<std::string> column_names = GetDataframeColumnNames(dataframe);
+    size_t const num_rows = py::len(dataframe);
+    py::object iloc = dataframe.attr("iloc");
+    py::slice const all_rows(0, static_cast<ssize_t>(num_rows), 1);
+
+    std::vector<py::object> columns;
+    std::vector<std::optional<ColumnBuffer>> views;
+    bool any_viewed = false;
+    for (size_t i = 0; i < column_names.size(); ++i) {
+        columns.push_back(iloc[py::make_tuple(all_rows, i)]);
+        std::optional<ColumnBuffer> view = ViewNumpyColumn(columns.back());
+        if (!view) view = ViewArrowColumn(columns.back());
+        any_viewed |= view.has_value();
+        views.push_back(std::move(view));
+    }
+    if (!any_viewed) return nullptr;
+
+    py::object is_null = py::module_::import("pandas").attr("isna");
+    std::vector<ColumnBuffer> buffers;
+    buffers.reserve(views.size());
+    for (size_t i = 0; i < views.size(); ++i) {
+        buffers.push_back(views[i] ? std::move(*views[i]) : MaterializeColumn(columns[i], is_null));
+    }
+    return std::make_shared<model::ColumnarDatasetStream>(std::move(name), std::move(column_names),
+                                                          std::move(buffers), num_rows);
+}
+
+}  // namespace python_bindings
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <pybind11/pybind11.h>
+
+#include "model/table/columnar_dataset_stream.h"
+
+namespace python_bindings {
+
+// Creates a dataset that views the columns of a pandas DataFrame in place: numeric NumPy columns
+// through their buffers and Arrow-backed columns through the Arrow C data interface. Columns that
+// cannot be viewed are converted to strings column by column, the same way the row-wise readers
+// convert them. Returns nullptr if no column can be viewed, since then the row-wise readers are
+// just as fast.
+std::shared_ptr<model::ColumnarDatasetStream> CreateColumnarDataset(pybind11::handle dataframe,
+                                                                    std::string name);
+
+}  // namespace python_bindings
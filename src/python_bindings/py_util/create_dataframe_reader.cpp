@@ -1,6 +1,7 @@
 #include "create_dataframe_reader.h"
 
 #include "config/exceptions.h"
+#include "py_util/columnar_dataframe_reader.h"
 #include "py_util/dataframe_reader.h"
 
 namespace python_bindings {
@@ -27,6 +28,9 @@ static bool AllColumnsAreStrings(py::handle dataframe) {
 config::InputTable CreateDataFrameReader(py::handle dataframe, std::string name) {
     if (!IsDataFrame(dataframe))
         throw config::ConfigurationError("Passed object is not a dataframe");
+    if (auto dataset = CreateColumnarDataset(dataframe, name)) {
+        return dataset;
+    }
     if (AllColumnsAreStrings(dataframe)) {
         return std::make_shared<StringDataframeReader>(dataframe, std::move(name));
     } else {
@@ -15,7 +15,7 @@ namespace python_bindings {
 
 namespace py = pybind11;
 
-static std::vector<std::string> GetColumnNames(py::handle dataframe) {
+std::vector<std::string> GetDataframeColumnNames(py::handle dataframe) {
     std::vector<std::string> names;
     py::list name_lst = dataframe.attr("columns").attr("to_list")();
     for (py::handle element : name_lst) {
@@ -28,9 +28,16 @@ DataframeReaderBase::DataframeReaderBase(py::handle dataframe, std::string name)
     : dataframe_(py::reinterpret_borrow<py::object>(dataframe)),
       df_iter_(dataframe_.attr("itertuples")(false, py::none{})),
       name_(std::move(name)),
-      column_names_(GetColumnNames(dataframe_)) {}
+      column_names_(GetDataframeColumnNames(dataframe_)) {}
+
+DataframeReaderBase::~DataframeReaderBase() {
+    py::gil_scoped_acquire gil;
+    df_iter_ = py::iterator();
+    dataframe_ = py::object();
+}
 
 void DataframeReaderBase::Reset() {
+    py::gil_scoped_acquire gil;
     df_iter_ = dataframe_.attr("itertuples")(false, py::none{});
 }
 
@@ -47,14 +54,22 @@ size_t DataframeReaderBase::GetNumberOfColumns() const {
 }
 
 bool DataframeReaderBase::HasNextRow() const {
+    py::gil_scoped_acquire gil;
     return df_iter_ != py::iterator::sentinel();
 }
 
 std::vector<std::string> StringDataframeReader::GetNextRow() {
+    py::gil_scoped_acquire gil;
     return py::cast<std::vector<std::string>>(*df_iter_++);
 }
 
+ArbitraryDataframeReader::~ArbitraryDataframeReader() {
+    py::gil_scoped_acquire gil;
+    is_null_ = nullptr;
+}
+
 std::vector<std::string> ArbitraryDataframeReader::GetNextRow() {
+    py::gil_scoped_acquire gil;
     std::vector<std::string> strings{};
     auto tuple_row = py::reinterpret_borrow<py::object>(*df_iter_);
     ++df_iter_;
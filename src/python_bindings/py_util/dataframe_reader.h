@@ -6,6 +6,9 @@
 
 namespace python_bindings {
 
+std::vector<std::string> GetDataframeColumnNames(pybind11::handle dataframe);
+
+// Algorithms are run without the GIL, so every method that touches Python objects acquires it.
 class DataframeReaderBase : public model::IDatasetStream {
 protected:
     pybind11::object dataframe_;
@@ -15,6 +18,7 @@ protected:
 
 public:
     explicit DataframeReaderBase(pybind11::handle dataframe, std::string name = "Pandas dataframe");
+    ~DataframeReaderBase() override;
 
     void Reset() final;
     [[nodiscard]] std::string GetRelationName() const final;
@@ -53,6 +57,7 @@ private:
 
 public:
     using DataframeReaderBase::DataframeReaderBase;
+    ~ArbitraryDataframeReader() final;
 
     [[nodiscard]] std::vector<std::string> GetNextRow() final;
 };
@@ -15,6 +15,7 @@
 #include "config/exceptions.h"
 #include "config/tabular_data/input_table_type.h"
 #include "config/tabular_data/input_tables_type.h"
+#include "model/table/dataset_snapshot.h"
 #include "parser/csv_parser/csv_parser.h"
 #include "py_util/create_dataframe_reader.h"
 #include "util/enum_to_available_values.h"
@@ -50,6 +51,15 @@ config::InputTable PythonObjToInputTable(std::string_view option_name, py::handl
     if (py::isinstance<py::tuple>(obj)) {
         return CreateCsvParser(option_name, py::cast<py::tuple>(obj));
     }
+    if (py::isinstance<py::str>(obj) || py::hasattr(obj, "__fspath__")) {
+        auto const path = CastAndReplaceCastError<std::filesystem::path>(option_name, obj);
+        if (!model::IsDatasetSnapshot(path)) {
+            throw config::ConfigurationError(path.string() +
+                                             " is not a dataset snapshot, pass a CSV file as a "
+                                             "(path, separator, has_header) tuple.");
+        }
+        return model::OpenDatasetSnapshot(path);
+    }
     return python_bindings::CreateDataFrameReader(obj);
 }
 
@@ -129,6 +139,9 @@ std::unordered_map<std::type_index, ConvFunc> const kConverters{
         kNormalConvPair<std::filesystem::path>,
         kNormalConvPair<std::vector<std::filesystem::path>>,
         kNormalConvPair<std::unordered_set<size_t>>,
+        kNormalConvPair<std::vector<std::vector<unsigned int>>>,
+        kNormalConvPair<
+                std::vector<std::pair<std::vector<unsigned int>, std::vector<unsigned int>>>>,
 };
 
 }  // namespace
@@ -1,3 +1,4 @@
+import time
 import unittest
 from collections import namedtuple
 from itertools import chain
@@ -33,7 +34,9 @@ ALGO_CORRECT_OPTIONS_INFO = [
     (desb.fd.algorithms.Depminer, [ONLY_NULL_EQUAL_NULL_OPTION_CONTAINER]),
     (desb.fd.algorithms.FUN, [ONLY_NULL_EQUAL_NULL_OPTION_CONTAINER]),
     (desb.fd.algorithms.FdMine, [ONLY_NULL_EQUAL_NULL_OPTION_CONTAINER]),
-    (desb.fd.algorithms.HyFD, [ONLY_NULL_EQUAL_NULL_OPTION_CONTAINER]),
+    (desb.fd.algorithms.HyFD, [
+        get_common_option_container({"threads": 15}),
+    ]),
     (desb.afd.algorithms.Pyro, [
         get_common_option_container(
             {"seed": 1, "max_lhs": 12, "threads": 5, "error": 0.015}
@@ -191,7 +194,36 @@ class TestPythonBindings(unittest.TestCase):
             with self.subTest(msg=f"metric_verifier_load: {load}"):
                 with self.assertRaises(desb.ConfigurationError):
                     check_metric_verifier_failure(load.path, load.options)
-                
+
+    def test_execute_async(self):
+        algo = desb.fd.algorithms.HyFD()
+        algo.load_data(table=("WDC_satellites.csv", ",", True))
+        execution = algo.execute_async()
+        self.assertGreaterEqual(execution.result(), 0)
+        self.assertTrue(execution.done())
+        self.assertFalse(execution.cancelled())
+        self.assertGreater(len(algo.get_fds()), 0)
+
+    def test_execute_async_cancelled(self):
+        algo = desb.fd.algorithms.FdMine()
+        algo.load_data(table=("WDC_satellites.csv", ",", True))
+        start = time.monotonic()
+        algo.execute()
+        full_run_time = time.monotonic() - start
+        full_fds = len(algo.get_fds())
+
+        start = time.monotonic()
+        execution = algo.execute_async()
+        execution.cancel()
+        # A run that got to finish would return its time instead
+        with self.assertRaises(desb.ExecutionCancelled):
+            execution.result()
+        self.assertLess(time.monotonic() - start, full_run_time / 2)
+        self.assertTrue(execution.cancelled())
+        self.assertTrue(execution.done())
+        # A cancelled run does not prevent the next one
+        algo.execute()
+        self.assertEqual(len(algo.get_fds()), full_fds)
 
 
 if __name__ == "__main__":
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <system_error>
+
+namespace tests {
+
+/// file in the temporary directory with a name of its own, so that test runs in parallel do not
+/// overwrite each other's files; removed when the test is over
+class TemporaryFile {
+private:
+    std::filesystem::path path_;
+
+public:
+    TemporaryFile() {
+        static std::atomic<unsigned> files_created = 0;
+        path_ = std::filesystem::temp_directory_path() /
+                ("desbordante_test_" + std::to_string(std::random_device{}()) + "_" +
+                 std::to_string(files_created++));
+    }
+
+    TemporaryFile(TemporaryFile const&) = delete;
+    TemporaryFile& operator=(TemporaryFile const&) = delete;
+
+    ~TemporaryFile() {
+        std::error_code error;
+        std::filesystem::remove(path_, error);
+    }
+
+    std::filesystem::path const& GetPath() const noexcept {
+        return path_;
+    }
+};
+
+}  // namespace tests
@@ -1,14 +1,39 @@
+#include <algorithm>
 #include <iostream>
+#include <list>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <string_view>
 #include <vector>
 
+#include <boost/any.hpp>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include "algorithms/algo_factory.h"
+#include "algorithms/fd/dfd/dfd.h"
+#include "algorithms/fd/fd.h"
+#include "algorithms/fd/fd_mine/fd_mine.h"
+#include "algorithms/fd/fun/fun.h"
+#include "algorithms/fd/hyfd/hyfd.h"
 #include "algorithms/fd/pyro/pyro.h"
+#include "algorithms/fd/tane/tane.h"
+#include "algorithms/ucc/hpivalid/hpivalid.h"
+#include "algorithms/ucc/hyucc/hyucc.h"
+#include "algorithms/ucc/ucc.h"
 #include "all_csv_configs.h"
 #include "config/error/type.h"
+#include "config/memory_budget/type.h"
 #include "config/names.h"
+#include "config/tabular_data/input_table_type.h"
+#include "config/time_limit/type.h"
+#include "model/table/idataset_stream.h"
+#include "util/cancellation.h"
+#include "util/metrics.h"
+#include "util/resource_usage.h"
 
 namespace tests {
 
@@ -64,4 +89,233 @@ INSTANTIATE_TEST_SUITE_P(, KeysTest,
                                            KeysTestParams({0, 2}, kCIPublicHighway700),
                                            KeysTestParams({}, kAbalone),
                                            KeysTestParams({}, kAdult)));
+
+TEST(AlgorithmCancellation, CancelledTokenStopsExecution) {
+    using namespace config::names;
+    algos::StdParamsMap params_map{{kCsvConfig, kWdcSatellites},
+                                   {kSeed, decltype(algos::pyro::Parameters::seed){0}},
+                                   {kError, config::ErrorType{0.0}}};
+    auto pyro = algos::CreateAndLoadAlgorithm<algos::Pyro>(params_map);
+
+    util::CancellationToken token;
+    pyro->SetCancellationToken(token);
+    token.Cancel();
+    EXPECT_THROW(pyro->Execute(), util::ExecutionCancelled);
+
+    pyro->SetCancellationToken({});
+    EXPECT_NO_THROW(pyro->Execute());
+    EXPECT_FALSE(pyro->FdList().empty());
+}
+
+TEST(AlgorithmMetrics, ReportedForEveryRun) {
+    using namespace config::names;
+    algos::StdParamsMap params_map{{kCsvConfig, kCIPublicHighway700},
+                                   {kSeed, decltype(algos::pyro::Parameters::seed){0}},
+                                   {kError, config::ErrorType{0.01}},
+                                   {kThreads, config::ThreadNumType{4}}};
+    auto pyro = algos::CreateAndLoadAlgorithm<algos::Pyro>(params_map);
+    EXPECT_TRUE(pyro->GetMetrics().timers.empty());
+
+    for (int run = 0; run < 2; ++run) {
+        if (run != 0) algos::ConfigureFromMap(*pyro, params_map);
+        pyro->Execute();
+        util::MetricsSnapshot const metrics = pyro->GetMetrics();
+        EXPECT_EQ(metrics.timers.at("execute").count, 1);
+        EXPECT_GT(metrics.counters.at("pli.intersections"), 0);
+        EXPECT_GT(metrics.counters.at("pli_cache.misses"), 0);
+        EXPECT_EQ(metrics.timers.at("pli.intersection_time").count,
+                  metrics.counters.at("pli.intersections"));
+        for (std::string_view phase_name : pyro->GetPhaseNames()) {
+            EXPECT_EQ(metrics.timers.count("phase." + std::string(phase_name)), 1);
+        }
+    }
+}
+
+namespace {
+
+// Random columns, binary by default, make the lattice of a level-wise algorithm wide, the FDs and
+// UCCs between them are long. The columns A and B determine each other, the column K is constant.
+class WideRandomTable final : public model::IDatasetStream {
+private:
+    static constexpr std::size_t kRows = 2000;
+
+    std::size_t random_columns_;
+    std::vector<Row> rows_;
+    std::size_t next_row_ = 0;
+
+public:
+    explicit WideRandomTable(std::size_t random_columns, int column_values = 2)
+        : random_columns_(random_columns) {
+        std::mt19937 gen{0};
+        std::uniform_int_distribution<int> value{0, column_values - 1};
+        std::uniform_int_distribution<int> a_value{0, 3};
+        for (std::size_t i = 0; i != kRows; ++i) {
+            int const a = a_value(gen);
+            Row row{std::to_string(a), "b" + std::to_string((a + 1) % 4), "k"};
+            for (std::size_t j = 0; j != random_columns_; ++j) {
+                row.push_back(std::to_string(value(gen)));
+            }
+            rows_.push_back(std::move(row));
+        }
+    }
+
+    Row GetNextRow() override {
+        return rows_[next_row_++];
+    }
+
+    bool HasNextRow() const override {
+        return next_row_ != rows_.size();
+    }
+
+    std::size_t GetNumberOfColumns() const override {
+        return random_columns_ + 3;
+    }
+
+    std::string GetColumnName(std::size_t index) const override {
+        if (index < 3) return std::string(1, "ABK"[index]);
+        return "C" + std::to_string(index - 3);
+    }
+
+    std::string GetRelationName() const override {
+        return "wide_random";
+    }
+
+    void Reset() override {
+        next_row_ = 0;
+    }
+};
+
+std::set<std::string> ToStrings(std::list<FD> const& fds) {
+    std::set<std::string> strings;
+    for (FD const& fd : fds) {
+        strings.insert(fd.ToLongString());
+    }
+    return strings;
+}
+
+std::set<std::string> ToStrings(std::list<model::UCC> const& uccs) {
+    std::set<std::string> strings;
+    for (model::UCC const& ucc : uccs) {
+        strings.insert(ucc.ToIndicesString());
+    }
+    return strings;
+}
+
+// Minimal FDs of WideRandomTable, mined without a budget once for each width
+std::set<std::string> const& GetAllFds(std::size_t random_columns) {
+    static std::map<std::size_t, std::set<std::string>> all_fds;
+    auto const [it, inserted] = all_fds.try_emplace(random_columns);
+    if (inserted) {
+        auto const table = std::make_shared<WideRandomTable>(random_columns);
+        auto hyfd = algos::CreateAndLoadAlgorithm<algos::hyfd::HyFD>(
+                algos::StdParamsMap{{config::names::kTable, config::InputTable{table}}});
+        hyfd->Execute();
+        it->second = ToStrings(hyfd->FdList());
+    }
+    return it->second;
+}
+
+// Runs the algorithm on WideRandomTable with a budget it cannot finish in, the run must stop and
+// keep only FDs of the full result
+template <typename Algo>
+std::set<std::string> MineWithBudget(std::string_view budget_option, boost::any budget,
+                                     std::size_t random_columns = 18) {
+    using namespace config::names;
+    auto const table = std::make_shared<WideRandomTable>(random_columns);
+    algos::StdParamsMap const params_map{{kTable, config::InputTable{table}},
+                                         {std::string{budget_option}, std::move(budget)}};
+    auto algorithm = algos::CreateAndLoadAlgorithm<Algo>(params_map);
+
+    EXPECT_NO_THROW(algorithm->Execute());
+    EXPECT_FALSE(algorithm->IsComplete());
+    std::set<std::string> const fds = ToStrings(algorithm->FdList());
+    std::set<std::string> const& all_fds = GetAllFds(random_columns);
+    for (std::string const& fd : fds) {
+        EXPECT_TRUE(all_fds.contains(fd)) << fd << " is not a minimal FD";
+    }
+    return fds;
+}
+
+}  // namespace
+
+TEST(AlgorithmBudget, ExceededTimeLimitKeepsPartialResults) {
+    using config::names::kTimeLimitSeconds;
+    config::TimeLimitSecondsType const time_limit = 1;
+    MineWithBudget<algos::Tane>(kTimeLimitSeconds, time_limit);
+    MineWithBudget<algos::FUN>(kTimeLimitSeconds, time_limit);
+    // These finish on the narrower table within the limit
+    MineWithBudget<algos::hyfd::HyFD>(kTimeLimitSeconds, time_limit, 20);
+    MineWithBudget<algos::Pyro>(kTimeLimitSeconds, time_limit, 20);
+    MineWithBudget<algos::DFD>(kTimeLimitSeconds, time_limit, 20);
+    // FdMine cannot restore the minimal FDs before its last level
+    EXPECT_TRUE(MineWithBudget<algos::FdMine>(kTimeLimitSeconds, time_limit).empty());
+}
+
+TEST(AlgorithmBudget, ExceededMemoryBudgetKeepsPartialResults) {
+    std::size_t const resident_mb = util::GetResidentSetSize() >> 20;
+    if (resident_mb == 0) GTEST_SKIP() << "Memory usage is not reported";
+    // The PLIs of the fifth level of the lattice take more than a hundred megabytes
+    config::MemoryBudgetMBType const memory_budget = resident_mb + 64;
+    MineWithBudget<algos::Tane>(config::names::kMemoryBudgetMB, memory_budget);
+}
+
+TEST(AlgorithmBudget, TimeLimitExpiringInValidationKeepsPartialUCCs) {
+    using namespace config::names;
+    constexpr std::size_t kRandomColumns = 18;
+    constexpr int kColumnValues = 4;
+    auto hpivalid = algos::CreateAndLoadAlgorithm<algos::HPIValid>(algos::StdParamsMap{
+            {kTable, config::InputTable{
+                             std::make_shared<WideRandomTable>(kRandomColumns, kColumnValues)}}});
+    hpivalid->Execute();
+    std::set<std::string> const all_uccs = ToStrings(hpivalid->UCCList());
+
+    // Sampling and induction take about a second, the validation that follows takes several. The
+    // limit expires while the validator goes through the levels, which stops after its current one.
+    auto hyucc = algos::CreateAndLoadAlgorithm<algos::HyUCC>(algos::StdParamsMap{
+            {kTable, config::InputTable{
+                             std::make_shared<WideRandomTable>(kRandomColumns, kColumnValues)}},
+            {kTimeLimitSeconds, config::TimeLimitSecondsType{2}}});
+    EXPECT_NO_THROW(hyucc->Execute());
+    EXPECT_FALSE(hyucc->IsComplete());
+    for (std::string const& ucc : ToStrings(hyucc->UCCList())) {
+        EXPECT_TRUE(all_uccs.contains(ucc)) << ucc << " is not a minimal UCC";
+    }
+}
+
+TEST(PyroParallelism, SameFdsForAnyNumberOfThreads) {
+    using namespace config::names;
+    auto discover = [](config::ThreadNumType threads) {
+        algos::StdParamsMap params_map{{kCsvConfig, kCIPublicHighway700},
+                                       {kSeed, decltype(algos::pyro::Parameters::seed){0}},
+                                       {kError, config::ErrorType{0.01}},
+                                       {kThreads, threads}};
+        auto pyro = algos::CreateAndLoadAlgorithm<algos::Pyro>(params_map);
+        pyro->Execute();
+        std::set<std::string> fds;
+        for (auto const& fd : pyro->FdList()) {
+            fds.insert(fd.ToLongString());
+        }
+        return fds;
+    };
+    std::set<std::string> const expected = discover(1);
+    EXPECT_EQ(discover(2), expected);
+    EXPECT_EQ(discover(8), expected);
+}
+
+TEST(HyFDParallelism, SameFdsForAnyNumberOfThreads) {
+    using namespace config::names;
+    auto discover = [](config::ThreadNumType threads) {
+        algos::StdParamsMap params_map{{kCsvConfig, kCIPublicHighway700}, {kThreads, threads}};
+        auto hyfd = algos::CreateAndLoadAlgorithm<algos::hyfd::HyFD>(params_map);
+        hyfd->Execute();
+        std::set<std::string> fds;
+        for (auto const& fd : hyfd->FdList()) {
+            fds.insert(fd.ToLongString());
+        }
+        return fds;
+    };
+    std::set<std::string> const expected = discover(1);
+    EXPECT_EQ(discover(4), expected);
+}
+
 }  // namespace tests
@@ -0,0 +1,82 @@
+#include <cstddef>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "benchmark/comparison.h"
+#include "temporary_file.h"
+
+namespace tests {
+
+namespace {
+
+struct RunRecord {
+    std::string name;
+    double wall_ms;
+    std::size_t peak_rss_bytes = 0;
+    bool ok = true;
+    bool isolated = true;
+};
+
+void WriteResults(std::filesystem::path const& path, std::vector<RunRecord> const& runs) {
+    std::ofstream out(path);
+    out << "{\"version\": 1, \"runs\": [";
+    for (std::size_t i = 0; i != runs.size(); ++i) {
+        RunRecord const& run = runs[i];
+        out << (i == 0 ? "" : ",") << "{\"case\": \"" << run.name
+            << "\", \"rows\": 0, \"threads\": 1, \"isolated\": "
+            << (run.isolated ? "true" : "false") << ", \"status\": \""
+            << (run.ok ? "ok" : "error") << "\", \"wall_ms_median\": " << run.wall_ms
+            << ", \"peak_rss_bytes\": " << run.peak_rss_bytes << "}";
+    }
+    out << "]}\n";
+}
+
+}  // namespace
+
+TEST(BenchmarkComparison, ReportsChangedAndUnmatchedRuns) {
+    using ::testing::HasSubstr;
+    using ::testing::Not;
+    std::size_t const mib = 1 << 20;
+    TemporaryFile const results;
+    TemporaryFile const baseline;
+    WriteResults(baseline.GetPath(), {{"same", 100},
+                                      {"slower", 100},
+                                      {"faster", 200},
+                                      {"noise", 1},
+                                      {"failing", 100},
+                                      {"heavier", 100, 100 * mib},
+                                      {"heavier_in_process", 100, 100 * mib, true, false},
+                                      {"removed", 100}});
+    WriteResults(results.GetPath(), {{"same", 103},
+                                     {"slower", 200},
+                                     {"faster", 100},
+                                     {"noise", 3},
+                                     {"failing", 100, 0, false},
+                                     {"heavier", 100, 200 * mib},
+                                     {"heavier_in_process", 100, 200 * mib, true, false},
+                                     {"added", 100}});
+
+    std::ostringstream out;
+    std::size_t const regressions =
+            bench::CompareWithBaseline(results.GetPath(), baseline.GetPath(), {}, out);
+    std::string const report = out.str();
+    EXPECT_EQ(regressions, 3);
+    EXPECT_THAT(report, HasSubstr("REGRESSION  slower rows=all threads=1: wall time"));
+    EXPECT_THAT(report, HasSubstr("improvement faster rows=all threads=1: wall time"));
+    EXPECT_THAT(report, HasSubstr("REGRESSION  failing rows=all threads=1: failed"));
+    EXPECT_THAT(report, HasSubstr("REGRESSION  heavier rows=all threads=1: peak RSS"));
+    EXPECT_THAT(report, HasSubstr("new         added rows=all threads=1"));
+    EXPECT_THAT(report, HasSubstr("dropped     removed rows=all threads=1"));
+    for (char const* unchanged : {" same ", " noise ", " heavier_in_process "}) {
+        EXPECT_THAT(report, Not(HasSubstr(unchanged)));
+    }
+    EXPECT_THAT(report, HasSubstr("3 regressions, 1 improvements, 1 not in the baseline, "
+                                  "1 only in the baseline"));
+}
+
+}  // namespace tests
@@ -0,0 +1,246 @@
+#include <chrono>
+#include <deque>
+#include <future>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "algorithms/algo_factory.h"
+#include "algorithms/fd/hyfd/hyfd.h"
+#include "algorithms/fd/pyro/pyro.h"
+#include "algorithms/fd/tane/tane.h"
+#include "algorithms/ucc/hyucc/hyucc.h"
+#include "all_csv_configs.h"
+#include "config/error/type.h"
+#include "config/names.h"
+#include "config/thread_number/type.h"
+#include "config/tabular_data/input_table_type.h"
+#include "csv_config_util.h"
+#include "model/table/dataset_cache.h"
+#include "model/table/idataset_stream.h"
+
+namespace tests {
+
+namespace {
+
+class DatasetCacheTest : public ::testing::Test {
+protected:
+    model::DatasetCache& cache_ = model::DatasetCache::Instance();
+
+    void TearDown() override {
+        cache_.SetMemoryBudget(0);
+        cache_.Clear();
+    }
+};
+
+// Holds the first row back until the gate is opened, reports when it is being read
+class GatedStream : public model::IDatasetStream {
+    config::InputTable stream_;
+    std::shared_future<void> gate_;
+    std::promise<void> reading_;
+    bool opened_ = false;
+
+public:
+    GatedStream(config::InputTable stream, std::shared_future<void> gate)
+        : stream_(std::move(stream)), gate_(std::move(gate)) {}
+
+    std::future<void> GetReading() {
+        return reading_.get_future();
+    }
+
+    Row GetNextRow() override {
+        if (!opened_) {
+            opened_ = true;
+            reading_.set_value();
+            gate_.wait();
+        }
+        return stream_->GetNextRow();
+    }
+
+    [[nodiscard]] bool HasNextRow() const override {
+        return stream_->HasNextRow();
+    }
+
+    [[nodiscard]] size_t GetNumberOfColumns() const override {
+        return stream_->GetNumberOfColumns();
+    }
+
+    [[nodiscard]] std::string GetColumnName(size_t index) const override {
+        return stream_->GetColumnName(index);
+    }
+
+    [[nodiscard]] std::string GetRelationName() const override {
+        return stream_->GetRelationName();
+    }
+
+    void Reset() override {
+        stream_->Reset();
+    }
+
+    [[nodiscard]] std::string GetIdentity() const override {
+        return stream_->GetIdentity();
+    }
+};
+
+std::set<std::string> ExecutePyro(algos::Pyro& pyro) {
+    pyro.Execute();
+    std::set<std::string> fds;
+    for (auto const& fd : pyro.FdList()) {
+        fds.insert(fd.ToLongString());
+    }
+    return fds;
+}
+
+std::set<std::string> ExecuteHyFD(algos::hyfd::HyFD& hyfd) {
+    hyfd.Execute();
+    std::set<std::string> fds;
+    for (auto const& fd : hyfd.FdList()) {
+        fds.insert(fd.ToLongString());
+    }
+    return fds;
+}
+
+std::set<std::string> ExecuteHyUCC(algos::HyUCC& hyucc) {
+    hyucc.Execute();
+    std::set<std::string> uccs;
+    for (auto const& ucc : hyucc.UCCList()) {
+        uccs.insert(ucc.ToIndicesString());
+    }
+    return uccs;
+}
+
+std::vector<std::deque<model::PLI::Cluster>> GetClusters(
+        ColumnLayoutRelationData const& relation) {
+    std::vector<std::deque<model::PLI::Cluster>> clusters;
+    for (ColumnData const& column_data : relation.GetColumnData()) {
+        clusters.push_back(column_data.GetPositionListIndex()->GetIndex());
+    }
+    return clusters;
+}
+
+}  // namespace
+
+TEST_F(DatasetCacheTest, SameFileIsParsedOnceWhileHeld) {
+    std::shared_ptr<ColumnLayoutRelationData> const relation =
+            cache_.GetRelation(*MakeInputTable(kTestFD), true);
+    EXPECT_EQ(cache_.GetRelation(*MakeInputTable(kTestFD), true), relation);
+    EXPECT_NE(cache_.GetRelation(*MakeInputTable(kTestFD), false), relation);
+    EXPECT_NE(cache_.GetRelation(*MakeInputTable(kTestWide), true), relation);
+
+    model::SharedRelationData const both =
+            cache_.Get(*MakeInputTable(kTestFD), true, {.relation = true, .typed_relation = true});
+    EXPECT_EQ(both.relation, relation);
+    ASSERT_NE(both.typed_relation, nullptr);
+    EXPECT_EQ(both.typed_relation->GetNumRows(), relation->GetNumRows());
+}
+
+TEST_F(DatasetCacheTest, ReleasedDataIsKeptWithinBudget) {
+    std::weak_ptr<ColumnLayoutRelationData> relation =
+            cache_.GetRelation(*MakeInputTable(kTestFD), true);
+    EXPECT_TRUE(relation.expired());
+    EXPECT_EQ(cache_.GetRetainedSize(), 0);
+
+    cache_.SetMemoryBudget(1 << 20);
+    relation = cache_.GetRelation(*MakeInputTable(kTestFD), true);
+    EXPECT_FALSE(relation.expired());
+    EXPECT_GT(cache_.GetRetainedSize(), 0);
+    EXPECT_EQ(cache_.GetRelation(*MakeInputTable(kTestFD), true), relation.lock());
+
+    cache_.SetMemoryBudget(1);
+    EXPECT_TRUE(relation.expired());
+    EXPECT_EQ(cache_.GetRetainedSize(), 0);
+}
+
+TEST_F(DatasetCacheTest, AlgorithmsShareTheRelation) {
+    using namespace config::names;
+    cache_.SetMemoryBudget(1 << 20);
+    algos::StdParamsMap const params_map{{kCsvConfig, kTestFD}};
+    auto tane = algos::CreateAndLoadAlgorithm<algos::Tane>(params_map);
+    std::size_t const retained_size = cache_.GetRetainedSize();
+    EXPECT_GT(retained_size, 0);
+    auto hyucc = algos::CreateAndLoadAlgorithm<algos::HyUCC>(params_map);
+    EXPECT_EQ(cache_.GetRetainedSize(), retained_size);
+    tane->Execute();
+    hyucc->Execute();
+    EXPECT_FALSE(tane->FdList().empty());
+}
+
+TEST_F(DatasetCacheTest, DatasetIsParsedOutsideTheLock) {
+    using namespace std::chrono_literals;
+    std::promise<void> gate;
+    GatedStream gated_stream(MakeInputTable(kTestFD), gate.get_future().share());
+    std::future<void> reading = gated_stream.GetReading();
+    auto gated = std::async(std::launch::async,
+                            [&] { return cache_.GetRelation(gated_stream, true); });
+    ASSERT_EQ(reading.wait_for(10s), std::future_status::ready);
+
+    auto other = std::async(std::launch::async, [&] {
+        return cache_.GetRelation(*MakeInputTable(kTestWide), true);
+    });
+    auto same = std::async(std::launch::async,
+                           [&] { return cache_.GetRelation(*MakeInputTable(kTestFD), true); });
+    EXPECT_EQ(other.wait_for(10s), std::future_status::ready);
+    // Waits for the data of the gated stream instead of parsing the file again
+    EXPECT_EQ(same.wait_for(100ms), std::future_status::timeout);
+    gate.set_value();
+
+    std::shared_ptr<ColumnLayoutRelationData> const relation = gated.get();
+    EXPECT_EQ(same.get(), relation);
+    EXPECT_NE(other.get(), relation);
+}
+
+TEST_F(DatasetCacheTest, ConcurrentRunsOnTheSharedRelation) {
+    using namespace config::names;
+    algos::StdParamsMap const params_map{
+            {kCsvConfig, kCIPublicHighway700},
+            {kSeed, decltype(algos::pyro::Parameters::seed){0}},
+            {kError, config::ErrorType{0.01}}};
+    std::set<std::string> const expected =
+            ExecutePyro(*algos::CreateAndLoadAlgorithm<algos::Pyro>(params_map));
+
+    cache_.SetMemoryBudget(64 << 20);
+    auto first = algos::CreateAndLoadAlgorithm<algos::Pyro>(params_map);
+    std::size_t const retained_size = cache_.GetRetainedSize();
+    auto second = algos::CreateAndLoadAlgorithm<algos::Pyro>(params_map);
+    EXPECT_EQ(cache_.GetRetainedSize(), retained_size);
+
+    std::set<std::string> first_fds;
+    std::thread first_run([&] { first_fds = ExecutePyro(*first); });
+    std::set<std::string> const second_fds = ExecutePyro(*second);
+    first_run.join();
+    EXPECT_EQ(first_fds, expected);
+    EXPECT_EQ(second_fds, expected);
+    // The runs leave nothing behind in the cached relation
+    EXPECT_EQ(ExecutePyro(*algos::CreateAndLoadAlgorithm<algos::Pyro>(params_map)), expected);
+}
+
+TEST_F(DatasetCacheTest, ConcurrentHyRunsOnTheSharedRelation) {
+    using namespace config::names;
+    algos::StdParamsMap const params_map{{kCsvConfig, kCIPublicHighway700},
+                                         {kThreads, config::ThreadNumType{2}}};
+    std::set<std::string> const expected_fds =
+            ExecuteHyFD(*algos::CreateAndLoadAlgorithm<algos::hyfd::HyFD>(params_map));
+    std::set<std::string> const expected_uccs =
+            ExecuteHyUCC(*algos::CreateAndLoadAlgorithm<algos::HyUCC>(params_map));
+
+    cache_.SetMemoryBudget(64 << 20);
+    auto hyfd = algos::CreateAndLoadAlgorithm<algos::hyfd::HyFD>(params_map);
+    auto hyucc = algos::CreateAndLoadAlgorithm<algos::HyUCC>(params_map);
+    std::shared_ptr<ColumnLayoutRelationData> const relation =
+            cache_.GetRelation(*MakeInputTable(kCIPublicHighway700), true);
+    auto const clusters = GetClusters(*relation);
+
+    std::set<std::string> fds;
+    std::thread hyfd_run([&] { fds = ExecuteHyFD(*hyfd); });
+    std::set<std::string> const uccs = ExecuteHyUCC(*hyucc);
+    hyfd_run.join();
+    EXPECT_EQ(fds, expected_fds);
+    EXPECT_EQ(uccs, expected_uccs);
+    // The samplers sort their own copies of the clusters
+    EXPECT_EQ(GetClusters(*relation), clusters);
+}
+
+}  // namespace tests
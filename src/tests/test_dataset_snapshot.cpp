@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "all_csv_configs.h"
+#include "csv_config_util.h"
+#include "model/table/column_buffer.h"
+#include "model/table/column_layout_relation_data.h"
+#include "model/table/column_layout_typed_relation_data.h"
+#include "model/table/dataset_snapshot.h"
+#include "temporary_file.h"
+
+namespace tests {
+
+namespace {
+
+class DatasetSnapshotTest : public ::testing::TestWithParam<CSVConfig> {
+protected:
+    TemporaryFile const file_;
+    std::filesystem::path const& path_ = file_.GetPath();
+};
+
+model::ColumnarDatasetStream MakeDataset(std::vector<std::string> column_names,
+                                         std::vector<std::vector<std::string>> columns) {
+    std::size_t const num_rows = columns.front().size();
+    std::vector<model::ColumnBuffer> buffers;
+    for (std::vector<std::string>& column : columns) {
+        buffers.push_back(model::ColumnBuffer::Materialized(std::move(column)));
+    }
+    return {"Dataset", std::move(column_names), std::move(buffers), num_rows};
+}
+
+std::vector<std::deque<std::vector<int>>> GetSortedIndices(ColumnLayoutRelationData const& data) {
+    std::vector<std::deque<std::vector<int>>> indices;
+    for (ColumnData const& column_data : data.GetColumnData()) {
+        std::deque<std::vector<int>> index = column_data.GetPositionListIndex()->GetIndex();
+        std::sort(index.begin(), index.end());
+        indices.push_back(std::move(index));
+    }
+    return indices;
+}
+
+}  // namespace
+
+TEST_P(DatasetSnapshotTest, RestoresDataset) {
+    model::WriteDatasetSnapshot(*MakeInputTable(GetParam()), path_);
+    ASSERT_TRUE(model::IsDatasetSnapshot(path_));
+    std::shared_ptr<model::ColumnarDatasetStream> const snapshot =
+            model::OpenDatasetSnapshot(path_);
+
+    auto input_table = MakeInputTable(GetParam());
+    ASSERT_EQ(snapshot->GetRelationName(), input_table->GetRelationName());
+    ASSERT_EQ(snapshot->GetNumberOfColumns(), input_table->GetNumberOfColumns());
+    for (size_t i = 0; i != snapshot->GetNumberOfColumns(); ++i) {
+        EXPECT_EQ(snapshot->GetColumnName(i), input_table->GetColumnName(i));
+    }
+    while (input_table->HasNextRow()) {
+        ASSERT_TRUE(snapshot->HasNextRow());
+        EXPECT_EQ(snapshot->GetNextRow(), input_table->GetNextRow());
+    }
+    EXPECT_FALSE(snapshot->HasNextRow());
+
+    for (bool is_null_eq_null : {true, false}) {
+        input_table->Reset();
+        auto const expected = ColumnLayoutRelationData::CreateFrom(*input_table, is_null_eq_null);
+        auto const actual = ColumnLayoutRelationData::CreateFrom(*snapshot, is_null_eq_null);
+        EXPECT_EQ(GetSortedIndices(*actual), GetSortedIndices(*expected));
+    }
+
+    input_table->Reset();
+    auto const expected = model::ColumnLayoutTypedRelationData::CreateFrom(*input_table, true);
+    auto const actual = model::ColumnLayoutTypedRelationData::CreateFrom(*snapshot, true);
+    ASSERT_EQ(actual->GetNumRows(), expected->GetNumRows());
+    for (size_t i = 0; i != expected->GetNumColumns(); ++i) {
+        model::TypedColumnData const& expected_column = expected->GetColumnData(i);
+        model::TypedColumnData const& actual_column = actual->GetColumnData(i);
+        EXPECT_EQ(actual_column.GetTypeId(), expected_column.GetTypeId());
+        EXPECT_EQ(actual_column.GetNumNulls(), expected_column.GetNumNulls());
+        EXPECT_EQ(actual_column.GetNumEmpties(), expected_column.GetNumEmpties());
+        for (size_t row = 0; row != expected_column.GetNumRows(); ++row) {
+            EXPECT_EQ(actual_column.GetDataAsString(row), expected_column.GetDataAsString(row));
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(DatasetSnapshot, DatasetSnapshotTest,
+                         ::testing::Values(kTestFD, kNullEmpty, kSimpleTypes, kTestEmpty));
+
+TEST(DatasetSnapshot, StoresIntegerColumnsAsIntegers) {
+    TemporaryFile const file;
+    std::filesystem::path const& path = file.GetPath();
+    model::WriteDatasetSnapshot(*MakeInputTable(kNullEmpty), path);
+    std::shared_ptr<model::ColumnarDatasetStream> const snapshot = model::OpenDatasetSnapshot(path);
+    using ElementType = model::ColumnBuffer::ElementType;
+    // " NullAndInt" consists of integers and a NULL, "IntAndEmpty" has an empty value
+    EXPECT_EQ(snapshot->GetColumn(1).GetElementType(), ElementType::kInt64);
+    EXPECT_TRUE(snapshot->GetColumn(1).IsNull(0));
+    EXPECT_EQ(snapshot->GetColumn(2).GetElementType(), ElementType::kLargeUtf8);
+    EXPECT_FALSE(snapshot->GetIdentity().empty());
+}
+
+TEST(DatasetSnapshot, StoresDoubleColumnsAsDoubles) {
+    TemporaryFile const file;
+    // "Printed" holds doubles as they are printed, "Unprinted" has "3." that is printed as "3.0"
+    model::ColumnarDatasetStream dataset = MakeDataset(
+            {"Printed", "Unprinted"},
+            {{"1.5", "NULL", "-0.25", "1e+20", "1.5"}, {"1.5", "3.", "NULL", "0.1", "2.0"}});
+    model::WriteDatasetSnapshot(dataset, file.GetPath());
+    std::shared_ptr<model::ColumnarDatasetStream> const snapshot =
+            model::OpenDatasetSnapshot(file.GetPath());
+    using ElementType = model::ColumnBuffer::ElementType;
+    EXPECT_EQ(snapshot->GetColumn(0).GetElementType(), ElementType::kFloat64);
+    EXPECT_TRUE(snapshot->GetColumn(0).IsNull(1));
+    EXPECT_EQ(snapshot->GetColumn(0).GetFloatingPoint(3), 1e20);
+    EXPECT_EQ(snapshot->GetColumn(1).GetElementType(), ElementType::kLargeUtf8);
+
+    dataset.Reset();
+    while (dataset.HasNextRow()) {
+        EXPECT_EQ(snapshot->GetNextRow(), dataset.GetNextRow());
+    }
+    dataset.Reset();
+    auto const expected = model::ColumnLayoutTypedRelationData::CreateFrom(dataset, true);
+    auto const actual = model::ColumnLayoutTypedRelationData::CreateFrom(*snapshot, true);
+    for (size_t i = 0; i != expected->GetNumColumns(); ++i) {
+        EXPECT_EQ(actual->GetColumnData(i).GetTypeId(), expected->GetColumnData(i).GetTypeId());
+        for (size_t row = 0; row != expected->GetNumRows(); ++row) {
+            EXPECT_EQ(actual->GetColumnData(i).GetDataAsString(row),
+                      expected->GetColumnData(i).GetDataAsString(row));
+        }
+    }
+}
+
+TEST(DatasetSnapshot, ChecksColumnsWhenTheyAreRead) {
+    TemporaryFile const file;
+    model::ColumnarDatasetStream dataset =
+            MakeDataset({"A", "B"}, {{"x", "y", "z"}, {"x", "x", "x"}});
+    model::WriteDatasetSnapshot(dataset, file.GetPath());
+
+    // Value ids 1, 2, 3 of "A" become -2, 2, 3
+    std::string data;
+    {
+        std::ifstream in(file.GetPath(), std::ios::binary);
+        data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    std::vector<int> const codes = {1, 2, 3};
+    std::size_t const codes_position = data.find(
+            std::string(reinterpret_cast<char const*>(codes.data()), codes.size() * sizeof(int)));
+    ASSERT_NE(codes_position, std::string::npos);
+    int const negative_code = ColumnLayoutRelationData::kNullValueId - 1;
+    data.replace(codes_position, sizeof(int), reinterpret_cast<char const*>(&negative_code),
+                 sizeof(int));
+    std::ofstream(file.GetPath(), std::ios::binary | std::ios::trunc) << data;
+
+    std::shared_ptr<model::ColumnarDatasetStream> const snapshot =
+            model::OpenDatasetSnapshot(file.GetPath());
+    EXPECT_NO_THROW(snapshot->GetColumn(1));
+    EXPECT_THROW(snapshot->GetColumn(0), std::runtime_error);
+    EXPECT_THROW(snapshot->GetNextRow(), std::runtime_error);
+}
+
+TEST(DatasetSnapshot, RejectsOtherFiles) {
+    std::filesystem::path const& csv_path = kTestFD.path;
+    EXPECT_FALSE(model::IsDatasetSnapshot(csv_path));
+    EXPECT_THROW(model::OpenDatasetSnapshot(csv_path), std::runtime_error);
+
+    TemporaryFile const file;
+    std::filesystem::path const& path = file.GetPath();
+    model::WriteDatasetSnapshot(*MakeInputTable(kTestFD), path);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) / 2);
+    EXPECT_TRUE(model::IsDatasetSnapshot(path));
+    EXPECT_THROW(model::OpenDatasetSnapshot(path), std::runtime_error);
+}
+
+}  // namespace tests
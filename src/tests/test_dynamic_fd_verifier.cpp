@@ -8,8 +8,10 @@
 #include "config/exceptions.h"
 #include "config/indices/type.h"
 #include "config/names.h"
+#include "config/thread_number/type.h"
 #include "csv_config_util.h"
 #include "fd/fd_verifier/dynamic_fd_verifier.h"
+#include "fd/fd_verifier/dynamic_multi_fd_verifier.h"
 #include "fd/fd_verifier/dynamic_stats_calculator.h"
 #include "model/types/builtin.h"
 
@@ -141,6 +143,94 @@ INSTANTIATE_TEST_SUITE_P(
 
 // clang-format on
 
+TEST(TestDynFDVerifyingSequential, BatchesAccumulate) {
+    algos::StdParamsMap params{{onam::kCsvConfig, kTestDynamicFDInit},
+                               {onam::kLhsIndices, config::IndicesType{0, 1}},
+                               {onam::kRhsIndices, config::IndicesType{1, 4}}};
+    auto verifier = algos::CreateAndLoadAlgorithm<algos::fd_verifier::DynamicFDVerifier>(params);
+    // Loading has set the batches to their defaults already, so they are set explicitly
+    verifier->SetOption(onam::kInsertStatements, MakeInputTable(kTestDynamicFDInsert));
+    verifier->Execute();
+    algos::ConfigureFromMap(*verifier,
+                            {{onam::kUpdateStatements, MakeInputTable(kTestDynamicFDUpdate)}});
+    verifier->Execute();
+    algos::ConfigureFromMap(
+            *verifier, {{onam::kDeleteStatements, std::unordered_set<size_t>{1, 6, 3}}});
+    verifier->Execute();
+
+    // Same table as after applying all three batches at once
+    EXPECT_FALSE(verifier->FDHolds());
+    EXPECT_DOUBLE_EQ(verifier->GetError(), 1.L / 22);
+    EXPECT_EQ(verifier->GetNumErrorRows(), 5);
+    EXPECT_EQ(verifier->GetNumErrorClusters(), 2);
+
+    TestSorting(std::move(verifier));
+}
+
+TEST(TestDynMultiFDVerifying, MatchesSingleFDVerifier) {
+    using FDIndices = DynamicMultiFDVerifier::FDIndices;
+    std::vector<FDIndices> const fds{{{1, 2}, {0, 3}}, {{1}, {2, 3}},  {{1, 4}, {2, 3, 5}},
+                                     {{0, 1}, {1, 4}}, {{2, 1}, {3, 0}}, {{2, 4}, {0, 1, 3, 5}}};
+    std::unordered_set<size_t> const deletes{1, 6, 3};
+    algos::StdParamsMap params{{onam::kCsvConfig, kTestDynamicFDInit},
+                               {onam::kFDs, fds},
+                               // Shares the PLI of the LHS of the first FD
+                               {onam::kUCCs, std::vector<config::IndicesType>{{2, 1}}},
+                               {onam::kThreads, static_cast<config::ThreadNumType>(2)}};
+    auto verifier = algos::CreateAndLoadAlgorithm<DynamicMultiFDVerifier>(params);
+    verifier->SetOption(onam::kInsertStatements, MakeInputTable(kTestDynamicFDInsert));
+    verifier->SetOption(onam::kUpdateStatements, MakeInputTable(kTestDynamicFDUpdate));
+    verifier->SetOption(onam::kDeleteStatements, deletes);
+    verifier->Execute();
+
+    algos::StdParamsMap ucc_params{{onam::kCsvConfig, kTestDynamicFDInit},
+                                   {onam::kUCCs, std::vector<config::IndicesType>{{1, 2}}}};
+    auto ucc_verifier = algos::CreateAndLoadAlgorithm<DynamicMultiFDVerifier>(ucc_params);
+    ucc_verifier->SetOption(onam::kInsertStatements, MakeInputTable(kTestDynamicFDInsert));
+    ucc_verifier->SetOption(onam::kUpdateStatements, MakeInputTable(kTestDynamicFDUpdate));
+    ucc_verifier->SetOption(onam::kDeleteStatements, deletes);
+    ucc_verifier->Execute();
+    EXPECT_EQ(verifier->UCCHolds(0), ucc_verifier->UCCHolds(0));
+    EXPECT_DOUBLE_EQ(verifier->GetUCCStatistics(0).GetError(),
+                     ucc_verifier->GetUCCStatistics(0).GetError());
+    EXPECT_EQ(verifier->GetUCCStatistics(0).GetNumErrorRows(),
+              ucc_verifier->GetUCCStatistics(0).GetNumErrorRows());
+
+    ASSERT_EQ(verifier->GetNumFDs(), fds.size());
+    for (size_t i = 0; i < fds.size(); ++i) {
+        DynFDVerifyingParams single_params(fds[i].first, fds[i].second, 0, 0, 0.,
+                                           kTestDynamicFDInsert, kTestDynamicFDUpdate, deletes);
+        auto single_verifier =
+                algos::CreateAndLoadAlgorithm<DynamicFDVerifier>(single_params.params);
+        single_verifier->Execute();
+        DynamicStatsCalculator const& stats = verifier->GetFDStatistics(i);
+        EXPECT_EQ(stats.FDHolds(), single_verifier->FDHolds());
+        EXPECT_DOUBLE_EQ(stats.GetError(), single_verifier->GetError());
+        EXPECT_EQ(stats.GetNumErrorRows(), single_verifier->GetNumErrorRows());
+        EXPECT_EQ(stats.GetNumErrorClusters(), single_verifier->GetNumErrorClusters());
+    }
+}
+
+TEST(TestDynMultiFDVerifying, UCCs) {
+    algos::StdParamsMap params{{onam::kCsvConfig, kTestDynamicFDInit},
+                               {onam::kUCCs, std::vector<config::IndicesType>{{5}, {0}}}};
+    auto verifier = algos::CreateAndLoadAlgorithm<DynamicMultiFDVerifier>(params);
+    ASSERT_EQ(verifier->GetNumUCCs(), 2);
+    EXPECT_FALSE(verifier->UCCHolds(0));
+    EXPECT_EQ(verifier->GetUCCStatistics(0).GetNumErrorClusters(), 3);
+    EXPECT_EQ(verifier->GetUCCStatistics(0).GetNumErrorRows(), 6);
+    EXPECT_DOUBLE_EQ(verifier->GetUCCStatistics(0).GetError(), 1.L / 22);
+    EXPECT_EQ(verifier->GetUCCStatistics(1).GetNumErrorRows(), 12);
+
+    verifier->SetOption(onam::kDeleteStatements, std::unordered_set<size_t>{3, 6});
+    verifier->Execute();
+    EXPECT_FALSE(verifier->UCCHolds(0));
+    EXPECT_EQ(verifier->GetUCCStatistics(0).GetNumErrorClusters(), 1);
+    EXPECT_EQ(verifier->GetUCCStatistics(0).GetNumErrorRows(), 2);
+    EXPECT_DOUBLE_EQ(verifier->GetUCCStatistics(0).GetError(), 1.L / 45);
+    EXPECT_EQ(verifier->GetUCCStatistics(1).GetNumErrorRows(), 10);
+}
+
 class TestDynFDVerifyingExceptions : public ::testing::TestWithParam<DynFDVerifyingParams> {};
 
 void CreateLoadExeute(algos::StdParamsMap const& params) {
@@ -12,6 +12,7 @@
 #include "algorithms/fd/pyro/pyro.h"
 #include "algorithms/fd/tane/pfdtane.h"
 #include "algorithms/fd/tane/tane.h"
+#include "config/thread_number/type.h"
 #include "model/table/relational_schema.h"
 #include "test_fd_util.h"
 
@@ -161,4 +162,33 @@ using Algorithms =
                          algos::FDep, algos::FUN, algos::hyfd::HyFD, algos::PFDTane>;
 INSTANTIATE_TYPED_TEST_SUITE_P(AlgorithmTest, AlgorithmTest, Algorithms);
 
+template <typename T>
+void TestSpillingKeepsFds() {
+    using namespace config::names;
+    algos::StdParamsMap params{{kCsvConfig, kCIPublicHighway700},
+                               {kError, config::ErrorType{0.0}},
+                               {kThreads, config::ThreadNumType{2}}};
+    auto in_memory = algos::CreateAndLoadAlgorithm<T>(params);
+    in_memory->Execute();
+    // Every PLI above the first levels is spilled once the limit is this low
+    params[kPliSpillLimitKB] = 1u;
+    auto spilling = algos::CreateAndLoadAlgorithm<T>(params);
+    spilling->Execute();
+
+    util::MetricsSnapshot const metrics = spilling->GetMetrics();
+    EXPECT_GT(metrics.counters.at(algos::tane::TaneCommon::kSpilledPlisMetric), 0u);
+    EXPECT_GT(metrics.counters.at(algos::tane::TaneCommon::kPeakRssMetric), 0u);
+    EXPECT_EQ(in_memory->GetMetrics().counters.at(algos::tane::TaneCommon::kSpilledPlisMetric),
+              0u);
+    ASSERT_TRUE(CheckFdListEquality(FDsToSet(in_memory->FdList()), spilling->FdList()));
+}
+
+TEST(TaneSpilling, TaneFindsSameFds) {
+    TestSpillingKeepsFds<algos::Tane>();
+}
+
+TEST(TaneSpilling, PFDTaneFindsSameFds) {
+    TestSpillingKeepsFds<algos::PFDTane>();
+}
+
 }  // namespace tests
@@ -0,0 +1,48 @@
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "algorithms/algo_factory.h"
+#include "algorithms/fd/fdep/fdep.h"
+#include "all_csv_configs.h"
+#include "config/names.h"
+#include "config/thread_number/type.h"
+
+namespace tests {
+namespace onam = config::names;
+
+namespace {
+
+struct ConstantHash {
+    size_t operator()(std::string const&) const noexcept {
+        return 0;
+    }
+};
+
+std::string MineFds(CSVConfig const& csv_config, config::ThreadNumType threads) {
+    algos::StdParamsMap params{{onam::kCsvConfig, csv_config}, {onam::kThreads, threads}};
+    auto algorithm = algos::CreateAndLoadAlgorithm<algos::FDep>(params);
+    algorithm->Execute();
+    return algorithm->GetJsonFDs();
+}
+
+}  // namespace
+
+TEST(FDepTest, EqualHashesKeepValuesApart) {
+    algos::FDep::ValueDictionary<ConstantHash> dictionary;
+    std::vector<unsigned> codes;
+    for (std::string value : {"a", "b", "a", "", "c", "b"}) {
+        codes.push_back(dictionary.Encode(std::move(value)));
+    }
+    EXPECT_EQ(codes, (std::vector<unsigned>{0, 1, 0, 2, 3, 1}));
+}
+
+TEST(FDepTest, SameFdsForAnyThreadCount) {
+    // Several blocks of tuples, so that the tiles are split between the threads
+    std::string const single_threaded = MineFds(kCIPublicHighway700, 1);
+    EXPECT_EQ(MineFds(kCIPublicHighway700, 4), single_threaded);
+    EXPECT_EQ(MineFds(kTestFD, 1), MineFds(kTestFD, 3));
+}
+
+}  // namespace tests
@@ -3,6 +3,7 @@
 #include "algo_factory.h"
 #include "all_csv_configs.h"
 #include "config/names.h"
+#include "config/thread_number/type.h"
 #include "fd/tane/pfdtane.h"
 #include "model/table/column_layout_relation_data.h"
 #include "parser/csv_parser/csv_parser.h"
@@ -45,6 +46,14 @@ TEST_P(TestPFDTaneMining, DefaultTest) {
     EXPECT_EQ(p.result_hash, algos->Fletcher16());
 }
 
+TEST_P(TestPFDTaneMining, ParallelTest) {
+    auto params = GetParam().params;
+    params[onam::kThreads] = config::ThreadNumType{4};
+    auto algos = algos::CreateAndLoadAlgorithm<algos::PFDTane>(params);
+    algos->Execute();
+    EXPECT_EQ(GetParam().result_hash, algos->Fletcher16());
+}
+
 TEST_P(TestPFDTaneValidation, ErrorCalculationTest) {
     auto const& p = GetParam();
     double eps = 0.00001;
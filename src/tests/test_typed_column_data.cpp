@@ -1,11 +1,24 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <map>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
 #include "algorithms/fd/fd_algorithm.h"
 #include "all_csv_configs.h"
 #include "csv_config_util.h"
+#include "model/table/column_buffer.h"
 #include "model/table/column_layout_typed_relation_data.h"
+#include "model/table/column_layout_relation_data.h"
+#include "model/table/columnar_dataset_stream.h"
+#include "model/table/relation_data_loader.h"
+#include "model/types/value_parsing.h"
 
 namespace tests {
 
@@ -92,4 +105,161 @@ TEST(TypeSystem, SumColumnDoubles) {
     EXPECT_DOUBLE_EQ(type.GetValue<mo::Double>(sum.get()), expected);
 }
 
+TEST(TypeSystem, ColumnarDataset) {
+    using ElementType = mo::ColumnBuffer::ElementType;
+    std::vector<std::int64_t> ints = {3, -1, 3, 7};
+    std::uint8_t ints_validity = 0b1011;
+    std::vector<double> doubles = {1.5, std::nan(""), 2.0, 1.5};
+    std::vector<std::int32_t> offsets = {0, 1, 1, 3, 4};
+    char const* chars = "abca";
+    std::vector<std::uint64_t> uints = {1, std::numeric_limits<std::uint64_t>::max(), 2, 3};
+
+    std::vector<mo::ColumnBuffer> columns;
+    columns.push_back(mo::ColumnBuffer::Numeric(ElementType::kInt64, 4, ints.data(),
+                                                sizeof(std::int64_t), &ints_validity, 0, nullptr));
+    columns.push_back(mo::ColumnBuffer::Numeric(ElementType::kFloat64, 4, doubles.data(),
+                                                sizeof(double), nullptr, 0, nullptr));
+    columns.push_back(mo::ColumnBuffer::Strings(ElementType::kUtf8, 4, chars, offsets.data(),
+                                                nullptr, 0, nullptr));
+    columns.push_back(mo::ColumnBuffer::Numeric(ElementType::kUInt64, 4, uints.data(),
+                                                sizeof(std::uint64_t), nullptr, 0, nullptr));
+    mo::ColumnarDatasetStream dataset("columnar", {"int", "double", "string", "uint"},
+                                      std::move(columns), 4);
+
+    std::vector<mo::TypedColumnData> col_data{mo::CreateTypedColumnData(dataset, true)};
+    ASSERT_EQ(col_data.size(), 4);
+    EXPECT_EQ(col_data[0].GetTypeId(), +TypeId::kInt);
+    EXPECT_EQ(col_data[1].GetTypeId(), +TypeId::kDouble);
+    EXPECT_EQ(col_data[2].GetTypeId(), +TypeId::kString);
+    EXPECT_EQ(col_data[3].GetTypeId(), +TypeId::kBigInt);
+
+    EXPECT_EQ(col_data[0].GetNumNulls(), 1);
+    EXPECT_TRUE(col_data[0].IsNull(2));
+    EXPECT_EQ(mo::Type::GetValue<mo::Int>(col_data[0].GetValue(1)), -1);
+    EXPECT_TRUE(col_data[1].IsNull(1));
+    EXPECT_DOUBLE_EQ(mo::Type::GetValue<mo::Double>(col_data[1].GetValue(3)), 1.5);
+    EXPECT_TRUE(col_data[2].IsEmpty(1));
+    EXPECT_EQ(col_data[2].GetDataAsString(2), "bc");
+
+    // Rows are still available for the algorithms that read the stream row by row
+    dataset.Reset();
+    ASSERT_TRUE(dataset.HasNextRow());
+    EXPECT_EQ(dataset.GetNextRow(), std::vector<std::string>({"3", "1.5", "a", "1"}));
+    EXPECT_EQ(dataset.GetNextRow(),
+              std::vector<std::string>({"-1", "NULL", "", "18446744073709551615"}));
+    EXPECT_EQ(dataset.GetNextRow(), std::vector<std::string>({"NULL", "2.0", "bc", "2"}));
+}
+
+TEST(TypeSystem, SingleScanLoadsBothRelations) {
+    auto input_table = MakeInputTable(kTestFD);
+    mo::LoadedRelationData const loaded = mo::LoadRelationData(
+            *input_table, true, {.relation = true, .typed_relation = true});
+
+    // The expected data is built from the cells of the table, without the loader
+    input_table->Reset();
+    size_t const num_columns = input_table->GetNumberOfColumns();
+    std::vector<std::vector<std::string>> columns(num_columns);
+    while (input_table->HasNextRow()) {
+        std::vector<std::string> const row = input_table->GetNextRow();
+        for (size_t i = 0; i != num_columns; ++i) {
+            columns[i].push_back(row[i]);
+        }
+    }
+
+    ASSERT_EQ(loaded.relation->GetNumColumns(), num_columns);
+    ASSERT_EQ(loaded.typed_relation->GetNumColumns(), num_columns);
+    for (size_t i = 0; i != num_columns; ++i) {
+        // Rows with equal cells, nulls are equal to each other
+        std::map<std::string, std::vector<int>> rows_by_value;
+        for (size_t row = 0; row != columns[i].size(); ++row) {
+            rows_by_value[columns[i][row]].push_back(row);
+        }
+        std::vector<std::vector<int>> expected_clusters;
+        for (auto& [value, rows] : rows_by_value) {
+            if (rows.size() > 1) expected_clusters.push_back(std::move(rows));
+        }
+        std::deque<std::vector<int>> const& index =
+                loaded.relation->GetColumnData(i).GetPositionListIndex()->GetIndex();
+        std::vector<std::vector<int>> clusters(index.begin(), index.end());
+        std::sort(expected_clusters.begin(), expected_clusters.end());
+        std::sort(clusters.begin(), clusters.end());
+        EXPECT_EQ(clusters, expected_clusters) << "Column index: " << i;
+
+        Column const* column = loaded.typed_relation->GetSchema()->GetColumn(i);
+        mo::TypedColumnData const expected =
+                mo::TypedColumnDataFactory::CreateFrom(column, columns[i], true);
+        mo::TypedColumnData const& actual = loaded.typed_relation->GetColumnData(i);
+        EXPECT_EQ(actual.GetTypeId(), expected.GetTypeId());
+        ASSERT_EQ(actual.GetNumRows(), expected.GetNumRows());
+        for (size_t row = 0; row != expected.GetNumRows(); ++row) {
+            EXPECT_EQ(actual.GetDataAsString(row), expected.GetDataAsString(row));
+        }
+    }
+
+    input_table->Reset();
+    mo::LoadedRelationData const typed_only =
+            mo::LoadRelationData(*input_table, true, {.typed_relation = true});
+    EXPECT_EQ(typed_only.relation, nullptr);
+    EXPECT_EQ(typed_only.typed_relation->GetNumRows(), columns.front().size());
+}
+
+TEST(TypeSystem, SameColumnsForAnyThreadCount) {
+    auto input_table = MakeInputTable(kSimpleTypes);
+    auto const sequential = mo::ColumnLayoutTypedRelationData::CreateFrom(*input_table, true, 1);
+    input_table->Reset();
+    auto const parallel = mo::ColumnLayoutTypedRelationData::CreateFrom(*input_table, true, 4);
+
+    ASSERT_EQ(parallel->GetNumColumns(), sequential->GetNumColumns());
+    for (size_t i = 0; i != sequential->GetNumColumns(); ++i) {
+        mo::TypedColumnData const& expected = sequential->GetColumnData(i);
+        mo::TypedColumnData const& actual = parallel->GetColumnData(i);
+        EXPECT_EQ(actual.GetTypeId(), expected.GetTypeId());
+        ASSERT_EQ(actual.GetNumRows(), expected.GetNumRows());
+        for (size_t row = 0; row != expected.GetNumRows(); ++row) {
+            EXPECT_EQ(actual.GetDataAsString(row), expected.GetDataAsString(row));
+        }
+    }
+}
+
+TEST(TypeSystem, ValueParsing) {
+    EXPECT_EQ(mo::ParseInt("-9223372036854775808"), std::numeric_limits<mo::Int>::min());
+    EXPECT_EQ(mo::ParseInt("+0012345678901"), 12345678901);
+    EXPECT_FALSE(mo::ParseInt("9223372036854775808"));
+    EXPECT_TRUE(mo::IsBigIntString("9223372036854775808"));
+    EXPECT_TRUE(mo::IsBigIntString("-123456789012345678901234"));
+    EXPECT_FALSE(mo::IsIntString("12a"));
+    EXPECT_FALSE(mo::IsIntString("-"));
+    EXPECT_TRUE(mo::IsDoubleString("1e-5"));
+    EXPECT_FALSE(mo::IsDoubleString("1e999"));
+    EXPECT_FALSE(mo::IsDoubleString("1.5 "));
+    EXPECT_TRUE(mo::IsNullString("NULL"));
+    EXPECT_TRUE(mo::IsEmptyString(""));
+
+    EXPECT_EQ(mo::ParseDelimitedDate("2024-Feb-29"), mo::Date(2024, 2, 29));
+    EXPECT_EQ(mo::ParseDelimitedDate("2024/january/31"), mo::Date(2024, 1, 31));
+    EXPECT_FALSE(mo::ParseDelimitedDate("2023-02-29"));
+    EXPECT_FALSE(mo::ParseDelimitedDate("1399-01-01"));
+    EXPECT_EQ(mo::ParseUndelimitedDate("20240131"), mo::Date(2024, 1, 31));
+    EXPECT_EQ(mo::ParseUndelimitedDate("2000029"), mo::Date(2000, 2, 9));
+    EXPECT_FALSE(mo::IsUndelimitedDateString("20241301"));
+    EXPECT_TRUE(mo::IsDateString("2024.01.31"));
+    EXPECT_FALSE(mo::IsDateString("abc"));
+}
+
+TEST(TypeSystem, NullsAndEmptiesOfConcreteColumn) {
+    RelationalSchema schema("relation");
+    schema.AppendColumn(Column(&schema, "column", 0));
+    mo::TypedColumnData const col_data = mo::TypedColumnDataFactory::CreateFrom(
+            schema.GetColumn(0), {"1", "", "NULL", "20", "", "3"}, true);
+    EXPECT_EQ(col_data.GetTypeId(), +TypeId::kInt);
+    EXPECT_EQ(col_data.GetNumNulls(), 1);
+    EXPECT_EQ(col_data.GetNumEmpties(), 2);
+    EXPECT_TRUE(col_data.IsNull(2));
+    EXPECT_TRUE(col_data.IsEmpty(1));
+    EXPECT_TRUE(col_data.IsEmpty(4));
+    EXPECT_FALSE(col_data.IsNullOrEmpty(3));
+    EXPECT_EQ(mo::Type::GetValue<mo::Int>(col_data.GetValue(3)), 20);
+    EXPECT_EQ(mo::Type::GetValue<mo::Int>(col_data.GetValue(5)), 3);
+}
+
 }  // namespace tests
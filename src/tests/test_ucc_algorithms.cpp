@@ -1,19 +1,34 @@
+#include <algorithm>
+#include <deque>
+#include <iterator>
+#include <limits>
 #include <memory>
 #include <ostream>
 #include <string>
+#include <vector>
 
 #include <boost/dynamic_bitset.hpp>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include "algorithms/algo_factory.h"
+#include "algorithms/fd/hycommon/preprocessor.h"
+#include "algorithms/ucc/hpivalid/config.h"
+#include "algorithms/ucc/hpivalid/pli_table.h"
+#include "algorithms/ucc/hpivalid/result_collector.h"
+#include "algorithms/ucc/hpivalid/tree_search.h"
 #include "algorithms/ucc/hyucc/hyucc.h"
+#include "algorithms/ucc/hyucc/inductor.h"
+#include "algorithms/ucc/hyucc/model/ucc_tree.h"
+#include "algorithms/ucc/hyucc/sampler.h"
+#include "algorithms/ucc/hyucc/validator.h"
 #include "algorithms/ucc/ucc.h"
 #include "algorithms/ucc/ucc_algorithm.h"
 #include "all_csv_configs.h"
 #include "config/names.h"
 #include "config/thread_number/type.h"
 #include "csv_config_util.h"
+#include "model/table/column_layout_relation_data.h"
 #include "test_hash_util.h"
 
 std::ostream& operator<<(std::ostream& os, Vertical const& v) {
@@ -119,6 +134,75 @@ public:
 template <typename AlgorithmUnderTest>
 config::ThreadNumType UCCAlgorithmTest<AlgorithmUnderTest>::threads_ = 1;
 
+// Runs the HPIValid tree search with every PLI intersected in parallel
+std::vector<model::RawUCC> SearchIntersectingInParallel(CSVConfig const& csv_config,
+                                                        config::ThreadNumType threads) {
+    auto relation = ColumnLayoutRelationData::CreateFrom(*MakeInputTable(csv_config), true);
+    algos::hpiv::PLITable tab;
+    tab.nr_rows = relation->GetNumRows();
+    tab.nr_cols = relation->GetNumColumns();
+    auto plis = algos::hy::util::BuildPLIs(relation.get());
+    for (auto const* pli : plis) {
+        tab.plis.push_back(pli->GetIndex());
+    }
+    tab.inverse_mapping = algos::hy::util::BuildInvertedPlis(plis);
+
+    algos::hpiv::Config cfg;
+    cfg.seed = 0;
+    cfg.threads = threads;
+    cfg.min_parallel_intersection_records = 0;
+    algos::hpiv::ResultCollector rc(3600);
+    algos::hpiv::TreeSearch(tab, cfg, rc).Run();
+    std::vector<model::RawUCC> uccs = rc.GetUCCs();
+    std::sort(uccs.begin(), uccs.end());
+    return uccs;
+}
+
+// UCCs of the tree with fewer columns than max_arity + 1, in the original column order
+std::vector<model::RawUCC> GetUCCsUpTo(algos::hyucc::UCCTree const& tree, unsigned max_arity,
+                                       std::vector<algos::hy::ClusterId> const& og_mapping) {
+    std::vector<model::RawUCC> uccs;
+    for (model::RawUCC const& ucc : tree.FillUCCs()) {
+        if (ucc.count() > max_arity) continue;
+        uccs.push_back(algos::hy::RestoreAgreeSet(ucc, og_mapping, og_mapping.size()));
+    }
+    std::sort(uccs.begin(), uccs.end());
+    return uccs;
+}
+
+// Goes through the rounds of HyUCC until the validator is cancelled at its stop_poll-th poll. The
+// UCCs of the levels it has validated by then must be the UCCs of these sizes in all_uccs. Returns
+// the number of polls.
+std::size_t ValidateUntilPoll(ColumnLayoutRelationData* relation, std::size_t stop_poll,
+                              std::vector<model::RawUCC> const& all_uccs) {
+    auto [plis, pli_records, og_mapping] = algos::hy::Preprocess(relation);
+    auto const plis_shared = std::make_shared<algos::hy::PLIs>(std::move(plis));
+    auto const pli_records_shared = std::make_shared<algos::hy::Rows>(std::move(pli_records));
+    algos::hyucc::Sampler sampler(plis_shared, pli_records_shared);
+    algos::hyucc::UCCTree tree(relation->GetNumColumns());
+    algos::hyucc::Inductor inductor(&tree);
+    std::size_t polls = 0;
+    algos::hyucc::Validator validator(&tree, plis_shared, pli_records_shared, 1,
+                                      [&polls, stop_poll] { return ++polls >= stop_poll; });
+
+    algos::hy::IdPairs comparison_suggestions;
+    do {
+        inductor.UpdateUCCTree(sampler.GetNonUCCs(comparison_suggestions));
+        comparison_suggestions = validator.ValidateAndExtendCandidates();
+    } while (polls < stop_poll && !comparison_suggestions.empty());
+
+    bool const is_stopped = polls >= stop_poll;
+    // The validator returns right after the poll it is stopped at
+    EXPECT_TRUE(!is_stopped || polls <= stop_poll + 1) << "Stopped at poll " << stop_poll;
+    unsigned const max_arity =
+            is_stopped ? validator.GetLevelNum() - 1 : relation->GetNumColumns();
+    std::vector<model::RawUCC> expected;
+    std::copy_if(all_uccs.begin(), all_uccs.end(), std::back_inserter(expected),
+                 [max_arity](model::RawUCC const& ucc) { return ucc.count() <= max_arity; });
+    EXPECT_EQ(GetUCCsUpTo(tree, max_arity, og_mapping), expected) << "Stopped at poll " << stop_poll;
+    return polls;
+}
+
 }  // namespace
 
 TYPED_TEST_SUITE_P(UCCAlgorithmTest);
@@ -150,4 +234,32 @@ REGISTER_TYPED_TEST_SUITE_P(UCCAlgorithmTest, ConsistentHashOnLightDatasets,
 using Algorithms = ::testing::Types<algos::HyUCC, algos::PyroUCC, algos::HPIValid>;
 INSTANTIATE_TYPED_TEST_SUITE_P(UCCAlgorithmTest, UCCAlgorithmTest, Algorithms);
 
+TEST(HPIValidParallelism, SameUCCsForAnyNumberOfThreads) {
+    for (CSVConfig const& csv_config : {kCIPublicHighway700, kTestWide}) {
+        std::vector<model::RawUCC> const expected = SearchIntersectingInParallel(csv_config, 1);
+        EXPECT_FALSE(expected.empty());
+        EXPECT_EQ(SearchIntersectingInParallel(csv_config, 4), expected)
+                << "Different UCCs on dataset " << csv_config.path.filename();
+    }
+}
+
+TEST(HyUCCCancellation, ValidatorKeepsTheLevelsItHasGoneThrough) {
+    auto relation =
+            ColumnLayoutRelationData::CreateFrom(*MakeInputTable(kOdTestNormEchocardiogram), true);
+    auto hyucc = algos::CreateAndLoadAlgorithm<algos::HyUCC>(
+            algos::StdParamsMap{{config::names::kCsvConfig, kOdTestNormEchocardiogram}});
+    hyucc->Execute();
+    std::vector<model::RawUCC> all_uccs;
+    for (model::UCC const& ucc : hyucc->UCCList()) {
+        all_uccs.push_back(ucc.GetColumnIndices());
+    }
+    std::sort(all_uccs.begin(), all_uccs.end());
+
+    std::size_t const polls =
+            ValidateUntilPoll(relation.get(), std::numeric_limits<std::size_t>::max(), all_uccs);
+    for (std::size_t stop_poll = 1; stop_poll <= polls; ++stop_poll) {
+        ValidateUntilPoll(relation.get(), stop_poll, all_uccs);
+    }
+}
+
 }  // namespace tests
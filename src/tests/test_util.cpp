@@ -1,16 +1,35 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <iostream>
+#include <numeric>
+#include <random>
 #include <thread>
+#include <unordered_set>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include "all_csv_configs.h"
 #include "csv_config_util.h"
+#include "fd/hycommon/compressed_records.h"
+#include "fd/hyfd/model/fd_tree.h"
 #include "fd/pyrocommon/model/list_agree_set_sample.h"
 #include "levenshtein_distance.h"
 #include "model/table/agree_set_factory.h"
+#include "model/table/column_buffer.h"
 #include "model/table/column_layout_relation_data.h"
+#include "model/table/columnar_dataset_stream.h"
+#include "model/table/dynamic_position_list_index.h"
 #include "model/table/identifier_set.h"
+#include "model/table/position_list_index.h"
+#include "util/agree_mask.h"
+#include "util/custom_hashes.h"
+#include "util/metrics.h"
+#include "util/parallel_for.h"
+#include "util/progress.h"
+#include "util/resource_usage.h"
+#include "util/watchdog.h"
 
 namespace tests {
 
@@ -78,6 +97,288 @@ TEST(pliIntersectChecker, first) {
     ASSERT_THAT(intersection->GetIndex(), ContainerEq(ans));
 }
 
+TEST(pliChecker, SerializeRoundTrip) {
+    std::mt19937 gen(0);
+    std::vector<int> first(1000);
+    std::vector<int> second(1000);
+    for (std::size_t i = 0; i < first.size(); ++i) {
+        first[i] = gen() % 50 + 1;
+        second[i] = gen() % 7 + 1;
+    }
+    auto pli1 = model::PositionListIndex::CreateFor(first, true);
+    auto pli2 = model::PositionListIndex::CreateFor(second, true);
+    auto intersection = pli1->Intersect(pli2.get());
+
+    for (model::PositionListIndex const* pli : {pli1.get(), intersection.get()}) {
+        auto restored = model::PositionListIndex::Deserialize(pli->Serialize());
+        ASSERT_THAT(restored->GetIndex(), ContainerEq(pli->GetIndex()));
+        ASSERT_EQ(restored->GetSize(), pli->GetSize());
+        ASSERT_EQ(restored->GetNepAsLong(), pli->GetNepAsLong());
+        ASSERT_EQ(restored->GetEntropy(), pli->GetEntropy());
+        ASSERT_EQ(restored->GetRelationSize(), pli->GetRelationSize());
+    }
+}
+
+TEST(pliChecker, columnar) {
+    using ElementType = model::ColumnBuffer::ElementType;
+    std::vector<std::int64_t> ints = {5, 5, 0, 0};
+    std::uint8_t ints_validity = 0b0011;
+    std::vector<std::int64_t> offsets = {0, 1, 1, 1, 5};
+    char const* chars = "aNULL";
+    std::uint8_t strings_validity = 0b1110;
+
+    auto get_index = [&](bool is_null_eq_null) {
+        std::vector<model::ColumnBuffer> columns;
+        columns.push_back(model::ColumnBuffer::Numeric(ElementType::kInt64, 4, ints.data(),
+                                                       sizeof(std::int64_t), &ints_validity, 0,
+                                                       nullptr));
+        columns.push_back(model::ColumnBuffer::Strings(ElementType::kLargeUtf8, 4, chars,
+                                                       offsets.data(), &strings_validity, 0,
+                                                       nullptr));
+        model::ColumnarDatasetStream dataset("columnar", {"int", "string"}, std::move(columns),
+                                             4);
+        auto relation = ColumnLayoutRelationData::CreateFrom(dataset, is_null_eq_null);
+        vector<deque<vector<int>>> result;
+        for (auto const& column_data : relation->GetColumnData()) {
+            deque<vector<int>> index = column_data.GetPositionListIndex()->GetIndex();
+            std::sort(index.begin(), index.end());
+            result.push_back(std::move(index));
+        }
+        return result;
+    };
+
+    // Nulls are equal to each other and to the "NULL" string, empty strings are Desbordante nulls
+    vector<deque<vector<int>>> ans = {{{0, 1}, {2, 3}}, {{0, 3}, {1, 2}}};
+    ASSERT_THAT(get_index(true), ContainerEq(ans));
+    ans = {{{0, 1}, {2, 3}}, {{0, 3}}};
+    ASSERT_THAT(get_index(false), ContainerEq(ans));
+}
+
+TEST(dynamicPliChecker, UpdateKeepsProbingTable) {
+    using model::DynPLI;
+    std::vector<DynPLI::ClusterValue> records = {{1, 1}, {2, 1}, {1, 1}, {3, 2}, {2, 1}};
+    auto pli = DynPLI::CreateFor(records);
+    ASSERT_EQ(pli->GetNumCluster(), 3);
+    DynPLI::ClusterId const cluster_11 = *pli->FindCluster({1, 1});
+    DynPLI::ClusterId const cluster_32 = *pli->FindCluster({3, 2});
+    EXPECT_EQ(pli->GetProbingTable()[2], cluster_11);
+
+    // Removing the only record of a cluster frees its slab for the next new cluster
+    std::vector<std::pair<std::optional<size_t>, DynPLI::ClusterValue>> inserts = {
+            {std::nullopt, {4, 4}}, {0, {2, 1}}};
+    pli->UpdateWith(inserts, {0, 3});
+    EXPECT_EQ(pli->GetNumCluster(), 3);
+    EXPECT_EQ(pli->GetSize(), 5);
+    EXPECT_EQ(pli->GetRelationSize(), 6);
+    EXPECT_FALSE(pli->FindCluster({3, 2}).has_value());
+    EXPECT_EQ(*pli->FindCluster({4, 4}), cluster_32);
+    EXPECT_EQ(pli->GetClusterId(3), DynPLI::kNoCluster);
+    EXPECT_EQ(pli->GetClusterId(5), cluster_32);
+    EXPECT_THAT(pli->GetCluster(cluster_11), ContainerEq(vector<int>{2}));
+    DynPLI::ClusterId const cluster_21 = *pli->FindCluster({2, 1});
+    EXPECT_EQ(pli->GetCluster(cluster_21).size(), 3);
+    EXPECT_EQ(pli->GetClusterId(0), cluster_21);
+
+    std::vector<DynPLI::ClusterValue> other_records = {{5}, {6}, {5}, {6}, {6}, {5}};
+    auto other_pli = DynPLI::CreateFor(other_records);
+    other_pli->RemoveRecord(3);
+    auto intersection = pli->Intersect(other_pli.get());
+    EXPECT_EQ(intersection->GetNumCluster(), 4);
+    EXPECT_EQ(intersection->GetSize(), 5);
+    std::optional<DynPLI::ClusterId> cluster_216 = intersection->FindCluster({2, 1, 6});
+    ASSERT_TRUE(cluster_216.has_value());
+    EXPECT_EQ(intersection->GetCluster(*cluster_216).size(), 2);
+}
+
+TEST(dynamicPliChecker, ReplayedChangesMatchClusters) {
+    using model::DynPLI;
+    auto pli = DynPLI::CreateFor({{1}, {2}, {1}, {1}, {3}, {2}, {1}});
+    std::vector<DynPLI::Cluster> copies = pli->GetClusters();
+
+    DynPLI::Changes const changes = pli->ApplyChanges({0, 5, 4}, {{7, {2}}, {0, {1}}, {5, {4}}});
+    for (DynPLI::RecordPosition const& removed : changes.removed) {
+        DynPLI::Cluster& copy = copies[removed.cluster_id];
+        ASSERT_EQ(copy[removed.position], (int)removed.record_id);
+        copy[removed.position] = copy.back();
+        copy.pop_back();
+    }
+    for (DynPLI::RecordPosition const& added : changes.added) {
+        if (copies.size() <= (size_t)added.cluster_id) copies.resize(added.cluster_id + 1);
+        DynPLI::Cluster& copy = copies[added.cluster_id];
+        ASSERT_EQ(copy.size(), added.position);
+        copy.push_back(added.record_id);
+    }
+    copies.resize(pli->GetClusters().size());
+    EXPECT_EQ(copies, pli->GetClusters());
+    EXPECT_EQ(pli->GetSize(), 7);
+    EXPECT_EQ(pli->GetNumCluster(), 3);
+}
+
+TEST(CompressedRecords, NarrowColumnsKeepClusterIds) {
+    using algos::hy::ClusterId, algos::hy::PLIUtil;
+    constexpr size_t kNumRows = 3000;
+    // Columns needing 4, 2 and 1 bytes, then enough narrow columns to be matched word by word
+    std::vector<ClusterId> const num_clusters = {70000, 300, 256, 254, 9, 5, 3, 3, 3, 3, 3, 3,
+                                                 2,     2,   2,   2,   2, 2, 2, 2, 1};
+    std::mt19937 gen(7);
+    algos::hy::Columns columns;
+    for (ClusterId clusters : num_clusters) {
+        std::uniform_int_distribution<ClusterId> distribution(0, clusters);
+        std::vector<ClusterId> column(kNumRows);
+        for (ClusterId& cluster_id : column) {
+            // The extra value stands for singleton clusters
+            cluster_id = distribution(gen);
+            if (cluster_id == clusters) cluster_id = PLIUtil::kSingletonClusterId;
+        }
+        columns.push_back(std::move(column));
+    }
+
+    algos::hy::CompressedRecords const records(columns, 4);
+    ASSERT_EQ(records.GetNumRows(), kNumRows);
+    ASSERT_EQ(records.GetNumColumns(), num_clusters.size());
+    // 4 + 2 + 2 (256 clusters do not fit into a byte with the singleton id) + 18, aligned
+    EXPECT_EQ(records.GetRowSize(), 28);
+    for (size_t row = 0; row != kNumRows; ++row) {
+        for (size_t column = 0; column != columns.size(); ++column) {
+            ASSERT_EQ(records.Get(row, column), columns[column][row]);
+        }
+    }
+    for (size_t row = 1; row != kNumRows; ++row) {
+        boost::dynamic_bitset<> expected(columns.size());
+        for (size_t column = 0; column != columns.size(); ++column) {
+            ClusterId const cluster_id = columns[column][row];
+            expected[column] = !PLIUtil::IsSingletonCluster(cluster_id) &&
+                               cluster_id == columns[column][row - 1];
+        }
+        boost::dynamic_bitset<> attributes(columns.size());
+        records.Match(attributes, row, row - 1);
+        ASSERT_EQ(attributes, expected);
+    }
+}
+
+template <typename Code>
+void TestAgreeMask() {
+    using util::AgreeMaskIsa;
+    constexpr Code kNull = std::numeric_limits<Code>::max();
+    std::mt19937 gen(11);
+    // Few distinct codes, so that rows agree on many columns
+    std::uniform_int_distribution<unsigned> distribution(0, 3);
+    auto random_code = [&]() {
+        unsigned const code = distribution(gen);
+        return code == 3 ? kNull : static_cast<Code>(code);
+    };
+    for (size_t count : {0, 1, 7, 15, 16, 31, 33, 63, 64, 65, 100, 129, 200}) {
+        std::vector<Code> first(count);
+        std::vector<Code> second(count);
+        std::generate(first.begin(), first.end(), random_code);
+        std::generate(second.begin(), second.end(), random_code);
+        for (size_t first_bit : {0, 5, 63, 64, 70}) {
+            size_t const num_words = util::GetAgreeMaskWords(first_bit + count);
+            std::vector<std::uint64_t> expected(num_words);
+            for (size_t i = 0; i != count; ++i) {
+                if (first[i] == second[i] && first[i] != kNull) {
+                    expected[(first_bit + i) / 64] |= std::uint64_t{1} << (first_bit + i) % 64;
+                }
+            }
+            for (AgreeMaskIsa isa :
+                 {AgreeMaskIsa::kScalar, AgreeMaskIsa::kAvx2, AgreeMaskIsa::kAvx512}) {
+                if (!util::IsAgreeMaskIsaSupported(isa)) continue;
+                std::vector<std::uint64_t> mask(num_words);
+                util::AddAgreeMask(isa, first.data(), second.data(), count, kNull, mask.data(),
+                                   first_bit);
+                ASSERT_EQ(mask, expected) << "isa " << static_cast<int>(isa) << ", " << count
+                                          << " codes from bit " << first_bit;
+            }
+        }
+    }
+}
+
+TEST(AgreeMask, EveryIsaMatchesReference) {
+    TestAgreeMask<std::uint8_t>();
+    TestAgreeMask<std::uint16_t>();
+    TestAgreeMask<std::uint32_t>();
+}
+
+template <typename Code>
+void BenchmarkAgreeMask(size_t num_columns) {
+    using util::AgreeMaskIsa;
+    constexpr size_t kNumRows = 1 << 12;
+    constexpr size_t kNumPairs = 1 << 22;
+    constexpr Code kNull = std::numeric_limits<Code>::max();
+    std::mt19937 gen(3);
+    std::uniform_int_distribution<unsigned> distribution(0, 3);
+    std::vector<Code> rows(kNumRows * num_columns);
+    for (Code& code : rows) {
+        unsigned const value = distribution(gen);
+        code = value == 3 ? kNull : static_cast<Code>(value);
+    }
+    std::vector<std::uint64_t> mask(util::GetAgreeMaskWords(num_columns));
+
+    for (AgreeMaskIsa isa : {AgreeMaskIsa::kScalar, AgreeMaskIsa::kAvx2, AgreeMaskIsa::kAvx512}) {
+        if (!util::IsAgreeMaskIsaSupported(isa)) continue;
+        std::uint64_t checksum = 0;
+        auto const start = std::chrono::steady_clock::now();
+        for (size_t pair = 0; pair != kNumPairs; ++pair) {
+            Code const* const first = rows.data() + (pair % kNumRows) * num_columns;
+            Code const* const second = rows.data() + ((pair * 7 + 1) % kNumRows) * num_columns;
+            std::fill(mask.begin(), mask.end(), 0);
+            util::AddAgreeMask(isa, first, second, num_columns, kNull, mask.data());
+            checksum += mask.front();
+        }
+        std::chrono::duration<double, std::nano> const elapsed =
+                std::chrono::steady_clock::now() - start;
+        cout << sizeof(Code) << "-byte codes, " << num_columns << " columns, isa "
+             << static_cast<int>(isa) << ": " << elapsed.count() / kNumPairs
+             << " ns per pair (checksum " << checksum << ")" << endl;
+    }
+}
+
+// Compares the instruction sets on row pairs, run with --gtest_also_run_disabled_tests
+TEST(AgreeMask, DISABLED_Benchmark) {
+    for (size_t num_columns : {16, 48, 128}) {
+        BenchmarkAgreeMask<std::uint8_t>(num_columns);
+        BenchmarkAgreeMask<std::uint16_t>(num_columns);
+        BenchmarkAgreeMask<std::uint32_t>(num_columns);
+    }
+}
+
+TEST(FDTree, RemoveReusesNodes) {
+    using algos::hyfd::fd_tree::FDTree;
+    // Wider than a bitset block
+    constexpr size_t kNumAttributes = 70;
+    auto make_lhs = [](std::initializer_list<size_t> attributes) {
+        boost::dynamic_bitset<> lhs(kNumAttributes);
+        for (size_t attribute : attributes) lhs.set(attribute);
+        return lhs;
+    };
+    FDTree tree(kNumAttributes);
+    EXPECT_EQ(tree.FillFDs().size(), kNumAttributes);
+    for (size_t rhs = 0; rhs != kNumAttributes; ++rhs) {
+        tree.Remove(boost::dynamic_bitset<>(kNumAttributes), rhs);
+    }
+    EXPECT_TRUE(tree.FillFDs().empty());
+
+    EXPECT_NE(tree.AddFD(make_lhs({1, 65}), 3), FDTree::kNoVertex);
+    EXPECT_EQ(tree.AddFD(make_lhs({1}), 69), FDTree::kNoVertex);
+    EXPECT_NE(tree.AddFD(make_lhs({1, 2, 64}), 0), FDTree::kNoVertex);
+    EXPECT_TRUE(tree.ContainsFD(make_lhs({1, 65}), 3));
+    EXPECT_FALSE(tree.ContainsFD(make_lhs({1, 65}), 0));
+    EXPECT_TRUE(tree.FindFdOrGeneral(make_lhs({1, 2, 65}), 3));
+    EXPECT_FALSE(tree.FindFdOrGeneral(make_lhs({2, 65}), 3));
+    EXPECT_EQ(tree.GetFdAndGenerals(make_lhs({1, 2, 64, 65}), 0).size(), 1);
+    EXPECT_EQ(tree.GetLevel(2).size(), 2);
+    EXPECT_EQ(tree.GetNextLevel(tree.GetLevel(2)).size(), 1);
+    EXPECT_EQ(tree.FillFDs().size(), 3);
+
+    tree.Remove(make_lhs({1, 2, 64}), 0);
+    EXPECT_EQ(tree.GetChild(tree.GetChild(FDTree::kRoot, 1), 2), FDTree::kNoVertex);
+    EXPECT_EQ(tree.FillFDs().size(), 2);
+    size_t const memory_usage = tree.GetMemoryUsage();
+    EXPECT_NE(tree.AddFD(make_lhs({1, 3, 64}), 0), FDTree::kNoVertex);
+    EXPECT_TRUE(tree.ContainsFD(make_lhs({1, 3, 64}), 0));
+    EXPECT_EQ(tree.GetMemoryUsage(), memory_usage);
+}
+
 TEST(testingBitsetToLonglong, first) {
     size_t encoded_num = 1254;
     boost::dynamic_bitset<> simple_bitset{20, encoded_num};
@@ -87,6 +388,73 @@ TEST(testingBitsetToLonglong, first) {
     for (auto long_long_repr : res_vector) ASSERT_EQ(encoded_num, long_long_repr);
 }
 
+TEST(ListAgreeSetSample, CountsAgreeSupersets) {
+    // 70 columns take two words per agree set
+    for (int num_columns : {6, 70}) {
+        RelationalSchema schema("schema");
+        for (int i = 0; i < num_columns; ++i) {
+            schema.AppendColumn(std::to_string(i));
+        }
+        schema.Init();
+
+        std::mt19937 gen(num_columns);
+        auto random_bitset = [&gen, num_columns](unsigned percent) {
+            boost::dynamic_bitset<> bitset(num_columns);
+            for (int i = 0; i < num_columns; ++i) {
+                bitset[i] = gen() % 100 < percent;
+            }
+            return bitset;
+        };
+        std::unordered_map<boost::dynamic_bitset<>, int, util::BitsetHash> agree_set_counters;
+        for (int i = 0; i < 200; ++i) {
+            agree_set_counters[random_bitset(90)] += 1 + gen() % 5;
+        }
+        model::ListAgreeSetSample sample(nullptr, *schema.empty_vertical_, 1000, 1000,
+                                         agree_set_counters);
+
+        for (int i = 0; i < 100; ++i) {
+            Vertical agreement = schema.GetVertical(random_bitset(10));
+            Vertical disagreement =
+                    schema.GetVertical(random_bitset(10) - agreement.GetColumnIndices());
+            unsigned long long expected_agreeing = 0, expected = 0;
+            for (auto const& [agree_set, count] : agree_set_counters) {
+                if (!agreement.GetColumnIndices().is_subset_of(agree_set)) continue;
+                expected_agreeing += count;
+                if (!agree_set.intersects(disagreement.GetColumnIndices())) expected += count;
+            }
+            EXPECT_EQ(sample.GetNumAgreeSupersets(agreement), expected_agreeing);
+            EXPECT_EQ(sample.GetNumAgreeSupersets(agreement, disagreement), expected);
+            EXPECT_THAT(*sample.GetNumAgreeSupersetsExt(agreement, disagreement),
+                        ContainerEq(vector<unsigned long long>{expected_agreeing, expected}));
+        }
+    }
+}
+
+TEST(VerticalHash, DistinguishesColumnsOfWideSchemas) {
+    int const num_columns = 150;
+    RelationalSchema schema("schema");
+    for (int i = 0; i < num_columns; ++i) {
+        schema.AppendColumn(std::to_string(i));
+    }
+    schema.Init();
+
+    std::unordered_set<Vertical> verticals;
+    std::unordered_set<size_t> hashes;
+    for (int i = 0; i < num_columns; ++i) {
+        boost::dynamic_bitset<> indices(num_columns);
+        indices.set(i);
+        Vertical vertical = schema.GetVertical(indices);
+        hashes.insert(std::hash<Vertical>{}(vertical));
+        verticals.insert(std::move(vertical));
+        indices.set(num_columns - 1 - i);
+        verticals.insert(schema.GetVertical(indices));
+    }
+    verticals.insert(*schema.empty_vertical_);
+
+    EXPECT_EQ(hashes.size(), num_columns);
+    EXPECT_EQ(verticals.size(), num_columns + num_columns / 2 + 1);
+}
+
 TEST(IdentifierSetTest, Computation) {
     std::set<std::string> id_sets;
     std::set<std::string> id_sets_ans = {"[(A, 0), (B, 1), (C, 1), (D, 1), (E, 1), (F, 1)]",
@@ -151,7 +519,7 @@ void TestAgreeSetFactory(AgreeSetFactory::Configuration c) {
         auto relation = ColumnLayoutRelationData::CreateFrom(*input_table, false);
         AgreeSetFactory factory(relation.get(), c);
         for (model::AgreeSet const& agree_set : factory.GenAgreeSets()) {
-            agree_sets_actual.insert(agree_set.ToString());
+            agree_sets_actual.insert(relation->GetSchema()->GetVertical(agree_set).ToString());
         }
     } catch (std::runtime_error const& e) {
         cout << "Exception raised in test: " << e.what() << endl;
@@ -180,6 +548,111 @@ TEST(AgreeSetFactoryTest, UsingMCAndGetAgreeSet) {
     TestAgreeSetFactory(c);
 }
 
+TEST(Metrics, CollectUpdatesOfWorkerThreads) {
+    util::Metrics metrics;
+    util::AddToCounter("values");
+    {
+        util::MetricsScope scope(&metrics);
+        std::vector<std::uint64_t> values(1000);
+        std::iota(values.begin(), values.end(), 0);
+        util::ParallelForeach(values.begin(), values.end(), 4, [](std::uint64_t value) {
+            util::AddToCounter("values");
+            util::AddToCounter("sum", value);
+            util::RecordInHistogram("distribution", value);
+        });
+    }
+    util::AddToCounter("values");
+
+    util::MetricsSnapshot const snapshot = metrics.Snapshot();
+    EXPECT_EQ(snapshot.counters.at("values"), 1000);
+    EXPECT_EQ(snapshot.counters.at("sum"), 999 * 1000 / 2);
+    /* 0, 1, [2, 4), [4, 8), ..., [512, 1024) */
+    std::vector<std::uint64_t> expected_buckets{1, 1};
+    for (std::uint64_t bucket_begin = 2; bucket_begin < 1000; bucket_begin *= 2) {
+        expected_buckets.push_back(std::min<std::uint64_t>(bucket_begin, 1000 - bucket_begin));
+    }
+    EXPECT_THAT(snapshot.histograms.at("distribution"), ContainerEq(expected_buckets));
+
+    metrics.Reset();
+    EXPECT_TRUE(metrics.Snapshot().counters.empty());
+}
+
+namespace {
+
+struct TestMetricHandles {
+    util::MetricCounter& counter;
+
+    explicit TestMetricHandles(util::Metrics& metrics) : counter(metrics.GetCounter("handles")) {}
+};
+
+}  // namespace
+
+TEST(Metrics, HandlesAreResolvedAgainForNewRuns) {
+    EXPECT_EQ(util::GetCurrentMetricHandles<TestMetricHandles>(), nullptr);
+    util::Metrics metrics;
+    util::MetricsScope scope(&metrics);
+    util::GetCurrentMetricHandles<TestMetricHandles>()->counter.Add(2);
+    util::GetCurrentMetricHandles<TestMetricHandles>()->counter.Add();
+    EXPECT_EQ(metrics.GetCounterValue("handles"), 3);
+
+    // Handles of the previous run refer to destroyed metrics
+    metrics.Reset();
+    util::GetCurrentMetricHandles<TestMetricHandles>()->counter.Add();
+    EXPECT_EQ(metrics.GetCounterValue("handles"), 1);
+
+    // Looking values up does not create metrics
+    EXPECT_EQ(metrics.GetCounterValue("absent"), 0);
+    EXPECT_EQ(metrics.GetTimerValue("absent").count, 0);
+    EXPECT_EQ(metrics.Snapshot().counters.size(), 1);
+    EXPECT_TRUE(metrics.Snapshot().timers.empty());
+}
+
+TEST(Progress, SumsUpdatesOfWorkerThreads) {
+    util::Progress progress({"first", "second"});
+    std::vector<int> items(4000);
+    util::ParallelForeach(items.begin(), items.end(), 4,
+                          [&progress](int) { progress.AddProgress(100.0 / 4000); });
+    EXPECT_EQ(progress.GetProgress().first, 0);
+    EXPECT_NEAR(progress.GetProgress().second, 100, 1e-6);
+
+    progress.ToNextProgressPhase();
+    EXPECT_EQ(progress.GetProgress(), std::make_pair(uint8_t{1}, 0.0));
+    progress.SetProgress(42.5);
+    EXPECT_EQ(progress.GetProgress(), std::make_pair(uint8_t{1}, 42.5));
+    progress.ResetProgress();
+    EXPECT_EQ(progress.GetProgress(), std::make_pair(uint8_t{0}, 0.0));
+}
+
+TEST(Watchdog, CancelsTokenAfterTimeLimit) {
+    util::CancellationToken token;
+    {
+        util::Watchdog watchdog(token, std::chrono::hours(1));
+    }
+    EXPECT_FALSE(token.IsCancelled());
+
+    util::Watchdog watchdog(token, std::chrono::milliseconds(10));
+    auto const deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!token.IsCancelled() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_TRUE(token.IsCancelled());
+    EXPECT_EQ(watchdog.GetExceededLimit(), util::Watchdog::Limit::kTime);
+}
+
+TEST(Watchdog, CancelsTokenOverMemoryBudget) {
+    if (util::GetResidentSetSize() == 0) GTEST_SKIP() << "Memory usage is not reported";
+    util::CancellationToken token;
+    {
+        util::Watchdog watchdog(token, std::chrono::hours(1), util::GetResidentSetSize() * 16);
+        EXPECT_EQ(watchdog.GetExceededLimit(), util::Watchdog::Limit::kNone);
+    }
+    EXPECT_FALSE(token.IsCancelled());
+
+    util::Watchdog watchdog(token, std::chrono::hours(1), 1);
+    EXPECT_TRUE(token.IsCancelled());
+    EXPECT_EQ(watchdog.GetExceededLimit(), util::Watchdog::Limit::kMemory);
+}
+
 TEST(AgreeSetFactoryTest, UsingHandleEqvClass) {
     AgreeSetFactory::Configuration c(MCGenMethod::kUsingHandleEqvClass);
     TestAgreeSetFactory(c);
@@ -195,14 +668,11 @@ TEST(AgreeSetFactoryTest, UsingHandlePartition) {
     TestAgreeSetFactory(c);
 }
 
-#if 0
 TEST(AgreeSetFactoryTest, MCGenParallel) {
     AgreeSetFactory::Configuration c(AgreeSetsGenMethod::kUsingVectorOfIDSets,
-                                     MCGenMethod::kParallel,
-                                     std::thread::hardware_concurrency());
-    testAgreeSetFactory(c);
+                                     MCGenMethod::kParallel, 4);
+    TestAgreeSetFactory(c);
 }
-#endif
 
 struct TestLevenshteinParam {
     std::string l;